@@ -1228,14 +1228,85 @@ void Com_sprintf (char *dest, int size, char *fmt, ...)
 {
 	int		len;
 	va_list		argptr;
-	char	bigbuffer[0x10000];
+
+	if (size <= 0)
+		return;
 
 	va_start (argptr,fmt);
-	len = vsprintf (bigbuffer,fmt,argptr);
+	len = vsnprintf (dest,size,fmt,argptr);
 	va_end (argptr);
-	if (len >= size)
+	if (len < 0 || len >= size)
+	{
 		Com_Printf ("Com_sprintf: overflow of %i in %i\n", len, size);
-	strncpy (dest, bigbuffer, size-1);
+		dest[size-1] = 0;
+	}
+}
+
+/*
+=====================================================================
+
+  TEXT BUFFERS
+
+=====================================================================
+*/
+
+void TB_Init (textbuf_t *buf, char *data, int maxsize)
+{
+	buf->data = data;
+	buf->maxsize = maxsize;
+	buf->cursize = 0;
+	buf->overflowed = false;
+	if (maxsize > 0)
+		data[0] = 0;
+}
+
+qboolean TB_Append (textbuf_t *buf, char *text)
+{
+	int		len;
+
+	len = strlen (text);
+	if (buf->cursize + len >= buf->maxsize)
+	{
+		buf->overflowed = true;
+		return false;
+	}
+	memcpy (buf->data + buf->cursize, text, len + 1);
+	buf->cursize += len;
+	return true;
+}
+
+qboolean TB_Printf (textbuf_t *buf, char *fmt, ...)
+{
+	int		len, space;
+	va_list	argptr;
+
+	space = buf->maxsize - buf->cursize;
+	if (space <= 0)
+	{
+		buf->overflowed = true;
+		return false;
+	}
+
+	va_start (argptr, fmt);
+	len = vsnprintf (buf->data + buf->cursize, space, fmt, argptr);
+	va_end (argptr);
+
+	if (len < 0 || len >= space)
+	{
+		buf->data[buf->cursize] = 0;
+		buf->overflowed = true;
+		return false;
+	}
+	buf->cursize += len;
+	return true;
+}
+
+void TB_Truncate (textbuf_t *buf, int length)
+{
+	if (length < 0 || length >= buf->cursize)
+		return;
+	buf->cursize = length;
+	buf->data[length] = 0;
 }
 
 /*
@@ -220,6 +220,23 @@ char *COM_Parse (char **data_p);
 
 void Com_sprintf (char *dest, int size, char *fmt, ...);
 
+// bounded text builder: appends in place and tracks the length, so a
+// layout is assembled without rescanning it or formatting through a
+// temporary.  An append that doesn't fit is dropped whole, leaving the
+// text as it was, so a layout never ends in half a command.
+typedef struct
+{
+	char		*data;
+	int			maxsize;		// including the terminating 0
+	int			cursize;		// strlen (data)
+	qboolean	overflowed;		// something was dropped
+} textbuf_t;
+
+void TB_Init (textbuf_t *buf, char *data, int maxsize);
+qboolean TB_Append (textbuf_t *buf, char *text);
+qboolean TB_Printf (textbuf_t *buf, char *fmt, ...);
+void TB_Truncate (textbuf_t *buf, int length);
+
 void Com_PageInMemory (byte *buffer, int size);
 
 //=============================================
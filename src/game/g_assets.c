@@ -0,0 +1,240 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_assets.c -- resolved sound, image and model indexes
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+ASSET INDEXES
+
+gi.soundindex and friends look the name up in the server's configstrings
+every time they are called.  The player, HUD and weapon code called them
+with the same few dozen names every frame for every client.
+
+Those names are listed here once.  G_Asset (SND_NOAMMO) returns the index
+from asset_index, and only goes to the server the first time a name is
+used on a level.  The assets worldspawn precaches anyway are resolved by
+G_PrecacheAssets at spawn time; the rest are resolved when first used,
+exactly as the name lookups did, so no map gets configstrings it didn't
+have before.
+
+Item icons and view models get the same treatment through G_ItemIcon and
+G_ItemViewModel, filled in by PrecacheItem.
+
+Indexes only hold for the level they were resolved on, so everything is
+forgotten when a level is spawned or loaded.
+
+==============================================================================
+*/
+
+typedef enum
+{
+	AT_SOUND,
+	AT_IMAGE,
+	AT_MODEL
+} assettype_t;
+
+typedef struct
+{
+	assettype_t	type;
+	char		*name;
+	qboolean	precache;		// worldspawn precaches it anyway
+} assetdef_t;
+
+static assetdef_t	asset_defs[NUM_ASSETS] =
+{
+	{AT_SOUND, NULL, false},
+
+	{AT_SOUND, "*pain25_1.wav", true},
+	{AT_SOUND, "*pain25_2.wav", true},
+	{AT_SOUND, "*pain50_1.wav", true},
+	{AT_SOUND, "*pain50_2.wav", true},
+	{AT_SOUND, "*pain75_1.wav", true},
+	{AT_SOUND, "*pain75_2.wav", true},
+	{AT_SOUND, "*pain100_1.wav", true},
+	{AT_SOUND, "*pain100_2.wav", true},
+	{AT_SOUND, "*gurp1.wav", true},
+	{AT_SOUND, "*gurp2.wav", true},
+	{AT_SOUND, "player/drown1.wav", false},
+	{AT_SOUND, "player/gasp1.wav", true},
+	{AT_SOUND, "player/gasp2.wav", true},
+	{AT_SOUND, "player/burn1.wav", false},
+	{AT_SOUND, "player/burn2.wav", false},
+	{AT_SOUND, "player/lava_in.wav", false},
+	{AT_SOUND, "player/watr_in.wav", true},
+	{AT_SOUND, "player/watr_out.wav", true},
+	{AT_SOUND, "player/watr_un.wav", true},
+	{AT_SOUND, "player/u_breath1.wav", true},
+	{AT_SOUND, "player/u_breath2.wav", true},
+
+	{AT_SOUND, "items/damage2.wav", false},
+	{AT_SOUND, "items/protect2.wav", false},
+	{AT_SOUND, "items/airout.wav", false},
+	{AT_SOUND, "items/damage3.wav", false},
+	{AT_SOUND, "misc/power2.wav", false},
+	{AT_SOUND, "misc/pc_up.wav", true},
+
+	{AT_SOUND, "weapons/noammo.wav", true},
+	{AT_SOUND, "weapons/hgrena1b.wav", false},
+	{AT_SOUND, "weapons/hgrenc1b.wav", false},
+	{AT_SOUND, "weapons/hgrent1a.wav", false},
+	{AT_SOUND, "weapons/hgrenb1a.wav", false},
+	{AT_SOUND, "weapons/hgrenb2a.wav", false},
+	{AT_SOUND, "weapons/grenlb1b.wav", false},
+	{AT_SOUND, "weapons/hyprbl1a.wav", false},
+	{AT_SOUND, "weapons/hyprbd1a.wav", false},
+	{AT_SOUND, "weapons/hyprbu1a.wav", false},
+	{AT_SOUND, "weapons/chngnu1a.wav", false},
+	{AT_SOUND, "weapons/chngnd1a.wav", false},
+	{AT_SOUND, "weapons/chngnl1a.wav", false},
+	{AT_SOUND, "weapons/rg_hum.wav", false},
+	{AT_SOUND, "weapons/bfg_hum.wav", false},
+	{AT_SOUND, "weapons/bfg__l1a.wav", false},
+	{AT_SOUND, "weapons/bfg__x1b.wav", false},
+	{AT_SOUND, "misc/lasfly.wav", false},
+	{AT_SOUND, "weapons/rockfly.wav", false},
+	{AT_SOUND, "weapons/blastf1a.wav", false},
+	{AT_SOUND, "sound/dod/DoD.wav", false},
+	{AT_SOUND, "sound/dod/DoD_hum.wav", false},
+	{AT_SOUND, "misc/tele1.wav", false},
+
+	{AT_IMAGE, "i_help", true},
+	{AT_IMAGE, "i_powershield", false},
+	{AT_IMAGE, "p_quad", false},
+	{AT_IMAGE, "p_invulnerability", false},
+	{AT_IMAGE, "p_envirosuit", false},
+	{AT_IMAGE, "p_rebreather", false},
+
+	{AT_MODEL, "models/objects/laser/tris.md2", false},
+	{AT_MODEL, "models/objects/grenade/tris.md2", false},
+	{AT_MODEL, "models/objects/grenade2/tris.md2", false},
+	{AT_MODEL, "models/objects/rocket/tris.md2", false},
+	{AT_MODEL, "models/objects/dod/tris.md2", false},
+	{AT_MODEL, "models/objects/detpack/tris.md2", false},
+	{AT_MODEL, "sprites/s_bfg1.sp2", false},
+	{AT_MODEL, "sprites/s_bfg3.sp2", false},
+	{AT_MODEL, "models/objects/rtdu/rtdu.md2", false},
+	{AT_MODEL, "models/objects/rtdu/tripod.md2", false}
+};
+
+int		asset_index[NUM_ASSETS];
+
+static int	item_icon[MAX_ITEMS];
+static int	item_view_model[MAX_ITEMS];
+
+/*
+=================
+G_ResolveAsset
+
+Called through G_Asset the first time an asset is used on a level.
+=================
+*/
+int G_ResolveAsset (asset_t asset)
+{
+	assetdef_t	*def;
+
+	if (asset <= ASSET_NONE || asset >= NUM_ASSETS)
+		return 0;
+
+	def = &asset_defs[asset];
+	if (def->type == AT_SOUND)
+		asset_index[asset] = gi.soundindex (def->name);
+	else if (def->type == AT_IMAGE)
+		asset_index[asset] = gi.imageindex (def->name);
+	else
+		asset_index[asset] = gi.modelindex (def->name);
+	return asset_index[asset];
+}
+
+/*
+=================
+G_PrecacheAssets
+
+Called from SP_worldspawn with the rest of the player precaches.
+=================
+*/
+void G_PrecacheAssets (void)
+{
+	int		i;
+
+	for (i=ASSET_NONE+1 ; i<NUM_ASSETS ; i++)
+		if (asset_defs[i].precache)
+			G_ResolveAsset (i);
+}
+
+/*
+=================
+G_ResetAssets
+
+Called whenever a level is spawned or loaded, since the server hands out
+a fresh set of indexes for every map.
+=================
+*/
+void G_ResetAssets (void)
+{
+	memset (asset_index, 0, sizeof(asset_index));
+	memset (item_icon, 0, sizeof(item_icon));
+	memset (item_view_model, 0, sizeof(item_view_model));
+}
+
+/*
+=================
+G_ItemIcon / G_ItemViewModel
+=================
+*/
+int G_ItemIcon (gitem_t *item)
+{
+	int		index;
+
+	if (!item || !item->icon)
+		return 0;
+	index = ITEM_INDEX(item);
+	if (!item_icon[index])
+		item_icon[index] = gi.imageindex (item->icon);
+	return item_icon[index];
+}
+
+int G_ItemViewModel (gitem_t *item)
+{
+	int		index;
+
+	if (!item || !item->view_model)
+		return 0;
+	index = ITEM_INDEX(item);
+	if (!item_view_model[index])
+		item_view_model[index] = gi.modelindex (item->view_model);
+	return item_view_model[index];
+}
+
+/*
+=================
+G_PrecacheItemAssets
+
+Called from PrecacheItem, which is where an item's icon and view model
+get their configstrings in the first place.
+=================
+*/
+void G_PrecacheItemAssets (gitem_t *item)
+{
+	G_ItemIcon (item);
+	G_ItemViewModel (item);
+}
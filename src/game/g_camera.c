@@ -400,7 +400,7 @@ void SP_misc_camera(edict_t *self)
 {
         camera_state_t *cam;
 
-        cam = gi.TagMalloc(sizeof(*cam), TAG_LEVEL);
+        cam = G_TagMalloc(sizeof(*cam), TAG_LEVEL, "camera");
         memset(cam, 0, sizeof(*cam));
         self->camera_state = cam;
 
@@ -215,13 +215,13 @@ void Cmd_Give_f (edict_t *ent)
 	{
 		gitem_armor_t	*info;
 
-		it = FindItem("Jacket Armor");
+		it = G_Item (ITEM_JACKET_ARMOR);
 		ent->client->pers.inventory[ITEM_INDEX(it)] = 0;
 
-		it = FindItem("Combat Armor");
+		it = G_Item (ITEM_COMBAT_ARMOR);
 		ent->client->pers.inventory[ITEM_INDEX(it)] = 0;
 
-		it = FindItem("Body Armor");
+		it = G_Item (ITEM_BODY_ARMOR);
 		info = (gitem_armor_t *)it->info;
 		ent->client->pers.inventory[ITEM_INDEX(it)] = info->max_count;
 
@@ -231,7 +231,7 @@ void Cmd_Give_f (edict_t *ent)
 
 	if (give_all || Q_stricmp(name, "Power Shield") == 0)
 	{
-		it = FindItem("Power Shield");
+		it = G_Item (ITEM_POWER_SHIELD);
 		it_ent = G_Spawn();
 		it_ent->classname = it->classname;
 		SpawnItem (it_ent, it);
@@ -694,8 +694,8 @@ void Cmd_Players_f (edict_t *ent)
 {
 	int		i;
 	int		count;
-	char	small[64];
 	char	large[1280];
+	textbuf_t	buf;
 	int		index[256];
 
 	count = 0;
@@ -709,20 +709,19 @@ void Cmd_Players_f (edict_t *ent)
 	// sort by frags
 	qsort (index, count, sizeof(index[0]), PlayerSort);
 
-	// print information
-	large[0] = 0;
+	// print information, leaving room for the "..."
+	TB_Init (&buf, large, sizeof(large) - 100);
 
 	for (i = 0 ; i < count ; i++)
 	{
-		Com_sprintf (small, sizeof(small), "%3i %s\n",
+		if (!TB_Printf (&buf, "%3i %s\n",
 			game.clients[index[i]].ps.stats[STAT_FRAGS],
-			game.clients[index[i]].pers.netname);
-		if (strlen (small) + strlen(large) > sizeof(large) - 100 )
+			game.clients[index[i]].pers.netname))
 		{	// can't print all of them in one packet
-			strcat (large, "...\n");
+			buf.maxsize = sizeof(large);
+			TB_Append (&buf, "...\n");
 			break;
 		}
-		strcat (large, small);
 	}
 
 	gi.cprintf (ent, PRINT_HIGH, "%s\n%i players\n", large, count);
@@ -786,10 +785,11 @@ Cmd_Say_f
 */
 void Cmd_Say_f (edict_t *ent, qboolean team, qboolean arg0)
 {
-	int		i, j;
+	int		j;
 	edict_t	*other;
 	char	*p;
 	char	text[2048];
+	textbuf_t	buf;
 	gclient_t *cl;
 
 	if (gi.argc () < 2 && !arg0)
@@ -798,16 +798,17 @@ void Cmd_Say_f (edict_t *ent, qboolean team, qboolean arg0)
 	if (!((int)(dmflags->value) & (DF_MODELTEAMS | DF_SKINTEAMS)))
 		team = false;
 
+	TB_Init (&buf, text, sizeof(text));
 	if (team)
-		Com_sprintf (text, sizeof(text), "(%s): ", ent->client->pers.netname);
+		TB_Printf (&buf, "(%s): ", ent->client->pers.netname);
 	else
-		Com_sprintf (text, sizeof(text), "%s: ", ent->client->pers.netname);
+		TB_Printf (&buf, "%s: ", ent->client->pers.netname);
 
 	if (arg0)
 	{
-		strcat (text, gi.argv(0));
-		strcat (text, " ");
-		strcat (text, gi.args());
+		TB_Append (&buf, gi.argv(0));
+		TB_Append (&buf, " ");
+		TB_Append (&buf, gi.args());
 	}
 	else
 	{
@@ -818,14 +819,13 @@ void Cmd_Say_f (edict_t *ent, qboolean team, qboolean arg0)
 			p++;
 			p[strlen(p)-1] = 0;
 		}
-		strcat(text, p);
+		TB_Append (&buf, p);
 	}
 
 	// don't let text be too long for malicious reasons
-	if (strlen(text) > 150)
-		text[150] = 0;
+	TB_Truncate (&buf, 150);
 
-	strcat(text, "\n");
+	TB_Append (&buf, "\n");
 
 	if (flood_msgs->value) {
 		cl = ent->client;
@@ -835,19 +835,12 @@ void Cmd_Say_f (edict_t *ent, qboolean team, qboolean arg0)
 				(int)(cl->flood_locktill - level.time));
             return;
         }
-        i = cl->flood_whenhead - flood_msgs->value + 1;
-        if (i < 0)
-            i = (sizeof(cl->flood_when)/sizeof(cl->flood_when[0])) + i;
-		if (cl->flood_when[i] && 
-			level.time - cl->flood_when[i] < flood_persecond->value) {
+		if (!G_RateLimit (ent, RL_CHAT)) {
 			cl->flood_locktill = level.time + flood_waitdelay->value;
 			gi.cprintf(ent, PRINT_CHAT, "Flood protection:  You can't talk for %d seconds.\n",
 				(int)flood_waitdelay->value);
             return;
         }
-		cl->flood_whenhead = (cl->flood_whenhead + 1) %
-			(sizeof(cl->flood_when)/sizeof(cl->flood_when[0]));
-		cl->flood_when[cl->flood_whenhead] = level.time;
 	}
 
 	if (dedicated->value)
@@ -899,6 +892,100 @@ void Cmd_PlayerList_f(edict_t *ent)
 	gi.cprintf(ent, PRINT_HIGH, "%s", text);
 }
 
+/*
+=================
+Cmd_QuickSave_f / Cmd_QuickLoad_f / Cmd_Rewind_f
+
+In-memory snapshots of the current level, single player and coop only.
+They move every player, so with more than one client slot only the
+listen server's own player may use them, and only with g_coop_snapshots
+set.  The server console always can, through "sv quicksave", "sv
+quickload" and "sv rewind"; ent is NULL then.
+
+argv(0) rewind [seconds]
+sv rewind [seconds]
+=================
+*/
+static qboolean Snapshot_Allowed (edict_t *ent)
+{
+	if (deathmatch->value)
+	{
+		gi.cprintf (ent, PRINT_HIGH, "Snapshots are not available in deathmatch.\n");
+		return false;
+	}
+	if (!ent || game.maxclients == 1)
+		return true;
+	if (!g_coop_snapshots->value)
+	{
+		gi.cprintf (ent, PRINT_HIGH, "Snapshots are off in multiplayer (g_coop_snapshots).\n");
+		return false;
+	}
+	if (!G_SnapshotHost (ent))
+	{
+		gi.cprintf (ent, PRINT_HIGH, "Only the server's host can use snapshots.\n");
+		return false;
+	}
+	return true;
+}
+
+void Cmd_QuickSave_f (edict_t *ent)
+{
+	if (!Snapshot_Allowed (ent))
+		return;
+	if (G_QuickSave ())
+		gi.cprintf (ent, PRINT_HIGH, "Quicksaved.\n");
+	else
+		gi.cprintf (ent, PRINT_HIGH, "Couldn't quicksave.\n");
+}
+
+void Cmd_QuickLoad_f (edict_t *ent)
+{
+	if (!Snapshot_Allowed (ent))
+		return;
+	if (!G_QuickLoad ())
+		gi.cprintf (ent, PRINT_HIGH, "No quicksave for this level.\n");
+}
+
+void Cmd_Rewind_f (edict_t *ent)
+{
+	float	seconds;
+
+	if (!Snapshot_Allowed (ent))
+		return;
+
+	seconds = atof (gi.argv (ent ? 1 : 2));
+	seconds = G_Rewind (seconds);
+	if (seconds < 0)
+		gi.cprintf (ent, PRINT_HIGH, "Nothing to rewind to (set g_rewind).\n");
+	else
+		gi.cprintf (ent, PRINT_HIGH, "Rewound %.1f seconds.\n", seconds);
+}
+
+
+/*
+=================
+ClientCommandClass
+
+Which of the client's token buckets a command is taken from.
+=================
+*/
+static rateclass_t ClientCommandClass (char *cmd)
+{
+	if (!Q_stricmp (cmd, "say") || !Q_stricmp (cmd, "say_team"))
+		return RL_CHAT;
+	if (!Q_stricmp (cmd, "players") || !Q_stricmp (cmd, "score") || !Q_stricmp (cmd, "help")
+		|| !Q_stricmp (cmd, "inven") || !Q_stricmp (cmd, "playerlist"))
+		return RL_LAYOUT;
+	if (!Q_stricmp (cmd, "wave"))
+		return RL_GESTURE;
+	// switching and using what the player carries, which spawns nothing
+	if (!Q_stricmp (cmd, "use") || !Q_stricmp (cmd, "invuse") || !Q_stricmp (cmd, "invnext")
+		|| !Q_stricmp (cmd, "invprev") || !Q_stricmp (cmd, "invnextw") || !Q_stricmp (cmd, "invprevw")
+		|| !Q_stricmp (cmd, "invnextp") || !Q_stricmp (cmd, "invprevp") || !Q_stricmp (cmd, "weapnext")
+		|| !Q_stricmp (cmd, "weapprev") || !Q_stricmp (cmd, "weaplast") || !Q_stricmp (cmd, "putaway"))
+		return RL_GAMEPLAY;
+	return RL_COMMAND;
+}
 
 /*
 =================
@@ -908,12 +995,18 @@ ClientCommand
 void ClientCommand (edict_t *ent)
 {
 	char	*cmd;
+	rateclass_t	cls;
 
 	if (!ent->client)
 		return;		// not fully in game yet
 
 	cmd = gi.argv(0);
 
+	// chat is limited in Cmd_Say_f, which also gets the unknown commands
+	cls = ClientCommandClass (cmd);
+	if (cls != RL_CHAT && !G_RateLimit (ent, cls))
+		return;
+
 	if (Q_stricmp (cmd, "players") == 0)
 	{
 		Cmd_Players_f (ent);
@@ -987,6 +1080,12 @@ void ClientCommand (edict_t *ent)
 		Cmd_Wave_f (ent);
 	else if (Q_stricmp(cmd, "playerlist") == 0)
 		Cmd_PlayerList_f(ent);
+	else if (Q_stricmp (cmd, "quicksave") == 0)
+		Cmd_QuickSave_f (ent);
+	else if (Q_stricmp (cmd, "quickload") == 0)
+		Cmd_QuickLoad_f (ent);
+	else if (Q_stricmp (cmd, "rewind") == 0)
+		Cmd_Rewind_f (ent);
 	else	// anything that doesn't match a command will be a chat
 		Cmd_Say_f (ent, false, true);
 }
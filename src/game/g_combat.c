@@ -21,15 +21,16 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include "g_local.h"
 
+static int	candamage_traces;	// every CanDamage trace, for the radius stats
+
 /*
 ============
-CanDamage
+CanDamageFrom
 
-Returns true if the inflictor can directly damage the target.  Used for
-explosions and melee attacks.
+Traces from origin to the target, skipping passent and what it owns.
 ============
 */
-qboolean CanDamage (edict_t *targ, edict_t *inflictor)
+static qboolean CanDamageFrom (edict_t *targ, vec3_t origin, edict_t *passent)
 {
 	vec3_t	dest;
 	trace_t	trace;
@@ -39,7 +40,8 @@ qboolean CanDamage (edict_t *targ, edict_t *inflictor)
 	{
 		VectorAdd (targ->absmin, targ->absmax, dest);
 		VectorScale (dest, 0.5, dest);
-		trace = gi.trace (inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
+		candamage_traces++;
+		trace = gi.trace (origin, vec3_origin, vec3_origin, dest, passent, MASK_SOLID);
 		if (trace.fraction == 1.0)
 			return true;
 		if (trace.ent == targ)
@@ -47,35 +49,40 @@ qboolean CanDamage (edict_t *targ, edict_t *inflictor)
 		return false;
 	}
 	
-	trace = gi.trace (inflictor->s.origin, vec3_origin, vec3_origin, targ->s.origin, inflictor, MASK_SOLID);
+	candamage_traces++;
+	trace = gi.trace (origin, vec3_origin, vec3_origin, targ->s.origin, passent, MASK_SOLID);
 	if (trace.fraction == 1.0)
 		return true;
 
 	VectorCopy (targ->s.origin, dest);
 	dest[0] += 15.0;
 	dest[1] += 15.0;
-	trace = gi.trace (inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
+	candamage_traces++;
+	trace = gi.trace (origin, vec3_origin, vec3_origin, dest, passent, MASK_SOLID);
 	if (trace.fraction == 1.0)
 		return true;
 
 	VectorCopy (targ->s.origin, dest);
 	dest[0] += 15.0;
 	dest[1] -= 15.0;
-	trace = gi.trace (inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
+	candamage_traces++;
+	trace = gi.trace (origin, vec3_origin, vec3_origin, dest, passent, MASK_SOLID);
 	if (trace.fraction == 1.0)
 		return true;
 
 	VectorCopy (targ->s.origin, dest);
 	dest[0] -= 15.0;
 	dest[1] += 15.0;
-	trace = gi.trace (inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
+	candamage_traces++;
+	trace = gi.trace (origin, vec3_origin, vec3_origin, dest, passent, MASK_SOLID);
 	if (trace.fraction == 1.0)
 		return true;
 
 	VectorCopy (targ->s.origin, dest);
 	dest[0] -= 15.0;
 	dest[1] -= 15.0;
-	trace = gi.trace (inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
+	candamage_traces++;
+	trace = gi.trace (origin, vec3_origin, vec3_origin, dest, passent, MASK_SOLID);
 	if (trace.fraction == 1.0)
 		return true;
 
@@ -83,6 +90,181 @@ qboolean CanDamage (edict_t *targ, edict_t *inflictor)
 	return false;
 }
 
+/*
+============
+CanDamage
+
+Returns true if the inflictor can directly damage the target.  Used for
+explosions and melee attacks.
+============
+*/
+qboolean CanDamage (edict_t *targ, edict_t *inflictor)
+{
+	return CanDamageFrom (targ, inflictor->s.origin, inflictor);
+}
+
+
+/*
+==============================================================================
+
+RADIUS DAMAGE LINE OF SIGHT
+
+Splash weapons ask CanDamage about the same targets from the same spot
+over and over (hellfury and deatomizer volleys, the BFG's explosion frames,
+clustered blasts from the explosion queue), and each answer can cost five
+traces.  Answers are cached for the rest of the frame, keyed by the blast
+origin snapped to a small cell, the entity the traces skip and the
+target's entity number and linkcount, so a target that relinks is traced
+again.
+
+The traces skip the inflictor's owner rather than the inflictor, which
+still skips the inflictor itself and lets every projectile of a volley
+share its answers.  An inflictor without an owner is skipped itself.
+
+g_radius_stats 1 prints how many traces radius damage spent each frame.
+
+==============================================================================
+*/
+
+#define LOS_CACHE_SIZE	256		// must be a power of two
+#define LOS_CELL_SIZE	8
+
+typedef struct
+{
+	int			framenum;		// 0 = empty
+	int			cell[3];
+	int			target;
+	int			passent;
+	int			linkcount;
+	qboolean	visible;
+} los_cache_t;
+
+typedef struct
+{
+	int		queries;
+	int		cached;
+	int		pretested;
+	int		traces;
+} radius_stats_t;
+
+static los_cache_t		los_cache[LOS_CACHE_SIZE];
+static radius_stats_t	radius_stats;
+
+/*
+=================
+LOS_PointInBox
+
+A blast that goes off inside a monster's or player's bounding box (a
+grenade rolling into someone's feet) can always see the target's origin,
+which is inside the same box.  Brush models are excluded because their
+boxes routinely wrap around walls.
+=================
+*/
+static qboolean LOS_PointInBox (edict_t *targ, vec3_t point)
+{
+	int		i;
+
+	if (targ->movetype == MOVETYPE_PUSH || targ->solid == SOLID_BSP)
+		return false;
+
+	for (i=0 ; i<3 ; i++)
+	{
+		if (point[i] < targ->absmin[i] || point[i] > targ->absmax[i])
+			return false;
+	}
+	return true;
+}
+
+/*
+=================
+CanRadiusDamage
+
+CanDamage for splash damage, answered from the per-frame cache when
+possible.
+=================
+*/
+qboolean CanRadiusDamage (edict_t *targ, edict_t *inflictor)
+{
+	los_cache_t	*entry;
+	int			cell[3];
+	edict_t		*passent;
+	int			target, pass;
+	unsigned	hash;
+	int			before;
+	int			i;
+
+	radius_stats.queries++;
+
+	if (LOS_PointInBox (targ, inflictor->s.origin))
+	{
+		radius_stats.pretested++;
+		return true;
+	}
+
+	for (i=0 ; i<3 ; i++)
+		cell[i] = (int)floor (inflictor->s.origin[i] / LOS_CELL_SIZE);
+	target = targ - g_edicts;
+	passent = inflictor->owner ? inflictor->owner : inflictor;
+	pass = passent - g_edicts;
+	if (pass < 0 || pass >= globals.num_edicts)
+		pass = -1;		// a queued blast's stand-in, which no trace can hit
+
+	hash = (unsigned)cell[0] * 73856093u ^ (unsigned)cell[1] * 19349663u
+		^ (unsigned)cell[2] * 83492791u ^ (unsigned)target * 2654435761u
+		^ (unsigned)pass;
+	entry = &los_cache[hash & (LOS_CACHE_SIZE - 1)];
+
+	if (entry->framenum == level.framenum + 1
+		&& entry->target == target && entry->passent == pass
+		&& entry->linkcount == targ->linkcount
+		&& entry->cell[0] == cell[0] && entry->cell[1] == cell[1] && entry->cell[2] == cell[2])
+	{
+		radius_stats.cached++;
+		return entry->visible;
+	}
+
+	before = candamage_traces;
+	entry->visible = CanDamageFrom (targ, inflictor->s.origin, passent);
+	radius_stats.traces += candamage_traces - before;
+
+	entry->framenum = level.framenum + 1;
+	entry->target = target;
+	entry->passent = pass;
+	entry->linkcount = targ->linkcount;
+	VectorCopy (cell, entry->cell);
+	return entry->visible;
+}
+
+/*
+=================
+G_RadiusStatsFrame
+
+Reports and clears this frame's radius damage counters.
+=================
+*/
+void G_RadiusStatsFrame (void)
+{
+	if (g_radius_stats->value && radius_stats.queries)
+		gi.dprintf ("radius: frame %i, %i queries, %i cached, %i in box, %i traces\n",
+			level.framenum, radius_stats.queries, radius_stats.cached,
+			radius_stats.pretested, radius_stats.traces);
+
+	memset (&radius_stats, 0, sizeof(radius_stats));
+}
+
+/*
+=================
+G_ResetRadiusCache
+
+Forgets every cached answer; entity numbers are reused across levels.
+=================
+*/
+void G_ResetRadiusCache (void)
+{
+	memset (los_cache, 0, sizeof(los_cache));
+	memset (&radius_stats, 0, sizeof(radius_stats));
+}
+
 
 /*
 ============
@@ -135,12 +317,143 @@ void SpawnDamage (int type, vec3_t origin, vec3_t normal, int damage)
 {
 	if (damage > 255)
 		damage = 255;
-	gi.WriteByte (svc_temp_entity);
-	gi.WriteByte (type);
-//	gi.WriteByte (damage);
-	gi.WritePosition (origin);
-	gi.WriteDir (normal);
-	gi.multicast (origin, MULTICAST_PVS);
+	G_TempEntityDir (type, origin, normal, MULTICAST_PVS);
+}
+
+
+/*
+==============================================================================
+
+DAMAGE AGGREGATION
+
+A shotgun volley or a chaingun burst calls T_Damage once per pellet, and
+each call used to send its own blood or sparks temp entity and run the
+target's pain and react logic.  With g_damage_aggregate set, health,
+armor, kills and obituaries are still resolved hit by hit inside T_Damage,
+but the impact effects and the pain / M_ReactToDamage reactions are
+collected per target and applied once by G_FlushDamage at the end of the
+frame (and at the end of ClientThink, where player weapons fire).
+
+==============================================================================
+*/
+
+#define MAX_DAMAGE_RECORDS		64
+#define MAX_DAMAGE_ATTACKERS	4
+#define MAX_DAMAGE_EFFECTS		4
+
+typedef struct
+{
+	int			type;
+	vec3_t		point;			// summed, averaged when flushed
+	vec3_t		normal;			// first hit's surface normal
+	int			hits;
+} damage_effect_t;
+
+typedef struct
+{
+	edict_t		*targ;
+	void		(*pain)(edict_t *self, edict_t *other, float kick, int damage);
+	edict_t		*attackers[MAX_DAMAGE_ATTACKERS];	// oldest first
+	int			num_attackers;
+	int			take;
+	int			knockback;
+	damage_effect_t	effects[MAX_DAMAGE_EFFECTS];
+	int			num_effects;
+} damage_record_t;
+
+static damage_record_t	damage_records[MAX_DAMAGE_RECORDS];
+static int				num_damage_records;
+static qboolean			damage_flushing;
+
+static damage_record_t *Damage_GetRecord (edict_t *targ)
+{
+	damage_record_t	*rec;
+	int				i;
+
+	if (!g_damage_aggregate->value || damage_flushing)
+		return NULL;
+
+	// the same target is usually hit several times in a row
+	for (i=num_damage_records-1 ; i>=0 ; i--)
+	{
+		if (damage_records[i].targ == targ)
+			return &damage_records[i];
+	}
+
+	if (num_damage_records == MAX_DAMAGE_RECORDS)
+		return NULL;
+
+	rec = &damage_records[num_damage_records++];
+	memset (rec, 0, sizeof(*rec));
+	rec->targ = targ;
+	rec->pain = targ->pain;
+	return rec;
+}
+
+/*
+================
+T_DamageEffect
+
+SpawnDamage for an impact on targ, merged with the target's other impacts
+of the same type this frame when aggregation is on.
+================
+*/
+static void T_DamageEffect (edict_t *targ, int type, vec3_t point, vec3_t normal, int damage)
+{
+	damage_record_t	*rec;
+	damage_effect_t	*effect;
+	int				i;
+
+	rec = Damage_GetRecord (targ);
+	if (!rec)
+	{
+		SpawnDamage (type, point, normal, damage);
+		return;
+	}
+
+	for (i=0 ; i<rec->num_effects ; i++)
+	{
+		effect = &rec->effects[i];
+		if (effect->type == type)
+		{
+			VectorAdd (effect->point, point, effect->point);
+			effect->hits++;
+			return;
+		}
+	}
+
+	if (rec->num_effects == MAX_DAMAGE_EFFECTS)
+	{
+		SpawnDamage (type, point, normal, damage);
+		return;
+	}
+
+	effect = &rec->effects[rec->num_effects++];
+	effect->type = type;
+	VectorCopy (point, effect->point);
+	VectorCopy (normal, effect->normal);
+	effect->hits = 1;
+}
+
+static void Damage_AddAttacker (damage_record_t *rec, edict_t *attacker)
+{
+	int		i;
+
+	// keep the most recent attacker last, the way back to back
+	// M_ReactToDamage calls would have left things
+	for (i=0 ; i<rec->num_attackers ; i++)
+	{
+		if (rec->attackers[i] == attacker)
+			break;
+	}
+	if (i == rec->num_attackers && rec->num_attackers == MAX_DAMAGE_ATTACKERS)
+		i = 0;
+	else if (i == rec->num_attackers)
+		rec->num_attackers++;
+
+	for ( ; i<rec->num_attackers-1 ; i++)
+		rec->attackers[i] = rec->attackers[i+1];
+	rec->attackers[rec->num_attackers-1] = attacker;
 }
 
 
@@ -192,7 +505,7 @@ static int CheckPowerArmor (edict_t *ent, vec3_t point, vec3_t normal, int damag
 		power_armor_type = PowerArmorType (ent);
 		if (power_armor_type != POWER_ARMOR_NONE)
 		{
-			index = ITEM_INDEX(FindItem("Cells"));
+			index = G_ItemIndex (ITEM_CELLS);
 			power = client->pers.inventory[index];
 		}
 	}
@@ -240,7 +553,7 @@ static int CheckPowerArmor (edict_t *ent, vec3_t point, vec3_t normal, int damag
 	if (save > damage)
 		save = damage;
 
-	SpawnDamage (pa_te_type, point, normal, save);
+	T_DamageEffect (ent, pa_te_type, point, normal, save);
 	ent->powerarmor_time = level.time + 0.2;
 
 	power_used = save / damagePerCell;
@@ -287,7 +600,7 @@ static int CheckArmor (edict_t *ent, vec3_t point, vec3_t normal, int damage, in
 		return 0;
 
 	client->pers.inventory[index] -= save;
-	SpawnDamage (te_sparks, point, normal, save);
+	T_DamageEffect (ent, te_sparks, point, normal, save);
 
 	return save;
 }
@@ -374,6 +687,38 @@ qboolean CheckTeamDamage (edict_t *targ, edict_t *attacker)
 	return false;
 }
 
+/*
+============
+T_DamageReact
+
+Runs the target's pain and react logic for damage that did not kill it.
+============
+*/
+static void T_DamageReact (edict_t *targ, edict_t *attacker, int knockback, int take)
+{
+	if (targ->svflags & SVF_MONSTER)
+	{
+		M_ReactToDamage (targ, attacker);
+		if (!(targ->monsterinfo.aiflags & AI_DUCKED) && (take))
+		{
+			targ->pain (targ, attacker, knockback, take);
+			// nightmare mode monsters don't go into pain frames often
+			if (skill->value == 3)
+				targ->pain_debounce_time = level.time + 5;
+		}
+	}
+	else if (targ->client)
+	{
+		if (!(targ->flags & FL_GODMODE) && (take))
+			targ->pain (targ, attacker, knockback, take);
+	}
+	else if (take)
+	{
+		if (targ->pain)
+			targ->pain (targ, attacker, knockback, take);
+	}
+}
+
 void T_Damage (edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir, vec3_t point, vec3_t normal, int damage, int knockback, int dflags, int mod)
 {
 	gclient_t	*client;
@@ -382,6 +727,7 @@ void T_Damage (edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir,
 	int			asave;
 	int			psave;
 	int			te_sparks;
+	damage_record_t	*rec;
 
 	if (!targ->takedamage)
 		return;
@@ -455,7 +801,7 @@ void T_Damage (edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir,
 	{
 		take = 0;
 		save = damage;
-		SpawnDamage (te_sparks, point, normal, save);
+		T_DamageEffect (targ, te_sparks, point, normal, save);
 	}
 
 	// check for invincibility
@@ -487,9 +833,9 @@ void T_Damage (edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir,
 	if (take)
 	{
 		if ((targ->svflags & SVF_MONSTER) || (client))
-			SpawnDamage (TE_BLOOD, point, normal, take);
+			T_DamageEffect (targ, TE_BLOOD, point, normal, take);
 		else
-			SpawnDamage (te_sparks, point, normal, take);
+			T_DamageEffect (targ, te_sparks, point, normal, take);
 
 
 		targ->health = targ->health - take;
@@ -503,27 +849,15 @@ void T_Damage (edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir,
 		}
 	}
 
-	if (targ->svflags & SVF_MONSTER)
-	{
-		M_ReactToDamage (targ, attacker);
-		if (!(targ->monsterinfo.aiflags & AI_DUCKED) && (take))
-		{
-			targ->pain (targ, attacker, knockback, take);
-			// nightmare mode monsters don't go into pain frames often
-			if (skill->value == 3)
-				targ->pain_debounce_time = level.time + 5;
-		}
-	}
-	else if (client)
+	rec = Damage_GetRecord (targ);
+	if (rec)
 	{
-		if (!(targ->flags & FL_GODMODE) && (take))
-			targ->pain (targ, attacker, knockback, take);
-	}
-	else if (take)
-	{
-		if (targ->pain)
-			targ->pain (targ, attacker, knockback, take);
+		Damage_AddAttacker (rec, attacker);
+		rec->take += take;
+		rec->knockback += knockback;
 	}
+	else
+		T_DamageReact (targ, attacker, knockback, take);
 
 	// add to the damage inflicted on a player this frame
 	// the total will be turned into screen blends and view angle kicks
@@ -539,6 +873,72 @@ void T_Damage (edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir,
 }
 
 
+/*
+============
+G_FlushDamage
+
+Sends the merged impact effects and runs each surviving target's pain
+and react logic once, with the frame's total damage and knockback.
+============
+*/
+void G_FlushDamage (void)
+{
+	damage_record_t	*rec;
+	damage_effect_t	*effect;
+	edict_t			*targ;
+	vec3_t			point;
+	int				i, j;
+
+	if (damage_flushing || !num_damage_records)
+		return;
+
+	// pain callbacks can damage other things (or the target again);
+	// that damage is applied straight away rather than re-queued
+	damage_flushing = true;
+
+	for (i=0 ; i<num_damage_records ; i++)
+	{
+		rec = &damage_records[i];
+
+		for (j=0 ; j<rec->num_effects ; j++)
+		{
+			effect = &rec->effects[j];
+			VectorScale (effect->point, 1.0 / effect->hits, point);
+			SpawnDamage (effect->type, point, effect->normal, 0);
+		}
+
+		targ = rec->targ;
+		if (!targ->inuse || !targ->takedamage || targ->health <= 0)
+			continue;	// killed (or freed) later in the frame
+		if (targ->pain != rec->pain)
+			continue;	// became something else
+		if (!rec->num_attackers)
+			continue;
+
+		if (targ->svflags & SVF_MONSTER)
+		{
+			for (j=0 ; j<rec->num_attackers-1 ; j++)
+				M_ReactToDamage (targ, rec->attackers[j]);
+		}
+		T_DamageReact (targ, rec->attackers[rec->num_attackers-1], rec->knockback, rec->take);
+	}
+
+	num_damage_records = 0;
+	damage_flushing = false;
+}
+
+/*
+============
+G_ResetDamage
+============
+*/
+void G_ResetDamage (void)
+{
+	num_damage_records = 0;
+	damage_flushing = false;
+}
+
+
 /*
 ============
 T_RadiusDamage
@@ -566,7 +966,7 @@ void T_RadiusDamage (edict_t *inflictor, edict_t *attacker, float damage, edict_
 			points = points * 0.5;
 		if (points > 0)
 		{
-			if (CanDamage (ent, inflictor))
+			if (CanRadiusDamage (ent, inflictor))
 			{
 				VectorSubtract (ent->s.origin, inflictor->s.origin, dir);
 				T_Damage (ent, inflictor, attacker, dir, inflictor->s.origin, vec3_origin, (int)points, (int)points, DAMAGE_RADIUS, mod);
@@ -574,3 +974,250 @@ void T_RadiusDamage (edict_t *inflictor, edict_t *attacker, float damage, edict_
 		}
 	}
 }
+
+
+/*
+==============================================================================
+
+DEFERRED EXPLOSIONS
+
+Explosives used to call T_RadiusDamage straight from their die callbacks,
+so a room full of barrels recursed once per barrel and swept the edict
+list again at every level of the chain.  Blasts are now queued and
+drained at fixed points (after the entity loop in G_RunFrame and at the
+end of ClientThink).  Blasts that land close together are swept with a
+single findradius pass, but every blast still applies exactly the damage
+that T_RadiusDamage would have.
+
+g_explosion_queue 0 restores the immediate behaviour.
+g_explosion_budget limits how many blasts are resolved per frame; the
+rest carry over to the next frame.
+
+==============================================================================
+*/
+
+#define MAX_QUEUED_BLASTS	128
+#define MAX_BLAST_CLUSTER	8
+#define BLAST_MERGE_DIST	64
+
+typedef struct
+{
+	vec3_t		origin;
+	char		*classname;
+	edict_t		*owner;			// inflictor's owner, so traces still skip it
+	edict_t		*attacker;
+	qboolean	self_attack;	// the inflictor was its own attacker
+	edict_t		*ignore;
+	float		damage;
+	float		radius;
+	int			mod;
+} queued_blast_t;
+
+static queued_blast_t	blast_queue[MAX_QUEUED_BLASTS];
+static int				blast_head;
+static int				blast_count;
+static qboolean			blast_draining;
+static int				blast_framenum;
+static int				blast_resolved;
+
+// the queued inflictor has usually been freed by the time its blast
+// resolves, so each cluster member gets a stand-in edict that carries
+// the fields T_Damage and the die callbacks look at
+static edict_t			blast_inflictors[MAX_BLAST_CLUSTER];
+
+/*
+=================
+G_ResetExplosions
+
+Drops any blasts left over from the previous level.
+=================
+*/
+void G_ResetExplosions (void)
+{
+	blast_head = 0;
+	blast_count = 0;
+	blast_draining = false;
+	blast_framenum = 0;
+	blast_resolved = 0;
+}
+
+/*
+=================
+T_QueueRadiusDamage
+
+Same arguments as T_RadiusDamage.  The blast origin is taken from the
+inflictor now, so the caller is free to release the inflictor afterwards.
+=================
+*/
+void T_QueueRadiusDamage (edict_t *inflictor, edict_t *attacker, float damage, edict_t *ignore, float radius, int mod)
+{
+	queued_blast_t	*blast;
+
+	if (!g_explosion_queue->value || blast_count == MAX_QUEUED_BLASTS)
+	{
+		T_RadiusDamage (inflictor, attacker, damage, ignore, radius, mod);
+		return;
+	}
+
+	blast = &blast_queue[(blast_head + blast_count) % MAX_QUEUED_BLASTS];
+	blast_count++;
+
+	VectorCopy (inflictor->s.origin, blast->origin);
+	blast->classname = inflictor->classname;
+	blast->owner = inflictor->owner;
+	blast->attacker = attacker;
+	blast->self_attack = (attacker == inflictor);
+	blast->ignore = ignore;
+	blast->damage = damage;
+	blast->radius = radius;
+	blast->mod = mod;
+}
+
+static edict_t *Blast_SetupInflictor (int slot, queued_blast_t *blast)
+{
+	edict_t	*inflictor;
+
+	inflictor = &blast_inflictors[slot];
+	memset (inflictor, 0, sizeof(*inflictor));
+	inflictor->inuse = true;
+	inflictor->solid = SOLID_NOT;
+	inflictor->classname = blast->classname ? blast->classname : "explosion";
+	inflictor->owner = blast->owner;
+	VectorCopy (blast->origin, inflictor->s.origin);
+	return inflictor;
+}
+
+/*
+=================
+Blast_ResolveCluster
+
+Sweeps once for every blast in the cluster and applies each blast's
+damage with the same falloff, self-damage and line of sight rules as
+T_RadiusDamage.
+=================
+*/
+static void Blast_ResolveCluster (queued_blast_t *cluster, int count)
+{
+	edict_t	*inflictors[MAX_BLAST_CLUSTER];
+	edict_t	*attackers[MAX_BLAST_CLUSTER];
+	edict_t	*ent;
+	vec3_t	v, dir;
+	float	sweep, reach, points;
+	int		i;
+
+	sweep = 0;
+	for (i=0 ; i<count ; i++)
+	{
+		inflictors[i] = Blast_SetupInflictor (i, &cluster[i]);
+		attackers[i] = cluster[i].attacker ? cluster[i].attacker : world;
+
+		// an explosive that was its own attacker is usually freed by now.
+		// The stand-in can't be the attacker, since Killed and the die
+		// functions keep the attacker in edict fields that get saved.
+		if (cluster[i].self_attack && !attackers[i]->inuse)
+		{
+			if (cluster[i].owner && cluster[i].owner->inuse)
+				attackers[i] = cluster[i].owner;
+			else
+				attackers[i] = world;
+		}
+
+		VectorSubtract (cluster[i].origin, cluster[0].origin, v);
+		reach = VectorLength (v) + cluster[i].radius;
+		if (reach > sweep)
+			sweep = reach;
+	}
+
+	ent = NULL;
+	while ((ent = findradius(ent, cluster[0].origin, sweep)) != NULL)
+	{
+		for (i=0 ; i<count ; i++)
+		{
+			if (ent == cluster[i].ignore)
+				continue;
+			if (!ent->inuse || !ent->takedamage)
+				continue;
+
+			VectorAdd (ent->mins, ent->maxs, v);
+			VectorMA (ent->s.origin, 0.5, v, v);
+			VectorSubtract (cluster[i].origin, v, v);
+			if (VectorLength (v) > cluster[i].radius)
+				continue;	// outside this member's findradius
+
+			points = cluster[i].damage - 0.5 * VectorLength (v);
+			if (ent == cluster[i].attacker)
+				points = points * 0.5;
+			if (points <= 0)
+				continue;
+			if (!CanRadiusDamage (ent, inflictors[i]))
+				continue;
+
+			VectorSubtract (ent->s.origin, cluster[i].origin, dir);
+			T_Damage (ent, inflictors[i], attackers[i], dir, inflictors[i]->s.origin, vec3_origin, (int)points, (int)points, DAMAGE_RADIUS, cluster[i].mod);
+		}
+	}
+}
+
+/*
+=================
+G_RunExplosions
+
+Resolves queued blasts in the order they were queued.  Blasts set off
+while draining (chain reactions) are appended and resolved in the same
+pass unless the per-frame budget runs out.
+=================
+*/
+void G_RunExplosions (void)
+{
+	queued_blast_t	cluster[MAX_BLAST_CLUSTER];
+	queued_blast_t	*blast;
+	vec3_t			v;
+	int				count, kept, i, budget;
+
+	if (blast_draining || !blast_count)
+		return;
+
+	if (blast_framenum != level.framenum)
+	{
+		blast_framenum = level.framenum;
+		blast_resolved = 0;
+	}
+
+	budget = (int)g_explosion_budget->value;
+	blast_draining = true;
+
+	while (blast_count)
+	{
+		if (budget > 0 && blast_resolved >= budget)
+			break;
+
+		cluster[0] = blast_queue[blast_head];
+		count = 1;
+		blast_head = (blast_head + 1) % MAX_QUEUED_BLASTS;
+		blast_count--;
+
+		// pull any other already queued blasts that overlap the lead one,
+		// keeping the rest of the queue in order
+		kept = 0;
+		for (i=0 ; i<blast_count ; i++)
+		{
+			blast = &blast_queue[(blast_head + i) % MAX_QUEUED_BLASTS];
+			VectorSubtract (blast->origin, cluster[0].origin, v);
+			if (count < MAX_BLAST_CLUSTER && VectorLength (v) <= BLAST_MERGE_DIST
+				&& !(budget > 0 && blast_resolved + count >= budget))
+			{
+				cluster[count++] = *blast;
+				continue;
+			}
+			if (kept != i)
+				blast_queue[(blast_head + kept) % MAX_QUEUED_BLASTS] = *blast;
+			kept++;
+		}
+		blast_count = kept;
+
+		blast_resolved += count;
+		Blast_ResolveCluster (cluster, count);
+	}
+
+	blast_draining = false;
+}
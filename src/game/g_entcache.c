@@ -0,0 +1,1012 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_entcache.c -- precompiled map entity strings
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+ENTITY CACHE
+
+SpawnEntities used to tokenize the map's entity string, look every key up
+in fields[] and every classname up in itemlist and spawns[] each time the
+map was loaded.  EntCache_Compile does all of that once and produces a
+flat image:
+
+	header
+	one entcacheent_t per entity: its values and its spawn function
+	one entcachevalue_t per key: the fields[] index and the decoded value
+	the string pool, every distinct string stored once, unescaped
+
+SpawnEntities then only copies values into the edicts.  Images are keyed
+by map name and the CRC and length of the entity string, so a map that
+was edited is compiled again.  Spawn and field indexes are only good for
+the build that wrote them; the header carries a hash of both tables.
+
+The last few images are kept in memory and each one is also written to
+<gamedir>/maps/<map>.entc, so the first load after a restart is warm too.
+A missing or stale file only means the map is compiled again.
+
+EntCache_Compile never calls the engine unless asked to report unknown
+keys, so it can run off the main thread.  During a deathmatch
+intermission the next map's image is compiled on a worker thread straight
+from its .bsp, and SpawnEntities picks it up when the map changes.
+
+g_entcache	0 parses the entity string every time, as before
+
+==============================================================================
+*/
+
+#define	ENTCACHE_IDENT		(('C'<<24)+('T'<<16)+('N'<<8)+'E')
+#define	ENTCACHE_VERSION	1
+#define	MAX_ENTCACHE		8
+
+#define	ENTC_EMPTY			1		// no keys at all, the edict is cleared
+#define	ENTC_NOCLASS		2		// no classname key, ED_CallSpawn decides
+
+typedef struct
+{
+	int			ident;
+	int			version;
+	unsigned	build;			// EntCache_BuildHash of the writer
+	unsigned	crc;			// of the entity string
+	int			length;
+	int			numents;
+	int			numvalues;
+	int			poolsize;
+} entcacheheader_t;
+
+typedef struct
+{
+	int			firstvalue;
+	short		numvalues;
+	short		flags;
+	int			spawn;			// ED_FindSpawn
+} entcacheent_t;
+
+typedef struct
+{
+	int			field;			// index into fields[]
+	union
+	{
+		vec3_t	vec;
+		int		i;
+		float	f;
+		int		str;			// offset into the pool
+	} u;
+} entcachevalue_t;
+
+struct entcache_s
+{
+	byte				*data;		// header, ents, values, pool
+	int					size;
+	entcacheheader_t	*header;
+	entcacheent_t		*ents;
+	entcachevalue_t		*values;
+	char				*pool;
+	char				mapname[MAX_QPATH];
+	int					lastused;
+};
+
+static entcache_t	*entcache[MAX_ENTCACHE];
+static int			entcache_clock;
+
+static qboolean EntCache_Bind (entcache_t *cache);
+
+/*
+=================
+EntCache_CRC
+
+CRC-32 of the entity string.
+=================
+*/
+static unsigned	crc_table[256];
+
+static void EntCache_InitCRC (void)
+{
+	unsigned	c;
+	int			i, j;
+
+	if (crc_table[1])
+		return;
+	for (i=0 ; i<256 ; i++)
+	{
+		c = i;
+		for (j=0 ; j<8 ; j++)
+			c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+		crc_table[i] = c;
+	}
+}
+
+static unsigned EntCache_CRC (char *data, int length)
+{
+	unsigned	crc;
+	int			i;
+
+	EntCache_InitCRC ();
+	crc = 0xffffffffu;
+	for (i=0 ; i<length ; i++)
+		crc = crc_table[(crc ^ (byte)data[i]) & 0xff] ^ (crc >> 8);
+	return crc ^ 0xffffffffu;
+}
+
+static unsigned EntCache_BuildHash (void)
+{
+	static unsigned	build;
+	field_t			*f;
+	char			*c;
+
+	if (build)
+		return build;
+
+	build = sizeof(edict_t) * 31 + sizeof(spawn_temp_t);
+	for (f=fields ; f->name ; f++)
+	{
+		for (c=f->name ; *c ; c++)
+			build = build * 31 + *c;
+		build = build * 31 + f->ofs;
+		build = build * 31 + f->type;
+		build = build * 31 + f->flags;
+	}
+	build = ED_SpawnTableHash (build);
+	if (!build)
+		build = 1;
+	return build;
+}
+
+/*
+==============================================================================
+
+COMPILING
+
+==============================================================================
+*/
+
+#define	ENTC_STRING_HASH	1024
+
+typedef struct
+{
+	entcacheent_t	*ents;
+	int				numents, maxents;
+	entcachevalue_t	*values;
+	int				numvalues, maxvalues;
+	char			*pool;
+	int				poolsize, maxpool;
+	int				*strings;		// pool offset of each distinct string
+	int				*next;			// hash chain
+	int				numstrings, maxstrings;
+	int				hash[ENTC_STRING_HASH];
+} entcompile_t;
+
+/*
+=================
+EntCache_Token
+
+COM_Parse with the token in a buffer of the caller's, so compiling
+doesn't share com_token with the main thread.
+=================
+*/
+static char *EntCache_Token (char **data_p, char *token)
+{
+	int		c, len;
+	char	*data;
+
+	data = *data_p;
+	len = 0;
+	token[0] = 0;
+
+	if (!data)
+		return token;
+
+skipwhite:
+	while ((c = *data) <= ' ')
+	{
+		if (c == 0)
+		{
+			*data_p = NULL;
+			return token;
+		}
+		data++;
+	}
+
+	if (c == '/' && data[1] == '/')
+	{
+		while (*data && *data != '\n')
+			data++;
+		goto skipwhite;
+	}
+
+	if (c == '\"')
+	{
+		data++;
+		while (1)
+		{
+			c = *data++;
+			if (c == '\"' || !c)
+			{
+				token[len] = 0;
+				*data_p = data;
+				return token;
+			}
+			if (len < MAX_TOKEN_CHARS)
+				token[len++] = c;
+		}
+	}
+
+	do
+	{
+		if (len < MAX_TOKEN_CHARS)
+			token[len++] = c;
+		data++;
+		c = *data;
+	} while (c > 32);
+
+	if (len == MAX_TOKEN_CHARS)
+		len = 0;
+	token[len] = 0;
+
+	*data_p = data;
+	return token;
+}
+
+static void *EntCache_Grow (void *p, int *max, int need, int size)
+{
+	if (need <= *max)
+		return p;
+	*max = *max ? *max * 2 : 256;
+	while (need > *max)
+		*max *= 2;
+	return realloc (p, *max * size);
+}
+
+/*
+=================
+EntCache_AddString
+
+Unescapes value the way ED_NewString does and returns its offset in the
+pool, sharing it with an earlier copy of the same string.
+=================
+*/
+static int EntCache_AddString (entcompile_t *c, char *value)
+{
+	char		text[MAX_TOKEN_CHARS+1], *out;
+	unsigned	hash;
+	int			i, l, s;
+
+	l = strlen (value) + 1;
+	out = text;
+	for (i=0 ; i<l ; i++)
+	{
+		if (value[i] == '\\' && i < l-1)
+		{
+			i++;
+			if (value[i] == 'n')
+				*out++ = '\n';
+			else
+				*out++ = '\\';
+		}
+		else
+			*out++ = value[i];
+	}
+
+	hash = 0;
+	for (out=text ; *out ; out++)
+		hash = hash * 31 + *out;
+	hash &= ENTC_STRING_HASH-1;
+
+	for (s=c->hash[hash] ; s != -1 ; s=c->next[s])
+		if (!strcmp (c->pool + c->strings[s], text))
+			return c->strings[s];
+
+	l = strlen (text) + 1;
+	c->pool = EntCache_Grow (c->pool, &c->maxpool, c->poolsize + l, 1);
+	c->strings = EntCache_Grow (c->strings, &c->maxstrings, c->numstrings + 1, sizeof(int));
+	c->next = realloc (c->next, c->maxstrings * sizeof(int));
+	memcpy (c->pool + c->poolsize, text, l);
+
+	s = c->numstrings++;
+	c->strings[s] = c->poolsize;
+	c->next[s] = c->hash[hash];
+	c->hash[hash] = s;
+	c->poolsize += l;
+	return c->strings[s];
+}
+
+static void EntCache_FreeCompile (entcompile_t *c)
+{
+	free (c->ents);
+	free (c->values);
+	free (c->pool);
+	free (c->strings);
+	free (c->next);
+}
+
+/*
+=================
+EntCache_ParseEdict
+
+ED_ParseEdict into a compiled entity.  Returns false where ED_ParseEdict
+would have called gi.error.
+=================
+*/
+static qboolean EntCache_ParseEdict (entcompile_t *c, char **data, qboolean report)
+{
+	entcacheent_t	*e;
+	entcachevalue_t	*v;
+	field_t			*f;
+	char			token[MAX_TOKEN_CHARS+1];
+	char			keyname[256];
+	int				classname;
+	float			angle;
+
+	c->ents = EntCache_Grow (c->ents, &c->maxents, c->numents + 1, sizeof(entcacheent_t));
+	e = &c->ents[c->numents++];
+	e->firstvalue = c->numvalues;
+	e->numvalues = 0;
+	e->flags = ENTC_EMPTY;
+	classname = -1;
+
+	while (1)
+	{
+		EntCache_Token (data, token);
+		if (token[0] == '}')
+			break;
+		if (!*data)
+			return false;
+
+		strncpy (keyname, token, sizeof(keyname)-1);
+		keyname[sizeof(keyname)-1] = 0;
+
+		EntCache_Token (data, token);
+		if (!*data || token[0] == '}')
+			return false;
+
+		e->flags &= ~ENTC_EMPTY;
+		if (keyname[0] == '_')
+			continue;
+
+		for (f=fields ; f->name ; f++)
+			if (!(f->flags & FFL_NOSPAWN) && !Q_stricmp (f->name, keyname))
+				break;
+		if (!f->name)
+		{
+			if (report)
+				gi.dprintf ("%s is not a field\n", keyname);
+			continue;
+		}
+
+		c->values = EntCache_Grow (c->values, &c->maxvalues, c->numvalues + 1, sizeof(entcachevalue_t));
+		v = &c->values[c->numvalues++];
+		memset (v, 0, sizeof(*v));
+		v->field = f - fields;
+		e->numvalues++;
+
+		switch (f->type)
+		{
+		case F_LSTRING:
+			v->u.str = EntCache_AddString (c, token);
+			if (!strcmp (f->name, "classname"))
+				classname = v->u.str;
+			break;
+		case F_VECTOR:
+			sscanf (token, "%f %f %f", &v->u.vec[0], &v->u.vec[1], &v->u.vec[2]);
+			break;
+		case F_INT:
+			v->u.i = atoi (token);
+			break;
+		case F_FLOAT:
+			v->u.f = atof (token);
+			break;
+		case F_ANGLEHACK:
+			angle = atof (token);
+			VectorSet (v->u.vec, 0, angle, 0);
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (classname == -1)
+	{
+		e->flags |= ENTC_NOCLASS;
+		e->spawn = SPAWN_NONE;
+	}
+	else
+		e->spawn = ED_FindSpawn (c->pool + classname);
+	return true;
+}
+
+/*
+=================
+EntCache_Compile
+
+Returns NULL if the string is malformed; SpawnEntities will then parse it
+the old way and fail with the usual error.
+=================
+*/
+entcache_t *EntCache_Compile (char *mapname, char *entities, qboolean report)
+{
+	entcompile_t	c;
+	entcache_t		*cache;
+	entcacheheader_t	header;
+	char			token[MAX_TOKEN_CHARS+1];
+	char			*data;
+	qboolean		ok;
+
+	memset (&c, 0, sizeof(c));
+	memset (c.hash, -1, sizeof(c.hash));
+
+	ok = true;
+	data = entities;
+	while (1)
+	{
+		EntCache_Token (&data, token);
+		if (!data)
+			break;
+		if (token[0] != '{' || !EntCache_ParseEdict (&c, &data, report))
+		{
+			ok = false;
+			break;
+		}
+	}
+
+	if (!ok)
+	{
+		EntCache_FreeCompile (&c);
+		return NULL;
+	}
+
+	memset (&header, 0, sizeof(header));
+	header.ident = ENTCACHE_IDENT;
+	header.version = ENTCACHE_VERSION;
+	header.length = strlen (entities);
+	header.crc = EntCache_CRC (entities, header.length);
+	header.numents = c.numents;
+	header.numvalues = c.numvalues;
+	header.poolsize = c.poolsize;
+
+	cache = malloc (sizeof(*cache));
+	memset (cache, 0, sizeof(*cache));
+	cache->size = sizeof(header) + c.numents * sizeof(entcacheent_t)
+		+ c.numvalues * sizeof(entcachevalue_t) + c.poolsize;
+	cache->data = malloc (cache->size);
+	memcpy (cache->data, &header, sizeof(header));
+	memcpy (cache->data + sizeof(header), c.ents, c.numents * sizeof(entcacheent_t));
+	memcpy (cache->data + sizeof(header) + c.numents * sizeof(entcacheent_t),
+		c.values, c.numvalues * sizeof(entcachevalue_t));
+	memcpy (cache->data + cache->size - c.poolsize, c.pool, c.poolsize);
+	strncpy (cache->mapname, mapname, sizeof(cache->mapname)-1);
+	EntCache_Bind (cache);
+
+	EntCache_FreeCompile (&c);
+	return cache;
+}
+
+/*
+==============================================================================
+
+CACHE
+
+==============================================================================
+*/
+
+static void EntCache_Free (entcache_t *cache)
+{
+	free (cache->data);
+	free (cache);
+}
+
+/*
+=================
+EntCache_Bind
+
+Points the arrays into data and checks that they fit, and that every
+field, string and spawn index in them is in range.  The build hash is
+checked by the caller; a freshly compiled image gets it from
+EntCache_Store.
+=================
+*/
+static int EntCache_NumFields (void)
+{
+	static int	numfields;
+	field_t		*f;
+
+	if (!numfields)
+		for (f=fields ; f->name ; f++)
+			numfields++;
+	return numfields;
+}
+
+static qboolean EntCache_Bind (entcache_t *cache)
+{
+	entcacheheader_t	*h;
+	entcacheent_t		*e;
+	entcachevalue_t		*v;
+	int					i, need, numfields;
+
+	if (cache->size < sizeof(entcacheheader_t))
+		return false;
+	h = cache->header = (entcacheheader_t *)cache->data;
+	if (h->ident != ENTCACHE_IDENT || h->version != ENTCACHE_VERSION)
+		return false;
+	if (h->numents < 0 || h->numvalues < 0 || h->poolsize < 0)
+		return false;
+
+	need = sizeof(*h) + h->numents * sizeof(entcacheent_t)
+		+ h->numvalues * sizeof(entcachevalue_t) + h->poolsize;
+	if (need != cache->size)
+		return false;
+
+	cache->ents = (entcacheent_t *)(cache->data + sizeof(*h));
+	cache->values = (entcachevalue_t *)(cache->ents + h->numents);
+	cache->pool = (char *)(cache->values + h->numvalues);
+
+	// a damaged file must not send us outside the arrays
+	for (i=0 ; i<h->numents ; i++)
+	{
+		e = &cache->ents[i];
+		if (e->firstvalue < 0 || e->numvalues < 0
+			|| e->firstvalue + e->numvalues > h->numvalues)
+			return false;
+		if (!ED_SpawnIndexValid (e->spawn))
+			return false;
+	}
+	if (h->poolsize && cache->pool[h->poolsize-1])
+		return false;
+
+	numfields = EntCache_NumFields ();
+	for (i=0, v=cache->values ; i<h->numvalues ; i++, v++)
+	{
+		if (v->field < 0 || v->field >= numfields)
+			return false;
+		if (fields[v->field].type == F_LSTRING && (v->u.str < 0 || v->u.str >= h->poolsize))
+			return false;
+	}
+	return true;
+}
+
+static void EntCache_FileName (char *mapname, char *name, int size)
+{
+	cvar_t	*gamedir;
+
+	gamedir = gi.cvar ("game", "", 0);
+	Com_sprintf (name, size, "%s/maps/%s.entc", *gamedir->string ? gamedir->string : GAMEVERSION, mapname);
+}
+
+static void EntCache_Write (entcache_t *cache)
+{
+	char	name[MAX_OSPATH];
+	FILE	*f;
+
+	EntCache_FileName (cache->mapname, name, sizeof(name));
+	f = fopen (name, "wb");
+	if (!f)
+		return;
+	if (fwrite (cache->data, cache->size, 1, f) != 1)
+	{
+		fclose (f);
+		remove (name);
+		return;
+	}
+	fclose (f);
+}
+
+static entcache_t *EntCache_Read (char *mapname)
+{
+	char		name[MAX_OSPATH];
+	entcache_t	*cache;
+	FILE		*f;
+	int			size;
+
+	EntCache_FileName (mapname, name, sizeof(name));
+	f = fopen (name, "rb");
+	if (!f)
+		return NULL;
+
+	fseek (f, 0, SEEK_END);
+	size = ftell (f);
+	fseek (f, 0, SEEK_SET);
+
+	cache = malloc (sizeof(*cache));
+	memset (cache, 0, sizeof(*cache));
+	cache->size = size;
+	cache->data = malloc (size > 0 ? size : 1);
+	if (size <= 0 || fread (cache->data, size, 1, f) != 1 || !EntCache_Bind (cache)
+		|| cache->header->build != EntCache_BuildHash ())
+	{
+		fclose (f);
+		EntCache_Free (cache);
+		return NULL;
+	}
+	fclose (f);
+
+	strncpy (cache->mapname, mapname, sizeof(cache->mapname)-1);
+	return cache;
+}
+
+/*
+=================
+EntCache_Store
+
+Keeps cache in memory in place of any older image of the same map, or
+the least recently used one.  Takes ownership of cache.
+=================
+*/
+void EntCache_Store (entcache_t *cache)
+{
+	int		i, slot;
+
+	cache->header->build = EntCache_BuildHash ();
+
+	slot = 0;
+	for (i=0 ; i<MAX_ENTCACHE ; i++)
+	{
+		if (!entcache[i])
+		{
+			slot = i;
+			break;
+		}
+		if (!Q_stricmp (entcache[i]->mapname, cache->mapname))
+		{
+			slot = i;
+			break;
+		}
+		if (entcache[i]->lastused < entcache[slot]->lastused)
+			slot = i;
+	}
+
+	if (entcache[slot])
+		EntCache_Free (entcache[slot]);
+	cache->lastused = ++entcache_clock;
+	entcache[slot] = cache;
+}
+
+static qboolean EntCache_Matches (entcache_t *cache, char *mapname, unsigned crc, int length)
+{
+	return !Q_stricmp (cache->mapname, mapname)
+		&& cache->header->crc == crc && cache->header->length == length;
+}
+
+/*
+==============================================================================
+
+NEXT MAP PREPARATION
+
+==============================================================================
+*/
+
+#define	BSP_HEADER_SIZE		(8 + 19*8)		// ident, version, 19 lumps
+
+static qboolean		prepare_running;
+static char			prepare_mapname[MAX_QPATH];
+static char			prepare_filename[MAX_OSPATH];
+static entcache_t	*prepare_result;
+
+#ifdef _WIN32
+static HANDLE		prepare_thread;
+#else
+static pthread_t	prepare_thread;
+#endif
+
+static int EntCache_LittleLong (byte *b)
+{
+	return b[0] | (b[1]<<8) | (b[2]<<16) | (b[3]<<24);
+}
+
+/*
+=================
+EntCache_ReadBSPEntities
+
+Reads the entity lump of a .bsp, or NULL.  Runs on the worker.
+=================
+*/
+static char *EntCache_ReadBSPEntities (char *filename)
+{
+	byte	header[BSP_HEADER_SIZE];
+	char	*entities;
+	FILE	*f;
+	int		ofs, len;
+
+	f = fopen (filename, "rb");
+	if (!f)
+		return NULL;
+
+	entities = NULL;
+	if (fread (header, sizeof(header), 1, f) == 1
+		&& !memcmp (header, "IBSP", 4) && EntCache_LittleLong (header+4) == 38)
+	{
+		ofs = EntCache_LittleLong (header+8);		// lump 0 is the entities
+		len = EntCache_LittleLong (header+12);
+		if (ofs >= 0 && len > 0 && !fseek (f, ofs, SEEK_SET))
+		{
+			entities = malloc (len + 1);
+			if (fread (entities, len, 1, f) != 1)
+			{
+				free (entities);
+				entities = NULL;
+			}
+			else
+				entities[len] = 0;
+		}
+	}
+
+	fclose (f);
+	return entities;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI EntCache_PrepareThread (LPVOID arg)
+#else
+static void *EntCache_PrepareThread (void *arg)
+#endif
+{
+	char	*entities;
+
+	entities = EntCache_ReadBSPEntities (prepare_filename);
+	if (entities)
+	{
+		prepare_result = EntCache_Compile (prepare_mapname, entities, false);
+		free (entities);
+	}
+	return 0;
+}
+
+/*
+=================
+EntCache_Prepare
+
+Starts compiling the entities of the map named by a changelevel target
+("*unit$spawn" and the like) in the background.  Cinematics and maps
+that are already cached are left alone.
+=================
+*/
+void EntCache_Prepare (char *changemap)
+{
+	char	mapname[MAX_QPATH], *c;
+	cvar_t	*gamedir;
+	int		i;
+
+	if (!g_entcache->value || !changemap)
+		return;
+
+	EntCache_FinishPrepare ();
+
+	if (*changemap == '*')
+		changemap++;
+	strncpy (mapname, changemap, sizeof(mapname)-1);
+	mapname[sizeof(mapname)-1] = 0;
+	c = strchr (mapname, '$');
+	if (c)
+		*c = 0;
+	if (!mapname[0] || strchr (mapname, '.'))
+		return;
+
+	for (i=0 ; i<MAX_ENTCACHE ; i++)
+		if (entcache[i] && !Q_stricmp (entcache[i]->mapname, mapname))
+			return;
+
+	// everything the worker needs is set up here, it never calls the engine
+	EntCache_InitCRC ();
+	gamedir = gi.cvar ("game", "", 0);
+	Com_sprintf (prepare_filename, sizeof(prepare_filename), "%s/maps/%s.bsp",
+		*gamedir->string ? gamedir->string : GAMEVERSION, mapname);
+	strcpy (prepare_mapname, mapname);
+	prepare_result = NULL;
+
+#ifdef _WIN32
+	prepare_thread = CreateThread (NULL, 0, EntCache_PrepareThread, NULL, 0, NULL);
+	if (!prepare_thread)
+		return;
+#else
+	if (pthread_create (&prepare_thread, NULL, EntCache_PrepareThread, NULL))
+		return;
+#endif
+	prepare_running = true;
+}
+
+/*
+=================
+EntCache_FinishPrepare
+
+Waits for the worker, if there is one, and caches what it compiled.
+SpawnEntities still checks the image against the entity string it was
+given, so one compiled from a .bsp the server didn't load is just unused.
+=================
+*/
+void EntCache_FinishPrepare (void)
+{
+	if (!prepare_running)
+		return;
+
+#ifdef _WIN32
+	WaitForSingleObject (prepare_thread, INFINITE);
+	CloseHandle (prepare_thread);
+#else
+	pthread_join (prepare_thread, NULL);
+#endif
+	prepare_running = false;
+
+	if (prepare_result)
+	{
+		EntCache_Store (prepare_result);
+		EntCache_Write (prepare_result);
+		prepare_result = NULL;
+	}
+}
+
+/*
+=================
+EntCache_Get
+
+Returns the compiled image of entities, from memory, from disk or freshly
+compiled, or NULL if the cache is off or the string is malformed.
+=================
+*/
+entcache_t *EntCache_Get (char *mapname, char *entities)
+{
+	entcache_t	*cache;
+	unsigned	crc;
+	int			i, length;
+
+	if (!g_entcache->value)
+		return NULL;
+
+	EntCache_FinishPrepare ();
+
+	length = strlen (entities);
+	crc = EntCache_CRC (entities, length);
+
+	for (i=0 ; i<MAX_ENTCACHE ; i++)
+	{
+		cache = entcache[i];
+		if (cache && EntCache_Matches (cache, mapname, crc, length))
+		{
+			cache->lastused = ++entcache_clock;
+			return cache;
+		}
+	}
+
+	cache = EntCache_Read (mapname);
+	if (cache && !EntCache_Matches (cache, mapname, crc, length))
+	{
+		EntCache_Free (cache);
+		cache = NULL;
+	}
+
+	if (!cache)
+	{
+		cache = EntCache_Compile (mapname, entities, true);
+		if (!cache)
+			return NULL;
+		EntCache_Store (cache);
+		EntCache_Write (cache);
+		return cache;
+	}
+
+	EntCache_Store (cache);
+	return cache;
+}
+
+void EntCache_Clear (void)
+{
+	int		i;
+
+	EntCache_FinishPrepare ();
+	for (i=0 ; i<MAX_ENTCACHE ; i++)
+	{
+		if (entcache[i])
+			EntCache_Free (entcache[i]);
+		entcache[i] = NULL;
+	}
+}
+
+/*
+==============================================================================
+
+SPAWNING
+
+==============================================================================
+*/
+
+int EntCache_NumEdicts (entcache_t *cache)
+{
+	return cache->header->numents;
+}
+
+/*
+=================
+EntCache_SpawnEdict
+
+ED_ParseEdict for entity num of a compiled image.
+=================
+*/
+void EntCache_SpawnEdict (entcache_t *cache, int num, edict_t *ent)
+{
+	entcacheent_t	*e;
+	entcachevalue_t	*v;
+	field_t			*f;
+	byte			*b;
+	int				i;
+
+	memset (&st, 0, sizeof(st));
+
+	e = &cache->ents[num];
+	if (e->flags & ENTC_EMPTY)
+	{
+		memset (ent, 0, sizeof(*ent));
+		G_SyncHotEdict (ent);
+		return;
+	}
+
+	for (i=0, v=cache->values+e->firstvalue ; i<e->numvalues ; i++, v++)
+	{
+		f = &fields[v->field];
+		if (f->flags & FFL_SPAWNTEMP)
+			b = (byte *)&st;
+		else if (G_FieldExt (f) >= 0)
+			b = G_EdictExt (ent, G_FieldExt (f));
+		else
+			b = (byte *)ent;
+
+		switch (f->type)
+		{
+		case F_LSTRING:
+			*(char **)(b+f->ofs) = G_CopyString (cache->pool + v->u.str);
+			break;
+		case F_VECTOR:
+		case F_ANGLEHACK:
+			VectorCopy (v->u.vec, ((float *)(b+f->ofs)));
+			break;
+		case F_INT:
+			*(int *)(b+f->ofs) = v->u.i;
+			break;
+		case F_FLOAT:
+			*(float *)(b+f->ofs) = v->u.f;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/*
+=================
+EntCache_CallSpawn
+
+ED_CallSpawn without the classname lookups.
+=================
+*/
+void EntCache_CallSpawn (entcache_t *cache, int num, edict_t *ent)
+{
+	entcacheent_t	*e;
+
+	e = &cache->ents[num];
+	if (e->flags & (ENTC_EMPTY|ENTC_NOCLASS))
+		ED_CallSpawn (ent);
+	else
+		ED_CallSpawnIndex (ent, e->spawn);
+}
@@ -0,0 +1,198 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_ext.c -- per-subsystem edict extension tables
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+EDICT EXTENSIONS
+
+The actor path, mission marker, spider and cyborg state used to be
+embedded in every edict.  It now lives in one side table per subsystem,
+indexed by edict number.  An entry is allocated the first time an entity
+touches that subsystem's state (G_ActorExt (self)->path_state, ...), so a
+light or path_corner carries none of it.
+
+Entries come from TAG_LEVEL.  G_FreeEdict puts an entity's entries on a
+free list for the next entity that needs one, and the tables are emptied
+whenever TAG_LEVEL is freed.
+
+"sv edictmem" reports what the tables hold against what embedding the
+same state in every edict would cost.
+
+==============================================================================
+*/
+
+typedef struct
+{
+	char	*name;
+	int		size;
+	int		fieldflag;		// FFL_* that marks its fields in field tables
+} edictexttype_t;
+
+static edictexttype_t	ext_types[NUM_EDICT_EXTS] =
+{
+	{"actor", sizeof(actor_ext_t), FFL_ACTOREXT},
+	{"mission", sizeof(mission_ext_t), FFL_MISSIONEXT},
+	{"spider", sizeof(spider_ext_t), FFL_SPIDEREXT},
+	{"cyborg", sizeof(cyborg_ext_t), FFL_CYBORGEXT}
+};
+
+static void	*ext_table[NUM_EDICT_EXTS][MAX_EDICTS];
+static void	*ext_free[NUM_EDICT_EXTS][MAX_EDICTS];
+static int	ext_numfree[NUM_EDICT_EXTS];
+static int	ext_allocated[NUM_EDICT_EXTS];
+
+/*
+=================
+G_EdictExt
+
+Returns ent's entry in an extension table, allocating a cleared one if
+it doesn't have one yet.
+=================
+*/
+void *G_EdictExt (edict_t *ent, edict_ext_t ext)
+{
+	int		entnum;
+	void	*p;
+
+	entnum = ent - g_edicts;
+	if (entnum < 0 || entnum >= MAX_EDICTS)
+		gi.error ("G_EdictExt: bad edict");
+
+	p = ext_table[ext][entnum];
+	if (p)
+		return p;
+
+	if (ext_numfree[ext])
+		p = ext_free[ext][--ext_numfree[ext]];
+	else
+	{
+		p = G_TagMalloc (ext_types[ext].size, TAG_LEVEL, ext_types[ext].name);
+		ext_allocated[ext]++;
+	}
+	memset (p, 0, ext_types[ext].size);
+	ext_table[ext][entnum] = p;
+	return p;
+}
+
+/*
+=================
+G_FindEdictExt
+
+Like G_EdictExt, but NULL if ent has no entry.
+=================
+*/
+void *G_FindEdictExt (edict_t *ent, edict_ext_t ext)
+{
+	return ext_table[ext][ent - g_edicts];
+}
+
+int G_EdictExtSize (edict_ext_t ext)
+{
+	return ext_types[ext].size;
+}
+
+/*
+=================
+G_FreeEdictExt
+=================
+*/
+void G_FreeEdictExt (edict_t *ent)
+{
+	int		ext, entnum;
+
+	entnum = ent - g_edicts;
+	for (ext=0 ; ext<NUM_EDICT_EXTS ; ext++)
+	{
+		if (!ext_table[ext][entnum])
+			continue;
+		ext_free[ext][ext_numfree[ext]++] = ext_table[ext][entnum];
+		ext_table[ext][entnum] = NULL;
+	}
+}
+
+/*
+=================
+G_ResetEdictExt
+
+Called after TAG_LEVEL has been freed.
+=================
+*/
+void G_ResetEdictExt (void)
+{
+	memset (ext_table, 0, sizeof(ext_table));
+	memset (ext_numfree, 0, sizeof(ext_numfree));
+	memset (ext_allocated, 0, sizeof(ext_allocated));
+}
+
+/*
+=================
+G_FieldExt
+
+The extension table a spawn or save field belongs to, or -1 for a field
+of the edict itself.
+=================
+*/
+int G_FieldExt (field_t *field)
+{
+	int		ext;
+
+	for (ext=0 ; ext<NUM_EDICT_EXTS ; ext++)
+		if (field->flags & ext_types[ext].fieldflag)
+			return ext;
+	return -1;
+}
+
+/*
+=================
+Svcmd_EdictMem_f
+
+sv edictmem
+=================
+*/
+void Svcmd_EdictMem_f (void)
+{
+	int		ext, i, inuse, embedded, total;
+
+	gi.cprintf (NULL, PRINT_HIGH, "edict_t is %i bytes, %i edicts\n", (int)sizeof(edict_t), game.maxentities);
+
+	// the tables themselves are fixed
+	embedded = 0;
+	total = sizeof(ext_table) + sizeof(ext_free);
+	for (ext=0 ; ext<NUM_EDICT_EXTS ; ext++)
+	{
+		inuse = 0;
+		for (i=0 ; i<game.maxentities ; i++)
+			if (ext_table[ext][i])
+				inuse++;
+
+		gi.cprintf (NULL, PRINT_HIGH, "%-8s %3i bytes: %4i in use, %4i allocated, %7i bytes\n",
+			ext_types[ext].name, ext_types[ext].size, inuse, ext_allocated[ext],
+			ext_allocated[ext] * ext_types[ext].size);
+		embedded += game.maxentities * ext_types[ext].size;
+		total += ext_allocated[ext] * ext_types[ext].size;
+	}
+
+	gi.cprintf (NULL, PRINT_HIGH, "%i bytes in side tables, %i if embedded in every edict: %i reclaimed\n",
+		total, embedded, embedded - total);
+}
@@ -0,0 +1,308 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_hot.c -- packed copy of the edict fields every scan reads
+
+#include "g_local.h"
+#include <time.h>
+
+/*
+==============================================================================
+
+HOT EDICT ARRAY
+
+An edict is well over a kilobyte, and the loops that walk every edict to
+find the ones in use (G_RunFrame, SV_Push, G_Spawn) touch a cache line of
+each one, free or not.  g_hot keeps inuse, linkcount and solid for each
+edict in 8 bytes, so those loops read g_hot and only go to the edicts
+that are in use.
+
+The edict stays authoritative.  An entry is copied from its edict:
+
+	when the edict is linked or unlinked (gi.linkentity is wrapped)
+	when gi.setmodel gives it an inline brush model, which the engine
+		links on the spot without going through gi.linkentity (wrapped too)
+	when it is initialized or freed
+	when a level is spawned, loaded or restored from a snapshot
+
+inuse and linkcount match the edict as long as inuse is only changed by
+G_InitEdict / G_FreeEdict or followed by a link.  solid is the one the
+edict was last linked with, which is what G_NoteBrushMove wants; origin,
+movetype and the current solid can all change without a link, so
+findradius and the other scans read those from the edict once inuse has
+let it through.
+
+"sv hotbench" times the in-use scan over the current level both ways.
+
+==============================================================================
+*/
+
+edict_hot_t	*g_hot;
+int			g_brushmoves;
+
+#define	BRUSH_MOVES		64		// must be a power of two
+
+// the boxes brush models were linked into or taken out of, the last
+// BRUSH_MOVES of them
+typedef struct
+{
+	vec3_t	absmin, absmax;
+} brushmove_t;
+
+static brushmove_t	brush_moves[BRUSH_MOVES];
+
+static void	(*real_linkentity) (edict_t *ent);
+static void	(*real_unlinkentity) (edict_t *ent);
+static void	(*real_setmodel) (edict_t *ent, char *name);
+
+/*
+=================
+G_SyncHotEdict
+=================
+*/
+void G_SyncHotEdict (edict_t *ent)
+{
+	edict_hot_t	*hot;
+	int			entnum;
+
+	entnum = ent - g_edicts;
+	if (!g_hot || entnum < 0 || entnum >= game.maxentities)
+		return;		// not one of ours, like the blast inflictors
+
+	hot = &g_hot[entnum];
+	hot->linkcount = ent->linkcount;
+	hot->inuse = ent->inuse;
+	hot->solid = ent->solid;
+}
+
+/*
+=================
+G_ResyncHotEdicts
+
+Called whenever the edicts are overwritten wholesale.
+=================
+*/
+void G_ResyncHotEdicts (void)
+{
+	int		i;
+
+	memset (g_hot, 0, game.maxentities * sizeof(g_hot[0]));
+	for (i=0 ; i<globals.num_edicts ; i++)
+		G_SyncHotEdict (&g_edicts[i]);
+
+	// everything may have changed, so no earlier lookup holds
+	g_brushmoves += BRUSH_MOVES + 1;
+}
+
+/*
+=================
+G_AllocHotEdicts
+
+Called right after g_edicts is allocated.  TagMalloc makes no promise
+past pointer alignment, so the array is lined up by hand.
+=================
+*/
+void G_AllocHotEdicts (void)
+{
+	byte	*p;
+
+	p = G_TagMalloc (game.maxentities * sizeof(g_hot[0]) + HOT_LINE - 1, TAG_GAME, "hot");
+	g_hot = (edict_hot_t *)(((size_t)p + HOT_LINE - 1) & ~(size_t)(HOT_LINE - 1));
+	memset (g_hot, 0, game.maxentities * sizeof(g_hot[0]));
+}
+
+/*
+=================
+G_NoteBrushMove
+
+The world's contents only change where a brush model is linked or
+unlinked.  Called with the box it leaves before the link and the box it
+takes after it.  The hot entry hasn't been synced yet at the first call,
+so it still has the solid the entity was last linked with.  Returns the
+box recorded, or NULL.
+=================
+*/
+static brushmove_t *G_NoteBrushMove (edict_t *ent)
+{
+	brushmove_t	*m;
+	int			entnum;
+
+	if (!ent->area.prev)
+		return NULL;		// not in the world, so it has no box
+
+	entnum = ent - g_edicts;
+	if (ent->solid != SOLID_BSP
+		&& (!g_hot || entnum < 0 || entnum >= game.maxentities || g_hot[entnum].solid != SOLID_BSP))
+		return NULL;
+
+	m = &brush_moves[g_brushmoves & (BRUSH_MOVES-1)];
+	VectorCopy (ent->absmin, m->absmin);
+	VectorCopy (ent->absmax, m->absmax);
+	g_brushmoves++;
+	return m;
+}
+
+/*
+=================
+G_BrushMovedSince
+
+True if a brush model has been linked or unlinked over point since
+g_brushmoves was at since.
+=================
+*/
+qboolean G_BrushMovedSince (int since, vec3_t point)
+{
+	brushmove_t	*m;
+	int			i;
+
+	if (g_brushmoves - since > BRUSH_MOVES)
+		return true;		// the ring has gone past it
+
+	for (i=since ; i<g_brushmoves ; i++)
+	{
+		m = &brush_moves[i & (BRUSH_MOVES-1)];
+		if (point[0] >= m->absmin[0] && point[0] <= m->absmax[0]
+			&& point[1] >= m->absmin[1] && point[1] <= m->absmax[1]
+			&& point[2] >= m->absmin[2] && point[2] <= m->absmax[2])
+			return true;
+	}
+	return false;
+}
+
+/*
+=================
+G_NoteBrushLink
+
+Called after ent has been linked, with what G_NoteBrushMove recorded
+before.
+=================
+*/
+static void G_NoteBrushLink (edict_t *ent, brushmove_t *before)
+{
+	// a brush that rotates or is relinked in place keeps its box
+	if (ent->solid == SOLID_BSP
+		&& (!before || !VectorCompare (before->absmin, ent->absmin) || !VectorCompare (before->absmax, ent->absmax)))
+		G_NoteBrushMove (ent);
+}
+
+static void G_LinkEntity (edict_t *ent)
+{
+	brushmove_t	*m;
+
+	m = G_NoteBrushMove (ent);
+	real_linkentity (ent);
+	G_NoteBrushLink (ent, m);
+	G_SyncHotEdict (ent);
+}
+
+static void G_UnlinkEntity (edict_t *ent)
+{
+	G_NoteBrushMove (ent);
+	real_unlinkentity (ent);
+	G_SyncHotEdict (ent);
+}
+
+static void G_SetModel (edict_t *ent, char *name)
+{
+	brushmove_t	*m;
+
+	if (!name || name[0] != '*')
+	{
+		real_setmodel (ent, name);
+		return;
+	}
+
+	// the engine links inline models itself
+	m = G_NoteBrushMove (ent);
+	real_setmodel (ent, name);
+	G_NoteBrushLink (ent, m);
+	G_SyncHotEdict (ent);
+}
+
+/*
+=================
+G_HookLinkEntity
+
+Called from GetGameAPI, so every gi.linkentity in the game, and every
+link the engine makes for gi.setmodel, keeps its entry current.
+=================
+*/
+void G_HookLinkEntity (void)
+{
+	real_linkentity = gi.linkentity;
+	real_unlinkentity = gi.unlinkentity;
+	real_setmodel = gi.setmodel;
+	gi.linkentity = G_LinkEntity;
+	gi.unlinkentity = G_UnlinkEntity;
+	gi.setmodel = G_SetModel;
+}
+
+/*
+=================
+Svcmd_HotBench_f
+
+sv hotbench [passes]
+
+Times the loop G_RunFrame and G_Spawn make to find the edicts in use,
+reading inuse from the edicts and from g_hot.
+=================
+*/
+void Svcmd_HotBench_f (void)
+{
+	edict_t		*ent;
+	edict_hot_t	*hot;
+	clock_t		start;
+	double		cold_ms, hot_ms;
+	int			passes, pass, i, cold_found, hot_found;
+
+	passes = atoi (gi.argv(2));
+	if (passes <= 0)
+		passes = 1000;
+
+	cold_found = 0;
+	start = clock ();
+	for (pass=0 ; pass<passes ; pass++)
+	{
+		for (i=0, ent=g_edicts ; i<globals.num_edicts ; i++, ent++)
+		{
+			if (!ent->inuse)
+				continue;
+			cold_found++;
+		}
+	}
+	cold_ms = (clock () - start) * 1000.0 / CLOCKS_PER_SEC;
+
+	hot_found = 0;
+	start = clock ();
+	for (pass=0 ; pass<passes ; pass++)
+	{
+		for (i=0, hot=g_hot ; i<globals.num_edicts ; i++, hot++)
+		{
+			if (!hot->inuse)
+				continue;
+			hot_found++;
+		}
+	}
+	hot_ms = (clock () - start) * 1000.0 / CLOCKS_PER_SEC;
+
+	gi.cprintf (NULL, PRINT_HIGH, "%i edicts, %i passes: edicts %.2f ms, hot %.2f ms (%i/%i in use)\n",
+		globals.num_edicts, passes, cold_ms, hot_ms, cold_found / passes, hot_found / passes);
+	gi.cprintf (NULL, PRINT_HIGH, "bytes per edict scanned: %i vs %i\n",
+		(int)sizeof(edict_t), (int)sizeof(edict_hot_t));
+}
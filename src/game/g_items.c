@@ -81,49 +81,141 @@ gitem_t	*GetItemByIndex (int index)
 
 
 /*
-===============
-FindItemByClassname
+==============================================================================
 
-===============
+ITEM REGISTRY
+
+itemlist never changes, so InitItems hashes every classname and pickup
+name once.  FindItem and FindItemByClassname hash the name they are given
+and compare against the one item in that slot, instead of walking the list.
+Names are matched without regard to case, and the first item with a name
+wins, as they always have.
+
+The items the code itself refers to get an itemid_t.  G_Item (ITEM_CELLS)
+and G_ItemIndex (ITEM_CELLS) read the itemid_index table InitItems fills,
+so the per-frame code never looks a name up at all.  Every name in
+itemid_names has to exist; InitItems stops the game if one doesn't.
+
+==============================================================================
 */
-gitem_t	*FindItemByClassname (char *classname)
+
+#define	ITEM_HASH_SIZE	(MAX_ITEMS*2)		// a power of two
+
+static byte	item_classname_hash[ITEM_HASH_SIZE];	// itemlist index, 0 for none
+static byte	item_pickup_hash[ITEM_HASH_SIZE];
+
+int		itemid_index[NUM_ITEM_IDS];
+
+// pickup names, except for item_quad, which has always been found by classname
+static char	*itemid_names[NUM_ITEM_IDS] =
 {
-	int		i;
-	gitem_t	*it;
+	NULL,
+
+	"Body Armor",
+	"Combat Armor",
+	"Jacket Armor",
+	"Power Screen",
+	"Power Shield",
+
+	"Blaster",
+	"Shotgun",
+	"Super Shotgun",
+	"Machinegun",
+	"Chaingun",
+	"HyperBlaster",
+	"Railgun",
+	"BFG10K",
+	"Plasma Pistol",
+	"Plasma Rifle",
+	"Obliterator",
+	"Deatomizer",
+	"HellFury",
+	"Remote Detonator",
+	"DoD Launcher",
+	"RTDU",
+
+	"Shells",
+	"Bullets",
+	"Cells",
+	"Grenades",
+	"Rockets",
+	"Slugs",
+	"PistolPlasma",
+	"Rifle Plasma",
+	"Mines",
+	"Detonation Pack",
+	"DOD",
+
+	"item_quad",
+	"Airstrike Marker",
+	"Health"
+};
 
-	it = itemlist;
-	for (i=0 ; i<game.num_items ; i++, it++)
+static unsigned Item_HashName (char *name)
+{
+	unsigned	hash;
+	int			c;
+
+	hash = 2166136261u;
+	while (*name)
 	{
-		if (!it->classname)
-			continue;
-		if (!Q_stricmp(it->classname, classname))
-			return it;
+		c = *name++;
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		hash = (hash ^ c) * 16777619u;
 	}
+	return hash & (ITEM_HASH_SIZE-1);
+}
+
+#define	ITEM_NAME(it,ofs)	(*(char **)((byte *)(it) + (ofs)))
 
+static gitem_t *Item_HashFind (byte *table, int ofs, char *name)
+{
+	unsigned	slot;
+	gitem_t		*it;
+
+	for (slot = Item_HashName (name) ; table[slot] ; slot = (slot + 1) & (ITEM_HASH_SIZE-1))
+	{
+		it = &itemlist[table[slot]];
+		if (!Q_stricmp (ITEM_NAME(it, ofs), name))
+			return it;
+	}
 	return NULL;
 }
 
+static void Item_HashInsert (byte *table, int ofs, int index)
+{
+	unsigned	slot;
+	char		*name;
+
+	name = ITEM_NAME(&itemlist[index], ofs);
+	if (!name || Item_HashFind (table, ofs, name))
+		return;
+	for (slot = Item_HashName (name) ; table[slot] ; slot = (slot + 1) & (ITEM_HASH_SIZE-1))
+		;
+	table[slot] = index;
+}
+
 /*
 ===============
-FindItem
+FindItemByClassname
 
 ===============
 */
-gitem_t	*FindItem (char *pickup_name)
+gitem_t	*FindItemByClassname (char *classname)
 {
-	int		i;
-	gitem_t	*it;
+	return Item_HashFind (item_classname_hash, offsetof(gitem_t, classname), classname);
+}
 
-	it = itemlist;
-	for (i=0 ; i<game.num_items ; i++, it++)
-	{
-		if (!it->pickup_name)
-			continue;
-		if (!Q_stricmp(it->pickup_name, pickup_name))
-			return it;
-	}
+/*
+===============
+FindItem
 
-	return NULL;
+===============
+*/
+gitem_t	*FindItem (char *pickup_name)
+{
+	return Item_HashFind (item_pickup_hash, offsetof(gitem_t, pickup_name), pickup_name);
 }
 
 //======================================================================
@@ -141,7 +233,7 @@ void DoRespawn (edict_t *ent)
 		for (count = 0, ent = master; ent; ent = ent->chain, count++)
 			;
 
-		choice = rand() % count;
+		choice = G_Rand() % count;
 
 		for (count = 0, ent = master; count < choice; ent = ent->chain, count++)
 			;
@@ -254,7 +346,7 @@ qboolean Pickup_Bandolier (edict_t *ent, edict_t *other)
         if (other->client->pers.max_rifleplasma < 75)
                 other->client->pers.max_rifleplasma = 75;
 
-	item = FindItem("Bullets");
+	item = G_Item (ITEM_BULLETS);
 	if (item)
 	{
 		index = ITEM_INDEX(item);
@@ -263,7 +355,7 @@ qboolean Pickup_Bandolier (edict_t *ent, edict_t *other)
 			other->client->pers.inventory[index] = other->client->pers.max_bullets;
 	}
 
-        item = FindItem("Shells");
+        item = G_Item (ITEM_SHELLS);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -272,7 +364,7 @@ qboolean Pickup_Bandolier (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_shells;
         }
 
-        item = FindItem("PistolPlasma");
+        item = G_Item (ITEM_PISTOL_PLASMA);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -281,7 +373,7 @@ qboolean Pickup_Bandolier (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_pistolplasma;
         }
 
-        item = FindItem("Rifle Plasma");
+        item = G_Item (ITEM_RIFLE_PLASMA);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -290,7 +382,7 @@ qboolean Pickup_Bandolier (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_rifleplasma;
         }
 
-        item = FindItem("Mines");
+        item = G_Item (ITEM_MINES);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -299,7 +391,7 @@ qboolean Pickup_Bandolier (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_mines;
         }
 
-        item = FindItem("Detonation Pack");
+        item = G_Item (ITEM_DETPACK);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -308,7 +400,7 @@ qboolean Pickup_Bandolier (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_detpacks;
         }
 
-        item = FindItem("DOD");
+        item = G_Item (ITEM_DOD);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -351,7 +443,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
         if (other->client->pers.max_rifleplasma < 100)
                 other->client->pers.max_rifleplasma = 100;
 
-	item = FindItem("Bullets");
+	item = G_Item (ITEM_BULLETS);
 	if (item)
 	{
 		index = ITEM_INDEX(item);
@@ -360,7 +452,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
 			other->client->pers.inventory[index] = other->client->pers.max_bullets;
 	}
 
-	item = FindItem("Shells");
+	item = G_Item (ITEM_SHELLS);
 	if (item)
 	{
 		index = ITEM_INDEX(item);
@@ -369,7 +461,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
 			other->client->pers.inventory[index] = other->client->pers.max_shells;
 	}
 
-	item = FindItem("Cells");
+	item = G_Item (ITEM_CELLS);
 	if (item)
 	{
 		index = ITEM_INDEX(item);
@@ -378,7 +470,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
 			other->client->pers.inventory[index] = other->client->pers.max_cells;
 	}
 
-	item = FindItem("Grenades");
+	item = G_Item (ITEM_GRENADES);
 	if (item)
 	{
 		index = ITEM_INDEX(item);
@@ -387,7 +479,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
 			other->client->pers.inventory[index] = other->client->pers.max_grenades;
 	}
 
-	item = FindItem("Rockets");
+	item = G_Item (ITEM_ROCKETS);
 	if (item)
 	{
 		index = ITEM_INDEX(item);
@@ -396,7 +488,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
 			other->client->pers.inventory[index] = other->client->pers.max_rockets;
 	}
 
-        item = FindItem("Slugs");
+        item = G_Item (ITEM_SLUGS);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -405,7 +497,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_slugs;
         }
 
-        item = FindItem("PistolPlasma");
+        item = G_Item (ITEM_PISTOL_PLASMA);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -414,7 +506,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_pistolplasma;
         }
 
-        item = FindItem("Rifle Plasma");
+        item = G_Item (ITEM_RIFLE_PLASMA);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -423,7 +515,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_rifleplasma;
         }
 
-        item = FindItem("Mines");
+        item = G_Item (ITEM_MINES);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -432,7 +524,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_mines;
         }
 
-        item = FindItem("Detonation Pack");
+        item = G_Item (ITEM_DETPACK);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -441,7 +533,7 @@ qboolean Pickup_Pack (edict_t *ent, edict_t *other)
                         other->client->pers.inventory[index] = other->client->pers.max_detpacks;
         }
 
-        item = FindItem("DOD");
+        item = G_Item (ITEM_DOD);
         if (item)
         {
                 index = ITEM_INDEX(item);
@@ -633,7 +725,7 @@ qboolean Pickup_Ammo (edict_t *ent, edict_t *other)
 
 	if (weapon && !oldcount)
 	{
-		if (other->client->pers.weapon != ent->item && ( !deathmatch->value || other->client->pers.weapon == FindItem("blaster") ) )
+		if (other->client->pers.weapon != ent->item && ( !deathmatch->value || other->client->pers.weapon == G_Item (ITEM_BLASTER) ) )
 			other->client->newweapon = ent->item;
 	}
 
@@ -845,7 +937,7 @@ void Use_PowerArmor (edict_t *ent, gitem_t *item)
 	}
 	else
 	{
-		index = ITEM_INDEX(FindItem("cells"));
+		index = G_ItemIndex (ITEM_CELLS);
 		if (!ent->client->pers.inventory[index])
 		{
 			gi.cprintf (ent, PRINT_HIGH, "No cells for power armor.\n");
@@ -1136,10 +1228,7 @@ void PrecacheItem (gitem_t *it)
 		gi.soundindex (it->pickup_sound);
 	if (it->world_model)
 		gi.modelindex (it->world_model);
-	if (it->view_model)
-		gi.modelindex (it->view_model);
-	if (it->icon)
-		gi.imageindex (it->icon);
+	G_PrecacheItemAssets (it);
 
 	// parse everything for its ammo
 	if (it->ammo && it->ammo[0])
@@ -2559,7 +2648,7 @@ void SP_item_health (edict_t *self)
 
 	self->model = "models/items/healing/medium/tris.md2";
 	self->count = 10;
-	SpawnItem (self, FindItem ("Health"));
+	SpawnItem (self, G_Item (ITEM_HEALTH));
 	gi.soundindex ("items/n_health.wav");
 }
 
@@ -2575,7 +2664,7 @@ void SP_item_health_small (edict_t *self)
 
 	self->model = "models/items/healing/stimpack/tris.md2";
 	self->count = 2;
-	SpawnItem (self, FindItem ("Health"));
+	SpawnItem (self, G_Item (ITEM_HEALTH));
 	self->style = HEALTH_IGNORE_MAX;
 	gi.soundindex ("items/s_health.wav");
 }
@@ -2592,7 +2681,7 @@ void SP_item_health_large (edict_t *self)
 
 	self->model = "models/items/healing/large/tris.md2";
 	self->count = 25;
-	SpawnItem (self, FindItem ("Health"));
+	SpawnItem (self, G_Item (ITEM_HEALTH));
 	gi.soundindex ("items/l_health.wav");
 }
 
@@ -2608,7 +2697,7 @@ void SP_item_health_mega (edict_t *self)
 
 	self->model = "models/items/mega_h/tris.md2";
 	self->count = 100;
-	SpawnItem (self, FindItem ("Health"));
+	SpawnItem (self, G_Item (ITEM_HEALTH));
 	gi.soundindex ("items/m_health.wav");
 	self->style = HEALTH_IGNORE_MAX|HEALTH_TIMED;
 }
@@ -2616,7 +2705,31 @@ void SP_item_health_mega (edict_t *self)
 
 void InitItems (void)
 {
+	gitem_t	*it;
+	int		i;
+
 	game.num_items = sizeof(itemlist)/sizeof(itemlist[0]) - 1;
+	if (game.num_items > MAX_ITEMS)
+		gi.error ("InitItems: %i items, MAX_ITEMS is %i", game.num_items, MAX_ITEMS);
+
+	memset (item_classname_hash, 0, sizeof(item_classname_hash));
+	memset (item_pickup_hash, 0, sizeof(item_pickup_hash));
+	for (i=1 ; i<game.num_items ; i++)
+	{
+		Item_HashInsert (item_classname_hash, offsetof(gitem_t, classname), i);
+		Item_HashInsert (item_pickup_hash, offsetof(gitem_t, pickup_name), i);
+	}
+
+	for (i=ITEM_NONE+1 ; i<NUM_ITEM_IDS ; i++)
+	{
+		if (i == ITEM_QUAD)
+			it = FindItemByClassname (itemid_names[i]);
+		else
+			it = FindItem (itemid_names[i]);
+		if (!it)
+			gi.error ("InitItems: no item named %s", itemid_names[i]);
+		itemid_index[i] = ITEM_INDEX(it);
+	}
 }
 
 
@@ -2639,9 +2752,9 @@ void SetItemNames (void)
 		gi.configstring (CS_ITEMS+i, it->pickup_name);
 	}
 
-	jacket_armor_index = ITEM_INDEX(FindItem("Jacket Armor"));
-	combat_armor_index = ITEM_INDEX(FindItem("Combat Armor"));
-	body_armor_index   = ITEM_INDEX(FindItem("Body Armor"));
-	power_screen_index = ITEM_INDEX(FindItem("Power Screen"));
-	power_shield_index = ITEM_INDEX(FindItem("Power Shield"));
+	jacket_armor_index = G_ItemIndex (ITEM_JACKET_ARMOR);
+	combat_armor_index = G_ItemIndex (ITEM_COMBAT_ARMOR);
+	body_armor_index   = G_ItemIndex (ITEM_BODY_ARMOR);
+	power_screen_index = G_ItemIndex (ITEM_POWER_SCREEN);
+	power_shield_index = G_ItemIndex (ITEM_POWER_SHIELD);
 }
@@ -0,0 +1,222 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_levelcache.c -- in-memory images of hub levels
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+HUB LEVEL CACHE
+
+The hub maps (huba - hubd) and the barrack / harvester chains are left and
+re-entered many times.  Each exit writes the level with WriteLevel and
+each return reads it back with ReadLevel.
+
+WriteLevel keeps an image of those maps, usually a delta against the
+spawn baseline (g_save.c), and ReadLevel restores from that instead of
+the file when it has one.
+The file is still written, so a cache miss falls back to it.  At most
+g_hub_cache levels are kept; the least recently used one is dropped
+first.
+
+The cache is cleared whenever the save directory may no longer match it:
+on ReadGame (a savegame was copied in), when a new unit starts, and at
+shutdown.
+
+==============================================================================
+*/
+
+#define	MAX_LEVEL_CACHE		8
+
+typedef struct
+{
+	char	mapname[MAX_QPATH];
+	char	filename[MAX_OSPATH];
+	byte	*data;
+	int		size;
+	unsigned	hash;		// spawn baseline of a delta image, 0 if whole
+	int		lastused;
+} levelimage_t;
+
+static levelimage_t	level_cache[MAX_LEVEL_CACHE];
+static int			level_cache_clock;
+
+static char *hub_prefixes[] =
+{
+	"hub",
+	"barrack",
+	"harvester",
+	NULL
+};
+
+/*
+=================
+LevelCache_IsHub
+=================
+*/
+qboolean LevelCache_IsHub (char *mapname)
+{
+	char	**prefix;
+
+	for (prefix=hub_prefixes ; *prefix ; prefix++)
+	{
+		if (!Q_strncasecmp (mapname, *prefix, strlen (*prefix)))
+			return true;
+	}
+	return false;
+}
+
+static void LevelCache_Free (levelimage_t *image)
+{
+	if (image->data)
+		G_TagFree (image->data);
+	memset (image, 0, sizeof(*image));
+}
+
+static int LevelCache_Limit (void)
+{
+	int		limit;
+
+	limit = (int)g_hub_cache->value;
+	if (limit < 0)
+		return 0;
+	if (limit > MAX_LEVEL_CACHE)
+		return MAX_LEVEL_CACHE;
+	return limit;
+}
+
+/*
+=================
+LevelCache_Wants
+
+True if WriteLevel's image of mapname would be kept.
+=================
+*/
+qboolean LevelCache_Wants (char *mapname)
+{
+	return LevelCache_Limit () && LevelCache_IsHub (mapname);
+}
+
+/*
+=================
+LevelCache_Store
+
+Called by WriteLevel with the image of filename to keep.  A delta image
+carries the hash of the spawn baseline it was written against.
+=================
+*/
+void LevelCache_Store (char *mapname, char *filename, byte *data, int size, unsigned hash)
+{
+	levelimage_t	*image, *oldest;
+	int				i, limit;
+
+	if (!LevelCache_Wants (mapname))
+		return;
+	limit = LevelCache_Limit ();
+
+	// replace an older image of the same level, or take the least
+	// recently used slot once the limit is reached
+	image = NULL;
+	oldest = NULL;
+	for (i=0 ; i<MAX_LEVEL_CACHE ; i++)
+	{
+		if (!level_cache[i].data)
+			continue;
+		if (!strcmp (level_cache[i].filename, filename))
+		{
+			image = &level_cache[i];
+			break;
+		}
+		if (!oldest || level_cache[i].lastused < oldest->lastused)
+			oldest = &level_cache[i];
+	}
+
+	if (!image)
+	{
+		for (i=0 ; i<limit ; i++)
+		{
+			if (!level_cache[i].data)
+			{
+				image = &level_cache[i];
+				break;
+			}
+		}
+		if (!image)
+			image = oldest;
+	}
+
+	LevelCache_Free (image);
+	Com_sprintf (image->mapname, sizeof(image->mapname), "%s", mapname);
+	Com_sprintf (image->filename, sizeof(image->filename), "%s", filename);
+	image->data = G_TagMalloc (size, TAG_GAME, "levelcache");
+	memcpy (image->data, data, size);
+	image->size = size;
+	image->hash = hash;
+	image->lastused = ++level_cache_clock;
+}
+
+/*
+=================
+LevelCache_Open
+
+Opens the cached image of filename for reading, if there is one for the
+map SpawnEntities just loaded.  A delta image is only any use if the map
+was spawned the same way it was when the image was written; otherwise
+ReadLevel reads the file, which is always whole.
+=================
+*/
+qboolean LevelCache_Open (savestream_t *s, char *filename)
+{
+	levelimage_t	*image;
+	int				i;
+
+	if (!LevelCache_Limit ())
+		return false;
+
+	for (i=0, image=level_cache ; i<MAX_LEVEL_CACHE ; i++, image++)
+	{
+		if (!image->data || strcmp (image->filename, filename))
+			continue;
+		if (Q_stricmp (image->mapname, level.mapname))
+			return false;
+		if (image->hash && image->hash != G_SpawnBaselineHash (level.mapname))
+			return false;
+
+		image->lastused = ++level_cache_clock;
+		SaveStream_OpenMemory (s, filename, image->data, image->size);
+		return true;
+	}
+
+	return false;
+}
+
+/*
+=================
+LevelCache_Clear
+=================
+*/
+void LevelCache_Clear (void)
+{
+	int		i;
+
+	for (i=0 ; i<MAX_LEVEL_CACHE ; i++)
+		LevelCache_Free (&level_cache[i]);
+}
@@ -38,56 +38,186 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define OBLIVION_ENABLE_MONSTER_SENTINEL 1
 #endif
 
+// a separate copy of a global for each thread (g_workers.c)
+#ifdef _WIN32
+#define	THREADLOCAL	__declspec(thread)
+#else
+#define	THREADLOCAL	__thread
+#endif
+
 struct edict_s;
 
-typedef struct edict_oblivion_ext_s
+//
+// per-subsystem edict extensions, kept in side tables indexed by edict
+// number and only allocated for the entities that use them (g_ext.c)
+//
+typedef enum
+{
+	EXT_ACTOR,
+	EXT_MISSION,
+	EXT_SPIDER,
+	EXT_CYBORG,
+	NUM_EDICT_EXTS
+} edict_ext_t;
+
+// misc_actor / target_actor scripted paths
+typedef struct
 {
-struct edict_s *controller;              // active mission / path controller
-        struct edict_s *last_controller;         // controller that most recently fired us
-        struct edict_s *prev_path;               // last target_actor that we visited
-        struct edict_s *path_target;             // cached pointer for the pending path step
-        struct edict_s *script_target;           // auxiliary entity referenced by scripted actions
-        int                     controller_serial;      // cached controller serial used by save games
-        int                     path_toggle;            // persistent toggle state for scripted paths
-        float           controller_distance;    // most recent distance to the active controller
-        float           controller_resume;      // time when the controller may resume the sequence
-        float           path_wait_time;         // override for node wait behaviour (-1 = inherit)
-        float           path_time;              // next time to advance along the scripted path
-        float           path_speed;             // desired travel speed toward the controller
-        float           path_step_speed;        // instantaneous speed used for the current leg
-        float           path_remaining;         // distance remaining to the current controller
-        int                     path_state;             // internal state machine for scripted motion
-        vec3_t          path_dir;               // normalized direction toward the controller
-        vec3_t          path_velocity;          // velocity vector applied while marching the path
-        char            *custom_name;           // optional in-world display name for actor barks
-        float           custom_name_time;       // debounce timer for repeated chat broadcasts
-
-        int                     mission_timer_remaining;        // seconds remaining before mission timeout
-        int                     mission_timer_limit;             // configured mission time limit (seconds)
-        int                     mission_timer_cooldown;          // mission flag bitmask from spawn data
-        int                     mission_state;                   // next mission event to publish
-        vec3_t          mission_origin;                  // world-space mission marker
-        vec3_t          mission_angles;                  // mission marker orientation
-        vec3_t          mission_velocity;                // mission marker velocity for moving targets
+	struct edict_s *controller;              // active mission / path controller
+	struct edict_s *last_controller;         // controller that most recently fired us
+	struct edict_s *prev_path;               // last target_actor that we visited
+	struct edict_s *path_target;             // cached pointer for the pending path step
+	struct edict_s *script_target;           // auxiliary entity referenced by scripted actions
+	int                     controller_serial;      // cached controller serial used by save games
+	int                     path_toggle;            // persistent toggle state for scripted paths
+	float           controller_distance;    // most recent distance to the active controller
+	float           controller_resume;      // time when the controller may resume the sequence
+	float           path_wait_time;         // override for node wait behaviour (-1 = inherit)
+	float           path_time;              // next time to advance along the scripted path
+	float           path_speed;             // desired travel speed toward the controller
+	float           path_step_speed;        // instantaneous speed used for the current leg
+	float           path_remaining;         // distance remaining to the current controller
+	int                     path_state;             // internal state machine for scripted motion
+	vec3_t          path_dir;               // normalized direction toward the controller
+	vec3_t          path_velocity;          // velocity vector applied while marching the path
+	char            *custom_name;           // optional in-world display name for actor barks
+	float           custom_name_time;       // debounce timer for repeated chat broadcasts
+} actor_ext_t;
+
+// mission objective markers (target_help, actors)
+typedef struct
+{
+	int                     mission_timer_remaining;        // seconds remaining before mission timeout
+	int                     mission_timer_limit;             // configured mission time limit (seconds)
+	int                     mission_timer_cooldown;          // mission flag bitmask from spawn data
+	int                     mission_state;                   // next mission event to publish
+	vec3_t          mission_origin;                  // world-space mission marker
+	vec3_t          mission_angles;                  // mission marker orientation
+	vec3_t          mission_velocity;                // mission marker velocity for moving targets
 	float           mission_blend;                   // HUD blend strength for mission markers
 	float           mission_radius;                  // mission trigger radius in world units
 	char            *mission_id;                     // mission objective identifier
 	char            *mission_title;                  // mission log title override
 	char            *mission_text;                   // mission log body text
+} mission_ext_t;
 
-	float           cyborg_anchor_time;             // wounded stand-ground release timer
-	int             cyborg_anchor_stage;            // highest wounded anchor stage applied
-	qboolean        cyborg_landing_thud;            // pending heavy landing thud
-
+typedef struct
+{
 	qboolean        spider_alt_idle;                // alternate idle loop for boss variant
 	qboolean        spider_staggered;               // pain stagger flag
 	float           spider_stagger_time;            // timer gate for stagger recovery
 	int                     spider_combo_next;              // next combo chain seed
 	int                     spider_combo_last;              // most recent combo chain
 	int                     spider_combo_stage;             // current combo stage
+} spider_ext_t;
+
+typedef struct
+{
+	float           cyborg_anchor_time;             // wounded stand-ground release timer
+	int             cyborg_anchor_stage;            // highest wounded anchor stage applied
+	qboolean        cyborg_landing_thud;            // pending heavy landing thud
 	float           cyborg_pain_time;              // cooldown timer for cyborg pain reactions
 	int             cyborg_pain_slot;              // alternating pain sound selector
-} edict_oblivion_ext_t;
+} cyborg_ext_t;
+
+//
+// the edict fields the whole-level scans filter on, packed (g_hot.c)
+//
+#define	HOT_LINE	64		// the array starts on a cache line
+
+typedef struct
+{
+	int			linkcount;
+	byte		inuse;
+	byte		solid;			// as of the last link
+	byte		pad[2];
+} edict_hot_t;
+
+//
+// sounds, images and models the per-frame code uses by name (g_assets.c)
+//
+typedef enum
+{
+	ASSET_NONE,
+
+	// player
+	SND_PAIN25_1,
+	SND_PAIN25_2,
+	SND_PAIN50_1,
+	SND_PAIN50_2,
+	SND_PAIN75_1,
+	SND_PAIN75_2,
+	SND_PAIN100_1,
+	SND_PAIN100_2,
+	SND_GURP1,
+	SND_GURP2,
+	SND_DROWN,
+	SND_GASP1,
+	SND_GASP2,
+	SND_BURN1,
+	SND_BURN2,
+	SND_LAVA_IN,
+	SND_WATER_IN,
+	SND_WATER_OUT,
+	SND_WATER_UNDER,
+	SND_BREATH1,
+	SND_BREATH2,
+
+	// powerups
+	SND_QUAD_END,
+	SND_INVUL_END,
+	SND_AIR_OUT,
+	SND_QUAD_FIRE,
+	SND_POWER_OFF,
+	SND_HELP_BEEP,
+
+	// weapons
+	SND_NOAMMO,
+	SND_GRENADE_PIN,
+	SND_GRENADE_FUSE,
+	SND_GRENADE_TOSS,
+	SND_GRENADE_BOUNCE1,
+	SND_GRENADE_BOUNCE2,
+	SND_GRENADE_LAUNCHER_BOUNCE,
+	SND_HYPER_LOOP,
+	SND_HYPER_DOWN,
+	SND_HYPER_UP,
+	SND_CHAINGUN_UP,
+	SND_CHAINGUN_DOWN,
+	SND_CHAINGUN_LOOP,
+	SND_RAIL_HUM,
+	SND_BFG_HUM,
+	SND_BFG_FLY,
+	SND_BFG_EXPLODE,
+	SND_LASER_FLY,
+	SND_ROCKET_FLY,
+	SND_BLASTER,
+	SND_DOD,
+	SND_DOD_HUM,
+	SND_TELEPORT,
+
+	// hud
+	IMG_HELP,
+	IMG_POWERSHIELD,
+	IMG_QUAD,
+	IMG_INVULNERABILITY,
+	IMG_ENVIROSUIT,
+	IMG_REBREATHER,
+
+	// projectiles
+	MDL_LASER,
+	MDL_GRENADE,
+	MDL_GRENADE2,
+	MDL_ROCKET,
+	MDL_DOD,
+	MDL_DETPACK,
+	MDL_BFG_BALL,
+	MDL_BFG_EXPLODE,
+	MDL_RTDU,
+	MDL_RTDU_TRIPOD,
+
+	NUM_ASSETS
+} asset_t;
 
 typedef enum mission_event_e
 {
@@ -353,6 +483,59 @@ typedef struct gitem_s
 	char		*precaches;		// string of all models, sounds, and images this item will use
 } gitem_t;
 
+//
+// items the code refers to by name, resolved once by InitItems (g_items.c)
+//
+typedef enum
+{
+	ITEM_NONE,
+
+	// armor
+	ITEM_BODY_ARMOR,
+	ITEM_COMBAT_ARMOR,
+	ITEM_JACKET_ARMOR,
+	ITEM_POWER_SCREEN,
+	ITEM_POWER_SHIELD,
+
+	// weapons
+	ITEM_BLASTER,
+	ITEM_SHOTGUN,
+	ITEM_SUPER_SHOTGUN,
+	ITEM_MACHINEGUN,
+	ITEM_CHAINGUN,
+	ITEM_HYPERBLASTER,
+	ITEM_RAILGUN,
+	ITEM_BFG,
+	ITEM_PLASMA_PISTOL,
+	ITEM_PLASMA_RIFLE,
+	ITEM_OBLITERATOR,
+	ITEM_DEATOMIZER,
+	ITEM_HELLFURY,
+	ITEM_REMOTE_DETONATOR,
+	ITEM_DOD_LAUNCHER,
+	ITEM_RTDU,
+
+	// ammo
+	ITEM_SHELLS,
+	ITEM_BULLETS,
+	ITEM_CELLS,
+	ITEM_GRENADES,
+	ITEM_ROCKETS,
+	ITEM_SLUGS,
+	ITEM_PISTOL_PLASMA,
+	ITEM_RIFLE_PLASMA,
+	ITEM_MINES,
+	ITEM_DETPACK,
+	ITEM_DOD,
+
+	// misc
+	ITEM_QUAD,
+	ITEM_AIRSTRIKE_MARKER,
+	ITEM_HEALTH,
+
+	NUM_ITEM_IDS
+} itemid_t;
+
 
 
 typedef enum
@@ -521,6 +704,12 @@ typedef struct camera_state_s
 typedef struct camera_state_s camera_state_t;
 typedef struct rotate_train_state_s rotate_train_state_t;
 
+struct rotate_train_state_s
+{
+        vec3_t  final_angles;
+        qboolean        has_final;
+};
+
 typedef struct
 {
 	// fixed data
@@ -673,13 +862,25 @@ extern	int	meansOfDeath;
 
 
 extern	edict_t			*g_edicts;
+extern	edict_hot_t		*g_hot;
+extern	int				g_brushmoves;	// brush model links and unlinks
+
+#define	G_HOT(e)	(&g_hot[(e) - g_edicts])
 
 #define	FOFS(x) ((ptrdiff_t)offsetof(edict_t, x))
 #define	STOFS(x) ((ptrdiff_t)offsetof(spawn_temp_t, x))
 #define	LLOFS(x) ((ptrdiff_t)offsetof(level_locals_t, x))
 #define	CLOFS(x) ((ptrdiff_t)offsetof(gclient_t, x))
-
-#define random()	((rand () & 0x7fff) / ((float)0x7fff))
+#define	GAOFS(x) ((ptrdiff_t)offsetof(game_locals_t, x))
+#define	CAMOFS(x) ((ptrdiff_t)offsetof(camera_state_t, x))
+#define	ACTOFS(x) ((ptrdiff_t)offsetof(actor_ext_t, x))
+#define	MISOFS(x) ((ptrdiff_t)offsetof(mission_ext_t, x))
+#define	SPIOFS(x) ((ptrdiff_t)offsetof(spider_ext_t, x))
+#define	CYBOFS(x) ((ptrdiff_t)offsetof(cyborg_ext_t, x))
+
+// game code draws from G_Rand (g_utils.c) rather than the C library's
+// rand, which everything else in the process shares
+#define random()	((G_Rand () & 0x7fff) / ((float)0x7fff))
 #define crandom()	(2.0 * (random() - 0.5))
 
 extern	cvar_t	*maxentities;
@@ -719,6 +920,36 @@ extern	cvar_t	*flood_waitdelay;
 
 extern	cvar_t	*sv_maplist;
 
+extern	cvar_t	*g_explosion_queue;
+extern	cvar_t	*g_explosion_budget;
+extern	cvar_t	*g_radius_stats;
+extern	cvar_t	*g_damage_aggregate;
+
+extern	cvar_t	*g_te_batch;
+extern	cvar_t	*g_te_pvs_budget;
+extern	cvar_t	*g_te_client_budget;
+extern	cvar_t	*g_te_stats;
+
+extern	cvar_t	*g_laser_cache;
+
+extern	cvar_t	*g_async_save;
+extern	cvar_t	*g_hub_cache;
+extern	cvar_t	*g_delta_saves;
+extern	cvar_t	*g_rewind;
+extern	cvar_t	*g_coop_snapshots;
+extern	cvar_t	*g_entcache;
+
+extern	cvar_t	*g_client_threads;
+
+extern	cvar_t	*g_rate_layout;
+extern	cvar_t	*g_rate_gesture;
+extern	cvar_t	*g_rate_userinfo;
+extern	cvar_t	*g_rate_gameplay;
+extern	cvar_t	*g_rate_command;
+extern	cvar_t	*g_rate_connect;
+extern	cvar_t	*g_rate_connect_ip;
+extern	cvar_t	*g_rate_frame;
+
 #define world	(&g_edicts[0])
 
 // item spawnflags
@@ -736,6 +967,10 @@ extern	cvar_t	*sv_maplist;
 //
 #define FFL_SPAWNTEMP		1
 #define FFL_NOSPAWN			2
+#define FFL_ACTOREXT		4		// ofs is into the edict's actor_ext_t
+#define FFL_MISSIONEXT		8		// ... mission_ext_t
+#define FFL_SPIDEREXT		16		// ... spider_ext_t
+#define FFL_CYBORGEXT		32		// ... cyborg_ext_t
 
 typedef enum {
 	F_INT, 
@@ -749,7 +984,10 @@ typedef enum {
 	F_CLIENT,			// index on disk, pointer in memory
 	F_FUNCTION,
 	F_MMOVE,
-	F_IGNORE
+	F_IGNORE,
+	F_BYTES,			// size bytes of plain data, saves only
+	F_LBLOCK,			// pointer to size bytes of plain data, TAG_LEVEL
+	F_CAMERA			// pointer to a camera_state_t, TAG_LEVEL
 } fieldtype_t;
 
 typedef struct
@@ -758,10 +996,12 @@ typedef struct
 	ptrdiff_t	ofs;
 	fieldtype_t	type;
 	int		flags;
+	int		size;		// F_BYTES and F_LBLOCK only
 } field_t;
 
 
 extern	field_t fields[];
+extern	field_t savefields[];
 extern	gitem_t	itemlist[];
 
 
@@ -770,6 +1010,9 @@ extern	gitem_t	itemlist[];
 //
 void Cmd_Help_f (edict_t *ent);
 void Cmd_Score_f (edict_t *ent);
+void Cmd_QuickSave_f (edict_t *ent);
+void Cmd_QuickLoad_f (edict_t *ent);
+void Cmd_Rewind_f (edict_t *ent);
 
 //
 // g_items.c
@@ -780,6 +1023,9 @@ void SetItemNames (void);
 gitem_t	*FindItem (char *pickup_name);
 gitem_t	*FindItemByClassname (char *classname);
 #define	ITEM_INDEX(x) ((x)-itemlist)
+extern	int	itemid_index[NUM_ITEM_IDS];
+#define	G_Item(id)		(&itemlist[itemid_index[id]])
+#define	G_ItemIndex(id)	(itemid_index[id])
 edict_t *Drop_Item (edict_t *ent, gitem_t *item);
 void SetRespawn (edict_t *ent, float delay);
 void ChangeWeapon (edict_t *ent);
@@ -818,6 +1064,10 @@ void	G_TouchSolids (edict_t *ent);
 
 char	*G_CopyString (char *in);
 
+int		G_Rand (void);
+void	G_SeedRand (unsigned seed);
+unsigned G_RandState (void);
+
 float	*tv (float x, float y, float z);
 char	*vtos (vec3_t v);
 
@@ -838,7 +1088,7 @@ qboolean Mission_HasUnread (void);
 //
 // p_menu.c
 //
-void MissionMenu_BuildObjectiveLayout (char *buffer, size_t buffer_size);
+void MissionMenu_BuildObjectiveLayout (textbuf_t *buf);
 
 float vectoyaw (vec3_t vec);
 void vectoangles (vec3_t vec, vec3_t angles);
@@ -848,8 +1098,16 @@ void vectoangles (vec3_t vec, vec3_t angles);
 //
 qboolean OnSameTeam (edict_t *ent1, edict_t *ent2);
 qboolean CanDamage (edict_t *targ, edict_t *inflictor);
+qboolean CanRadiusDamage (edict_t *targ, edict_t *inflictor);
+void G_RadiusStatsFrame (void);
+void G_ResetRadiusCache (void);
 void T_Damage (edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir, vec3_t point, vec3_t normal, int damage, int knockback, int dflags, int mod);
+void G_FlushDamage (void);
+void G_ResetDamage (void);
 void T_RadiusDamage (edict_t *inflictor, edict_t *attacker, float damage, edict_t *ignore, float radius, int mod);
+void T_QueueRadiusDamage (edict_t *inflictor, edict_t *attacker, float damage, edict_t *ignore, float radius, int mod);
+void G_RunExplosions (void);
+void G_ResetExplosions (void);
 
 // damage flags
 #define DAMAGE_RADIUS			0x00000001	// damage was indirect
@@ -899,6 +1157,7 @@ void BecomeExplosion1(edict_t *self);
 
 void G_ScreenFade_Reset (void);
 void G_ScreenFade_AddBlend (edict_t *ent);
+void G_ScreenFade_ClientConnect (edict_t *ent);
 
 //
 // g_ai.c
@@ -946,6 +1205,198 @@ edict_t *fire_detpack (edict_t *self, vec3_t start, vec3_t aimdir, int damage, i
 void remote_detonator_trigger (edict_t *owner);
 edict_t *fire_proximity_mine (edict_t *self, vec3_t start, vec3_t aimdir, int damage, int speed, float damage_radius, int splash_damage);
 
+//
+// g_tent.c
+//
+void G_TempEntityPoint (int type, vec3_t pos, multicast_t to);
+void G_TempEntityDir (int type, vec3_t pos, vec3_t dir, multicast_t to);
+void G_TempEntitySplash (int type, int count, vec3_t pos, vec3_t dir, int color, multicast_t to);
+void G_FlushTempEntities (void);
+void G_ResetTempEntities (void);
+
+//
+// g_save.c
+//
+void G_CaptureSpawnBaseline (void);
+void G_FreeSpawnBaseline (void);
+unsigned G_SpawnBaselineHash (char *mapname);
+
+//
+// g_savestream.c
+//
+#define	SAVE_STREAM_BUFFER	16384
+
+typedef struct
+{
+	FILE		*f;
+	char		filename[MAX_OSPATH];
+	qboolean	reading;
+	byte		data[SAVE_STREAM_BUFFER];
+	int			cursize;
+	int			readcount;
+	int			total;			// bytes written or read so far
+
+	qboolean	snapshot;		// collecting into mem for the background writer
+	byte		*mem;			// snapshot being written, or image being read
+	int			memsize;
+	int			memmax;
+	int			memread;
+} savestream_t;
+
+void SaveStream_OpenWrite (savestream_t *s, char *filename);
+void SaveStream_OpenSnapshot (savestream_t *s, char *filename);
+void SaveStream_OpenRead (savestream_t *s, char *filename);
+void SaveStream_OpenMemory (savestream_t *s, char *filename, byte *data, int size);
+byte *SaveStream_SnapshotData (savestream_t *s, int *size);
+void SaveStream_Rewind (savestream_t *s);
+void SaveStream_Discard (savestream_t *s);
+void SaveStream_Close (savestream_t *s);
+void SaveStream_Write (savestream_t *s, const void *data, int length);
+void SaveStream_WriteByte (savestream_t *s, int c);
+void SaveStream_WriteShort (savestream_t *s, int c);
+void SaveStream_WriteInt (savestream_t *s, int c);
+void SaveStream_WriteString (savestream_t *s, char *str);
+void SaveStream_Read (savestream_t *s, void *data, int length);
+void SaveStream_Skip (savestream_t *s, int length);
+int SaveStream_ReadByte (savestream_t *s);
+int SaveStream_ReadShort (savestream_t *s);
+int SaveStream_ReadInt (savestream_t *s);
+char *SaveStream_ReadString (savestream_t *s, int tag);
+void SaveStream_ReadName (savestream_t *s, char *out, int size);
+void SaveStream_QueueWrite (char *filename, byte *data, int size);
+void SaveStream_Barrier (char *filename);
+void SaveStream_Shutdown (void);
+
+//
+// g_levelcache.c
+//
+qboolean LevelCache_IsHub (char *mapname);
+qboolean LevelCache_Wants (char *mapname);
+void LevelCache_Store (char *mapname, char *filename, byte *data, int size, unsigned hash);
+qboolean LevelCache_Open (savestream_t *s, char *filename);
+void LevelCache_Clear (void);
+
+//
+// g_ext.c
+//
+void *G_EdictExt (edict_t *ent, edict_ext_t ext);
+void *G_FindEdictExt (edict_t *ent, edict_ext_t ext);
+int G_EdictExtSize (edict_ext_t ext);
+void G_FreeEdictExt (edict_t *ent);
+void G_ResetEdictExt (void);
+int G_FieldExt (field_t *field);
+void Svcmd_EdictMem_f (void);
+
+#define	G_ActorExt(e)	((actor_ext_t *)G_EdictExt ((e), EXT_ACTOR))
+#define	G_MissionExt(e)	((mission_ext_t *)G_EdictExt ((e), EXT_MISSION))
+#define	G_SpiderExt(e)	((spider_ext_t *)G_EdictExt ((e), EXT_SPIDER))
+#define	G_CyborgExt(e)	((cyborg_ext_t *)G_EdictExt ((e), EXT_CYBORG))
+
+//
+// g_spawn.c
+//
+#define	SPAWN_NONE	-1
+
+int ED_FindSpawn (char *classname);
+qboolean ED_SpawnIndexValid (int spawn);
+void ED_CallSpawnIndex (edict_t *ent, int spawn);
+void ED_CallSpawn (edict_t *ent);
+unsigned ED_SpawnTableHash (unsigned hash);
+
+//
+// g_entcache.c
+//
+typedef struct entcache_s entcache_t;
+
+entcache_t *EntCache_Compile (char *mapname, char *entities, qboolean report);
+void EntCache_Store (entcache_t *cache);
+entcache_t *EntCache_Get (char *mapname, char *entities);
+void EntCache_Clear (void);
+void EntCache_Prepare (char *changemap);
+void EntCache_FinishPrepare (void);
+int EntCache_NumEdicts (entcache_t *cache);
+void EntCache_SpawnEdict (entcache_t *cache, int num, edict_t *ent);
+void EntCache_CallSpawn (entcache_t *cache, int num, edict_t *ent);
+
+//
+// g_mem.c
+//
+void *G_TagMalloc (int size, int tag, char *owner);
+void G_TagFree (void *block);
+void G_FreeTags (int tag);
+void G_MemEntity (edict_t *ent);
+void Svcmd_Mem_f (void);
+
+//
+// g_hot.c
+//
+void G_SyncHotEdict (edict_t *ent);
+void G_ResyncHotEdicts (void);
+void G_AllocHotEdicts (void);
+void G_HookLinkEntity (void);
+qboolean G_BrushMovedSince (int since, vec3_t point);
+void Svcmd_HotBench_f (void);
+
+//
+// g_workers.c
+//
+void G_HookWorkerCalls (void);
+qboolean G_ParallelClientFrames (void);
+void G_ShutdownWorkers (void);
+void Svcmd_ClientBench_f (void);
+
+//
+// g_ratelimit.c
+//
+typedef enum
+{
+	RL_CHAT,
+	RL_LAYOUT,
+	RL_GESTURE,
+	RL_USERINFO,
+	RL_GAMEPLAY,
+	RL_COMMAND,
+	NUM_RATE_CLASSES
+} rateclass_t;
+
+qboolean G_RateLimit (edict_t *ent, rateclass_t cls);
+qboolean G_RateLimitConnect (char *ip);
+void G_RateLimitClientConnect (edict_t *ent);
+void G_ClientUserinfoChanged (edict_t *ent, char *userinfo);
+void G_RunPendingUserinfo (edict_t *ent);
+void Svcmd_RateStats_f (void);
+
+//
+// g_assets.c
+//
+extern	int	asset_index[NUM_ASSETS];
+
+#define	G_Asset(a)	(asset_index[a] ? asset_index[a] : G_ResolveAsset (a))
+
+int G_ResolveAsset (asset_t asset);
+void G_PrecacheAssets (void);
+void G_ResetAssets (void);
+int G_ItemIcon (gitem_t *item);
+int G_ItemViewModel (gitem_t *item);
+void G_PrecacheItemAssets (gitem_t *item);
+
+//
+// g_snapshot.c
+//
+qboolean G_QuickSave (void);
+qboolean G_QuickLoad (void);
+float G_Rewind (float seconds);
+void G_SnapshotClientConnect (edict_t *ent, char *ip);
+qboolean G_SnapshotHost (edict_t *ent);
+void G_RunSnapshots (void);
+void G_ResetSnapshots (void);
+void G_FreeSnapshots (void);
+
+//
+// g_target.c
+//
+void G_ResetLaserCache (void);
+
 //
 // g_ptrail.c
 //
@@ -965,6 +1416,7 @@ void PutClientInServer (edict_t *ent);
 void InitClientPersistant (gclient_t *client);
 void InitClientResp (gclient_t *client);
 void InitBodyQue (void);
+void G_ResetSpawnSpots (void);
 void ClientBeginServerFrame (edict_t *ent);
 
 //
@@ -982,7 +1434,18 @@ qboolean SV_FilterPacket (char *from);
 //
 // p_view.c
 //
+
+// what changed since a client's stats (p_hud.c) or blend were last
+// worked out
+#define	VIEW_INVENTORY		1	// ammo, armor, power armor cells, selected item
+#define	VIEW_POWERUPS		2	// a powerup or weapon timer counting down
+#define	VIEW_DAMAGE			4	// a damage or bonus flash fading
+#define	VIEW_MOVEMENT		8	// the eye went into different contents
+
 void ClientEndServerFrame (edict_t *ent);
+qboolean ClientBeginViewFrame (edict_t *ent);
+void ClientCalcViewFrame (edict_t *ent);
+void ClientFinishViewFrame (edict_t *ent);
 void Camera_ClientPreFrame (edict_t *ent);
 void Camera_ClientPostFrame (edict_t *ent);
 
@@ -993,8 +1456,11 @@ void MoveClientToIntermission (edict_t *client);
 void G_SetStats (edict_t *ent);
 void G_SetSpectatorStats (edict_t *ent);
 void G_CheckChaseStats (edict_t *ent);
+void G_BuildChaseList (void);
 void ValidateSelectedItem (edict_t *ent);
 void DeathmatchScoreboardMessage (edict_t *client, edict_t *killer);
+void G_ResetScoreboard (void);
+void G_ResetClientStats (void);
 
 //
 // g_pweapon.c
@@ -1174,8 +1640,6 @@ struct gclient_s
 	float		pickup_msg_time;
 
 	float		flood_locktill;		// locked from talking
-	float		flood_when[10];		// when messages were said
-	int			flood_whenhead;		// head pointer for when said
 
 	float		respawn_time;		// can respawn when time > this
 
@@ -1349,7 +1813,6 @@ struct edict_s
 	gitem_t		*item;			// for bonus items
 
 	// common data blocks
-	edict_oblivion_ext_t	oblivion;
 	moveinfo_t		moveinfo;
 	monsterinfo_t	monsterinfo;
 };
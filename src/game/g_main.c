@@ -71,6 +71,36 @@ cvar_t	*flood_waitdelay;
 
 cvar_t	*sv_maplist;
 
+cvar_t	*g_explosion_queue;
+cvar_t	*g_explosion_budget;
+cvar_t	*g_radius_stats;
+cvar_t	*g_damage_aggregate;
+
+cvar_t	*g_te_batch;
+cvar_t	*g_te_pvs_budget;
+cvar_t	*g_te_client_budget;
+cvar_t	*g_te_stats;
+
+cvar_t	*g_laser_cache;
+
+cvar_t	*g_async_save;
+cvar_t	*g_hub_cache;
+cvar_t	*g_delta_saves;
+cvar_t	*g_rewind;
+cvar_t	*g_coop_snapshots;
+cvar_t	*g_entcache;
+
+cvar_t	*g_client_threads;
+
+cvar_t	*g_rate_layout;
+cvar_t	*g_rate_gesture;
+cvar_t	*g_rate_userinfo;
+cvar_t	*g_rate_gameplay;
+cvar_t	*g_rate_command;
+cvar_t	*g_rate_connect;
+cvar_t	*g_rate_connect_ip;
+cvar_t	*g_rate_frame;
+
 void SpawnEntities (char *mapname, char *entities, char *spawnpoint);
 void ClientThink (edict_t *ent, usercmd_t *cmd);
 qboolean ClientConnect (edict_t *ent, char *userinfo);
@@ -102,8 +132,15 @@ void ShutdownGame (void)
 {
 	gi.dprintf ("==== ShutdownGame ====\n");
 
-	gi.FreeTags (TAG_LEVEL);
-	gi.FreeTags (TAG_GAME);
+	SaveStream_Shutdown ();
+	G_ShutdownWorkers ();
+	LevelCache_Clear ();
+	G_FreeSpawnBaseline ();
+	G_FreeSnapshots ();
+	EntCache_Clear ();
+
+	G_FreeTags (TAG_LEVEL);
+	G_FreeTags (TAG_GAME);
 }
 
 
@@ -118,6 +155,8 @@ and global variables
 game_export_t *GetGameAPI (game_import_t *import)
 {
 	gi = *import;
+	G_HookLinkEntity ();
+	G_HookWorkerCalls ();
 
 	globals.apiversion = GAME_API_VERSION;
 	globals.Init = InitGame;
@@ -131,7 +170,7 @@ game_export_t *GetGameAPI (game_import_t *import)
 
 	globals.ClientThink = ClientThink;
 	globals.ClientConnect = ClientConnect;
-	globals.ClientUserinfoChanged = ClientUserinfoChanged;
+	globals.ClientUserinfoChanged = G_ClientUserinfoChanged;
 	globals.ClientDisconnect = ClientDisconnect;
 	globals.ClientBegin = ClientBegin;
 	globals.ClientCommand = ClientCommand;
@@ -186,8 +225,13 @@ void ClientEndServerFrames (void)
 	int		i;
 	edict_t	*ent;
 
+	G_BuildChaseList ();
+
 	// calc the player views now that all pushing
 	// and damage has been added
+	if (G_ParallelClientFrames ())
+		return;
+
 	for (i=0 ; i<maxclients->value ; i++)
 	{
 		ent = g_edicts + 1 + i;
@@ -334,6 +378,10 @@ void ExitLevel (void)
 
 	Com_sprintf (command, sizeof(command), "gamemap \"%s\"\n", level.changemap);
 	gi.AddCommandString (command);
+
+	// a new unit wipes the saved levels, so forget the cached hubs too
+	if (level.changemap[0] == '*')
+		LevelCache_Clear ();
 	level.changemap = NULL;
 	level.exitintermission = 0;
 	level.intermissiontime = 0;
@@ -387,15 +435,16 @@ static void G_RunFrame_Internal (void)
 	ent = &g_edicts[0];
 	for (i=0 ; i<globals.num_edicts ; i++, ent++)
 	{
-		if (!ent->inuse)
+		if (!g_hot[i].inuse)
 			continue;
 
 		level.current_entity = ent;
+		G_MemEntity (ent);
 
 		VectorCopy (ent->s.origin, ent->s.old_origin);
 
 		// if the ground entity moved, make sure we are still on it
-		if ((ent->groundentity) && (ent->groundentity->linkcount != ent->groundentity_linkcount))
+		if ((ent->groundentity) && (G_HOT(ent->groundentity)->linkcount != ent->groundentity_linkcount))
 		{
 			ent->groundentity = NULL;
 			if ( !(ent->flags & (FL_SWIM|FL_FLY)) && (ent->svflags & SVF_MONSTER) )
@@ -405,19 +454,29 @@ static void G_RunFrame_Internal (void)
 		}
 
 		if (i > 0 && i <= maxclients->value)
-		{
 			ClientBeginServerFrame (ent);
-			continue;
-		}
-
-		G_RunEntity (ent);
+		else
+			G_RunEntity (ent);
 	}
+	G_MemEntity (NULL);
+
+	// resolve every blast queued by this frame's thinks and touches
+	G_RunExplosions ();
+	G_FlushDamage ();
 
 	// see if it is time to end a deathmatch
 	CheckDMRules ();
 
+	// send this frame's impact effects
+	G_FlushTempEntities ();
+
 	// build the playerstate_t structures for all players
         ClientEndServerFrames ();
+
+	G_RadiusStatsFrame ();
+
+	// keep the rewind ring going
+	G_RunSnapshots ();
 }
 
 static void Oblivion_RunFrame (void)
@@ -427,6 +486,10 @@ static void Oblivion_RunFrame (void)
 
 void G_RunFrame (void)
 {
+        // a level written on the last map change must be on disk before
+        // any console command can touch the save directory
+        SaveStream_Barrier (NULL);
+
         G_RunFrame_Internal ();
 }
 
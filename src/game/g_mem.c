@@ -0,0 +1,352 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_mem.c -- accounting for the game's tagged allocations
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+MEMORY ACCOUNTING
+
+Every tagged allocation in the game goes through G_TagMalloc, which names
+the subsystem that asked for it ("strings", "camera", "edicts", ...).  The
+classname of the entity being spawned, loaded or run at the time is
+recorded with it, so a level's strings can be told apart by the entities
+that own them.
+
+Each block carries a small header with its size and the bucket it was
+counted in, so G_TagFree can give the bytes back.  G_FreeTags empties
+every bucket of that tag.  Current and peak bytes are kept per tag and per
+bucket.
+
+Buckets are found through a hash of tag, owner and classname.  The last
+MAX_MEM_TAGS slots are held back, so once the table fills up each tag
+still gets a bucket of its own named "other" for everything that didn't
+fit, and no bucket that is already counting is ever renamed.
+
+sv mem				tag totals and the largest buckets
+sv mem dump [file]	every bucket, one per line, for comparing builds
+
+==============================================================================
+*/
+
+#define	MAX_MEM_TAGS		4
+#define	MAX_MEM_BUCKETS		512
+#define	MAX_MEM_LISTED		32
+#define	MEM_HASH_SIZE		1024		// must be a power of two
+
+typedef struct
+{
+	int		tag;
+	int		current;
+	int		peak;
+} memtag_t;
+
+typedef struct
+{
+	int		tag;
+	char	*owner;
+	char	classname[32];
+	int		current;
+	int		peak;
+	int		blocks;			// currently allocated
+	int		allocs;			// ever allocated
+	int		next;			// index + 1 of the next bucket in the hash chain
+} membucket_t;
+
+// a multiple of 16 so the block keeps the engine's alignment
+typedef struct
+{
+	int		bucket;
+	int		size;
+	int		pad[2];
+} memheader_t;
+
+static memtag_t		mem_tags[MAX_MEM_TAGS];
+static membucket_t	mem_buckets[MAX_MEM_BUCKETS];
+static int			mem_numbuckets;
+static int			mem_lastbucket;
+static int			mem_hash[MEM_HASH_SIZE];	// index + 1, 0 = empty
+static char			mem_other[] = "other";
+static edict_t		*mem_entity;
+
+/*
+=================
+G_MemEntity
+
+Names the entity that following allocations are made for, or NULL.
+=================
+*/
+void G_MemEntity (edict_t *ent)
+{
+	mem_entity = ent;
+}
+
+static memtag_t *Mem_Tag (int tag)
+{
+	int		i;
+
+	for (i=0 ; i<MAX_MEM_TAGS ; i++)
+	{
+		if (mem_tags[i].tag == tag)
+			return &mem_tags[i];
+		if (!mem_tags[i].tag)
+		{
+			mem_tags[i].tag = tag;
+			return &mem_tags[i];
+		}
+	}
+	return &mem_tags[MAX_MEM_TAGS-1];
+}
+
+static char *Mem_TagName (int tag)
+{
+	if (tag == TAG_GAME)
+		return "game";
+	if (tag == TAG_LEVEL)
+		return "level";
+	return va ("%i", tag);
+}
+
+static unsigned Mem_Hash (int tag, char *owner, char *classname)
+{
+	unsigned	hash;
+
+	hash = 2166136261u ^ (unsigned)tag;
+	hash = (hash ^ (unsigned)((size_t)owner >> 3)) * 16777619u;
+	while (*classname)
+		hash = (hash ^ (byte)*classname++) * 16777619u;
+	return hash & (MEM_HASH_SIZE-1);
+}
+
+static int Mem_FindBucket (unsigned hash, int tag, char *owner, char *classname)
+{
+	membucket_t	*b;
+	int			i;
+
+	for (i=mem_hash[hash] ; i ; i=b->next)
+	{
+		b = &mem_buckets[i-1];
+		if (b->tag == tag && b->owner == owner && !strncmp (b->classname, classname, sizeof(b->classname)-1))
+			return i-1;
+	}
+	return -1;
+}
+
+static int Mem_Bucket (int tag, char *owner)
+{
+	membucket_t	*b;
+	char		*classname;
+	unsigned	hash;
+	int			i;
+
+	classname = "";
+	if (mem_entity && mem_entity->classname)
+		classname = mem_entity->classname;
+
+	// most runs of allocations come from the same place
+	b = &mem_buckets[mem_lastbucket];
+	if (mem_numbuckets && b->tag == tag && b->owner == owner && !strncmp (b->classname, classname, sizeof(b->classname)-1))
+		return mem_lastbucket;
+
+	hash = Mem_Hash (tag, owner, classname);
+	i = Mem_FindBucket (hash, tag, owner, classname);
+	if (i >= 0)
+		return mem_lastbucket = i;
+
+	// once only the reserved slots are left, anything new goes to its
+	// tag's overflow bucket
+	if (mem_numbuckets >= MAX_MEM_BUCKETS - MAX_MEM_TAGS)
+	{
+		owner = mem_other;
+		classname = "";
+		hash = Mem_Hash (tag, owner, classname);
+		i = Mem_FindBucket (hash, tag, owner, classname);
+		if (i >= 0)
+			return mem_lastbucket = i;
+		if (mem_numbuckets == MAX_MEM_BUCKETS)
+			return mem_lastbucket = MAX_MEM_BUCKETS-1;	// more tags than Mem_Tag keeps apart
+	}
+
+	b = &mem_buckets[mem_numbuckets];
+	b->tag = tag;
+	b->owner = owner;
+	strncpy (b->classname, classname, sizeof(b->classname)-1);
+	b->next = mem_hash[hash];
+	mem_hash[hash] = ++mem_numbuckets;
+	return mem_lastbucket = mem_numbuckets-1;
+}
+
+/*
+=================
+G_TagMalloc
+
+owner must be a string that lives as long as the game dll does.
+=================
+*/
+void *G_TagMalloc (int size, int tag, char *owner)
+{
+	memheader_t	*h;
+	membucket_t	*b;
+	memtag_t	*t;
+
+	h = gi.TagMalloc (size + sizeof(memheader_t), tag);
+	h->bucket = Mem_Bucket (tag, owner);
+	h->size = size;
+
+	b = &mem_buckets[h->bucket];
+	b->current += size;
+	b->blocks++;
+	b->allocs++;
+	if (b->current > b->peak)
+		b->peak = b->current;
+
+	t = Mem_Tag (tag);
+	t->current += size;
+	if (t->current > t->peak)
+		t->peak = t->current;
+
+	return h + 1;
+}
+
+void G_TagFree (void *block)
+{
+	memheader_t	*h;
+	membucket_t	*b;
+
+	h = (memheader_t *)block - 1;
+	b = &mem_buckets[h->bucket];
+	b->current -= h->size;
+	b->blocks--;
+	Mem_Tag (b->tag)->current -= h->size;
+
+	gi.TagFree (h);
+}
+
+void G_FreeTags (int tag)
+{
+	membucket_t	*b;
+	int			i;
+
+	gi.FreeTags (tag);
+
+	for (i=0, b=mem_buckets ; i<mem_numbuckets ; i++, b++)
+	{
+		if (b->tag != tag)
+			continue;
+		b->current = 0;
+		b->blocks = 0;
+	}
+	Mem_Tag (tag)->current = 0;
+}
+
+static int Mem_CompareBuckets (const void *a, const void *b)
+{
+	const membucket_t	*ba = *(const membucket_t **)a;
+	const membucket_t	*bb = *(const membucket_t **)b;
+
+	if (ba->current != bb->current)
+		return bb->current - ba->current;
+	return bb->peak - ba->peak;
+}
+
+/*
+=================
+Svcmd_MemDump
+
+One line per bucket, whitespace separated, so the output of two builds
+can be diffed or loaded straight into a script.
+=================
+*/
+static void Svcmd_MemDump (char *filename)
+{
+	FILE		*f;
+	char		name[MAX_OSPATH];
+	membucket_t	*b;
+	memtag_t	*t;
+	cvar_t		*gamedir;
+	int			i;
+
+	if (*filename)
+		Com_sprintf (name, sizeof(name), "%s", filename);
+	else
+	{
+		gamedir = gi.cvar ("game", "", 0);
+		Com_sprintf (name, sizeof(name), "%s/mem.txt", *gamedir->string ? gamedir->string : GAMEVERSION);
+	}
+
+	f = fopen (name, "w");
+	if (!f)
+	{
+		gi.cprintf (NULL, PRINT_HIGH, "Couldn't open %s\n", name);
+		return;
+	}
+
+	fprintf (f, "# map %s frame %i\n", level.mapname, level.framenum);
+	fprintf (f, "# tag <tag> <current> <peak>\n");
+	fprintf (f, "# bucket <tag> <owner> <classname> <current> <peak> <blocks> <allocs>\n");
+	for (i=0, t=mem_tags ; i<MAX_MEM_TAGS && t->tag ; i++, t++)
+		fprintf (f, "tag %s %i %i\n", Mem_TagName (t->tag), t->current, t->peak);
+	for (i=0, b=mem_buckets ; i<mem_numbuckets ; i++, b++)
+		fprintf (f, "bucket %s %s %s %i %i %i %i\n", Mem_TagName (b->tag), b->owner,
+			b->classname[0] ? b->classname : "-", b->current, b->peak, b->blocks, b->allocs);
+
+	fclose (f);
+	gi.cprintf (NULL, PRINT_HIGH, "Wrote %s.\n", name);
+}
+
+/*
+=================
+Svcmd_Mem_f
+
+sv mem [dump [file]]
+=================
+*/
+void Svcmd_Mem_f (void)
+{
+	membucket_t	*sorted[MAX_MEM_BUCKETS];
+	membucket_t	*b;
+	memtag_t	*t;
+	int			i;
+
+	if (!Q_stricmp (gi.argv(2), "dump"))
+	{
+		Svcmd_MemDump (gi.argv(3));
+		return;
+	}
+
+	for (i=0, t=mem_tags ; i<MAX_MEM_TAGS && t->tag ; i++, t++)
+		gi.cprintf (NULL, PRINT_HIGH, "%-5s %9i bytes, peak %9i\n", Mem_TagName (t->tag), t->current, t->peak);
+
+	for (i=0 ; i<mem_numbuckets ; i++)
+		sorted[i] = &mem_buckets[i];
+	qsort (sorted, mem_numbuckets, sizeof(sorted[0]), Mem_CompareBuckets);
+
+	gi.cprintf (NULL, PRINT_HIGH, "tag   owner        classname                current     peak blocks\n");
+	for (i=0 ; i<mem_numbuckets && i<MAX_MEM_LISTED ; i++)
+	{
+		b = sorted[i];
+		gi.cprintf (NULL, PRINT_HIGH, "%-5s %-12s %-20s %9i %9i %6i\n", Mem_TagName (b->tag), b->owner,
+			b->classname[0] ? b->classname : "-", b->current, b->peak, b->blocks);
+	}
+	if (mem_numbuckets > MAX_MEM_LISTED)
+		gi.cprintf (NULL, PRINT_HIGH, "%i more, see \"sv mem dump\"\n", mem_numbuckets - MAX_MEM_LISTED);
+}
@@ -33,23 +33,27 @@ extern void SV_AddBlend (float r, float g, float b, float a, float *v_blend);
 
 static edict_t *screenfader_active_list;
 
-static void ScreenFader_EnablePolyblend(void)
-{
-        int i;
+// every active fader blended together, worked out once a frame for all
+// the clients
+static float screenfader_blend[4];
+static int screenfader_blendframe = -1;
 
-        if (!maxclients)
-                return;
+// clients that have been told to turn gl_polyblend on, this level and
+// connection
+static qboolean screenfader_polyblend[MAX_CLIENTS];
 
-        for (i = 1; i <= maxclients->value; i++) {
-                edict_t *cl = &g_edicts[i];
+static void ScreenFader_EnablePolyblend (edict_t *client)
+{
+        int clientnum;
 
-                if (!cl->inuse || !cl->client)
-                        continue;
+        clientnum = client - g_edicts - 1;
+        if (screenfader_polyblend[clientnum])
+                return;
+        screenfader_polyblend[clientnum] = true;
 
-                gi.WriteByte (svc_stufftext);
-                gi.WriteString ("gl_polyblend 1\n");
-                gi.unicast (cl, true);
-        }
+        gi.WriteByte (svc_stufftext);
+        gi.WriteString ("gl_polyblend 1\n");
+        gi.unicast (client, true);
 }
 
 static void ScreenFader_AddActive (edict_t *ent)
@@ -115,7 +119,6 @@ static void ScreenFader_ClearHold (edict_t *self);
 static void ScreenFader_Begin (edict_t *self)
 {
         ScreenFader_RemoveActive (self);
-        ScreenFader_EnablePolyblend ();
 
         if (self->wait <= 0.0f)
                 self->wait = FRAMETIME;
@@ -192,14 +195,30 @@ static void misc_screenfader_use (edict_t *self, edict_t *other, edict_t *activa
 void G_ScreenFade_Reset (void)
 {
         screenfader_active_list = NULL;
+        screenfader_blendframe = -1;
+        memset (screenfader_polyblend, 0, sizeof(screenfader_polyblend));
 }
 
-void G_ScreenFade_AddBlend (edict_t *client)
+void G_ScreenFade_ClientConnect (edict_t *client)
+{
+        screenfader_polyblend[client - g_edicts - 1] = false;
+}
+
+/*
+=================
+ScreenFader_CalcBlend
+
+SV_AddBlend puts each new color under the ones already there, which can
+be grouped any way, so the faders are blended on their own here and added
+to each client's view blend in one step.
+=================
+*/
+static void ScreenFader_CalcBlend (void)
 {
         edict_t *fader;
 
-        if (!client->client)
-                return;
+        screenfader_blendframe = level.framenum;
+        screenfader_blend[0] = screenfader_blend[1] = screenfader_blend[2] = screenfader_blend[3] = 0;
 
         for (fader = screenfader_active_list; fader; fader = fader->chain) {
                 float duration, frac, alpha;
@@ -229,10 +248,27 @@ void G_ScreenFade_AddBlend (edict_t *client)
                 if (alpha <= 0.0f)
                         continue;
 
-                SV_AddBlend (color[0], color[1], color[2], alpha, client->client->ps.blend);
+                SV_AddBlend (color[0], color[1], color[2], alpha, screenfader_blend);
         }
 }
 
+void G_ScreenFade_AddBlend (edict_t *client)
+{
+        if (!client->client || !screenfader_active_list)
+                return;
+
+        if (screenfader_blendframe != level.framenum)
+                ScreenFader_CalcBlend ();
+
+        ScreenFader_EnablePolyblend (client);
+
+        if (screenfader_blend[3] <= 0.0f)
+                return;
+
+        SV_AddBlend (screenfader_blend[0], screenfader_blend[1], screenfader_blend[2],
+                screenfader_blend[3], client->client->ps.blend);
+}
+
 /*QUAKED misc_screenfader (0 0 1) (-8 -8 -8) (8 8 8) START_ON
 Fades the player's screen from the first color to the second over time.
 pathtarget      "r g b a" string for the starting color. "message" can be used as a fallback.
@@ -501,7 +537,7 @@ void ThrowClientHead (edict_t *self, int damage)
 	vec3_t	vd;
 	char	*gibname;
 
-	if (rand()&1)
+	if (G_Rand()&1)
 	{
 		gibname = "models/objects/gibs/head2/tris.md2";
 		self->s.skinnum = 1;		// second skin is player
@@ -1051,7 +1087,7 @@ void func_explosive_explode (edict_t *self, edict_t *inflictor, edict_t *attacke
 	self->takedamage = DAMAGE_NO;
 
 	if (self->dmg)
-		T_RadiusDamage (self, attacker, self->dmg, NULL, self->dmg+40, MOD_EXPLOSIVE);
+		T_QueueRadiusDamage (self, attacker, self->dmg, NULL, self->dmg+40, MOD_EXPLOSIVE);
 
 	VectorSubtract (self->s.origin, inflictor->s.origin, self->velocity);
 	VectorNormalize (self->velocity);
@@ -1183,7 +1219,7 @@ void barrel_explode (edict_t *self)
 	float	spd;
 	vec3_t	save;
 
-	T_RadiusDamage (self, self->activator, self->dmg, NULL, self->dmg+40, MOD_BARREL);
+	T_QueueRadiusDamage (self, self->activator, self->dmg, NULL, self->dmg+40, MOD_BARREL);
 
 	VectorCopy (self->s.origin, save);
 	VectorMA (self->absmin, 0.5, self->size, self->s.origin);
@@ -1497,7 +1533,7 @@ void SP_misc_banner (edict_t *ent)
 	ent->movetype = MOVETYPE_NONE;
 	ent->solid = SOLID_NOT;
 	ent->s.modelindex = gi.modelindex ("models/objects/banner/tris.md2");
-	ent->s.frame = rand() % 16;
+	ent->s.frame = G_Rand() % 16;
 	gi.linkentity (ent);
 
 	ent->think = misc_banner_think;
@@ -2061,7 +2097,7 @@ void SP_func_clock (edict_t *self)
 
 	func_clock_reset (self);
 
-	self->message = gi.TagMalloc (CLOCK_MESSAGE_SIZE, TAG_LEVEL);
+	self->message = G_TagMalloc (CLOCK_MESSAGE_SIZE, TAG_LEVEL, "clock");
 
 	self->think = func_clock_think;
 
@@ -153,14 +153,35 @@ static void Mission_MarkUnread (void)
         state->unread_events++;
 }
 
+// what an entity without a mission table entry reads as
+static mission_ext_t mission_ext_none;
+
+/*
+=================
+Mission_ReadExt
+
+ent's mission state for reading.  Unlike G_MissionExt, it doesn't give
+the entity an entry when it has none.
+=================
+*/
+static mission_ext_t *Mission_ReadExt (edict_t *ent)
+{
+        mission_ext_t *mis = G_FindEdictExt (ent, EXT_MISSION);
+
+        return mis ? mis : &mission_ext_none;
+}
+
 static void Mission_FillObjectiveId (char *buffer, size_t buffer_size, edict_t *ent)
 {
+        mission_ext_t *mis;
+
         if (!buffer || !buffer_size)
                 return;
 
-        if (ent->oblivion.mission_id && ent->oblivion.mission_id[0])
+        mis = Mission_ReadExt (ent);
+        if (mis->mission_id && mis->mission_id[0])
         {
-                Mission_Strncpy (buffer, buffer_size, ent->oblivion.mission_id);
+                Mission_Strncpy (buffer, buffer_size, mis->mission_id);
                 return;
         }
 
@@ -182,8 +203,9 @@ static void Mission_FillObjectiveId (char *buffer, size_t buffer_size, edict_t *
 
 static void Mission_SetObjectiveText (mission_objective_save_t *obj, edict_t *ent)
 {
-        const char *explicit_title = ent->oblivion.mission_title;
-        const char *explicit_text = ent->oblivion.mission_text;
+        mission_ext_t *mis = Mission_ReadExt (ent);
+        const char *explicit_title = mis->mission_title;
+        const char *explicit_text = mis->mission_text;
         const char *message = ent->message;
 
         if (explicit_title && explicit_title[0])
@@ -361,35 +383,40 @@ void Mission_FrameUpdate (void)
 
 void Mission_RegisterHelpTarget (edict_t *ent)
 {
+        mission_ext_t *mis;
+
         if (!ent)
                 return;
 
-        if (!ent->oblivion.mission_state)
+        mis = G_MissionExt(ent);
+
+        if (!mis->mission_state)
         {
                 if (ent->spawnflags & 4)
-                        ent->oblivion.mission_state = MISSION_EVENT_START;
+                        mis->mission_state = MISSION_EVENT_START;
                 else
-                        ent->oblivion.mission_state = MISSION_EVENT_UPDATE;
+                        mis->mission_state = MISSION_EVENT_UPDATE;
         }
 
-        if (!ent->oblivion.mission_timer_cooldown)
+        if (!mis->mission_timer_cooldown)
         {
                 if (ent->spawnflags & 1)
-                        ent->oblivion.mission_timer_cooldown |= MISSION_FLAG_PRIMARY;
+                        mis->mission_timer_cooldown |= MISSION_FLAG_PRIMARY;
                 if (ent->spawnflags & 256)
-                        ent->oblivion.mission_timer_cooldown |= MISSION_FLAG_PERSISTENT;
+                        mis->mission_timer_cooldown |= MISSION_FLAG_PERSISTENT;
         }
 
-        if (ent->oblivion.mission_timer_limit < 0)
-                ent->oblivion.mission_timer_limit = 0;
+        if (mis->mission_timer_limit < 0)
+                mis->mission_timer_limit = 0;
 
-        if (ent->oblivion.mission_timer_remaining <= 0 && ent->oblivion.mission_timer_limit > 0)
-                ent->oblivion.mission_timer_remaining = ent->oblivion.mission_timer_limit;
+        if (mis->mission_timer_remaining <= 0 && mis->mission_timer_limit > 0)
+                mis->mission_timer_remaining = mis->mission_timer_limit;
 }
 
 static qboolean Mission_HandleObjectiveEvent (edict_t *ent, const char *id, mission_objective_save_t **out_obj)
 {
         mission_objective_save_t *obj = Mission_FindObjective (id);
+        mission_ext_t *mis = Mission_ReadExt (ent);
 
         if (!obj)
                 obj = Mission_AllocateObjective (id);
@@ -399,16 +426,16 @@ static qboolean Mission_HandleObjectiveEvent (edict_t *ent, const char *id, miss
 
         Mission_SetObjectiveText (obj, ent);
 
-        obj->primary = (ent->oblivion.mission_timer_cooldown & MISSION_FLAG_PRIMARY) != 0;
-        obj->persistent = (ent->oblivion.mission_timer_cooldown & MISSION_FLAG_PERSISTENT) != 0;
-        VectorCopy (ent->oblivion.mission_origin, obj->origin);
-        VectorCopy (ent->oblivion.mission_angles, obj->angles);
-        obj->radius = ent->oblivion.mission_radius;
-        obj->timer_limit = ent->oblivion.mission_timer_limit;
+        obj->primary = (mis->mission_timer_cooldown & MISSION_FLAG_PRIMARY) != 0;
+        obj->persistent = (mis->mission_timer_cooldown & MISSION_FLAG_PERSISTENT) != 0;
+        VectorCopy (mis->mission_origin, obj->origin);
+        VectorCopy (mis->mission_angles, obj->angles);
+        obj->radius = mis->mission_radius;
+        obj->timer_limit = mis->mission_timer_limit;
         if (obj->timer_limit < 0)
                 obj->timer_limit = 0;
         if (obj->timer_limit > 0)
-                obj->timer_remaining = Mission_SecondsToTicks (ent->oblivion.mission_timer_remaining > 0 ? ent->oblivion.mission_timer_remaining : obj->timer_limit);
+                obj->timer_remaining = Mission_SecondsToTicks (mis->mission_timer_remaining > 0 ? mis->mission_timer_remaining : obj->timer_limit);
         else
                 obj->timer_remaining = 0;
 
@@ -422,6 +449,7 @@ qboolean Mission_TargetHelpFired (edict_t *ent, edict_t *activator)
 {
         char id[32];
         mission_objective_save_t *obj = NULL;
+        mission_ext_t *mis;
         int event;
 
         (void)activator;
@@ -429,12 +457,13 @@ qboolean Mission_TargetHelpFired (edict_t *ent, edict_t *activator)
         if (!ent)
                 return false;
 
-        event = ent->oblivion.mission_state;
+        mis = Mission_ReadExt (ent);
+        event = mis->mission_state;
         if (!event)
                 event = (ent->spawnflags & 4) ? MISSION_EVENT_START : MISSION_EVENT_UPDATE;
 
-        if (!ent->message && (!ent->oblivion.mission_text || !ent->oblivion.mission_text[0])
-                && !ent->oblivion.mission_id && event == MISSION_EVENT_UPDATE)
+        if (!ent->message && (!mis->mission_text || !mis->mission_text[0])
+                && !mis->mission_id && event == MISSION_EVENT_UPDATE)
         {
                 return false;
         }
@@ -449,7 +449,7 @@ qboolean SV_Push (edict_t *pusher, vec3_t move, vec3_t amove)
 	check = g_edicts+1;
 	for (e = 1; e < globals.num_edicts; e++, check++)
 	{
-		if (!check->inuse)
+		if (!g_hot[e].inuse)
 			continue;
 		if (check->movetype == MOVETYPE_PUSH
 		|| check->movetype == MOVETYPE_STOP
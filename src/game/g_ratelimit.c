@@ -0,0 +1,512 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_ratelimit.c -- token buckets for client commands and connects
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+RATE LIMITS
+
+Every command a client sends runs on the server's frame, and nothing but
+chat had a limit.  A client binding "score" or a userinfo change to a key
+repeat could make the server build layouts or reparse skins hundreds of
+times a second.
+
+Each client now has a token bucket per class of command.  A bucket holds
+up to burst tokens and gains rate tokens a second; a command takes one
+token, and is dropped when there is none.  The client is told, at most
+once a second.  The classes are set by "rate burst" cvars:
+
+	g_rate_layout		scoreboards, help and inventory		"2 6"
+	g_rate_gesture		wave								"1 3"
+	g_rate_userinfo		userinfo changes					"2 8"
+	g_rate_gameplay		use, weapnext, invuse and the like	"20 40"
+	g_rate_command		everything else						"20 40"
+	g_rate_connect		new connections, for the server		"4 32"
+	g_rate_connect_ip	new connections, for each address	"1 4"
+
+A connection has to get a token from its address's bucket before it may
+take one from the server's, so one host retrying can't use up the
+server's and lock everyone else out.  The address buckets are kept in a
+small hash table; when it is full the one left alone longest is reused.
+
+A rate of 0 turns that class's limit off.  Chat keeps its flood_msgs,
+flood_persecond and flood_waitdelay cvars: the bucket holds flood_msgs
+messages and refills over flood_persecond seconds, and a client that
+runs out is still locked out for flood_waitdelay.
+
+A userinfo change that is over the limit isn't dropped, since the last
+one sent is the one the client is left with.  It is kept and applied from
+ClientBeginServerFrame once the client has a token again.
+
+g_rate_frame caps the commands of all clients together in one server
+frame, chat, gameplay commands and connects aside.  0 is no cap.  The
+gameplay commands are left out so that a burst of scoreboards from other
+players never costs anyone a weapon switch.
+
+"sv ratestats" lists what has been dropped.
+
+==============================================================================
+*/
+
+void ClientUserinfoChanged (edict_t *ent, char *userinfo);
+
+typedef struct
+{
+	float	tokens;
+	float	time;			// level.time tokens were last counted, -1 for full
+} ratebucket_t;
+
+static char		*rate_names[NUM_RATE_CLASSES] =
+{
+	"chat",
+	"layout",
+	"gesture",
+	"userinfo",
+	"gameplay",
+	"command"
+};
+
+static cvar_t		**rate_cvars[NUM_RATE_CLASSES] =
+{
+	NULL,
+	&g_rate_layout,
+	&g_rate_gesture,
+	&g_rate_userinfo,
+	&g_rate_gameplay,
+	&g_rate_command
+};
+
+static qboolean		rate_parsed;
+static float		rate_rate[NUM_RATE_CLASSES];
+static float		rate_burst[NUM_RATE_CLASSES];
+
+static float		connect_rate, connect_burst;
+static ratebucket_t	connect_bucket = {0, -1};
+
+#define	CONNECT_HASH_SIZE	256		// must be a power of two
+#define	CONNECT_PROBES		8
+
+typedef struct
+{
+	unsigned		addr;
+	qboolean		used;
+	ratebucket_t	b;
+} connectbucket_t;
+
+static float			connect_ip_rate, connect_ip_burst;
+static connectbucket_t	connect_hosts[CONNECT_HASH_SIZE];
+
+static ratebucket_t	rate_buckets[MAX_CLIENTS][NUM_RATE_CLASSES];
+static int			rate_drops[MAX_CLIENTS][NUM_RATE_CLASSES];
+
+static int			rate_totals[NUM_RATE_CLASSES];
+static int			rate_framedrops;
+static int			rate_connectdrops;
+static int			rate_hostdrops;
+static float		rate_warned[MAX_CLIENTS];		// level.time of the last notice
+
+static int			frame_commands;
+static int			frame_framenum = -1;
+
+static qboolean		userinfo_pending[MAX_CLIENTS];
+static char			pending_userinfo[MAX_CLIENTS][MAX_INFO_STRING];
+
+/*
+=================
+Rate_Parse
+
+Reads a "rate burst" cvar.  A missing burst is one second's worth.
+=================
+*/
+static void Rate_Parse (cvar_t *var, float *rate, float *burst)
+{
+	char	*end;
+
+	*rate = (float)strtod (var->string, &end);
+	*burst = (float)strtod (end, NULL);
+	if (*rate < 0)
+		*rate = 0;
+	if (*burst < 1)
+		*burst = *rate < 1 ? 1 : *rate;
+	var->modified = false;
+}
+
+/*
+=================
+Rate_CheckCvars
+=================
+*/
+static void Rate_CheckCvars (void)
+{
+	int		i;
+
+	for (i=RL_CHAT+1 ; i<NUM_RATE_CLASSES ; i++)
+		if (!rate_parsed || (*rate_cvars[i])->modified)
+			Rate_Parse (*rate_cvars[i], &rate_rate[i], &rate_burst[i]);
+	if (!rate_parsed || g_rate_connect->modified)
+		Rate_Parse (g_rate_connect, &connect_rate, &connect_burst);
+	if (!rate_parsed || g_rate_connect_ip->modified)
+		Rate_Parse (g_rate_connect_ip, &connect_ip_rate, &connect_ip_burst);
+	rate_parsed = true;
+
+	// chat is held to the flood cvars
+	if (flood_msgs->value > 0 && flood_persecond->value > 0)
+	{
+		rate_burst[RL_CHAT] = flood_msgs->value;
+		rate_rate[RL_CHAT] = flood_msgs->value / flood_persecond->value;
+	}
+	else
+		rate_rate[RL_CHAT] = 0;
+}
+
+/*
+=================
+Rate_Take
+
+Refills the bucket for the time since it was last used and takes a token
+if there is one.  level.time starts over with every level, so a bucket
+from an earlier level is simply full.
+=================
+*/
+static qboolean Rate_Take (ratebucket_t *b, float rate, float burst)
+{
+	if (b->time < 0 || level.time < b->time)
+		b->tokens = burst;
+	else
+	{
+		b->tokens += (level.time - b->time) * rate;
+		if (b->tokens > burst)
+			b->tokens = burst;
+	}
+	b->time = level.time;
+
+	if (b->tokens < 1)
+		return false;
+	b->tokens -= 1;
+	return true;
+}
+
+/*
+=================
+Rate_Warn
+
+Tells a client a command was dropped, at most once a second.  Chat has
+its own message and userinfo changes aren't dropped.
+=================
+*/
+static void Rate_Warn (edict_t *ent, int clientnum, rateclass_t cls)
+{
+	if (cls == RL_CHAT || cls == RL_USERINFO)
+		return;
+	if (level.time >= rate_warned[clientnum] && level.time < rate_warned[clientnum] + 1)
+		return;
+	rate_warned[clientnum] = level.time;
+	gi.cprintf (ent, PRINT_HIGH, "Too many commands, \"%s\" was dropped.\n", gi.argv(0));
+}
+
+/*
+=================
+G_RateLimit
+
+Returns true if the client may run a command of the class now, and
+charges it for one.
+=================
+*/
+qboolean G_RateLimit (edict_t *ent, rateclass_t cls)
+{
+	int		clientnum;
+
+	clientnum = ent - g_edicts - 1;
+	if (clientnum < 0 || clientnum >= MAX_CLIENTS || cls < 0 || cls >= NUM_RATE_CLASSES)
+		return true;
+
+	Rate_CheckCvars ();
+
+	if (cls != RL_CHAT && cls != RL_GAMEPLAY && g_rate_frame->value > 0)
+	{
+		if (frame_framenum != level.framenum)
+		{
+			frame_framenum = level.framenum;
+			frame_commands = 0;
+		}
+		if (frame_commands >= g_rate_frame->value)
+		{
+			rate_framedrops++;
+			rate_drops[clientnum][cls]++;
+			Rate_Warn (ent, clientnum, cls);
+			return false;
+		}
+	}
+
+	if (rate_rate[cls] > 0 && !Rate_Take (&rate_buckets[clientnum][cls], rate_rate[cls], rate_burst[cls]))
+	{
+		rate_totals[cls]++;
+		rate_drops[clientnum][cls]++;
+		Rate_Warn (ent, clientnum, cls);
+		return false;
+	}
+
+	if (cls != RL_CHAT && cls != RL_GAMEPLAY)
+		frame_commands++;
+	return true;
+}
+
+/*
+=================
+Rate_ParseAddress
+
+"a.b.c.d:port" to a.b.c.d, like SV_FilterPacket.
+=================
+*/
+static unsigned Rate_ParseAddress (char *from)
+{
+	byte	m[4];
+	char	*p;
+	int		i;
+
+	i = 0;
+	p = from;
+	m[0] = m[1] = m[2] = m[3] = 0;
+	while (*p && i < 4)
+	{
+		while (*p >= '0' && *p <= '9')
+		{
+			m[i] = m[i]*10 + (*p - '0');
+			p++;
+		}
+		if (!*p || *p == ':')
+			break;
+		i++, p++;
+	}
+	return ((unsigned)m[0]<<24) | ((unsigned)m[1]<<16) | ((unsigned)m[2]<<8) | m[3];
+}
+
+/*
+=================
+Rate_HostBucket
+
+The bucket for an address.  A free slot, or failing that the one whose
+last connect was longest ago, is taken over for a new address.
+=================
+*/
+static ratebucket_t *Rate_HostBucket (unsigned addr)
+{
+	connectbucket_t	*h, *oldest;
+	unsigned		slot;
+	int				i;
+
+	slot = (addr * 2654435761u) >> 24;
+	oldest = NULL;
+	for (i=0 ; i<CONNECT_PROBES ; i++)
+	{
+		h = &connect_hosts[(slot + i) & (CONNECT_HASH_SIZE-1)];
+		if (h->used && h->addr == addr)
+			return &h->b;
+		if (!h->used || h->b.time > level.time)
+		{
+			oldest = h;		// free, or left from an earlier level
+			break;
+		}
+		if (!oldest || h->b.time < oldest->b.time)
+			oldest = h;
+	}
+
+	oldest->used = true;
+	oldest->addr = addr;
+	oldest->b.tokens = 0;
+	oldest->b.time = -1;
+	return &oldest->b;
+}
+
+/*
+=================
+G_RateLimitConnect
+
+Called from ClientConnect for a new connection.  The local client is
+never refused.
+=================
+*/
+qboolean G_RateLimitConnect (char *ip)
+{
+	if (!strcmp (ip, "loopback"))
+		return true;
+
+	Rate_CheckCvars ();
+
+	// the address first, so one host can't spend the server's tokens
+	if (connect_ip_rate > 0
+		&& !Rate_Take (Rate_HostBucket (Rate_ParseAddress (ip)), connect_ip_rate, connect_ip_burst))
+	{
+		rate_hostdrops++;
+		return false;
+	}
+
+	if (connect_rate > 0 && !Rate_Take (&connect_bucket, connect_rate, connect_burst))
+	{
+		rate_connectdrops++;
+		return false;
+	}
+	return true;
+}
+
+/*
+=================
+G_RateLimitClientConnect
+
+A new client starts with full buckets and no drops.
+=================
+*/
+void G_RateLimitClientConnect (edict_t *ent)
+{
+	int		clientnum, i;
+
+	clientnum = ent - g_edicts - 1;
+	if (clientnum < 0 || clientnum >= MAX_CLIENTS)
+		return;
+
+	for (i=0 ; i<NUM_RATE_CLASSES ; i++)
+	{
+		rate_buckets[clientnum][i].tokens = 0;
+		rate_buckets[clientnum][i].time = -1;
+		rate_drops[clientnum][i] = 0;
+	}
+	rate_warned[clientnum] = -1;
+	userinfo_pending[clientnum] = false;
+}
+
+/*
+=================
+G_ClientUserinfoChanged
+
+The engine's ClientUserinfoChanged.  The game's own calls, from
+ClientConnect and the spectator code, go straight to ClientUserinfoChanged.
+=================
+*/
+void G_ClientUserinfoChanged (edict_t *ent, char *userinfo)
+{
+	int		clientnum;
+
+	clientnum = ent - g_edicts - 1;
+	if (clientnum < 0 || clientnum >= MAX_CLIENTS || !ent->client || !ent->client->pers.connected)
+	{
+		ClientUserinfoChanged (ent, userinfo);
+		return;
+	}
+
+	if (!G_RateLimit (ent, RL_USERINFO))
+	{
+		strncpy (pending_userinfo[clientnum], userinfo, sizeof(pending_userinfo[clientnum])-1);
+		userinfo_pending[clientnum] = true;
+		return;
+	}
+
+	userinfo_pending[clientnum] = false;
+	ClientUserinfoChanged (ent, userinfo);
+}
+
+/*
+=================
+G_RunPendingUserinfo
+
+Called from ClientBeginServerFrame to apply a userinfo change that came
+in over the limit.
+=================
+*/
+void G_RunPendingUserinfo (edict_t *ent)
+{
+	int		clientnum;
+	char	userinfo[MAX_INFO_STRING];
+
+	clientnum = ent - g_edicts - 1;
+	if (clientnum < 0 || clientnum >= MAX_CLIENTS || !userinfo_pending[clientnum])
+		return;
+
+	// waiting for a token isn't counted as another drop
+	Rate_CheckCvars ();
+	if (frame_framenum != level.framenum)
+	{
+		frame_framenum = level.framenum;
+		frame_commands = 0;
+	}
+	if (g_rate_frame->value > 0 && frame_commands >= g_rate_frame->value)
+		return;
+	if (rate_rate[RL_USERINFO] > 0
+		&& !Rate_Take (&rate_buckets[clientnum][RL_USERINFO], rate_rate[RL_USERINFO], rate_burst[RL_USERINFO]))
+		return;
+
+	frame_commands++;
+	userinfo_pending[clientnum] = false;
+	strcpy (userinfo, pending_userinfo[clientnum]);
+	ClientUserinfoChanged (ent, userinfo);
+}
+
+/*
+=================
+Svcmd_RateStats_f
+
+sv ratestats [reset]
+=================
+*/
+void Svcmd_RateStats_f (void)
+{
+	edict_t	*ent;
+	int		i, j, total;
+
+	if (!Q_stricmp (gi.argv(2), "reset"))
+	{
+		memset (rate_totals, 0, sizeof(rate_totals));
+		memset (rate_drops, 0, sizeof(rate_drops));
+		rate_framedrops = rate_connectdrops = rate_hostdrops = 0;
+		gi.cprintf (NULL, PRINT_HIGH, "Rate limit counts cleared.\n");
+		return;
+	}
+
+	Rate_CheckCvars ();
+
+	gi.cprintf (NULL, PRINT_HIGH, "class      rate   burst  dropped\n");
+	for (i=0 ; i<NUM_RATE_CLASSES ; i++)
+		gi.cprintf (NULL, PRINT_HIGH, "%-9s %5.1f  %5.1f  %7i\n",
+			rate_names[i], rate_rate[i], rate_rate[i] > 0 ? rate_burst[i] : 0, rate_totals[i]);
+	gi.cprintf (NULL, PRINT_HIGH, "%-9s %5.1f  %5.1f  %7i\n",
+		"connect", connect_rate, connect_rate > 0 ? connect_burst : 0, rate_connectdrops);
+	gi.cprintf (NULL, PRINT_HIGH, "%-9s %5.1f  %5.1f  %7i\n",
+		"host", connect_ip_rate, connect_ip_rate > 0 ? connect_ip_burst : 0, rate_hostdrops);
+	gi.cprintf (NULL, PRINT_HIGH, "%i dropped over the frame cap of %i\n",
+		rate_framedrops, (int)g_rate_frame->value);
+
+	for (i=0 ; i<game.maxclients && i<MAX_CLIENTS ; i++)
+	{
+		ent = &g_edicts[i+1];
+		if (!ent->inuse || !ent->client)
+			continue;
+		for (j=0, total=0 ; j<NUM_RATE_CLASSES ; j++)
+			total += rate_drops[i][j];
+		if (!total)
+			continue;
+		gi.cprintf (NULL, PRINT_HIGH, "%3i %-15s", i, ent->client->pers.netname);
+		for (j=0 ; j<NUM_RATE_CLASSES ; j++)
+			if (rate_drops[i][j])
+				gi.cprintf (NULL, PRINT_HIGH, " %s %i", rate_names[j], rate_drops[i][j]);
+		gi.cprintf (NULL, PRINT_HIGH, "\n");
+	}
+}
@@ -7,10 +7,6 @@
 #define RTDU_MAX_PITCH          0.0f
 #define RTDU_PROJECTILE_OFFSET  32.0f
 
-static int rtdu_model_index;
-static int rtdu_tripod_model_index;
-static int rtdu_fire_sound;
-static int rtdu_spawn_sound;
 
 static vec3_t rtdu_mins = {-16.0f, -16.0f, 0.0f};
 static vec3_t rtdu_maxs = { 16.0f,  16.0f, 48.0f};
@@ -156,9 +152,7 @@ static void RTDU_TurretThink(edict_t *self)
 
                         fire_blaster_with_mod(self->owner ? self->owner : self,
                                      start, forward, damage, 1000, EF_BLASTER, false, MOD_REMOTE_CANNON);
-                        if (!rtdu_fire_sound)
-                                rtdu_fire_sound = gi.soundindex("weapons/blastf1a.wav");
-                        gi.sound(self, CHAN_WEAPON, rtdu_fire_sound, 1, ATTN_NORM, 0);
+                        gi.sound(self, CHAN_WEAPON, G_Asset (SND_BLASTER), 1, ATTN_NORM, 0);
                         self->wait = level.time + RTDU_FIRE_INTERVAL;
                         self->s.frame = (self->s.frame + 1) % 4;
                 }
@@ -218,7 +212,7 @@ static edict_t *RTDU_CreateTripod(edict_t *turret)
         tripod = G_Spawn();
         tripod->movetype = MOVETYPE_NONE;
         tripod->solid = SOLID_NOT;
-        tripod->s.modelindex = rtdu_tripod_model_index;
+        tripod->s.modelindex = G_Asset (MDL_RTDU_TRIPOD);
         VectorCopy(turret->s.origin, tripod->s.origin);
         VectorCopy(turret->s.angles, tripod->s.angles);
         tripod->owner = turret;
@@ -241,7 +235,7 @@ static edict_t *RTDU_SpawnTurret(edict_t *owner, vec3_t origin, vec3_t angles)
         VectorCopy(rtdu_maxs, turret->maxs);
         VectorCopy(origin, turret->s.origin);
         VectorCopy(angles, turret->s.angles);
-        turret->s.modelindex = rtdu_model_index;
+        turret->s.modelindex = G_Asset (MDL_RTDU);
         turret->takedamage = DAMAGE_YES;
         turret->die = RTDU_TurretDie;
         turret->health = 200;
@@ -278,7 +272,7 @@ static void RTDU_RemoveTurret(edict_t *player, qboolean refund)
         if (!refund)
                 return;
 
-        item = FindItem("RTDU");
+        item = G_Item (ITEM_RTDU);
         if (!item)
                 return;
 
@@ -288,14 +282,10 @@ static void RTDU_RemoveTurret(edict_t *player, qboolean refund)
 
 static void RTDU_PrecacheModels(void)
 {
-        if (!rtdu_model_index)
-                rtdu_model_index = gi.modelindex("models/objects/rtdu/rtdu.md2");
-        if (!rtdu_tripod_model_index)
-                rtdu_tripod_model_index = gi.modelindex("models/objects/rtdu/tripod.md2");
-        if (!rtdu_fire_sound)
-                rtdu_fire_sound = gi.soundindex("weapons/blastf1a.wav");
-        if (!rtdu_spawn_sound)
-                rtdu_spawn_sound = gi.soundindex("misc/tele1.wav");
+        G_Asset (MDL_RTDU);
+        G_Asset (MDL_RTDU_TRIPOD);
+        G_Asset (SND_BLASTER);
+        G_Asset (SND_TELEPORT);
 }
 
 qboolean Pickup_RTDU (edict_t *ent, edict_t *other)
@@ -373,9 +363,7 @@ void rtdu_use (edict_t *ent, gitem_t *item)
         ent->client->rtdu.turret = turret;
         ent->client->pers.inventory[index]--;
         ent->client->rtdu.next_use_time = level.time + RTDU_COOLDOWN_TIME;
-        if (!rtdu_spawn_sound)
-                rtdu_spawn_sound = gi.soundindex("misc/tele1.wav");
-        gi.sound(ent, CHAN_AUTO, rtdu_spawn_sound, 1, ATTN_NORM, 0);
+        gi.sound(ent, CHAN_AUTO, G_Asset (SND_TELEPORT), 1, ATTN_NORM, 0);
 }
 
 void Drop_RTDU (edict_t *ent, gitem_t *item)
@@ -13,11 +13,6 @@
 
 void Move_Calc (edict_t *ent, vec3_t dest, void(*func)(edict_t *));
 
-struct rotate_train_state_s {
-        vec3_t  final_angles;
-        qboolean        has_final;
-};
-
 static void rotate_train_next(edict_t *self);
 static void rotate_train_wait(edict_t *self);
 static void rotate_train_resume(edict_t *self);
@@ -334,7 +329,7 @@ void SP_func_rotate_train(edict_t *self)
 
         self->use = rotate_train_use;
 
-        rotate_train_state_t *rt = gi.TagMalloc(sizeof(*rt), TAG_LEVEL);
+        rotate_train_state_t *rt = G_TagMalloc(sizeof(*rt), TAG_LEVEL, "rtrain");
         memset(rt, 0, sizeof(*rt));
         self->rotate_train = rt;
 
@@ -19,6 +19,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 #include "g_local.h"
+#include <time.h>
 
 #define Function(f) {#f, f}
 
@@ -52,37 +53,37 @@ field_t fields[] = {
 	{"speeds", FOFS(rotate_speed), F_VECTOR},
         {"move_origin", FOFS(move_origin), F_VECTOR},
         {"move_angles", FOFS(move_angles), F_VECTOR},
-        {"mission_controller", FOFS(oblivion.controller), F_EDICT, FFL_NOSPAWN},
-        {"mission_last_controller", FOFS(oblivion.last_controller), F_EDICT, FFL_NOSPAWN},
-        {"mission_prev_path", FOFS(oblivion.prev_path), F_EDICT, FFL_NOSPAWN},
-        {"mission_path_target", FOFS(oblivion.path_target), F_EDICT, FFL_NOSPAWN},
-        {"mission_script_target", FOFS(oblivion.script_target), F_EDICT, FFL_NOSPAWN},
-        {"mission_controller_serial", FOFS(oblivion.controller_serial), F_INT, FFL_NOSPAWN},
-        {"mission_path_toggle", FOFS(oblivion.path_toggle), F_INT, FFL_NOSPAWN},
-        {"mission_controller_distance", FOFS(oblivion.controller_distance), F_FLOAT, FFL_NOSPAWN},
-        {"mission_controller_resume", FOFS(oblivion.controller_resume), F_FLOAT, FFL_NOSPAWN},
-        {"mission_path_wait", FOFS(oblivion.path_wait_time), F_FLOAT, FFL_NOSPAWN},
-        {"mission_path_time", FOFS(oblivion.path_time), F_FLOAT, FFL_NOSPAWN},
-        {"mission_path_speed", FOFS(oblivion.path_speed), F_FLOAT, FFL_NOSPAWN},
-        {"mission_path_step_speed", FOFS(oblivion.path_step_speed), F_FLOAT, FFL_NOSPAWN},
-        {"mission_path_remaining", FOFS(oblivion.path_remaining), F_FLOAT, FFL_NOSPAWN},
-        {"mission_path_state", FOFS(oblivion.path_state), F_INT, FFL_NOSPAWN},
-        {"mission_path_dir", FOFS(oblivion.path_dir), F_VECTOR, FFL_NOSPAWN},
-        {"mission_path_velocity", FOFS(oblivion.path_velocity), F_VECTOR, FFL_NOSPAWN},
-        {"mission_custom_name", FOFS(oblivion.custom_name), F_LSTRING},
-        {"mission_custom_name_time", FOFS(oblivion.custom_name_time), F_FLOAT, FFL_NOSPAWN},
-        {"mission_id", FOFS(oblivion.mission_id), F_LSTRING},
-        {"mission_title", FOFS(oblivion.mission_title), F_LSTRING},
-        {"mission_text", FOFS(oblivion.mission_text), F_LSTRING},
-        {"mission_event", FOFS(oblivion.mission_state), F_INT},
-        {"mission_timer_limit", FOFS(oblivion.mission_timer_limit), F_INT},
-        {"mission_timer_start", FOFS(oblivion.mission_timer_remaining), F_INT},
-        {"mission_flags", FOFS(oblivion.mission_timer_cooldown), F_INT},
-        {"mission_origin", FOFS(oblivion.mission_origin), F_VECTOR},
-        {"mission_angles", FOFS(oblivion.mission_angles), F_VECTOR},
-        {"mission_velocity", FOFS(oblivion.mission_velocity), F_VECTOR},
-        {"mission_blend", FOFS(oblivion.mission_blend), F_FLOAT},
-        {"mission_radius", FOFS(oblivion.mission_radius), F_FLOAT},
+        {"mission_controller", ACTOFS(controller), F_EDICT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_last_controller", ACTOFS(last_controller), F_EDICT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_prev_path", ACTOFS(prev_path), F_EDICT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_target", ACTOFS(path_target), F_EDICT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_script_target", ACTOFS(script_target), F_EDICT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_controller_serial", ACTOFS(controller_serial), F_INT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_toggle", ACTOFS(path_toggle), F_INT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_controller_distance", ACTOFS(controller_distance), F_FLOAT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_controller_resume", ACTOFS(controller_resume), F_FLOAT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_wait", ACTOFS(path_wait_time), F_FLOAT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_time", ACTOFS(path_time), F_FLOAT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_speed", ACTOFS(path_speed), F_FLOAT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_step_speed", ACTOFS(path_step_speed), F_FLOAT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_remaining", ACTOFS(path_remaining), F_FLOAT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_state", ACTOFS(path_state), F_INT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_dir", ACTOFS(path_dir), F_VECTOR, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_path_velocity", ACTOFS(path_velocity), F_VECTOR, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_custom_name", ACTOFS(custom_name), F_LSTRING, FFL_ACTOREXT},
+        {"mission_custom_name_time", ACTOFS(custom_name_time), F_FLOAT, FFL_ACTOREXT|FFL_NOSPAWN},
+        {"mission_id", MISOFS(mission_id), F_LSTRING, FFL_MISSIONEXT},
+        {"mission_title", MISOFS(mission_title), F_LSTRING, FFL_MISSIONEXT},
+        {"mission_text", MISOFS(mission_text), F_LSTRING, FFL_MISSIONEXT},
+        {"mission_event", MISOFS(mission_state), F_INT, FFL_MISSIONEXT},
+        {"mission_timer_limit", MISOFS(mission_timer_limit), F_INT, FFL_MISSIONEXT},
+        {"mission_timer_start", MISOFS(mission_timer_remaining), F_INT, FFL_MISSIONEXT},
+        {"mission_flags", MISOFS(mission_timer_cooldown), F_INT, FFL_MISSIONEXT},
+        {"mission_origin", MISOFS(mission_origin), F_VECTOR, FFL_MISSIONEXT},
+        {"mission_angles", MISOFS(mission_angles), F_VECTOR, FFL_MISSIONEXT},
+        {"mission_velocity", MISOFS(mission_velocity), F_VECTOR, FFL_MISSIONEXT},
+        {"mission_blend", MISOFS(mission_blend), F_FLOAT, FFL_MISSIONEXT},
+        {"mission_radius", MISOFS(mission_radius), F_FLOAT, FFL_MISSIONEXT},
         {"style", FOFS(style), F_INT},
         {"count", FOFS(count), F_INT},
 	{"health", FOFS(health), F_INT},
@@ -158,25 +159,441 @@ field_t fields[] = {
 
 };
 
+/*
+==============================================================================
+
+SAVEGAME SCHEMA
+
+Every member of the structures below that has to survive a save is listed
+here.  Anything not listed is either rebuilt on load (world links and
+cluster data, which the server recomputes in gi.linkentity) or left zero.
+
+Each file starts with the names, types and sizes of the fields it was
+written with, and every record only holds the fields that are not zero.
+A loader matches fields by name, so adding a member only needs a new line
+here and old saves still load; fields the loader doesn't know are skipped.
+
+==============================================================================
+*/
+
+#define MEMBER_SIZE(type, x)	((int)sizeof(((type *)0)->x))
+
+field_t		savefields[] =
+{
+	{"s.number", FOFS(s.number), F_INT},
+	{"s.origin", FOFS(s.origin), F_VECTOR},
+	{"s.angles", FOFS(s.angles), F_VECTOR},
+	{"s.old_origin", FOFS(s.old_origin), F_VECTOR},
+	{"s.modelindex", FOFS(s.modelindex), F_INT},
+	{"s.modelindex2", FOFS(s.modelindex2), F_INT},
+	{"s.modelindex3", FOFS(s.modelindex3), F_INT},
+	{"s.modelindex4", FOFS(s.modelindex4), F_INT},
+	{"s.frame", FOFS(s.frame), F_INT},
+	{"s.skinnum", FOFS(s.skinnum), F_INT},
+	{"s.effects", FOFS(s.effects), F_INT},
+	{"s.renderfx", FOFS(s.renderfx), F_INT},
+	{"s.solid", FOFS(s.solid), F_INT},
+	{"s.sound", FOFS(s.sound), F_INT},
+	{"s.event", FOFS(s.event), F_INT},
+
+	{"client", FOFS(client), F_CLIENT},
+	{"inuse", FOFS(inuse), F_INT},
+	{"linkcount", FOFS(linkcount), F_INT},
+	{"svflags", FOFS(svflags), F_INT},
+	{"mins", FOFS(mins), F_VECTOR},
+	{"maxs", FOFS(maxs), F_VECTOR},
+	{"solid", FOFS(solid), F_INT},
+	{"clipmask", FOFS(clipmask), F_INT},
+	{"owner", FOFS(owner), F_EDICT},
+
+	{"movetype", FOFS(movetype), F_INT},
+	{"flags", FOFS(flags), F_INT},
+	{"model", FOFS(model), F_LSTRING},
+	{"freetime", FOFS(freetime), F_FLOAT},
+	{"message", FOFS(message), F_LSTRING},
+	{"classname", FOFS(classname), F_LSTRING},
+	{"spawnflags", FOFS(spawnflags), F_INT},
+	{"timestamp", FOFS(timestamp), F_FLOAT},
+	{"state_flags", FOFS(state_flags), F_INT},
+	{"state_time", FOFS(state_time), F_FLOAT},
+	{"angle", FOFS(angle), F_FLOAT},
+	{"target", FOFS(target), F_LSTRING},
+	{"targetname", FOFS(targetname), F_LSTRING},
+	{"killtarget", FOFS(killtarget), F_LSTRING},
+	{"team", FOFS(team), F_LSTRING},
+	{"pathtarget", FOFS(pathtarget), F_LSTRING},
+	{"deathtarget", FOFS(deathtarget), F_LSTRING},
+	{"combattarget", FOFS(combattarget), F_LSTRING},
+	{"target_ent", FOFS(target_ent), F_EDICT},
+
+	{"speed", FOFS(speed), F_FLOAT},
+	{"accel", FOFS(accel), F_FLOAT},
+	{"decel", FOFS(decel), F_FLOAT},
+	{"movedir", FOFS(movedir), F_VECTOR},
+	{"pos1", FOFS(pos1), F_VECTOR},
+	{"pos2", FOFS(pos2), F_VECTOR},
+	{"velocity", FOFS(velocity), F_VECTOR},
+	{"avelocity", FOFS(avelocity), F_VECTOR},
+	{"mass", FOFS(mass), F_INT},
+	{"air_finished", FOFS(air_finished), F_FLOAT},
+	{"gravity", FOFS(gravity), F_FLOAT},
+
+	{"goalentity", FOFS(goalentity), F_EDICT},
+	{"movetarget", FOFS(movetarget), F_EDICT},
+	{"yaw_speed", FOFS(yaw_speed), F_FLOAT},
+	{"ideal_yaw", FOFS(ideal_yaw), F_FLOAT},
+
+	{"nextthink", FOFS(nextthink), F_FLOAT},
+	{"prethink", FOFS(prethink), F_FUNCTION},
+	{"think", FOFS(think), F_FUNCTION},
+	{"blocked", FOFS(blocked), F_FUNCTION},
+	{"touch", FOFS(touch), F_FUNCTION},
+	{"use", FOFS(use), F_FUNCTION},
+	{"pain", FOFS(pain), F_FUNCTION},
+	{"die", FOFS(die), F_FUNCTION},
+
+	{"touch_debounce_time", FOFS(touch_debounce_time), F_FLOAT},
+	{"pain_debounce_time", FOFS(pain_debounce_time), F_FLOAT},
+	{"damage_debounce_time", FOFS(damage_debounce_time), F_FLOAT},
+	{"fly_sound_debounce_time", FOFS(fly_sound_debounce_time), F_FLOAT},
+	{"last_move_time", FOFS(last_move_time), F_FLOAT},
+
+	{"health", FOFS(health), F_INT},
+	{"max_health", FOFS(max_health), F_INT},
+	{"gib_health", FOFS(gib_health), F_INT},
+	{"deadflag", FOFS(deadflag), F_INT},
+	{"show_hostile", FOFS(show_hostile), F_INT},
+	{"powerarmor_time", FOFS(powerarmor_time), F_FLOAT},
+	{"map", FOFS(map), F_LSTRING},
+
+	{"viewheight", FOFS(viewheight), F_INT},
+	{"takedamage", FOFS(takedamage), F_INT},
+	{"dmg", FOFS(dmg), F_INT},
+	{"radius_dmg", FOFS(radius_dmg), F_INT},
+	{"dmg_radius", FOFS(dmg_radius), F_FLOAT},
+	{"sounds", FOFS(sounds), F_INT},
+	{"count", FOFS(count), F_INT},
+
+	{"chain", FOFS(chain), F_EDICT},
+	{"enemy", FOFS(enemy), F_EDICT},
+	{"oldenemy", FOFS(oldenemy), F_EDICT},
+	{"activator", FOFS(activator), F_EDICT},
+	{"groundentity", FOFS(groundentity), F_EDICT},
+	{"groundentity_linkcount", FOFS(groundentity_linkcount), F_INT},
+	{"teamchain", FOFS(teamchain), F_EDICT},
+	{"teammaster", FOFS(teammaster), F_EDICT},
+	{"mynoise", FOFS(mynoise), F_EDICT},
+	{"mynoise2", FOFS(mynoise2), F_EDICT},
+
+	{"camera_state", FOFS(camera_state), F_CAMERA},
+	{"rotate_train", FOFS(rotate_train), F_LBLOCK, 0, sizeof(rotate_train_state_t)},
+
+	{"noise_index", FOFS(noise_index), F_INT},
+	{"noise_index2", FOFS(noise_index2), F_INT},
+	{"volume", FOFS(volume), F_FLOAT},
+	{"attenuation", FOFS(attenuation), F_FLOAT},
+
+	{"wait", FOFS(wait), F_FLOAT},
+	{"delay", FOFS(delay), F_FLOAT},
+	{"random", FOFS(random), F_FLOAT},
+	{"duration", FOFS(duration), F_FLOAT},
+	{"rotate", FOFS(rotate), F_VECTOR},
+	{"rotate_speed", FOFS(rotate_speed), F_VECTOR},
+	{"duration_vector", FOFS(duration_vector), F_VECTOR},
+	{"teleport_time", FOFS(teleport_time), F_FLOAT},
+
+	{"watertype", FOFS(watertype), F_INT},
+	{"waterlevel", FOFS(waterlevel), F_INT},
+	{"move_origin", FOFS(move_origin), F_VECTOR},
+	{"move_angles", FOFS(move_angles), F_VECTOR},
+	{"light_level", FOFS(light_level), F_INT},
+	{"style", FOFS(style), F_INT},
+	{"item", FOFS(item), F_ITEM},
+
+	{"mission_controller", ACTOFS(controller), F_EDICT, FFL_ACTOREXT},
+	{"mission_last_controller", ACTOFS(last_controller), F_EDICT, FFL_ACTOREXT},
+	{"mission_prev_path", ACTOFS(prev_path), F_EDICT, FFL_ACTOREXT},
+	{"mission_path_target", ACTOFS(path_target), F_EDICT, FFL_ACTOREXT},
+	{"mission_script_target", ACTOFS(script_target), F_EDICT, FFL_ACTOREXT},
+	{"mission_controller_serial", ACTOFS(controller_serial), F_INT, FFL_ACTOREXT},
+	{"mission_path_toggle", ACTOFS(path_toggle), F_INT, FFL_ACTOREXT},
+	{"mission_controller_distance", ACTOFS(controller_distance), F_FLOAT, FFL_ACTOREXT},
+	{"mission_controller_resume", ACTOFS(controller_resume), F_FLOAT, FFL_ACTOREXT},
+	{"mission_path_wait", ACTOFS(path_wait_time), F_FLOAT, FFL_ACTOREXT},
+	{"mission_path_time", ACTOFS(path_time), F_FLOAT, FFL_ACTOREXT},
+	{"mission_path_speed", ACTOFS(path_speed), F_FLOAT, FFL_ACTOREXT},
+	{"mission_path_step_speed", ACTOFS(path_step_speed), F_FLOAT, FFL_ACTOREXT},
+	{"mission_path_remaining", ACTOFS(path_remaining), F_FLOAT, FFL_ACTOREXT},
+	{"mission_path_state", ACTOFS(path_state), F_INT, FFL_ACTOREXT},
+	{"mission_path_dir", ACTOFS(path_dir), F_VECTOR, FFL_ACTOREXT},
+	{"mission_path_velocity", ACTOFS(path_velocity), F_VECTOR, FFL_ACTOREXT},
+	{"mission_custom_name", ACTOFS(custom_name), F_LSTRING, FFL_ACTOREXT},
+	{"mission_custom_name_time", ACTOFS(custom_name_time), F_FLOAT, FFL_ACTOREXT},
+	{"mission_timer_start", MISOFS(mission_timer_remaining), F_INT, FFL_MISSIONEXT},
+	{"mission_timer_limit", MISOFS(mission_timer_limit), F_INT, FFL_MISSIONEXT},
+	{"mission_flags", MISOFS(mission_timer_cooldown), F_INT, FFL_MISSIONEXT},
+	{"mission_event", MISOFS(mission_state), F_INT, FFL_MISSIONEXT},
+	{"mission_origin", MISOFS(mission_origin), F_VECTOR, FFL_MISSIONEXT},
+	{"mission_angles", MISOFS(mission_angles), F_VECTOR, FFL_MISSIONEXT},
+	{"mission_velocity", MISOFS(mission_velocity), F_VECTOR, FFL_MISSIONEXT},
+	{"mission_blend", MISOFS(mission_blend), F_FLOAT, FFL_MISSIONEXT},
+	{"mission_radius", MISOFS(mission_radius), F_FLOAT, FFL_MISSIONEXT},
+	{"mission_id", MISOFS(mission_id), F_LSTRING, FFL_MISSIONEXT},
+	{"mission_title", MISOFS(mission_title), F_LSTRING, FFL_MISSIONEXT},
+	{"mission_text", MISOFS(mission_text), F_LSTRING, FFL_MISSIONEXT},
+	{"cyborg_anchor_time", CYBOFS(cyborg_anchor_time), F_FLOAT, FFL_CYBORGEXT},
+	{"cyborg_anchor_stage", CYBOFS(cyborg_anchor_stage), F_INT, FFL_CYBORGEXT},
+	{"cyborg_landing_thud", CYBOFS(cyborg_landing_thud), F_INT, FFL_CYBORGEXT},
+	{"spider_alt_idle", SPIOFS(spider_alt_idle), F_INT, FFL_SPIDEREXT},
+	{"spider_staggered", SPIOFS(spider_staggered), F_INT, FFL_SPIDEREXT},
+	{"spider_stagger_time", SPIOFS(spider_stagger_time), F_FLOAT, FFL_SPIDEREXT},
+	{"spider_combo_next", SPIOFS(spider_combo_next), F_INT, FFL_SPIDEREXT},
+	{"spider_combo_last", SPIOFS(spider_combo_last), F_INT, FFL_SPIDEREXT},
+	{"spider_combo_stage", SPIOFS(spider_combo_stage), F_INT, FFL_SPIDEREXT},
+	{"cyborg_pain_time", CYBOFS(cyborg_pain_time), F_FLOAT, FFL_CYBORGEXT},
+	{"cyborg_pain_slot", CYBOFS(cyborg_pain_slot), F_INT, FFL_CYBORGEXT},
+
+	{"moveinfo.start_origin", FOFS(moveinfo.start_origin), F_VECTOR},
+	{"moveinfo.start_angles", FOFS(moveinfo.start_angles), F_VECTOR},
+	{"moveinfo.end_origin", FOFS(moveinfo.end_origin), F_VECTOR},
+	{"moveinfo.end_angles", FOFS(moveinfo.end_angles), F_VECTOR},
+	{"moveinfo.sound_start", FOFS(moveinfo.sound_start), F_INT},
+	{"moveinfo.sound_middle", FOFS(moveinfo.sound_middle), F_INT},
+	{"moveinfo.sound_end", FOFS(moveinfo.sound_end), F_INT},
+	{"moveinfo.accel", FOFS(moveinfo.accel), F_FLOAT},
+	{"moveinfo.speed", FOFS(moveinfo.speed), F_FLOAT},
+	{"moveinfo.decel", FOFS(moveinfo.decel), F_FLOAT},
+	{"moveinfo.distance", FOFS(moveinfo.distance), F_FLOAT},
+	{"moveinfo.wait", FOFS(moveinfo.wait), F_FLOAT},
+	{"moveinfo.state", FOFS(moveinfo.state), F_INT},
+	{"moveinfo.dir", FOFS(moveinfo.dir), F_VECTOR},
+	{"moveinfo.current_speed", FOFS(moveinfo.current_speed), F_FLOAT},
+	{"moveinfo.move_speed", FOFS(moveinfo.move_speed), F_FLOAT},
+	{"moveinfo.next_speed", FOFS(moveinfo.next_speed), F_FLOAT},
+	{"moveinfo.remaining_distance", FOFS(moveinfo.remaining_distance), F_FLOAT},
+	{"moveinfo.decel_distance", FOFS(moveinfo.decel_distance), F_FLOAT},
+	{"endfunc", FOFS(moveinfo.endfunc), F_FUNCTION},
+
+	{"currentmove", FOFS(monsterinfo.currentmove), F_MMOVE},
+	{"monsterinfo.aiflags", FOFS(monsterinfo.aiflags), F_INT},
+	{"monsterinfo.nextframe", FOFS(monsterinfo.nextframe), F_INT},
+	{"monsterinfo.scale", FOFS(monsterinfo.scale), F_FLOAT},
+	{"monsterinfo.speed", FOFS(monsterinfo.speed), F_FLOAT},
+	{"stand", FOFS(monsterinfo.stand), F_FUNCTION},
+	{"idle", FOFS(monsterinfo.idle), F_FUNCTION},
+	{"search", FOFS(monsterinfo.search), F_FUNCTION},
+	{"walk", FOFS(monsterinfo.walk), F_FUNCTION},
+	{"run", FOFS(monsterinfo.run), F_FUNCTION},
+	{"dodge", FOFS(monsterinfo.dodge), F_FUNCTION},
+	{"attack", FOFS(monsterinfo.attack), F_FUNCTION},
+	{"melee", FOFS(monsterinfo.melee), F_FUNCTION},
+	{"sight", FOFS(monsterinfo.sight), F_FUNCTION},
+	{"checkattack", FOFS(monsterinfo.checkattack), F_FUNCTION},
+	{"monsterinfo.pausetime", FOFS(monsterinfo.pausetime), F_FLOAT},
+	{"monsterinfo.attack_finished", FOFS(monsterinfo.attack_finished), F_FLOAT},
+	{"monsterinfo.saved_goal", FOFS(monsterinfo.saved_goal), F_VECTOR},
+	{"monsterinfo.search_time", FOFS(monsterinfo.search_time), F_FLOAT},
+	{"monsterinfo.trail_time", FOFS(monsterinfo.trail_time), F_FLOAT},
+	{"monsterinfo.last_sighting", FOFS(monsterinfo.last_sighting), F_VECTOR},
+	{"monsterinfo.attack_state", FOFS(monsterinfo.attack_state), F_INT},
+	{"monsterinfo.lefty", FOFS(monsterinfo.lefty), F_INT},
+	{"monsterinfo.idle_time", FOFS(monsterinfo.idle_time), F_FLOAT},
+	{"monsterinfo.linkcount", FOFS(monsterinfo.linkcount), F_INT},
+	{"monsterinfo.power_armor_type", FOFS(monsterinfo.power_armor_type), F_INT},
+	{"monsterinfo.power_armor_power", FOFS(monsterinfo.power_armor_power), F_INT},
+	{"monsterinfo.max_ideal_distance", FOFS(monsterinfo.max_ideal_distance), F_FLOAT},
+
+	{NULL, 0, F_INT}
+};
+
+field_t		camerafields[] =
+{
+	{"active", CAMOFS(active), F_INT},
+	{"freeze_players", CAMOFS(freeze_players), F_INT},
+	{"default_wait", CAMOFS(default_wait), F_FLOAT},
+	{"wait_override", CAMOFS(wait_override), F_FLOAT},
+	{"stop_time", CAMOFS(stop_time), F_FLOAT},
+	{"speed", CAMOFS(speed), F_FLOAT},
+	{"duration", CAMOFS(duration), F_FLOAT},
+	{"initial_corner", CAMOFS(initial_corner), F_EDICT},
+	{"current_corner", CAMOFS(current_corner), F_EDICT},
+	{"target_corner", CAMOFS(target_corner), F_EDICT},
+	{"focus", CAMOFS(focus), F_EDICT},
+	{"track", CAMOFS(track), F_EDICT},
+	{"activator", CAMOFS(activator), F_EDICT},
+	{"move_start_time", CAMOFS(move_start_time), F_FLOAT},
+	{"move_duration", CAMOFS(move_duration), F_FLOAT},
+	{"move_start", CAMOFS(move_start), F_VECTOR},
+	{"move_end", CAMOFS(move_end), F_VECTOR},
+	{"start_angles", CAMOFS(start_angles), F_VECTOR},
+	{"end_angles", CAMOFS(end_angles), F_VECTOR},
+	{"has_angle_goal", CAMOFS(has_angle_goal), F_INT},
+	{"sound_loop", CAMOFS(sound_loop), F_INT},
+
+	{NULL, 0, F_INT}
+};
+
 field_t		levelfields[] =
 {
+	{"framenum", LLOFS(framenum), F_INT},
+	{"time", LLOFS(time), F_FLOAT},
+	{"level_name", LLOFS(level_name), F_BYTES, 0, MEMBER_SIZE(level_locals_t, level_name)},
+	{"mapname", LLOFS(mapname), F_BYTES, 0, MEMBER_SIZE(level_locals_t, mapname)},
+	{"nextmap", LLOFS(nextmap), F_BYTES, 0, MEMBER_SIZE(level_locals_t, nextmap)},
+	{"intermissiontime", LLOFS(intermissiontime), F_FLOAT},
 	{"changemap", LLOFS(changemap), F_LSTRING},
-                   
+	{"exitintermission", LLOFS(exitintermission), F_INT},
+	{"intermission_origin", LLOFS(intermission_origin), F_VECTOR},
+	{"intermission_angle", LLOFS(intermission_angle), F_VECTOR},
+
 	{"sight_client", LLOFS(sight_client), F_EDICT},
 	{"sight_entity", LLOFS(sight_entity), F_EDICT},
+	{"sight_entity_framenum", LLOFS(sight_entity_framenum), F_INT},
 	{"sound_entity", LLOFS(sound_entity), F_EDICT},
+	{"sound_entity_framenum", LLOFS(sound_entity_framenum), F_INT},
 	{"sound2_entity", LLOFS(sound2_entity), F_EDICT},
+	{"sound2_entity_framenum", LLOFS(sound2_entity_framenum), F_INT},
+
+	{"pic_health", LLOFS(pic_health), F_INT},
+	{"total_secrets", LLOFS(total_secrets), F_INT},
+	{"found_secrets", LLOFS(found_secrets), F_INT},
+	{"total_goals", LLOFS(total_goals), F_INT},
+	{"found_goals", LLOFS(found_goals), F_INT},
+	{"total_monsters", LLOFS(total_monsters), F_INT},
+	{"killed_monsters", LLOFS(killed_monsters), F_INT},
+	{"current_entity", LLOFS(current_entity), F_EDICT},
+	{"body_que", LLOFS(body_que), F_INT},
+	{"power_cubes", LLOFS(power_cubes), F_INT},
 
 	{NULL, 0, F_INT}
 };
 
+// client_persistant_t is saved twice, as pers and as resp.coop_respawn
+#define PERSFIELDS(p) \
+	{#p ".userinfo", CLOFS(p.userinfo), F_BYTES, 0, MAX_INFO_STRING}, \
+	{#p ".netname", CLOFS(p.netname), F_BYTES, 0, MEMBER_SIZE(gclient_t, p.netname)}, \
+	{#p ".hand", CLOFS(p.hand), F_INT}, \
+	{#p ".connected", CLOFS(p.connected), F_INT}, \
+	{#p ".health", CLOFS(p.health), F_INT}, \
+	{#p ".max_health", CLOFS(p.max_health), F_INT}, \
+	{#p ".savedFlags", CLOFS(p.savedFlags), F_INT}, \
+	{#p ".selected_item", CLOFS(p.selected_item), F_INT}, \
+	{#p ".inventory", CLOFS(p.inventory), F_BYTES, 0, MEMBER_SIZE(gclient_t, p.inventory)}, \
+	{#p ".max_bullets", CLOFS(p.max_bullets), F_INT}, \
+	{#p ".max_shells", CLOFS(p.max_shells), F_INT}, \
+	{#p ".max_rockets", CLOFS(p.max_rockets), F_INT}, \
+	{#p ".max_grenades", CLOFS(p.max_grenades), F_INT}, \
+	{#p ".max_cells", CLOFS(p.max_cells), F_INT}, \
+	{#p ".max_slugs", CLOFS(p.max_slugs), F_INT}, \
+	{#p ".max_mines", CLOFS(p.max_mines), F_INT}, \
+	{#p ".max_detpacks", CLOFS(p.max_detpacks), F_INT}, \
+	{#p ".max_dods", CLOFS(p.max_dods), F_INT}, \
+	{#p ".max_pistolplasma", CLOFS(p.max_pistolplasma), F_INT}, \
+	{#p ".max_rifleplasma", CLOFS(p.max_rifleplasma), F_INT}, \
+	{#p ".weapon", CLOFS(p.weapon), F_ITEM}, \
+	{#p ".lastweapon", CLOFS(p.lastweapon), F_ITEM}, \
+	{#p ".power_cubes", CLOFS(p.power_cubes), F_INT}, \
+	{#p ".score", CLOFS(p.score), F_INT}, \
+	{#p ".game_helpchanged", CLOFS(p.game_helpchanged), F_INT}, \
+	{#p ".helpchanged", CLOFS(p.helpchanged), F_INT}, \
+	{#p ".spectator", CLOFS(p.spectator), F_INT}
+
 field_t		clientfields[] =
 {
-	{"pers.weapon", CLOFS(pers.weapon), F_ITEM},
-	{"pers.lastweapon", CLOFS(pers.lastweapon), F_ITEM},
+	{"ps", CLOFS(ps), F_BYTES, 0, sizeof(player_state_t)},
+	{"ping", CLOFS(ping), F_INT},
+
+	PERSFIELDS(pers),
+	PERSFIELDS(resp.coop_respawn),
+	{"resp.enterframe", CLOFS(resp.enterframe), F_INT},
+	{"resp.score", CLOFS(resp.score), F_INT},
+	{"resp.cmd_angles", CLOFS(resp.cmd_angles), F_VECTOR},
+	{"resp.spectator", CLOFS(resp.spectator), F_INT},
+	{"old_pmove", CLOFS(old_pmove), F_BYTES, 0, sizeof(pmove_state_t)},
+
+	{"showscores", CLOFS(showscores), F_INT},
+	{"showinventory", CLOFS(showinventory), F_INT},
+	{"showhelp", CLOFS(showhelp), F_INT},
+	{"showhelpicon", CLOFS(showhelpicon), F_INT},
+	{"ammo_index", CLOFS(ammo_index), F_INT},
+	{"buttons", CLOFS(buttons), F_INT},
+	{"oldbuttons", CLOFS(oldbuttons), F_INT},
+	{"latched_buttons", CLOFS(latched_buttons), F_INT},
+	{"weapon_thunk", CLOFS(weapon_thunk), F_INT},
 	{"newweapon", CLOFS(newweapon), F_ITEM},
-	{"rtdu.next_use_time", CLOFS(rtdu.next_use_time), F_FLOAT},
+	{"plasma_pistol_next_regen", CLOFS(plasma_pistol_next_regen), F_FLOAT},
+	{"plasma_rifle_next_regen", CLOFS(plasma_rifle_next_regen), F_FLOAT},
+
+	{"damage_armor", CLOFS(damage_armor), F_INT},
+	{"damage_parmor", CLOFS(damage_parmor), F_INT},
+	{"damage_blood", CLOFS(damage_blood), F_INT},
+	{"damage_knockback", CLOFS(damage_knockback), F_INT},
+	{"damage_from", CLOFS(damage_from), F_VECTOR},
+	{"killer_yaw", CLOFS(killer_yaw), F_FLOAT},
+
+	{"weaponstate", CLOFS(weaponstate), F_INT},
+	{"kick_angles", CLOFS(kick_angles), F_VECTOR},
+	{"kick_origin", CLOFS(kick_origin), F_VECTOR},
+	{"v_dmg_roll", CLOFS(v_dmg_roll), F_FLOAT},
+	{"v_dmg_pitch", CLOFS(v_dmg_pitch), F_FLOAT},
+	{"v_dmg_time", CLOFS(v_dmg_time), F_FLOAT},
+	{"fall_time", CLOFS(fall_time), F_FLOAT},
+	{"fall_value", CLOFS(fall_value), F_FLOAT},
+	{"damage_alpha", CLOFS(damage_alpha), F_FLOAT},
+	{"bonus_alpha", CLOFS(bonus_alpha), F_FLOAT},
+	{"damage_blend", CLOFS(damage_blend), F_VECTOR},
+	{"v_angle", CLOFS(v_angle), F_VECTOR},
+	{"bobtime", CLOFS(bobtime), F_FLOAT},
+	{"oldviewangles", CLOFS(oldviewangles), F_VECTOR},
+	{"oldvelocity", CLOFS(oldvelocity), F_VECTOR},
+
+	{"next_drown_time", CLOFS(next_drown_time), F_FLOAT},
+	{"old_waterlevel", CLOFS(old_waterlevel), F_INT},
+	{"breather_sound", CLOFS(breather_sound), F_INT},
+	{"machinegun_shots", CLOFS(machinegun_shots), F_INT},
+
+	{"anim_end", CLOFS(anim_end), F_INT},
+	{"anim_priority", CLOFS(anim_priority), F_INT},
+	{"anim_duck", CLOFS(anim_duck), F_INT},
+	{"anim_run", CLOFS(anim_run), F_INT},
+
+	{"quad_framenum", CLOFS(quad_framenum), F_FLOAT},
+	{"invincible_framenum", CLOFS(invincible_framenum), F_FLOAT},
+	{"breather_framenum", CLOFS(breather_framenum), F_FLOAT},
+	{"enviro_framenum", CLOFS(enviro_framenum), F_FLOAT},
+
+	{"grenade_blew_up", CLOFS(grenade_blew_up), F_INT},
+	{"grenade_time", CLOFS(grenade_time), F_FLOAT},
+	{"silencer_shots", CLOFS(silencer_shots), F_INT},
+	{"weapon_sound", CLOFS(weapon_sound), F_INT},
+	{"pickup_msg_time", CLOFS(pickup_msg_time), F_FLOAT},
+
+	{"flood_locktill", CLOFS(flood_locktill), F_FLOAT},
+	{"respawn_time", CLOFS(respawn_time), F_FLOAT},
+
+	{"chase_target", CLOFS(chase_target), F_EDICT},
+	{"update_chase", CLOFS(update_chase), F_INT},
 	{"rtdu.turret", CLOFS(rtdu.turret), F_EDICT},
+	{"rtdu.next_use_time", CLOFS(rtdu.next_use_time), F_FLOAT},
+	{"camera", CLOFS(camera), F_EDICT},
+	{"camera_freeze", CLOFS(camera_freeze), F_INT},
+	{"camera_endtime", CLOFS(camera_endtime), F_FLOAT},
+
+	{NULL, 0, F_INT}
+};
+
+field_t		gamefields[] =
+{
+	{"helpmessage1", GAOFS(helpmessage1), F_BYTES, 0, MEMBER_SIZE(game_locals_t, helpmessage1)},
+	{"helpmessage2", GAOFS(helpmessage2), F_BYTES, 0, MEMBER_SIZE(game_locals_t, helpmessage2)},
+	{"helpchanged", GAOFS(helpchanged), F_INT},
+	{"spawnpoint", GAOFS(spawnpoint), F_BYTES, 0, MEMBER_SIZE(game_locals_t, spawnpoint)},
+	{"maxclients", GAOFS(maxclients), F_INT},
+	{"maxentities", GAOFS(maxentities), F_INT},
+	{"serverflags", GAOFS(serverflags), F_INT},
+	{"num_items", GAOFS(num_items), F_INT},
+	{"mission", GAOFS(mission), F_BYTES, 0, sizeof(mission_state_t)},
+	{"autosaved", GAOFS(autosaved), F_INT},
 
 	{NULL, 0, F_INT}
 };
@@ -194,6 +611,8 @@ void InitGame (void)
 {
 	gi.dprintf ("==== InitGame ====\n");
 
+	G_SeedRand ((unsigned)time (NULL));
+
 	gun_x = gi.cvar ("gun_x", "0", 0);
 	gun_y = gi.cvar ("gun_y", "0", 0);
 	gun_z = gi.cvar ("gun_z", "0", 0);
@@ -243,6 +662,53 @@ void InitGame (void)
 	// dm map list
 	sv_maplist = gi.cvar ("sv_maplist", "", 0);
 
+	// deferred radius damage
+	g_explosion_queue = gi.cvar ("g_explosion_queue", "1", 0);
+	g_explosion_budget = gi.cvar ("g_explosion_budget", "0", 0);
+	g_radius_stats = gi.cvar ("g_radius_stats", "0", 0);
+
+	// per-target damage effects and pain, once per frame
+	g_damage_aggregate = gi.cvar ("g_damage_aggregate", "0", 0);
+
+	// temp entity batching
+	g_te_batch = gi.cvar ("g_te_batch", "1", 0);
+	g_te_pvs_budget = gi.cvar ("g_te_pvs_budget", "0", 0);
+	g_te_client_budget = gi.cvar ("g_te_client_budget", "0", 0);
+	g_te_stats = gi.cvar ("g_te_stats", "0", 0);
+
+	// skip re-tracing target_laser beams nothing has moved through
+	g_laser_cache = gi.cvar ("g_laser_cache", "1", 0);
+
+	// write level and game files from a memory snapshot on a worker thread
+	g_async_save = gi.cvar ("g_async_save", "1", 0);
+
+	// hub levels kept in memory between visits
+	g_hub_cache = gi.cvar ("g_hub_cache", "4", 0);
+
+	// cached hub levels only hold what changed since SpawnEntities
+	g_delta_saves = gi.cvar ("g_delta_saves", "1", 0);
+
+	// seconds between in-memory rewind snapshots
+	g_rewind = gi.cvar ("g_rewind", "0", 0);
+	// quicksave, quickload and rewind for the listen server's host in coop
+	g_coop_snapshots = gi.cvar ("g_coop_snapshots", "0", 0);
+	// reuse compiled map entity strings
+	g_entcache = gi.cvar ("g_entcache", "1", 0);
+
+	// worker threads for the clients' end of frame view work, 0 for none
+	g_client_threads = gi.cvar ("g_client_threads", "0", 0);
+
+	// client command token buckets, "rate burst" per second
+	g_rate_layout = gi.cvar ("g_rate_layout", "2 6", 0);
+	g_rate_gesture = gi.cvar ("g_rate_gesture", "1 3", 0);
+	g_rate_userinfo = gi.cvar ("g_rate_userinfo", "2 8", 0);
+	g_rate_gameplay = gi.cvar ("g_rate_gameplay", "20 40", 0);
+	g_rate_command = gi.cvar ("g_rate_command", "20 40", 0);
+	g_rate_connect = gi.cvar ("g_rate_connect", "4 32", 0);
+	g_rate_connect_ip = gi.cvar ("g_rate_connect_ip", "1 4", 0);
+	// most client commands run in one server frame, 0 for no cap
+	g_rate_frame = gi.cvar ("g_rate_frame", "64", 0);
+
         // items
         InitItems ();
 
@@ -254,238 +720,460 @@ void InitGame (void)
 
         // initialize all entities for this game
 	game.maxentities = maxentities->value;
-	g_edicts =  gi.TagMalloc (game.maxentities * sizeof(g_edicts[0]), TAG_GAME);
+	g_edicts =  G_TagMalloc (game.maxentities * sizeof(g_edicts[0]), TAG_GAME, "edicts");
 	globals.edicts = g_edicts;
+	G_AllocHotEdicts ();
 	globals.max_edicts = game.maxentities;
 
 	// initialize all clients for this game
 	game.maxclients = maxclients->value;
-	game.clients = gi.TagMalloc (game.maxclients * sizeof(game.clients[0]), TAG_GAME);
+	game.clients = G_TagMalloc (game.maxclients * sizeof(game.clients[0]), TAG_GAME, "clients");
 	globals.num_edicts = game.maxclients+1;
 }
 
 //=========================================================
 
-void WriteField1 (FILE *f, field_t *field, byte *base)
+#define	SAVE_MAGIC			(('V'<<24)+('S'<<16)+('B'<<8)+'O')	// "OBSV"
+#define	SAVE_VERSION		3
+#define	SAVE_END_RECORD		-1
+#define	MAX_SCHEMA_FIELDS	256
+
+// a field as it was written in the file being loaded
+typedef struct
+{
+	field_t		*field;			// NULL if this build doesn't have it
+	int			type;
+	int			size;
+} schemafield_t;
+
+typedef struct
 {
-	void		*p;
-	int			len;
-	int			index;
+	int				count;
+	schemafield_t	fields[MAX_SCHEMA_FIELDS];
+} saveschema_t;
+
+static saveschema_t	schema_game, schema_client;
+static saveschema_t	schema_level, schema_edict, schema_camera;
+
+// camera_state records nested in the edict records being read
+static saveschema_t	*record_camera = &schema_camera;
 
+static qboolean Save_FieldSaved (field_t *field)
+{
 	if (field->flags & FFL_SPAWNTEMP)
-		return;
+		return false;
+	return field->type != F_IGNORE && field->type != F_ANGLEHACK;
+}
+
+/*
+=================
+Save_FieldMemSize
 
-	p = (void *)(base + field->ofs);
+Bytes the field occupies in its structure.
+=================
+*/
+static int Save_FieldMemSize (field_t *field)
+{
 	switch (field->type)
 	{
 	case F_INT:
 	case F_FLOAT:
-	case F_ANGLEHACK:
+		return 4;
 	case F_VECTOR:
-	case F_IGNORE:
+		return sizeof(vec3_t);
+	case F_BYTES:
+		return field->size;
+	default:
+		return sizeof(void *);
+	}
+}
+
+/*
+=================
+Save_FieldBase
+
+Edict fields kept in an extension table are saved from the edict's
+entry, if it has one, and loaded into a new one.
+=================
+*/
+static byte *Save_FieldBase (field_t *field, byte *base, qboolean alloc)
+{
+	int		ext;
+
+	ext = G_FieldExt (field);
+	if (ext < 0)
+		return base;
+	if (alloc)
+		return G_EdictExt ((edict_t *)base, ext);
+	return G_FindEdictExt ((edict_t *)base, ext);
+}
+
+static qboolean Save_FieldIsDefault (field_t *field, byte *base)
+{
+	byte	*p;
+	int		i, size;
+
+	base = Save_FieldBase (field, base, false);
+	if (!base)
+		return true;
+	p = base + field->ofs;
+	size = Save_FieldMemSize (field);
+	for (i=0 ; i<size ; i++)
+		if (p[i])
+			return false;
+	return true;
+}
+
+/*
+=================
+Save_WriteSchema
+
+Names, types and sizes of every saved field, in record index order.
+=================
+*/
+static void Save_WriteSchema (savestream_t *s, field_t *table)
+{
+	field_t	*field;
+	int		count;
+
+	count = 0;
+	for (field=table ; field->name ; field++)
+		if (Save_FieldSaved (field))
+			count++;
+	SaveStream_WriteShort (s, count);
+
+	for (field=table ; field->name ; field++)
+	{
+		if (!Save_FieldSaved (field))
+			continue;
+		SaveStream_WriteString (s, field->name);
+		SaveStream_WriteByte (s, field->type);
+		SaveStream_WriteInt (s, field->size);
+	}
+}
+
+/*
+=================
+Save_ReadSchema
+
+Matches each field in the file to this build's table by name.
+=================
+*/
+static void Save_ReadSchema (savestream_t *s, field_t *table, saveschema_t *schema)
+{
+	schemafield_t	*sf;
+	field_t			*field;
+	char			name[MAX_QPATH];
+	int				i;
+
+	schema->count = SaveStream_ReadShort (s);
+	if (schema->count < 0 || schema->count > MAX_SCHEMA_FIELDS)
+		gi.error ("%s: bad schema", s->filename);
+
+	for (i=0, sf=schema->fields ; i<schema->count ; i++, sf++)
+	{
+		SaveStream_ReadName (s, name, sizeof(name));
+		sf->type = SaveStream_ReadByte (s);
+		sf->size = SaveStream_ReadInt (s);
+		sf->field = NULL;
+
+		for (field=table ; field->name ; field++)
+		{
+			if (!Save_FieldSaved (field) || strcmp (field->name, name))
+				continue;
+			if (field->type == sf->type)
+				sf->field = field;
+			break;
+		}
+
+		if (!sf->field)
+			gi.dprintf ("%s: ignoring saved field %s\n", s->filename, name);
+	}
+}
+
+/*
+=================
+Save_NativeSchema
+
+The schema this build writes, for reading records it wrote itself.
+=================
+*/
+static void Save_NativeSchema (field_t *table, saveschema_t *schema)
+{
+	schemafield_t	*sf;
+	field_t			*field;
+
+	schema->count = 0;
+	for (field=table ; field->name ; field++)
+	{
+		if (!Save_FieldSaved (field))
+			continue;
+		sf = &schema->fields[schema->count++];
+		sf->field = field;
+		sf->type = field->type;
+		sf->size = field->size;
+	}
+}
+
+static void Save_WriteRecord (savestream_t *s, field_t *table, byte *base);
+static void Save_ReadRecord (savestream_t *s, saveschema_t *schema, byte *base);
+static void Save_SkipRecord (savestream_t *s, saveschema_t *schema);
+
+static void Save_WriteFieldData (savestream_t *s, field_t *field, byte *base)
+{
+	void	*p;
+	edict_t	*ent;
+	int		index;
+
+	p = (void *)(Save_FieldBase (field, base, false) + field->ofs);
+	switch (field->type)
+	{
+	case F_INT:
+	case F_FLOAT:
+		SaveStream_Write (s, p, 4);
+		break;
+	case F_VECTOR:
+		SaveStream_Write (s, p, sizeof(vec3_t));
+		break;
+	case F_BYTES:
+		SaveStream_Write (s, p, field->size);
 		break;
 
 	case F_LSTRING:
 	case F_GSTRING:
-		if ( *(char **)p )
-			len = strlen(*(char **)p) + 1;
-		else
-			len = 0;
-		*(int *)p = len;
+		SaveStream_WriteString (s, *(char **)p);
 		break;
 	case F_EDICT:
-		if ( *(edict_t **)p == NULL)
-			index = -1;
-		else
-			index = *(edict_t **)p - g_edicts;
-		*(int *)p = index;
+		ent = *(edict_t **)p;
+		if (ent < g_edicts || ent >= g_edicts + game.maxentities)
+			gi.error ("%s: %s doesn't point at an edict", s->filename, field->name);
+		index = ent - g_edicts;
+		SaveStream_WriteInt (s, index);
 		break;
 	case F_CLIENT:
-		if ( *(gclient_t **)p == NULL)
-			index = -1;
-		else
-			index = *(gclient_t **)p - game.clients;
-		*(int *)p = index;
+		index = *(gclient_t **)p - game.clients;
+		SaveStream_WriteInt (s, index);
 		break;
 	case F_ITEM:
-		if ( *(edict_t **)p == NULL)
-			index = -1;
-		else
-			index = *(gitem_t **)p - itemlist;
-		*(int *)p = index;
+		index = *(gitem_t **)p - itemlist;
+		SaveStream_WriteInt (s, index);
 		break;
 
 	//relative to code segment
 	case F_FUNCTION:
-		if (*(byte **)p == NULL)
-			index = 0;
-		else
-			index = *(byte **)p - ((byte *)InitGame);
-		*(int *)p = index;
+		index = *(byte **)p - ((byte *)InitGame);
+		SaveStream_WriteInt (s, index);
 		break;
 
 	//relative to data segment
 	case F_MMOVE:
-		if (*(byte **)p == NULL)
-			index = 0;
-		else
-			index = *(byte **)p - (byte *)&mmove_reloc;
-		*(int *)p = index;
+		index = *(byte **)p - (byte *)&mmove_reloc;
+		SaveStream_WriteInt (s, index);
 		break;
 
-	default:
-		gi.error ("WriteEdict: unknown field type");
-	}
-}
-
-
-void WriteField2 (FILE *f, field_t *field, byte *base)
-{
-	int			len;
-	void		*p;
-
-	if (field->flags & FFL_SPAWNTEMP)
-		return;
-
-	p = (void *)(base + field->ofs);
-	switch (field->type)
-	{
-	case F_LSTRING:
-		if ( *(char **)p )
-		{
-			len = strlen(*(char **)p) + 1;
-			fwrite (*(char **)p, len, 1, f);
-		}
+	case F_LBLOCK:
+		SaveStream_Write (s, *(byte **)p, field->size);
+		break;
+	case F_CAMERA:
+		Save_WriteRecord (s, camerafields, *(byte **)p);
 		break;
+
+	default:
+		gi.error ("Save_WriteFieldData: unknown field type");
 	}
 }
 
-void ReadField (FILE *f, field_t *field, byte *base)
+static void Save_ReadFieldData (savestream_t *s, field_t *field, int size, byte *base)
 {
-	void		*p;
-	int			len;
-	int			index;
+	void	*p;
+	int		index;
 
-	if (field->flags & FFL_SPAWNTEMP)
-		return;
-
-	p = (void *)(base + field->ofs);
+	p = (void *)(Save_FieldBase (field, base, true) + field->ofs);
 	switch (field->type)
 	{
 	case F_INT:
 	case F_FLOAT:
-	case F_ANGLEHACK:
+		SaveStream_Read (s, p, 4);
+		break;
 	case F_VECTOR:
-	case F_IGNORE:
+		SaveStream_Read (s, p, sizeof(vec3_t));
 		break;
-
-	case F_LSTRING:
-		len = *(int *)p;
-		if (!len)
-			*(char **)p = NULL;
-		else
+	case F_BYTES:
+		// a fixed array that has changed size keeps what still fits
+		if (size > field->size)
 		{
-			*(char **)p = gi.TagMalloc (len, TAG_LEVEL);
-			fread (*(char **)p, len, 1, f);
+			SaveStream_Read (s, p, field->size);
+			SaveStream_Skip (s, size - field->size);
 		}
+		else
+			SaveStream_Read (s, p, size);
+		break;
+
+	case F_LSTRING:
+		*(char **)p = SaveStream_ReadString (s, TAG_LEVEL);
+		break;
+	case F_GSTRING:
+		*(char **)p = SaveStream_ReadString (s, TAG_GAME);
 		break;
 	case F_EDICT:
-		index = *(int *)p;
-		if ( index == -1 )
-			*(edict_t **)p = NULL;
-		else
-			*(edict_t **)p = &g_edicts[index];
+		index = SaveStream_ReadInt (s);
+		if (index < 0 || index >= game.maxentities)
+			gi.error ("%s: bad edict index", s->filename);
+		*(edict_t **)p = &g_edicts[index];
 		break;
 	case F_CLIENT:
-		index = *(int *)p;
-		if ( index == -1 )
-			*(gclient_t **)p = NULL;
-		else
-			*(gclient_t **)p = &game.clients[index];
+		index = SaveStream_ReadInt (s);
+		if (index < 0 || index >= game.maxclients)
+			gi.error ("%s: bad client index", s->filename);
+		*(gclient_t **)p = &game.clients[index];
 		break;
 	case F_ITEM:
-		index = *(int *)p;
-		if ( index == -1 )
-			*(gitem_t **)p = NULL;
-		else
-			*(gitem_t **)p = &itemlist[index];
+		index = SaveStream_ReadInt (s);
+		if (index < 0 || index >= game.num_items)
+			gi.error ("%s: bad item index", s->filename);
+		*(gitem_t **)p = &itemlist[index];
 		break;
 
 	//relative to code segment
 	case F_FUNCTION:
-		index = *(int *)p;
-		if ( index == 0 )
-			*(byte **)p = NULL;
-		else
-			*(byte **)p = ((byte *)InitGame) + index;
+		index = SaveStream_ReadInt (s);
+		*(byte **)p = ((byte *)InitGame) + index;
 		break;
 
 	//relative to data segment
 	case F_MMOVE:
-		index = *(int *)p;
-		if (index == 0)
-			*(byte **)p = NULL;
-		else
-			*(byte **)p = (byte *)&mmove_reloc + index;
+		index = SaveStream_ReadInt (s);
+		*(byte **)p = (byte *)&mmove_reloc + index;
+		break;
+
+	case F_LBLOCK:
+		if (size != field->size)
+			gi.error ("%s: %s has changed size", s->filename, field->name);
+		*(byte **)p = G_TagMalloc (size, TAG_LEVEL, field->name);
+		SaveStream_Read (s, *(byte **)p, size);
+		break;
+	case F_CAMERA:
+		*(byte **)p = G_TagMalloc (sizeof(camera_state_t), TAG_LEVEL, "camera");
+		memset (*(byte **)p, 0, sizeof(camera_state_t));
+		Save_ReadRecord (s, record_camera, *(byte **)p);
 		break;
 
 	default:
-		gi.error ("ReadEdict: unknown field type");
+		gi.error ("Save_ReadFieldData: unknown field type");
 	}
 }
 
-//=========================================================
+static void Save_SkipFieldData (savestream_t *s, schemafield_t *sf)
+{
+	switch (sf->type)
+	{
+	case F_VECTOR:
+		SaveStream_Skip (s, sizeof(vec3_t));
+		break;
+	case F_BYTES:
+	case F_LBLOCK:
+		SaveStream_Skip (s, sf->size);
+		break;
+	case F_LSTRING:
+	case F_GSTRING:
+		SaveStream_Skip (s, SaveStream_ReadInt (s));
+		break;
+	case F_CAMERA:
+		Save_SkipRecord (s, record_camera);
+		break;
+	default:
+		SaveStream_Skip (s, 4);
+		break;
+	}
+}
 
 /*
-==============
-WriteClient
+=================
+Save_WriteRecord
 
-All pointer variables (except function pointers) must be handled specially.
-==============
+Writes each non-zero field as its schema index followed by its data.
+=================
 */
-void WriteClient (FILE *f, gclient_t *client)
+static void Save_WriteRecord (savestream_t *s, field_t *table, byte *base)
 {
-	field_t		*field;
-	gclient_t	temp;
-	
-	// all of the ints, floats, and vectors stay as they are
-	temp = *client;
+	field_t	*field;
+	int		index;
 
-	// change the pointers to lengths or indexes
-	for (field=clientfields ; field->name ; field++)
+	index = 0;
+	for (field=table ; field->name ; field++)
 	{
-		WriteField1 (f, field, (byte *)&temp);
+		if (!Save_FieldSaved (field))
+			continue;
+		if (!Save_FieldIsDefault (field, base))
+		{
+			SaveStream_WriteShort (s, index);
+			Save_WriteFieldData (s, field, base);
+		}
+		index++;
 	}
+	SaveStream_WriteShort (s, SAVE_END_RECORD);
+}
 
-	// write the block
-	fwrite (&temp, sizeof(temp), 1, f);
+/*
+=================
+Save_ReadRecord
 
-	// now write any allocated data following the edict
-	for (field=clientfields ; field->name ; field++)
+The structure must already be cleared; fields that weren't written stay zero.
+=================
+*/
+static void Save_ReadRecord (savestream_t *s, saveschema_t *schema, byte *base)
+{
+	schemafield_t	*sf;
+	int				index;
+
+	while (1)
 	{
-		WriteField2 (f, field, (byte *)client);
+		index = SaveStream_ReadShort (s);
+		if (index == SAVE_END_RECORD)
+			break;
+		if (index < 0 || index >= schema->count)
+			gi.error ("%s: bad field index", s->filename);
+
+		sf = &schema->fields[index];
+		if (sf->field)
+			Save_ReadFieldData (s, sf->field, sf->size, base);
+		else
+			Save_SkipFieldData (s, sf);
 	}
 }
 
-/*
-==============
-ReadClient
-
-All pointer variables (except function pointers) must be handled specially.
-==============
-*/
-void ReadClient (FILE *f, gclient_t *client)
+static void Save_SkipRecord (savestream_t *s, saveschema_t *schema)
 {
-	field_t		*field;
+	int		index;
 
-	fread (client, sizeof(*client), 1, f);
+	while (1)
+	{
+		index = SaveStream_ReadShort (s);
+		if (index == SAVE_END_RECORD)
+			break;
+		if (index < 0 || index >= schema->count)
+			gi.error ("%s: bad field index", s->filename);
+		Save_SkipFieldData (s, &schema->fields[index]);
+	}
+}
 
-	for (field=clientfields ; field->name ; field++)
+static void Save_WriteHeader (savestream_t *s)
+{
+	SaveStream_WriteInt (s, SAVE_MAGIC);
+	SaveStream_WriteInt (s, SAVE_VERSION);
+}
+
+static void Save_ReadHeader (savestream_t *s)
+{
+	if (SaveStream_ReadInt (s) != SAVE_MAGIC || SaveStream_ReadInt (s) != SAVE_VERSION)
 	{
-		ReadField (f, field, (byte *)client);
+		SaveStream_Close (s);
+		gi.error ("Savegame from an older version.\n");
 	}
 }
 
+//=========================================================
+
 /*
 ============
 WriteGame
@@ -502,167 +1190,237 @@ last save position.
 */
 void WriteGame (char *filename, qboolean autosave)
 {
-	FILE	*f;
-	int		i;
-	char	str[16];
+	savestream_t	s;
+	int				i;
+	char			str[16];
 
 	if (!autosave)
 		SaveClientData ();
 
-	f = fopen (filename, "wb");
-	if (!f)
-		gi.error ("Couldn't open %s", filename);
+	SaveStream_OpenSnapshot (&s, filename);
+	Save_WriteHeader (&s);
 
 	memset (str, 0, sizeof(str));
 	strcpy (str, __DATE__);
-	fwrite (str, sizeof(str), 1, f);
+	SaveStream_Write (&s, str, sizeof(str));
+
+	Save_WriteSchema (&s, gamefields);
+	Save_WriteSchema (&s, clientfields);
 
 	game.autosaved = autosave;
-	fwrite (&game, sizeof(game), 1, f);
+	Save_WriteRecord (&s, gamefields, (byte *)&game);
 	game.autosaved = false;
 
 	for (i=0 ; i<game.maxclients ; i++)
-		WriteClient (f, &game.clients[i]);
+		Save_WriteRecord (&s, clientfields, (byte *)&game.clients[i]);
 
-	fclose (f);
+	SaveStream_Close (&s);
+
+	// the server copies the whole save directory as soon as we return
+	SaveStream_Barrier (NULL);
 }
 
 void ReadGame (char *filename)
 {
-	FILE	*f;
-	int		i;
-	char	str[16];
+	savestream_t	s;
+	int				i;
+	char			str[16];
 
-	gi.FreeTags (TAG_GAME);
+	// the save directory now holds a different game
+	LevelCache_Clear ();
+	G_ResetSnapshots ();
+	G_FreeTags (TAG_GAME);
 
-	f = fopen (filename, "rb");
-	if (!f)
-		gi.error ("Couldn't open %s", filename);
+	SaveStream_OpenRead (&s, filename);
+	Save_ReadHeader (&s);
 
-	fread (str, sizeof(str), 1, f);
+	SaveStream_Read (&s, str, sizeof(str));
+	str[sizeof(str)-1] = 0;
 	if (strcmp (str, __DATE__))
 	{
-		fclose (f);
+		SaveStream_Close (&s);
 		gi.error ("Savegame from an older version.\n");
 	}
 
-	g_edicts =  gi.TagMalloc (game.maxentities * sizeof(g_edicts[0]), TAG_GAME);
+	g_edicts =  G_TagMalloc (game.maxentities * sizeof(g_edicts[0]), TAG_GAME, "edicts");
 	globals.edicts = g_edicts;
+	G_AllocHotEdicts ();
+
+	Save_ReadSchema (&s, gamefields, &schema_game);
+	Save_ReadSchema (&s, clientfields, &schema_client);
 
-        fread (&game, sizeof(game), 1, f);
-        game.clients = gi.TagMalloc (game.maxclients * sizeof(game.clients[0]), TAG_GAME);
-        for (i=0 ; i<game.maxclients ; i++)
-                ReadClient (f, &game.clients[i]);
+	memset (&game, 0, sizeof(game));
+	Save_ReadRecord (&s, &schema_game, (byte *)&game);
+
+	game.clients = G_TagMalloc (game.maxclients * sizeof(game.clients[0]), TAG_GAME, "clients");
+	for (i=0 ; i<game.maxclients ; i++)
+	{
+		memset (&game.clients[i], 0, sizeof(game.clients[i]));
+		Save_ReadRecord (&s, &schema_client, (byte *)&game.clients[i]);
+	}
 
-        Mission_OnGameLoaded ();
+	Mission_OnGameLoaded ();
 
-        fclose (f);
+	SaveStream_Close (&s);
 }
 
 //==========================================================
 
 
 /*
-==============
-WriteEdict
+==============================================================================
+
+SPAWN BASELINE
+
+Most of a saved level is exactly what SpawnEntities created: lights,
+path_corners, brush models that never moved.  G_CaptureSpawnBaseline
+encodes every entity once, right after the map is spawned, and WriteLevel
+then only writes the entities whose record differs from that, followed by
+the baseline entities that have been freed since.
+
+Only the hub cache image (g_levelcache.c) is a delta.  It carries a hash
+of the baseline it was written against, and the map is always spawned
+again before ReadLevel, which rebuilds the untouched entities from the
+new baseline.  Spawn functions draw from the game's generator seeded from
+the map and skill, so the same map spawns the same way.  An image whose
+hash doesn't match (the map changed underneath the game) isn't used.
 
-All pointer variables (except function pointers) must be handled specially.
-==============
+The file is always written whole, so a save still loads after the map or
+the game has been updated.  Deathmatch levels get no baseline.
+
+==============================================================================
 */
-void WriteEdict (FILE *f, edict_t *ent)
-{
-	field_t		*field;
-	edict_t		temp;
 
-	// all of the ints, floats, and vectors stay as they are
-	temp = *ent;
+typedef struct
+{
+	char		mapname[MAX_QPATH];
+	byte		*data;
+	int			size;
+	int			*ofs;			// record of each entity in data
+	int			*len;			// 0 if the entity wasn't in use
+	unsigned	hash;
+} spawnbaseline_t;
 
-	// change the pointers to lengths or indexes
-	for (field=fields ; field->name ; field++)
-	{
-		WriteField1 (f, field, (byte *)&temp);
-	}
+static spawnbaseline_t	spawn_baseline;
 
-	// write the block
-	fwrite (&temp, sizeof(temp), 1, f);
+static unsigned Save_Hash (unsigned hash, byte *data, int size)
+{
+	int		i;
 
-	// now write any allocated data following the edict
-	for (field=fields ; field->name ; field++)
+	for (i=0 ; i<size ; i++)
 	{
-		WriteField2 (f, field, (byte *)ent);
+		hash ^= data[i];
+		hash *= 16777619u;
 	}
+	return hash;
+}
 
+void G_FreeSpawnBaseline (void)
+{
+	free (spawn_baseline.data);
+	free (spawn_baseline.ofs);
+	free (spawn_baseline.len);
+	memset (&spawn_baseline, 0, sizeof(spawn_baseline));
 }
 
 /*
-==============
-WriteLevelLocals
+=================
+G_CaptureSpawnBaseline
 
-All pointer variables (except function pointers) must be handled specially.
-==============
+Called at the end of SpawnEntities.
+=================
 */
-void WriteLevelLocals (FILE *f)
+void G_CaptureSpawnBaseline (void)
 {
-	field_t		*field;
-	level_locals_t		temp;
+	savestream_t	s;
+	edict_t			*ent;
+	int				i, start;
 
-	// all of the ints, floats, and vectors stay as they are
-	temp = level;
+	G_FreeSpawnBaseline ();
 
-	// change the pointers to lengths or indexes
-	for (field=levelfields ; field->name ; field++)
+	spawn_baseline.ofs = malloc (game.maxentities * sizeof(int));
+	spawn_baseline.len = malloc (game.maxentities * sizeof(int));
+	if (!spawn_baseline.ofs || !spawn_baseline.len)
 	{
-		WriteField1 (f, field, (byte *)&temp);
+		G_FreeSpawnBaseline ();
+		return;
 	}
+	memset (spawn_baseline.len, 0, game.maxentities * sizeof(int));
 
-	// write the block
-	fwrite (&temp, sizeof(temp), 1, f);
-
-	// now write any allocated data following the edict
-	for (field=levelfields ; field->name ; field++)
+	SaveStream_OpenSnapshot (&s, "baseline");
+	for (i=0 ; i<globals.num_edicts ; i++)
 	{
-		WriteField2 (f, field, (byte *)&level);
+		ent = &g_edicts[i];
+		if (!ent->inuse)
+			continue;
+		SaveStream_SnapshotData (&s, &start);
+		Save_WriteRecord (&s, savefields, (byte *)ent);
+		SaveStream_SnapshotData (&s, &spawn_baseline.len[i]);
+		spawn_baseline.ofs[i] = start;
+		spawn_baseline.len[i] -= start;
 	}
+	spawn_baseline.data = SaveStream_SnapshotData (&s, &spawn_baseline.size);
+	s.mem = NULL;
+	SaveStream_Discard (&s);
+
+	Com_sprintf (spawn_baseline.mapname, sizeof(spawn_baseline.mapname), "%s", level.mapname);
+	spawn_baseline.hash = Save_Hash (2166136261u, (byte *)level.mapname, strlen (level.mapname));
+	spawn_baseline.hash = Save_Hash (spawn_baseline.hash, (byte *)spawn_baseline.len, game.maxentities * sizeof(int));
+	spawn_baseline.hash = Save_Hash (spawn_baseline.hash, spawn_baseline.data, spawn_baseline.size);
+	if (!spawn_baseline.hash)
+		spawn_baseline.hash = 1;	// 0 marks a full save
 }
 
+static qboolean Save_BaselineFor (char *mapname)
+{
+	return spawn_baseline.ofs && !Q_stricmp (spawn_baseline.mapname, mapname);
+}
 
 /*
-==============
-ReadEdict
+=================
+G_SpawnBaselineHash
 
-All pointer variables (except function pointers) must be handled specially.
-==============
+The hash a delta image of mapname has to carry to be rebuilt, 0 if
+there is no baseline for it.
+=================
 */
-void ReadEdict (FILE *f, edict_t *ent)
+unsigned G_SpawnBaselineHash (char *mapname)
 {
-	field_t		*field;
-
-	fread (ent, sizeof(*ent), 1, f);
+	return Save_BaselineFor (mapname) ? spawn_baseline.hash : 0;
+}
 
-	for (field=fields ; field->name ; field++)
-	{
-		ReadField (f, field, (byte *)ent);
-	}
+static qboolean Save_MatchesBaseline (int entnum, byte *data, int size)
+{
+	if (spawn_baseline.len[entnum] != size)
+		return false;
+	return !memcmp (spawn_baseline.data + spawn_baseline.ofs[entnum], data, size);
 }
 
 /*
-==============
-ReadLevelLocals
+=================
+Save_RestoreBaseline
 
-All pointer variables (except function pointers) must be handled specially.
-==============
+Decodes entity entnum as SpawnEntities left it.
+=================
 */
-void ReadLevelLocals (FILE *f)
+static void Save_RestoreBaseline (int entnum)
 {
-	field_t		*field;
+	static saveschema_t	native_edict, native_camera;
+	savestream_t		s;
+
+	Save_NativeSchema (savefields, &native_edict);
+	Save_NativeSchema (camerafields, &native_camera);
+
+	SaveStream_OpenMemory (&s, "baseline", spawn_baseline.data + spawn_baseline.ofs[entnum],
+		spawn_baseline.len[entnum]);
+	record_camera = &native_camera;
+	Save_ReadRecord (&s, &native_edict, (byte *)&g_edicts[entnum]);
+	record_camera = &schema_camera;
+	SaveStream_Close (&s);
+}
 
-	fread (&level, sizeof(level), 1, f);
+//=========================================================
 
-	for (field=levelfields ; field->name ; field++)
-	{
-		ReadField (f, field, (byte *)&level);
-	}
-}
 
 /*
 =================
@@ -672,39 +1430,87 @@ WriteLevel
 */
 void WriteLevel (char *filename)
 {
-	int		i;
-	edict_t	*ent;
-	FILE	*f;
-	void	*base;
-
-	f = fopen (filename, "wb");
-	if (!f)
-		gi.error ("Couldn't open %s", filename);
+	int				i;
+	edict_t			*ent;
+	savestream_t	s, d, record;
+	void			*base;
+	byte			*data;
+	int				size, count;
+	qboolean		delta;
 
-	// write out edict size for checking
-	i = sizeof(edict_t);
-	fwrite (&i, sizeof(i), 1, f);
+	SaveStream_OpenSnapshot (&s, filename);
+	Save_WriteHeader (&s);
 
 	// write out a function pointer for checking
 	base = (void *)InitGame;
-	fwrite (&base, sizeof(base), 1, f);
+	SaveStream_Write (&s, &base, sizeof(base));
+
+	Save_WriteSchema (&s, levelfields);
+	Save_WriteSchema (&s, savefields);
+	Save_WriteSchema (&s, camerafields);
 
 	// write out level_locals_t
-	WriteLevelLocals (f);
+	Save_WriteRecord (&s, levelfields, (byte *)&level);
 
-	// write out all the entities
+	// a cached hub level is kept as a delta against the spawn baseline,
+	// which starts out the same as the file
+	delta = g_delta_saves->value && Save_BaselineFor (level.mapname) && LevelCache_Wants (level.mapname);
+	if (delta)
+	{
+		SaveStream_OpenSnapshot (&d, filename);
+		data = SaveStream_SnapshotData (&s, &size);
+		SaveStream_Write (&d, data, size);
+		SaveStream_WriteInt (&d, spawn_baseline.hash);
+	}
+	SaveStream_WriteInt (&s, 0);
+
+	// write out all the entities, leaving the ones that are unchanged
+	// since they were spawned out of the delta
+	SaveStream_OpenSnapshot (&record, filename);
 	for (i=0 ; i<globals.num_edicts ; i++)
 	{
 		ent = &g_edicts[i];
 		if (!ent->inuse)
 			continue;
-		fwrite (&i, sizeof(i), 1, f);
-		WriteEdict (f, ent);
+		SaveStream_Rewind (&record);
+		Save_WriteRecord (&record, savefields, (byte *)ent);
+		data = SaveStream_SnapshotData (&record, &size);
+		SaveStream_WriteInt (&s, i);
+		SaveStream_Write (&s, data, size);
+		if (delta && !Save_MatchesBaseline (i, data, size))
+		{
+			SaveStream_WriteInt (&d, i);
+			SaveStream_Write (&d, data, size);
+		}
+	}
+	SaveStream_Discard (&record);
+	SaveStream_WriteInt (&s, -1);
+
+	if (delta)
+	{
+		SaveStream_WriteInt (&d, -1);
+
+		// and the spawned entities that have been freed
+		count = 0;
+		for (i=0 ; i<game.maxentities ; i++)
+			if (spawn_baseline.len[i] && (i >= globals.num_edicts || !g_edicts[i].inuse))
+				count++;
+		SaveStream_WriteInt (&d, count);
+		for (i=0 ; i<game.maxentities ; i++)
+			if (spawn_baseline.len[i] && (i >= globals.num_edicts || !g_edicts[i].inuse))
+				SaveStream_WriteInt (&d, i);
+
+		data = SaveStream_SnapshotData (&d, &size);
+		LevelCache_Store (level.mapname, filename, data, size, spawn_baseline.hash);
+		SaveStream_Discard (&d);
+	}
+	else
+	{
+		data = SaveStream_SnapshotData (&s, &size);
+		LevelCache_Store (level.mapname, filename, data, size, 0);
 	}
-	i = -1;
-	fwrite (&i, sizeof(i), 1, f);
 
-	fclose (f);
+	SaveStream_Close (&s);
 }
 
 
@@ -742,6 +1548,21 @@ static void G_RestoreRTDUTurretLinks (void)
 	}
 }
 
+static int Save_ReadEntnum (savestream_t *s)
+{
+	int		entnum;
+
+	entnum = SaveStream_ReadInt (s);
+	if (entnum == -1)
+		return entnum;
+	if (entnum < 0 || entnum >= game.maxentities)
+	{
+		SaveStream_Close (s);
+		gi.error ("ReadLevel: bad entnum");
+	}
+	return entnum;
+}
+
 /*
 =================
 ReadLevel
@@ -760,62 +1581,104 @@ No clients are connected yet.
 */
 void ReadLevel (char *filename)
 {
-	int		entnum;
-	FILE	*f;
-	int		i;
-	void	*base;
-	edict_t	*ent;
-
-	f = fopen (filename, "rb");
-	if (!f)
-		gi.error ("Couldn't open %s", filename);
+	int				entnum;
+	savestream_t	s;
+	int				i;
+	void			*base;
+	edict_t			*ent;
+	unsigned		hash;
+	int				count;
+	static qboolean	saved[MAX_EDICTS];
+
+	// returning to a hub level restores from its cached image
+	if (!LevelCache_Open (&s, filename))
+		SaveStream_OpenRead (&s, filename);
+	Save_ReadHeader (&s);
 
 	// free any dynamic memory allocated by loading the level
 	// base state
-	gi.FreeTags (TAG_LEVEL);
+	G_FreeTags (TAG_LEVEL);
+	G_ResetEdictExt ();
 
-	// wipe all the entities
+	// wipe all the entities; a level read from the hub cache may not
+	// follow a SpawnEntities, so nothing past num_edicts can be trusted
 	memset (g_edicts, 0, game.maxentities*sizeof(g_edicts[0]));
 	globals.num_edicts = maxclients->value+1;
 
-	// check edict size
-	fread (&i, sizeof(i), 1, f);
-	if (i != sizeof(edict_t))
-	{
-		fclose (f);
-		gi.error ("ReadLevel: mismatched edict size");
-	}
-
 	// check function pointer base address
-	fread (&base, sizeof(base), 1, f);
+	SaveStream_Read (&s, &base, sizeof(base));
 #ifdef _WIN32
 	if (base != (void *)InitGame)
 	{
-		fclose (f);
+		SaveStream_Close (&s);
 		gi.error ("ReadLevel: function pointers have moved");
 	}
 #else
 	gi.dprintf("Function offsets %d\n", ((byte *)base) - ((byte *)InitGame));
 #endif
 
+	Save_ReadSchema (&s, levelfields, &schema_level);
+	Save_ReadSchema (&s, savefields, &schema_edict);
+	Save_ReadSchema (&s, camerafields, &schema_camera);
+
 	// load the level locals
-	ReadLevelLocals (f);
+	memset (&level, 0, sizeof(level));
+	Save_ReadRecord (&s, &schema_level, (byte *)&level);
 
-	// load all the entities
+	hash = SaveStream_ReadInt (&s);
+	memset (saved, 0, sizeof(saved));
+
+	// load all the entities that were written
 	while (1)
 	{
-		if (fread (&entnum, sizeof(entnum), 1, f) != 1)
-		{
-			fclose (f);
-			gi.error ("ReadLevel: failed to read entnum");
-		}
+		entnum = Save_ReadEntnum (&s);
 		if (entnum == -1)
 			break;
 		if (entnum >= globals.num_edicts)
 			globals.num_edicts = entnum+1;
 
-		ent = &g_edicts[entnum];
-		ReadEdict (f, ent);
+		G_MemEntity (&g_edicts[entnum]);
+		Save_ReadRecord (&s, &schema_edict, (byte *)&g_edicts[entnum]);
+		saved[entnum] = true;
+	}
+	G_MemEntity (NULL);
+
+	// the rest of a delta save is the spawn baseline, less what was freed
+	if (hash)
+	{
+		count = SaveStream_ReadInt (&s);
+		for (i=0 ; i<count ; i++)
+		{
+			entnum = Save_ReadEntnum (&s);
+			if (entnum == -1)
+				gi.error ("ReadLevel: bad entnum");
+			saved[entnum] = true;
+		}
+
+		// LevelCache_Open only hands out images of the current baseline,
+		// but a file written as a delta by an older game may not match
+		if (hash != G_SpawnBaselineHash (level.mapname))
+			gi.dprintf ("ReadLevel: %s was spawned differently when saved, only the changed entities are restored\n", level.mapname);
+		else
+		{
+			for (i=0 ; i<game.maxentities ; i++)
+			{
+				if (saved[i] || !spawn_baseline.len[i])
+					continue;
+				if (i >= globals.num_edicts)
+					globals.num_edicts = i+1;
+				Save_RestoreBaseline (i);
+			}
+		}
+	}
+
+	SaveStream_Close (&s);
+
+	for (i=0 ; i<globals.num_edicts ; i++)
+	{
+		ent = &g_edicts[i];
+		if (!ent->inuse)
+			continue;
 
 		// let the server rebuild world links for this ent
 		memset (&ent->area, 0, sizeof(ent->area));
@@ -825,7 +1688,15 @@ void ReadLevel (char *filename)
 			Actor_PostLoad (ent);
 	}
 
-	fclose (f);
+	// cached laser beams, line of sight answers, asset indexes and
+	// snapshots belong to whatever level was running before
+	G_ResetLaserCache ();
+	G_ResetRadiusCache ();
+	G_ResetAssets ();
+	G_ResetScoreboard ();
+	G_ResetClientStats ();
+	G_ResetSpawnSpots ();
+	G_ResetSnapshots ();
 
 	// mark all clients as unconnected
 	for (i=0 ; i<maxclients->value ; i++)
@@ -850,4 +1721,5 @@ void ReadLevel (char *filename)
 	}
 
 	G_RestoreRTDUTurretLinks ();
+	G_ResyncHotEdicts ();
 }
@@ -0,0 +1,718 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_savestream.c -- buffered savegame file streams
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+SAVE STREAMS
+
+Savegames are written and read through a fixed buffer instead of one
+fwrite / fread per field, so a level with hundreds of entities turns into
+a handful of large file operations.
+
+Any short read or failed write is fatal, the same as the old fread based
+loader treated a truncated file.
+
+A snapshot stream (SaveStream_OpenSnapshot) collects the whole file in
+memory instead, and SaveStream_Close hands it to the background writer
+below.
+
+==============================================================================
+*/
+
+static void SaveStream_Flush (savestream_t *s)
+{
+	if (!s->cursize)
+		return;
+
+	if (s->snapshot)
+	{
+		if (s->memsize + s->cursize > s->memmax)
+		{
+			s->memmax = (s->memmax ? s->memmax : SAVE_STREAM_BUFFER) * 2;
+			while (s->memsize + s->cursize > s->memmax)
+				s->memmax *= 2;
+			s->mem = realloc (s->mem, s->memmax);
+			if (!s->mem)
+				gi.error ("Couldn't buffer %s", s->filename);
+		}
+		memcpy (s->mem + s->memsize, s->data, s->cursize);
+		s->memsize += s->cursize;
+		s->cursize = 0;
+		return;
+	}
+
+	if (fwrite (s->data, 1, s->cursize, s->f) != (size_t)s->cursize)
+	{
+		fclose (s->f);
+		s->f = NULL;
+		gi.error ("Couldn't write %s", s->filename);
+	}
+	s->cursize = 0;
+}
+
+static void SaveStream_Fill (savestream_t *s)
+{
+	s->readcount = 0;
+
+	if (!s->f)
+	{
+		s->cursize = s->memsize - s->memread;
+		if (s->cursize > SAVE_STREAM_BUFFER)
+			s->cursize = SAVE_STREAM_BUFFER;
+		memcpy (s->data, s->mem + s->memread, s->cursize);
+		s->memread += s->cursize;
+		return;
+	}
+
+	s->cursize = fread (s->data, 1, SAVE_STREAM_BUFFER, s->f);
+}
+
+/*
+=================
+SaveStream_OpenWrite / SaveStream_OpenRead
+=================
+*/
+void SaveStream_OpenWrite (savestream_t *s, char *filename)
+{
+	memset (s, 0, sizeof(*s));
+	Com_sprintf (s->filename, sizeof(s->filename), "%s", filename);
+
+	s->f = fopen (filename, "wb");
+	if (!s->f)
+		gi.error ("Couldn't open %s", filename);
+}
+
+/*
+=================
+SaveStream_OpenSnapshot
+
+Like SaveStream_OpenWrite, but the file is collected in memory and only
+written to disk by SaveStream_Close, on the background writer if
+g_async_save is set.
+=================
+*/
+void SaveStream_OpenSnapshot (savestream_t *s, char *filename)
+{
+	memset (s, 0, sizeof(*s));
+	Com_sprintf (s->filename, sizeof(s->filename), "%s", filename);
+	s->snapshot = true;
+}
+
+void SaveStream_OpenRead (savestream_t *s, char *filename)
+{
+	// don't read a file the background writer is still producing
+	SaveStream_Barrier (filename);
+
+	memset (s, 0, sizeof(*s));
+	Com_sprintf (s->filename, sizeof(s->filename), "%s", filename);
+	s->reading = true;
+
+	s->f = fopen (filename, "rb");
+	if (!s->f)
+		gi.error ("Couldn't open %s", filename);
+}
+
+/*
+=================
+SaveStream_OpenMemory
+
+Reads a file image that is already in memory.  data is not copied, and
+must stay valid until SaveStream_Close.
+=================
+*/
+void SaveStream_OpenMemory (savestream_t *s, char *filename, byte *data, int size)
+{
+	memset (s, 0, sizeof(*s));
+	Com_sprintf (s->filename, sizeof(s->filename), "%s", filename);
+	s->reading = true;
+	s->mem = data;
+	s->memsize = size;
+}
+
+/*
+=================
+SaveStream_SnapshotData
+
+Everything written to a snapshot stream so far, as one block.
+=================
+*/
+byte *SaveStream_SnapshotData (savestream_t *s, int *size)
+{
+	SaveStream_Flush (s);
+	*size = s->memsize;
+	return s->mem;
+}
+
+/*
+=================
+SaveStream_Rewind / SaveStream_Discard
+
+A snapshot stream can be used as scratch space: Rewind drops what was
+written but keeps the memory, Discard frees it without writing anything.
+=================
+*/
+void SaveStream_Rewind (savestream_t *s)
+{
+	s->cursize = 0;
+	s->memsize = 0;
+}
+
+void SaveStream_Discard (savestream_t *s)
+{
+	if (s->snapshot && s->mem)
+		free (s->mem);
+	s->mem = NULL;
+	s->memsize = s->memmax = 0;
+	s->cursize = 0;
+	s->snapshot = false;
+}
+
+/*
+=================
+SaveStream_Close
+
+Writes anything still buffered.
+=================
+*/
+void SaveStream_Close (savestream_t *s)
+{
+	if (s->snapshot)
+	{
+		SaveStream_Flush (s);
+		SaveStream_QueueWrite (s->filename, s->mem, s->memsize);
+		s->mem = NULL;
+		s->snapshot = false;
+		return;
+	}
+
+	if (!s->f)
+	{
+		s->mem = NULL;
+		return;
+	}
+
+	if (!s->reading)
+		SaveStream_Flush (s);
+	fclose (s->f);
+	s->f = NULL;
+}
+
+//=========================================================
+
+void SaveStream_Write (savestream_t *s, const void *data, int length)
+{
+	const byte	*in;
+	int			chunk;
+
+	in = (const byte *)data;
+	s->total += length;
+
+	while (length > 0)
+	{
+		if (s->cursize == SAVE_STREAM_BUFFER)
+			SaveStream_Flush (s);
+
+		chunk = SAVE_STREAM_BUFFER - s->cursize;
+		if (chunk > length)
+			chunk = length;
+		memcpy (s->data + s->cursize, in, chunk);
+		s->cursize += chunk;
+		in += chunk;
+		length -= chunk;
+	}
+}
+
+void SaveStream_WriteByte (savestream_t *s, int c)
+{
+	byte	b;
+
+	b = (byte)c;
+	SaveStream_Write (s, &b, 1);
+}
+
+void SaveStream_WriteShort (savestream_t *s, int c)
+{
+	short	sh;
+
+	sh = (short)c;
+	SaveStream_Write (s, &sh, sizeof(sh));
+}
+
+void SaveStream_WriteInt (savestream_t *s, int c)
+{
+	SaveStream_Write (s, &c, sizeof(c));
+}
+
+/*
+=================
+SaveStream_WriteString
+
+Length prefixed, no terminator.  NULL is written as length -1, so it
+doesn't come back as "".
+=================
+*/
+void SaveStream_WriteString (savestream_t *s, char *str)
+{
+	int		len;
+
+	if (!str)
+	{
+		SaveStream_WriteInt (s, -1);
+		return;
+	}
+
+	len = strlen (str);
+	SaveStream_WriteInt (s, len);
+	SaveStream_Write (s, str, len);
+}
+
+//=========================================================
+
+void SaveStream_Read (savestream_t *s, void *data, int length)
+{
+	byte	*out;
+	int		chunk;
+
+	out = (byte *)data;
+	s->total += length;
+
+	while (length > 0)
+	{
+		if (s->readcount == s->cursize)
+		{
+			SaveStream_Fill (s);
+			if (!s->cursize)
+			{
+				if (s->f)
+					fclose (s->f);
+				s->f = NULL;
+				gi.error ("%s: unexpected end of file", s->filename);
+			}
+		}
+
+		chunk = s->cursize - s->readcount;
+		if (chunk > length)
+			chunk = length;
+		if (out)
+		{
+			memcpy (out, s->data + s->readcount, chunk);
+			out += chunk;
+		}
+		s->readcount += chunk;
+		length -= chunk;
+	}
+}
+
+/*
+=================
+SaveStream_Skip
+
+Discards data the current schema has no use for.
+=================
+*/
+void SaveStream_Skip (savestream_t *s, int length)
+{
+	SaveStream_Read (s, NULL, length);
+}
+
+int SaveStream_ReadByte (savestream_t *s)
+{
+	byte	b;
+
+	SaveStream_Read (s, &b, 1);
+	return b;
+}
+
+int SaveStream_ReadShort (savestream_t *s)
+{
+	short	sh;
+
+	SaveStream_Read (s, &sh, sizeof(sh));
+	return sh;
+}
+
+int SaveStream_ReadInt (savestream_t *s)
+{
+	int		c;
+
+	SaveStream_Read (s, &c, sizeof(c));
+	return c;
+}
+
+/*
+=================
+SaveStream_ReadString
+
+Returns NULL for a string written as NULL, otherwise a copy allocated
+with tag.
+=================
+*/
+char *SaveStream_ReadString (savestream_t *s, int tag)
+{
+	char	*str;
+	int		len;
+
+	len = SaveStream_ReadInt (s);
+	if (len == -1)
+		return NULL;
+	if (len < 0)
+		gi.error ("%s: bad string length", s->filename);
+
+	str = G_TagMalloc (len + 1, tag, "strings");
+	SaveStream_Read (s, str, len);
+	str[len] = 0;
+	return str;
+}
+
+/*
+=================
+SaveStream_ReadName
+
+Reads a string into a fixed buffer, for schema names.
+=================
+*/
+void SaveStream_ReadName (savestream_t *s, char *out, int size)
+{
+	int		len;
+
+	len = SaveStream_ReadInt (s);
+	if (len < 0 || len >= size)
+		gi.error ("%s: bad field name", s->filename);
+	SaveStream_Read (s, out, len);
+	out[len] = 0;
+}
+
+/*
+==============================================================================
+
+BACKGROUND WRITER
+
+Snapshot streams are written out by a single worker thread, in the order
+they were queued, so WriteLevel on a level change only costs the time to
+serialize into memory and the disk write overlaps loading the next map.
+
+SaveStream_Barrier waits for queued writes to finish.  It runs before a
+save file is read, at the end of WriteGame (the server copies the save
+directory as soon as WriteGame returns), before each server frame and at
+shutdown.  A write that failed on the worker is reported from the barrier.
+
+==============================================================================
+*/
+
+#define	MAX_SAVE_JOBS	16
+
+typedef struct
+{
+	char	filename[MAX_OSPATH];
+	byte	*data;
+	int		size;
+} savejob_t;
+
+static savejob_t	save_jobs[MAX_SAVE_JOBS];
+static int			save_head, save_tail;	// queued jobs are [tail, head)
+static qboolean		save_busy;				// worker has taken the job at tail
+static qboolean		save_quit;
+static qboolean		save_thread_running;
+static char			save_failed[MAX_OSPATH];
+
+#ifdef _WIN32
+static CRITICAL_SECTION	save_lock;
+static HANDLE			save_work_event;
+static HANDLE			save_done_event;
+static HANDLE			save_thread;
+#else
+static pthread_mutex_t	save_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t	save_work_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t	save_done_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t		save_thread;
+#endif
+
+static void Save_Lock (void)
+{
+#ifdef _WIN32
+	EnterCriticalSection (&save_lock);
+#else
+	pthread_mutex_lock (&save_lock);
+#endif
+}
+
+static void Save_Unlock (void)
+{
+#ifdef _WIN32
+	LeaveCriticalSection (&save_lock);
+#else
+	pthread_mutex_unlock (&save_lock);
+#endif
+}
+
+// called and returns with the lock held
+static void Save_WaitForWork (void)
+{
+#ifdef _WIN32
+	Save_Unlock ();
+	WaitForSingleObject (save_work_event, INFINITE);
+	Save_Lock ();
+#else
+	pthread_cond_wait (&save_work_cond, &save_lock);
+#endif
+}
+
+// called and returns with the lock held
+static void Save_WaitForDone (void)
+{
+#ifdef _WIN32
+	Save_Unlock ();
+	WaitForSingleObject (save_done_event, INFINITE);
+	Save_Lock ();
+#else
+	pthread_cond_wait (&save_done_cond, &save_lock);
+#endif
+}
+
+static void Save_SignalWork (void)
+{
+#ifdef _WIN32
+	SetEvent (save_work_event);
+#else
+	pthread_cond_signal (&save_work_cond);
+#endif
+}
+
+static void Save_SignalDone (void)
+{
+#ifdef _WIN32
+	SetEvent (save_done_event);
+#else
+	pthread_cond_broadcast (&save_done_cond);
+#endif
+}
+
+/*
+=================
+Save_WriteJob
+
+Runs on the worker without the lock; must not call into the engine.
+=================
+*/
+static qboolean Save_WriteJob (savejob_t *job)
+{
+	FILE		*f;
+	qboolean	ok;
+
+	f = fopen (job->filename, "wb");
+	if (!f)
+		return false;
+	ok = fwrite (job->data, 1, job->size, f) == (size_t)job->size;
+	if (fclose (f))
+		ok = false;
+	return ok;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI Save_WorkerThread (LPVOID arg)
+#else
+static void *Save_WorkerThread (void *arg)
+#endif
+{
+	savejob_t	*job;
+
+	Save_Lock ();
+	while (1)
+	{
+		while (save_tail == save_head && !save_quit)
+			Save_WaitForWork ();
+		if (save_tail == save_head)
+			break;
+
+		job = &save_jobs[save_tail % MAX_SAVE_JOBS];
+		save_busy = true;
+		Save_Unlock ();
+
+		if (!Save_WriteJob (job))
+		{
+			Save_Lock ();
+			if (!save_failed[0])
+				Com_sprintf (save_failed, sizeof(save_failed), "%s", job->filename);
+			Save_Unlock ();
+		}
+		free (job->data);
+		job->data = NULL;
+
+		Save_Lock ();
+		save_busy = false;
+		save_tail++;
+		Save_SignalDone ();
+	}
+	Save_Unlock ();
+
+	return 0;
+}
+
+static qboolean Save_StartWorker (void)
+{
+	if (save_thread_running)
+		return true;
+
+	save_quit = false;
+#ifdef _WIN32
+	InitializeCriticalSection (&save_lock);
+	save_work_event = CreateEvent (NULL, FALSE, FALSE, NULL);
+	save_done_event = CreateEvent (NULL, FALSE, FALSE, NULL);
+	save_thread = CreateThread (NULL, 0, Save_WorkerThread, NULL, 0, NULL);
+	if (!save_thread)
+	{
+		CloseHandle (save_work_event);
+		CloseHandle (save_done_event);
+		DeleteCriticalSection (&save_lock);
+		return false;
+	}
+#else
+	if (pthread_create (&save_thread, NULL, Save_WorkerThread, NULL))
+		return false;
+#endif
+
+	save_thread_running = true;
+	return true;
+}
+
+/*
+=================
+SaveStream_QueueWrite
+
+Takes ownership of data, which must come from malloc.
+=================
+*/
+void SaveStream_QueueWrite (char *filename, byte *data, int size)
+{
+	savejob_t	*job;
+	qboolean	ok;
+
+	if (!g_async_save->value || !Save_StartWorker ())
+	{
+		savejob_t	sync;
+
+		Com_sprintf (sync.filename, sizeof(sync.filename), "%s", filename);
+		sync.data = data;
+		sync.size = size;
+		ok = Save_WriteJob (&sync);
+		free (data);
+		if (!ok)
+			gi.error ("Couldn't write %s", filename);
+		return;
+	}
+
+	Save_Lock ();
+	while (save_head - save_tail == MAX_SAVE_JOBS)
+		Save_WaitForDone ();
+
+	job = &save_jobs[save_head % MAX_SAVE_JOBS];
+	Com_sprintf (job->filename, sizeof(job->filename), "%s", filename);
+	job->data = data;
+	job->size = size;
+	save_head++;
+
+	Save_SignalWork ();
+	Save_Unlock ();
+}
+
+static qboolean Save_Pending (char *filename)
+{
+	int		i;
+
+	for (i=save_tail ; i<save_head ; i++)
+	{
+		if (!filename || !strcmp (save_jobs[i % MAX_SAVE_JOBS].filename, filename))
+			return true;
+	}
+	return false;
+}
+
+/*
+=================
+SaveStream_Barrier
+
+Waits until every queued write of filename, or of any file if NULL, is
+on disk.
+=================
+*/
+void SaveStream_Barrier (char *filename)
+{
+	char	failed[MAX_OSPATH];
+
+	if (!save_thread_running)
+		return;
+
+	Save_Lock ();
+	while (Save_Pending (filename))
+		Save_WaitForDone ();
+
+	failed[0] = 0;
+	if (save_failed[0])
+	{
+		Com_sprintf (failed, sizeof(failed), "%s", save_failed);
+		save_failed[0] = 0;
+	}
+	Save_Unlock ();
+
+	if (failed[0])
+		gi.error ("Couldn't write %s", failed);
+}
+
+/*
+=================
+SaveStream_Shutdown
+
+Finishes queued writes and stops the worker before the dll is unloaded.
+=================
+*/
+void SaveStream_Shutdown (void)
+{
+	if (!save_thread_running)
+		return;
+
+	Save_Lock ();
+	save_quit = true;
+	Save_SignalWork ();
+	Save_Unlock ();
+
+#ifdef _WIN32
+	WaitForSingleObject (save_thread, INFINITE);
+	CloseHandle (save_thread);
+	CloseHandle (save_work_event);
+	CloseHandle (save_done_event);
+	DeleteCriticalSection (&save_lock);
+#else
+	pthread_join (save_thread, NULL);
+#endif
+
+	save_thread_running = false;
+	save_head = save_tail = 0;
+	save_failed[0] = 0;
+}
@@ -0,0 +1,419 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_snapshot.c -- in-memory world snapshots
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+WORLD SNAPSHOTS
+
+A snapshot is a straight copy of game, level, the edicts and the clients.
+It backs the quicksave / quickload commands and the rewind ring.  It never
+goes near WriteGame / WriteLevel or the disk.
+
+Snapshots are restored into the same g_edicts and game.clients arrays they
+were taken from, so edict, client, item and function pointers stay valid
+as they are.  The exceptions are the TAG_LEVEL blocks that edicts point
+to and that change after spawning: camera_state and rotate_train.  Their
+contents are copied after the edicts along with the entity and offset of
+the pointer.  On restore they are copied back through the pointer that
+was restored.  Nothing allocated with TAG_LEVEL is freed before the
+level ends, so those pointers are still live.  Strings never change
+after spawning and are not copied.
+
+Edict extension table entries (g_ext.c) are copied the same way and
+handed back to their entities through G_EdictExt.
+
+All snapshots are dropped when a level is spawned or loaded.
+
+g_rewind			seconds between rewind snapshots, 0 for none
+g_coop_snapshots	lets the listen server's host use them in coop
+
+==============================================================================
+*/
+
+#define	MAX_REWIND_SNAPSHOTS	8
+#define	QUICKSAVE_SNAPSHOT		MAX_REWIND_SNAPSHOTS
+#define	MAX_SNAPSHOTS			(MAX_REWIND_SNAPSHOTS + 1)
+
+typedef struct
+{
+	int		entnum;
+	int		ext;			// extension table entry, or -1
+	int		ofs;			// of the pointer in the edict
+	int		size;			// bytes of block data that follow
+} snapblock_t;
+
+typedef struct
+{
+	qboolean		valid;
+	game_locals_t	game;
+	level_locals_t	level;
+	int				num_edicts;
+	edict_t			*edicts;		// [game.maxentities]
+	gclient_t		*clients;		// [game.maxclients]
+
+	byte			*blocks;		// snapblock_t + data, back to back
+	int				blocksize;
+	int				blockmax;
+} snapshot_t;
+
+static snapshot_t	snapshots[MAX_SNAPSHOTS];
+static int			rewind_head;		// next rewind slot to fill
+static float		rewind_time;		// level.time of the next rewind snapshot
+
+/*
+=================
+Snapshot_Alloc
+
+Every snapshot's edict and client arrays are allocated the first time any
+snapshot is taken, so taking one later never allocates.
+=================
+*/
+static qboolean Snapshot_Alloc (void)
+{
+	int		i;
+
+	if (snapshots[0].edicts)
+		return true;
+
+	for (i=0 ; i<MAX_SNAPSHOTS ; i++)
+	{
+		snapshots[i].edicts = malloc (game.maxentities * sizeof(edict_t));
+		snapshots[i].clients = malloc (game.maxclients * sizeof(gclient_t));
+		if (!snapshots[i].edicts || !snapshots[i].clients)
+		{
+			G_FreeSnapshots ();
+			return false;
+		}
+	}
+	return true;
+}
+
+static int Snapshot_BlockSize (field_t *field)
+{
+	if (field->type == F_LBLOCK)
+		return field->size;
+	if (field->type == F_CAMERA)
+		return sizeof(camera_state_t);
+	return 0;
+}
+
+static void Snapshot_AddBlock (snapshot_t *snap, int entnum, int ext, int ofs, void *data, int size)
+{
+	snapblock_t	block;
+	int			need;
+
+	need = snap->blocksize + sizeof(block) + size;
+	if (need > snap->blockmax)
+	{
+		snap->blockmax = snap->blockmax ? snap->blockmax * 2 : 4096;
+		while (need > snap->blockmax)
+			snap->blockmax *= 2;
+		snap->blocks = realloc (snap->blocks, snap->blockmax);
+		if (!snap->blocks)
+			gi.error ("Snapshot_AddBlock: out of memory");
+	}
+
+	block.entnum = entnum;
+	block.ext = ext;
+	block.ofs = ofs;
+	block.size = size;
+	memcpy (snap->blocks + snap->blocksize, &block, sizeof(block));
+	memcpy (snap->blocks + snap->blocksize + sizeof(block), data, size);
+	snap->blocksize = need;
+}
+
+static qboolean Snapshot_Take (snapshot_t *snap)
+{
+	field_t	*field;
+	edict_t	*ent;
+	int		i, size, ext;
+	byte	*p;
+
+	if (!Snapshot_Alloc ())
+		return false;
+
+	snap->game = game;
+	snap->level = level;
+	snap->num_edicts = globals.num_edicts;
+	memcpy (snap->edicts, g_edicts, globals.num_edicts * sizeof(edict_t));
+	memcpy (snap->clients, game.clients, game.maxclients * sizeof(gclient_t));
+
+	snap->blocksize = 0;
+	for (i=0, ent=g_edicts ; i<globals.num_edicts ; i++, ent++)
+	{
+		if (!ent->inuse)
+			continue;
+		for (field=savefields ; field->name ; field++)
+		{
+			size = Snapshot_BlockSize (field);
+			if (!size || G_FieldExt (field) >= 0)
+				continue;
+			p = *(byte **)((byte *)ent + field->ofs);
+			if (p)
+				Snapshot_AddBlock (snap, i, -1, field->ofs, p, size);
+		}
+		for (ext=0 ; ext<NUM_EDICT_EXTS ; ext++)
+		{
+			p = G_FindEdictExt (ent, ext);
+			if (p)
+				Snapshot_AddBlock (snap, i, ext, 0, p, G_EdictExtSize (ext));
+		}
+	}
+
+	snap->valid = true;
+	return true;
+}
+
+/*
+=================
+Snapshot_Restore
+=================
+*/
+static void Snapshot_Restore (snapshot_t *snap)
+{
+	snapblock_t	block;
+	edict_t		*ent, *cl;
+	int			i, ofs;
+	qboolean	linked;
+	byte		*p;
+
+	// the server's world links are kept in the edicts, so everything
+	// comes out of the world before the edicts are overwritten
+	for (i=0, ent=g_edicts ; i<globals.num_edicts ; i++, ent++)
+	{
+		if (ent->inuse)
+			gi.unlinkentity (ent);
+		G_FreeEdictExt (ent);
+	}
+
+	memcpy (g_edicts, snap->edicts, snap->num_edicts * sizeof(edict_t));
+	if (globals.num_edicts > snap->num_edicts)
+		memset (g_edicts + snap->num_edicts, 0, (globals.num_edicts - snap->num_edicts) * sizeof(edict_t));
+	globals.num_edicts = snap->num_edicts;
+	memcpy (game.clients, snap->clients, game.maxclients * sizeof(gclient_t));
+	game = snap->game;
+	level = snap->level;
+
+	for (ofs=0 ; ofs<snap->blocksize ; ofs+=sizeof(block)+block.size)
+	{
+		memcpy (&block, snap->blocks + ofs, sizeof(block));
+		ent = &g_edicts[block.entnum];
+		if (block.ext >= 0)
+			p = G_EdictExt (ent, block.ext);
+		else
+			p = *(byte **)((byte *)ent + block.ofs);
+		memcpy (p, snap->blocks + ofs + sizeof(block), block.size);
+	}
+
+	for (i=0, ent=g_edicts ; i<globals.num_edicts ; i++, ent++)
+	{
+		if (!ent->inuse)
+			continue;
+		linked = ent->area.prev != NULL;
+		memset (&ent->area, 0, sizeof(ent->area));
+		if (linked)
+			gi.linkentity (ent);
+	}
+
+	// don't let the clients predict across the jump
+	for (i=0 ; i<game.maxclients ; i++)
+	{
+		cl = g_edicts + 1 + i;
+		if (!cl->inuse || !cl->client)
+			continue;
+		cl->client->ps.pmove.pm_time = 160>>3;
+		cl->client->ps.pmove.pm_flags |= PMF_TIME_TELEPORT;
+	}
+
+	// caches that describe the world as it was a moment ago, and the
+	// blasts, pain and effects it queued for the end of the frame
+	G_ResetLaserCache ();
+	G_ResetRadiusCache ();
+	G_ResetSpawnSpots ();
+	G_ResetScoreboard ();
+	G_ResetClientStats ();
+	G_ResetAssets ();
+	G_ResetExplosions ();
+	G_ResetDamage ();
+	G_ResetTempEntities ();
+	G_ResyncHotEdicts ();
+}
+
+/*
+=================
+Snapshot_SameClients
+
+A snapshot can only be restored if the same players are in the game.
+=================
+*/
+static qboolean Snapshot_SameClients (snapshot_t *snap)
+{
+	int		i;
+
+	for (i=0 ; i<game.maxclients ; i++)
+	{
+		if (snap->edicts[i+1].inuse != g_edicts[i+1].inuse)
+			return false;
+		if (snap->clients[i].pers.connected != game.clients[i].pers.connected)
+			return false;
+	}
+	return true;
+}
+
+static qboolean Snapshot_Restorable (snapshot_t *snap)
+{
+	return snap->valid && Snapshot_SameClients (snap);
+}
+
+static qboolean	snapshot_host[MAX_CLIENTS];	// connected from the server's machine
+
+/*
+=================
+G_SnapshotClientConnect / G_SnapshotHost
+
+The engine only puts the address in the userinfo a client connects with,
+so whether it is the listen server's own player is noted then.
+=================
+*/
+void G_SnapshotClientConnect (edict_t *ent, char *ip)
+{
+	int		clientnum;
+
+	clientnum = ent - g_edicts - 1;
+	if (clientnum >= 0 && clientnum < MAX_CLIENTS)
+		snapshot_host[clientnum] = !strcmp (ip, "loopback");
+}
+
+qboolean G_SnapshotHost (edict_t *ent)
+{
+	int		clientnum;
+
+	clientnum = ent - g_edicts - 1;
+	return clientnum >= 0 && clientnum < MAX_CLIENTS && snapshot_host[clientnum];
+}
+
+/*
+=================
+G_QuickSave / G_QuickLoad
+=================
+*/
+qboolean G_QuickSave (void)
+{
+	return Snapshot_Take (&snapshots[QUICKSAVE_SNAPSHOT]);
+}
+
+qboolean G_QuickLoad (void)
+{
+	if (!Snapshot_Restorable (&snapshots[QUICKSAVE_SNAPSHOT]))
+		return false;
+	Snapshot_Restore (&snapshots[QUICKSAVE_SNAPSHOT]);
+	return true;
+}
+
+/*
+=================
+G_Rewind
+
+Restores the world to the rewind snapshot that is at least seconds old,
+or the oldest one there is.  Returns the seconds actually rewound, or -1.
+=================
+*/
+float G_Rewind (float seconds)
+{
+	snapshot_t	*snap, *best;
+	int			i;
+
+	best = NULL;
+	for (i=1 ; i<=MAX_REWIND_SNAPSHOTS ; i++)
+	{
+		snap = &snapshots[(rewind_head - i + MAX_REWIND_SNAPSHOTS) % MAX_REWIND_SNAPSHOTS];
+		if (!Snapshot_Restorable (snap))
+			break;
+		best = snap;
+		if (level.time - snap->level.time >= seconds)
+			break;
+	}
+	if (!best)
+		return -1;
+
+	seconds = level.time - best->level.time;
+	Snapshot_Restore (best);
+
+	// later snapshots are in the future now
+	for (i=0 ; i<MAX_REWIND_SNAPSHOTS ; i++)
+		if (snapshots[i].valid && snapshots[i].level.time > level.time)
+			snapshots[i].valid = false;
+	rewind_time = level.time + g_rewind->value;
+	return seconds;
+}
+
+/*
+=================
+G_RunSnapshots
+
+Called at the end of every frame to keep the rewind ring filled.
+=================
+*/
+void G_RunSnapshots (void)
+{
+	if (g_rewind->value <= 0 || deathmatch->value || level.intermissiontime)
+		return;
+	if (level.time < rewind_time)
+		return;
+
+	if (Snapshot_Take (&snapshots[rewind_head]))
+		rewind_head = (rewind_head + 1) % MAX_REWIND_SNAPSHOTS;
+	rewind_time = level.time + g_rewind->value;
+}
+
+/*
+=================
+G_ResetSnapshots
+
+Snapshots only hold for the level they were taken in.
+=================
+*/
+void G_ResetSnapshots (void)
+{
+	int		i;
+
+	for (i=0 ; i<MAX_SNAPSHOTS ; i++)
+		snapshots[i].valid = false;
+	rewind_head = 0;
+	rewind_time = 0;
+}
+
+void G_FreeSnapshots (void)
+{
+	int		i;
+
+	for (i=0 ; i<MAX_SNAPSHOTS ; i++)
+	{
+		free (snapshots[i].edicts);
+		free (snapshots[i].clients);
+		free (snapshots[i].blocks);
+	}
+	memset (snapshots, 0, sizeof(snapshots));
+	G_ResetSnapshots ();
+}
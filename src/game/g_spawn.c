@@ -325,45 +325,110 @@ spawn_t	spawns[] = {
 
 /*
 ===============
-ED_CallSpawn
+ED_FindSpawn
 
-Finds the spawn function for the entity and calls it
+Returns the spawn function for classname as an index that stays valid
+for the life of the dll: an itemlist index, -2 - an index into spawns[],
+or SPAWN_NONE.
 ===============
 */
-void ED_CallSpawn (edict_t *ent)
+int ED_FindSpawn (char *classname)
 {
 	spawn_t	*s;
 	gitem_t	*item;
-	int		i;
 
+	// check item spawn functions, which match case exactly
+	item = FindItemByClassname (classname);
+	if (item && !strcmp(item->classname, classname))
+		return ITEM_INDEX(item);
+
+	// check normal spawn functions
+	for (s=spawns ; s->name ; s++)
+	{
+		if (!strcmp(s->name, classname))
+			return -2 - (s - spawns);
+	}
+	return SPAWN_NONE;
+}
+
+/*
+===============
+ED_SpawnIndexValid
+
+True if spawn is something ED_FindSpawn could have returned.
+===============
+*/
+qboolean ED_SpawnIndexValid (int spawn)
+{
+	if (spawn >= 0)
+		return spawn < game.num_items;
+	if (spawn == SPAWN_NONE)
+		return true;
+	return -2 - spawn < (int)(sizeof(spawns)/sizeof(spawns[0])) - 1;
+}
+
+/*
+===============
+ED_CallSpawnIndex
+
+Calls a spawn function found by ED_FindSpawn.
+===============
+*/
+void ED_CallSpawnIndex (edict_t *ent, int spawn)
+{
+	if (spawn >= 0)
+		SpawnItem (ent, &itemlist[spawn]);
+	else if (spawn != SPAWN_NONE)
+		spawns[-2 - spawn].spawn (ent);
+	else
+		gi.dprintf ("%s doesn't have a spawn function\n", ent->classname);
+}
+
+/*
+===============
+ED_CallSpawn
+
+Finds the spawn function for the entity and calls it
+===============
+*/
+void ED_CallSpawn (edict_t *ent)
+{
 	if (!ent->classname)
 	{
 		gi.dprintf ("ED_CallSpawn: NULL classname\n");
 		return;
 	}
 
-	// check item spawn functions
-	for (i=0,item=itemlist ; i<game.num_items ; i++,item++)
+	ED_CallSpawnIndex (ent, ED_FindSpawn (ent->classname));
+}
+
+/*
+===============
+ED_SpawnTableHash
+
+Folds the spawn and item names into hash, so anything that stores
+ED_FindSpawn indexes can tell when they have moved.
+===============
+*/
+unsigned ED_SpawnTableHash (unsigned hash)
+{
+	spawn_t	*s;
+	char	*c;
+	int		i;
+
+	for (i=0 ; i<game.num_items ; i++)
 	{
-		if (!item->classname)
-			continue;
-		if (!strcmp(item->classname, ent->classname))
-		{	// found it
-			SpawnItem (ent, item);
-			return;
-		}
+		for (c=itemlist[i].classname ; c && *c ; c++)
+			hash = hash * 31 + *c;
+		hash = hash * 31 + '\n';
 	}
-
-	// check normal spawn functions
 	for (s=spawns ; s->name ; s++)
 	{
-		if (!strcmp(s->name, ent->classname))
-		{	// found it
-			s->spawn (ent);
-			return;
-		}
+		for (c=s->name ; *c ; c++)
+			hash = hash * 31 + *c;
+		hash = hash * 31 + '\n';
 	}
-	gi.dprintf ("%s doesn't have a spawn function\n", ent->classname);
+	return hash;
 }
 
 /*
@@ -378,7 +443,7 @@ char *ED_NewString (char *string)
 	
 	l = strlen(string) + 1;
 
-	newb = gi.TagMalloc (l, TAG_LEVEL);
+	newb = G_TagMalloc (l, TAG_LEVEL, "strings");
 
 	new_p = newb;
 
@@ -423,6 +488,8 @@ void ED_ParseField (char *key, char *value, edict_t *ent)
 		{	// found it
 			if (f->flags & FFL_SPAWNTEMP)
 				b = (byte *)&st;
+			else if (G_FieldExt (f) >= 0)
+				b = G_EdictExt (ent, G_FieldExt (f));
 			else
 				b = (byte *)ent;
 
@@ -450,6 +517,9 @@ void ED_ParseField (char *key, char *value, edict_t *ent)
 				((float *)(b+f->ofs))[2] = 0;
 				break;
 			case F_IGNORE:
+			case F_BYTES:		// save only
+			case F_LBLOCK:
+			case F_CAMERA:
 				break;
 			}
 			return;
@@ -506,7 +576,10 @@ char *ED_ParseEdict (char *data, edict_t *ent)
 	}
 
 	if (!init)
+	{
 		memset (ent, 0, sizeof(*ent));
+		G_SyncHotEdict (ent);
+	}
 
 	return data;
 }
@@ -575,10 +648,13 @@ parsing textual entity definitions out of an ent file.
 void SpawnEntities (char *mapname, char *entities, char *spawnpoint)
 {
 	edict_t		*ent;
+	entcache_t	*cache;
 	int			inhibit;
 	char		*com_token;
-	int			i;
+	int			i, num;
 	float		skill_level;
+	unsigned	seed, mapseed;
+	char		*c;
 
 	skill_level = floor (skill->value);
 	if (skill_level < 0)
@@ -590,10 +666,12 @@ void SpawnEntities (char *mapname, char *entities, char *spawnpoint)
 
 	SaveClientData ();
 
-        gi.FreeTags (TAG_LEVEL);
+        G_FreeTags (TAG_LEVEL);
+        G_ResetEdictExt ();
 
         memset (&level, 0, sizeof(level));
         memset (g_edicts, 0, game.maxentities * sizeof (g_edicts[0]));
+        G_ResyncHotEdicts ();
 
         Mission_BeginLevel (mapname);
 
@@ -604,24 +682,51 @@ void SpawnEntities (char *mapname, char *entities, char *spawnpoint)
 	for (i=0 ; i<game.maxclients ; i++)
 		g_edicts[i+1].client = game.clients + i;
 
+	// spawn functions that call random() have to spawn the map the same
+	// way every time, or level saves couldn't be written against the
+	// spawn baseline.  Deathmatch levels are never saved.
+	seed = G_RandState ();
+	if (!deathmatch->value)
+	{
+		mapseed = (unsigned)skill_level;
+		for (c=level.mapname ; *c ; c++)
+			mapseed = mapseed * 31 + *c;
+		G_SeedRand (mapseed);
+	}
+
+	// a map seen before is spawned from its compiled entities
+	cache = EntCache_Get (level.mapname, entities);
+
 	ent = NULL;
 	inhibit = 0;
 
 // parse ents
-	while (1)
+	for (num=0 ; ; num++)
 	{
-		// parse the opening brace	
-		com_token = COM_Parse (&entities);
-		if (!entities)
-			break;
-		if (com_token[0] != '{')
-			gi.error ("ED_LoadFromFile: found %s when expecting {",com_token);
+		if (cache)
+		{
+			if (num == EntCache_NumEdicts (cache))
+				break;
+		}
+		else
+		{
+			// parse the opening brace	
+			com_token = COM_Parse (&entities);
+			if (!entities)
+				break;
+			if (com_token[0] != '{')
+				gi.error ("ED_LoadFromFile: found %s when expecting {",com_token);
+		}
 
 		if (!ent)
 			ent = g_edicts;
 		else
 			ent = G_Spawn ();
-		entities = ED_ParseEdict (entities, ent);
+		G_MemEntity (ent);
+		if (cache)
+			EntCache_SpawnEdict (cache, num, ent);
+		else
+			entities = ED_ParseEdict (entities, ent);
 
 		// yet another map hack
 		if (!Q_stricmp(level.mapname, "command") && !Q_stricmp(ent->classname, "trigger_once") && !Q_stricmp(ent->model, "*27"))
@@ -656,8 +761,12 @@ void SpawnEntities (char *mapname, char *entities, char *spawnpoint)
 			ent->spawnflags &= ~(SPAWNFLAG_NOT_EASY|SPAWNFLAG_NOT_MEDIUM|SPAWNFLAG_NOT_HARD|SPAWNFLAG_NOT_COOP|SPAWNFLAG_NOT_DEATHMATCH);
 		}
 
-		ED_CallSpawn (ent);
+		if (cache)
+			EntCache_CallSpawn (cache, num, ent);
+		else
+			ED_CallSpawn (ent);
 	}	
+	G_MemEntity (NULL);
 
 	gi.dprintf ("%i entities inhibited\n", inhibit);
 
@@ -674,6 +783,12 @@ void SpawnEntities (char *mapname, char *entities, char *spawnpoint)
 	G_FindTeams ();
 
 	PlayerTrail_Init ();
+
+	G_SeedRand (seed);
+	if (deathmatch->value)
+		G_FreeSpawnBaseline ();
+	else
+		G_CaptureSpawnBaseline ();
 }
 
 
@@ -842,12 +957,23 @@ void SP_worldspawn (edict_t *ent)
 	ent->solid = SOLID_BSP;
 	ent->inuse = true;			// since the world doesn't use G_Spawn()
 	ent->s.modelindex = 1;		// world model is always index 1
+	G_SyncHotEdict (ent);
 
 	//---------------
 
 	// reserve some spots for dead player bodies for coop / deathmatch
 	InitBodyQue ();
 	G_ScreenFade_Reset ();
+	G_ResetExplosions ();
+	G_ResetRadiusCache ();
+	G_ResetDamage ();
+	G_ResetTempEntities ();
+	G_ResetLaserCache ();
+	G_ResetSnapshots ();
+	G_ResetAssets ();
+	G_ResetScoreboard ();
+	G_ResetClientStats ();
+	G_ResetSpawnSpots ();
 
 	// set configstrings for items
 	SetItemNames ();
@@ -909,7 +1035,7 @@ void SP_worldspawn (edict_t *ent)
 
 	snd_fry = gi.soundindex ("player/fry.wav");	// standing in lava / slime
 
-	PrecacheItem (FindItem ("Blaster"));
+	PrecacheItem (G_Item (ITEM_BLASTER));
 
 	gi.soundindex ("player/lava1.wav");
 	gi.soundindex ("player/lava2.wav");
@@ -988,6 +1114,8 @@ void SP_worldspawn (edict_t *ent)
 	gi.modelindex ("models/objects/gibs/skull/tris.md2");
 	gi.modelindex ("models/objects/gibs/head2/tris.md2");
 
+	G_PrecacheAssets ();
+
 //
 // Setup light animation tables. 'a' is total darkness, 'z' is doublebright.
 //
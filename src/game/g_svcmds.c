@@ -42,11 +42,14 @@ The ip address is specified in dot format, and any unspecified digits will match
 Removeip will only remove an address specified exactly the same way.  You cannot addip a subnet, then removeip a single host.
 
 listip
-Prints the current list of filters.
+Prints the current list of filters, with how many connects each one has matched.
 
 writeip
 Dumps "addip <ip>" commands to listip.cfg so it can be execed at a later date.  The filter lists are not saved and restored by default, because I beleive it would cause too much confusion.
 
+loadip [replace]
+Reads listip.cfg straight into the filter list, which is much quicker than execing a long one.  "replace" empties the list first.
+
 filterban <0 or 1>
 
 If 1 (the default), then ip addresses matching the current list will be prohibited from entering the game.  This is the default setting.
@@ -57,20 +60,37 @@ If 0, then only addresses matching the list will be allowed.  This lets you easi
 ==============================================================================
 */
 
+// every filter has whole octets masked, so most are a prefix of 8, 16, 24
+// or 32 bits and live in a binary trie that a lookup walks at most 32
+// steps down.  The rare ones with a wildcard octet in the middle, like
+// "192.0.40", are kept in a short list beside it.
+typedef struct ipnode_s
+{
+	struct ipnode_s	*child[2];
+	qboolean		filtered;
+	int				hits;
+} ipnode_t;
+
 typedef struct
 {
 	unsigned	mask;
 	unsigned	compare;
+	int			hits;
 } ipfilter_t;
 
-#define	MAX_IPFILTERS	1024
+static ipnode_t		ipfilter_root;
+static ipfilter_t	*ipsparse;
+static int			numipsparse, maxipsparse;
 
-ipfilter_t	ipfilters[MAX_IPFILTERS];
 int			numipfilters;
+static int	ipfilter_checks;
+static int	ipfilter_matches;
 
 /*
 =================
 StringToFilter
+
+Filters and addresses are held with the first octet in the top byte.
 =================
 */
 static qboolean StringToFilter (char *s, ipfilter_t *f)
@@ -95,7 +115,7 @@ static qboolean StringToFilter (char *s, ipfilter_t *f)
 		}
 		
 		j = 0;
-		while (*s >= '0' && *s <= '9')
+		while (*s >= '0' && *s <= '9' && j < sizeof(num)-1)
 		{
 			num[j++] = *s++;
 		}
@@ -109,12 +129,157 @@ static qboolean StringToFilter (char *s, ipfilter_t *f)
 		s++;
 	}
 	
-	f->mask = *(unsigned *)m;
-	f->compare = *(unsigned *)b;
+	f->mask = ((unsigned)m[0]<<24) | ((unsigned)m[1]<<16) | ((unsigned)m[2]<<8) | m[3];
+	f->compare = ((unsigned)b[0]<<24) | ((unsigned)b[1]<<16) | ((unsigned)b[2]<<8) | b[3];
+	f->hits = 0;
 	
 	return true;
 }
 
+/*
+=================
+FilterPrefixBits
+
+The length of f's mask if it is a prefix, otherwise -1.
+=================
+*/
+static int FilterPrefixBits (ipfilter_t *f)
+{
+	int		bits;
+
+	for (bits=0 ; bits<32 ; bits++)
+		if (!(f->mask & (0x80000000u >> bits)))
+			break;
+	if (bits < 32 && (f->mask << bits))
+		return -1;
+	return bits;
+}
+
+/*
+=================
+IP_AddFilter
+
+Returns false if the filter was already in the list.
+=================
+*/
+static qboolean IP_AddFilter (ipfilter_t *f)
+{
+	ipnode_t	*node;
+	int			bits, i, bit;
+
+	bits = FilterPrefixBits (f);
+	if (bits < 0)
+	{
+		for (i=0 ; i<numipsparse ; i++)
+			if (ipsparse[i].mask == f->mask && ipsparse[i].compare == f->compare)
+				return false;
+		if (numipsparse == maxipsparse)
+		{
+			maxipsparse = maxipsparse ? maxipsparse*2 : 16;
+			ipsparse = realloc (ipsparse, maxipsparse * sizeof(*ipsparse));
+			if (!ipsparse)
+				gi.error ("IP_AddFilter: out of memory");
+		}
+		ipsparse[numipsparse++] = *f;
+		numipfilters++;
+		return true;
+	}
+
+	node = &ipfilter_root;
+	for (i=0 ; i<bits ; i++)
+	{
+		bit = (f->compare >> (31 - i)) & 1;
+		if (!node->child[bit])
+		{
+			node->child[bit] = calloc (1, sizeof(ipnode_t));
+			if (!node->child[bit])
+				gi.error ("IP_AddFilter: out of memory");
+		}
+		node = node->child[bit];
+	}
+
+	if (node->filtered)
+		return false;
+	node->filtered = true;
+	node->hits = 0;
+	numipfilters++;
+	return true;
+}
+
+/*
+=================
+IP_RemoveFilter
+
+Returns false if the filter wasn't in the list.
+=================
+*/
+static qboolean IP_RemoveFilter (ipfilter_t *f)
+{
+	ipnode_t	*path[33];
+	ipnode_t	*node;
+	int			bits, i, bit;
+
+	bits = FilterPrefixBits (f);
+	if (bits < 0)
+	{
+		for (i=0 ; i<numipsparse ; i++)
+			if (ipsparse[i].mask == f->mask && ipsparse[i].compare == f->compare)
+			{
+				ipsparse[i] = ipsparse[--numipsparse];
+				numipfilters--;
+				return true;
+			}
+		return false;
+	}
+
+	node = &ipfilter_root;
+	path[0] = node;
+	for (i=0 ; i<bits ; i++)
+	{
+		node = node->child[(f->compare >> (31 - i)) & 1];
+		if (!node)
+			return false;
+		path[i+1] = node;
+	}
+
+	if (!node->filtered)
+		return false;
+	node->filtered = false;
+	numipfilters--;
+
+	// drop the branch if nothing else hangs off it
+	for (i=bits ; i>0 ; i--)
+	{
+		node = path[i];
+		if (node->filtered || node->child[0] || node->child[1])
+			break;
+		bit = (f->compare >> (32 - i)) & 1;
+		path[i-1]->child[bit] = NULL;
+		free (node);
+	}
+	return true;
+}
+
+static void IP_FreeNodes (ipnode_t *node)
+{
+	int		i;
+
+	for (i=0 ; i<2 ; i++)
+		if (node->child[i])
+		{
+			IP_FreeNodes (node->child[i]);
+			free (node->child[i]);
+		}
+}
+
+static void IP_ClearFilters (void)
+{
+	IP_FreeNodes (&ipfilter_root);
+	memset (&ipfilter_root, 0, sizeof(ipfilter_root));
+	numipsparse = 0;
+	numipfilters = 0;
+}
+
 /*
 =================
 SV_FilterPacket
@@ -122,13 +287,15 @@ SV_FilterPacket
 */
 qboolean SV_FilterPacket (char *from)
 {
-	int		i;
+	int		i, bits;
 	unsigned	in;
 	byte m[4];
 	char *p;
+	ipnode_t	*node;
 
 	i = 0;
 	p = from;
+	m[0] = m[1] = m[2] = m[3] = 0;
 	while (*p && i < 4) {
 		m[i] = 0;
 		while (*p >= '0' && *p <= '9') {
@@ -140,11 +307,32 @@ qboolean SV_FilterPacket (char *from)
 		i++, p++;
 	}
 	
-	in = *(unsigned *)m;
+	in = ((unsigned)m[0]<<24) | ((unsigned)m[1]<<16) | ((unsigned)m[2]<<8) | m[3];
+	ipfilter_checks++;
 
-	for (i=0 ; i<numipfilters ; i++)
-		if ( (in & ipfilters[i].mask) == ipfilters[i].compare)
+	node = &ipfilter_root;
+	for (bits=0 ; ; bits++)
+	{
+		if (node->filtered)
+		{
+			node->hits++;
+			ipfilter_matches++;
 			return (int)filterban->value;
+		}
+		if (bits == 32)
+			break;
+		node = node->child[(in >> (31 - bits)) & 1];
+		if (!node)
+			break;
+	}
+
+	for (i=0 ; i<numipsparse ; i++)
+		if ( (in & ipsparse[i].mask) == ipsparse[i].compare)
+		{
+			ipsparse[i].hits++;
+			ipfilter_matches++;
+			return (int)filterban->value;
+		}
 
 	return (int)!filterban->value;
 }
@@ -157,28 +345,15 @@ SV_AddIP_f
 */
 void SVCmd_AddIP_f (void)
 {
-	int		i;
-	
+	ipfilter_t	f;
+
 	if (gi.argc() < 3) {
 		gi.cprintf(NULL, PRINT_HIGH, "Usage:  addip <ip-mask>\n");
 		return;
 	}
 
-	for (i=0 ; i<numipfilters ; i++)
-		if (ipfilters[i].compare == 0xffffffff)
-			break;		// free spot
-	if (i == numipfilters)
-	{
-		if (numipfilters == MAX_IPFILTERS)
-		{
-			gi.cprintf (NULL, PRINT_HIGH, "IP filter list is full\n");
-			return;
-		}
-		numipfilters++;
-	}
-	
-	if (!StringToFilter (gi.argv(2), &ipfilters[i]))
-		ipfilters[i].compare = 0xffffffff;
+	if (StringToFilter (gi.argv(2), &f))
+		IP_AddFilter (&f);
 }
 
 /*
@@ -189,7 +364,6 @@ SV_RemoveIP_f
 void SVCmd_RemoveIP_f (void)
 {
 	ipfilter_t	f;
-	int			i, j;
 
 	if (gi.argc() < 3) {
 		gi.cprintf(NULL, PRINT_HIGH, "Usage:  sv removeip <ip-mask>\n");
@@ -199,56 +373,89 @@ void SVCmd_RemoveIP_f (void)
 	if (!StringToFilter (gi.argv(2), &f))
 		return;
 
-	for (i=0 ; i<numipfilters ; i++)
-		if (ipfilters[i].mask == f.mask
-		&& ipfilters[i].compare == f.compare)
-		{
-			for (j=i+1 ; j<numipfilters ; j++)
-				ipfilters[j-1] = ipfilters[j];
-			numipfilters--;
-			gi.cprintf (NULL, PRINT_HIGH, "Removed.\n");
-			return;
-		}
-	gi.cprintf (NULL, PRINT_HIGH, "Didn't find %s.\n", gi.argv(2));
+	if (IP_RemoveFilter (&f))
+		gi.cprintf (NULL, PRINT_HIGH, "Removed.\n");
+	else
+		gi.cprintf (NULL, PRINT_HIGH, "Didn't find %s.\n", gi.argv(2));
 }
 
 /*
 =================
-SV_ListIP_f
+IP_WalkFilters
+
+Calls func for every filter, the trie in address order and then the
+sparse ones.
 =================
 */
-void SVCmd_ListIP_f (void)
+static void IP_WalkNode (ipnode_t *node, unsigned compare, int bits, void (*func) (unsigned compare, int hits, void *arg), void *arg)
+{
+	if (node->filtered)
+		func (compare, node->hits, arg);
+	if (bits == 32)
+		return;
+	if (node->child[0])
+		IP_WalkNode (node->child[0], compare, bits+1, func, arg);
+	if (node->child[1])
+		IP_WalkNode (node->child[1], compare | (0x80000000u >> bits), bits+1, func, arg);
+}
+
+static void IP_WalkFilters (void (*func) (unsigned compare, int hits, void *arg), void *arg)
 {
 	int		i;
-	byte	b[4];
 
-	gi.cprintf (NULL, PRINT_HIGH, "Filter list:\n");
-	for (i=0 ; i<numipfilters ; i++)
-	{
-		*(unsigned *)b = ipfilters[i].compare;
-		gi.cprintf (NULL, PRINT_HIGH, "%3i.%3i.%3i.%3i\n", b[0], b[1], b[2], b[3]);
-	}
+	IP_WalkNode (&ipfilter_root, 0, 0, func, arg);
+	for (i=0 ; i<numipsparse ; i++)
+		func (ipsparse[i].compare, ipsparse[i].hits, arg);
+}
+
+static void IP_ListFilter (unsigned compare, int hits, void *arg)
+{
+	gi.cprintf (NULL, PRINT_HIGH, "%3i.%3i.%3i.%3i %8i hits\n", compare>>24, (compare>>16)&255,
+		(compare>>8)&255, compare&255, hits);
 }
 
 /*
 =================
-SV_WriteIP_f
+SV_ListIP_f
 =================
 */
-void SVCmd_WriteIP_f (void)
+void SVCmd_ListIP_f (void)
+{
+	gi.cprintf (NULL, PRINT_HIGH, "Filter list:\n");
+	IP_WalkFilters (IP_ListFilter, NULL);
+	gi.cprintf (NULL, PRINT_HIGH, "%i filters, %i of %i connects matched\n",
+		numipfilters, ipfilter_matches, ipfilter_checks);
+}
+
+static void IP_ListFileName (char *name, int size)
 {
-	FILE	*f;
-	char	name[MAX_OSPATH];
-	byte	b[4];
-	int		i;
 	cvar_t	*game;
 
 	game = gi.cvar("game", "", 0);
 
 	if (!*game->string)
-		sprintf (name, "%s/listip.cfg", GAMEVERSION);
+		Com_sprintf (name, size, "%s/listip.cfg", GAMEVERSION);
 	else
-		sprintf (name, "%s/listip.cfg", game->string);
+		Com_sprintf (name, size, "%s/listip.cfg", game->string);
+}
+
+static void IP_WriteFilter (unsigned compare, int hits, void *arg)
+{
+	fprintf ((FILE *)arg, "sv addip %i.%i.%i.%i\n", compare>>24, (compare>>16)&255,
+		(compare>>8)&255, compare&255);
+}
+
+/*
+=================
+SV_WriteIP_f
+=================
+*/
+void SVCmd_WriteIP_f (void)
+{
+	FILE	*f;
+	char	name[MAX_OSPATH];
+
+	IP_ListFileName (name, sizeof(name));
 
 	gi.cprintf (NULL, PRINT_HIGH, "Writing %s.\n", name);
 
@@ -261,13 +468,66 @@ void SVCmd_WriteIP_f (void)
 	
 	fprintf(f, "set filterban %d\n", (int)filterban->value);
 
-	for (i=0 ; i<numipfilters ; i++)
+	IP_WalkFilters (IP_WriteFilter, f);
+	
+	fclose (f);
+}
+
+/*
+=================
+SV_LoadIP_f
+
+Reads a listip.cfg written by writeip straight into the filter list,
+instead of running every line of it as a console command.
+=================
+*/
+void SVCmd_LoadIP_f (void)
+{
+	FILE		*f;
+	char		name[MAX_OSPATH];
+	char		line[256];
+	char		*p, *tok, *cmd;
+	ipfilter_t	filter;
+	int			added, lines;
+
+	IP_ListFileName (name, sizeof(name));
+
+	f = fopen (name, "rb");
+	if (!f)
 	{
-		*(unsigned *)b = ipfilters[i].compare;
-		fprintf (f, "sv addip %i.%i.%i.%i\n", b[0], b[1], b[2], b[3]);
+		gi.cprintf (NULL, PRINT_HIGH, "Couldn't open %s\n", name);
+		return;
+	}
+
+	if (gi.argc() > 2 && !Q_stricmp (gi.argv(2), "replace"))
+		IP_ClearFilters ();
+
+	added = lines = 0;
+	while (fgets (line, sizeof(line), f))
+	{
+		lines++;
+		p = line;
+		cmd = COM_Parse (&p);
+		if (!Q_stricmp (cmd, "sv"))
+			cmd = COM_Parse (&p);
+
+		if (!Q_stricmp (cmd, "addip"))
+		{
+			tok = COM_Parse (&p);
+			if (StringToFilter (tok, &filter) && IP_AddFilter (&filter))
+				added++;
+		}
+		else if (!Q_stricmp (cmd, "set"))
+		{
+			tok = COM_Parse (&p);
+			if (!Q_stricmp (tok, "filterban"))
+				gi.cvar_set ("filterban", COM_Parse (&p));
+		}
 	}
-	
 	fclose (f);
+
+	gi.cprintf (NULL, PRINT_HIGH, "%i filters added from %i lines of %s, %i in the list\n",
+		added, lines, name, numipfilters);
 }
 
 /*
@@ -294,6 +554,24 @@ static void Legacy_ServerCommand (void)
 		SVCmd_ListIP_f ();
 	else if (Q_stricmp (cmd, "writeip") == 0)
 		SVCmd_WriteIP_f ();
+	else if (Q_stricmp (cmd, "loadip") == 0)
+		SVCmd_LoadIP_f ();
+	else if (Q_stricmp (cmd, "edictmem") == 0)
+		Svcmd_EdictMem_f ();
+	else if (Q_stricmp (cmd, "hotbench") == 0)
+		Svcmd_HotBench_f ();
+	else if (Q_stricmp (cmd, "clientbench") == 0)
+		Svcmd_ClientBench_f ();
+	else if (Q_stricmp (cmd, "ratestats") == 0)
+		Svcmd_RateStats_f ();
+	else if (Q_stricmp (cmd, "quicksave") == 0)
+		Cmd_QuickSave_f (NULL);
+	else if (Q_stricmp (cmd, "quickload") == 0)
+		Cmd_QuickLoad_f (NULL);
+	else if (Q_stricmp (cmd, "rewind") == 0)
+		Cmd_Rewind_f (NULL);
+	else if (Q_stricmp (cmd, "mem") == 0)
+		Svcmd_Mem_f ();
 	else
 		gi.cprintf (NULL, PRINT_HIGH, "Unknown server command \"%s\"\n", cmd);
 }
@@ -159,30 +159,36 @@ When fired, the "message" key becomes the current personal computer string, and
 */
 void SP_target_help(edict_t *ent)
 {
+	mission_ext_t	*mis;
+
 	if (deathmatch->value)
 	{	// auto-remove for deathmatch
 		G_FreeEdict (ent);
 		return;
 	}
 
-	if (!ent->message && (!ent->oblivion.mission_text || !ent->oblivion.mission_text[0]))
+	// mission keys from the map have already given it an entry
+	mis = G_FindEdictExt (ent, EXT_MISSION);
+	if (!ent->message && (!mis || !mis->mission_text || !mis->mission_text[0]))
 	{
 		gi.dprintf ("%s with no message at %s\n", ent->classname, vtos(ent->s.origin));
 		G_FreeEdict (ent);
 		return;
 	}
 
-	if (!ent->oblivion.mission_id && ent->targetname && ent->targetname[0])
-		ent->oblivion.mission_id = ent->targetname;
+	mis = G_MissionExt(ent);
+
+	if (!mis->mission_id && ent->targetname && ent->targetname[0])
+		mis->mission_id = ent->targetname;
 
-	if (VectorCompare(ent->oblivion.mission_origin, vec3_origin))
-		VectorCopy(ent->s.origin, ent->oblivion.mission_origin);
+	if (VectorCompare(mis->mission_origin, vec3_origin))
+		VectorCopy(ent->s.origin, mis->mission_origin);
 
-	if (VectorCompare(ent->oblivion.mission_angles, vec3_origin))
-		VectorCopy(ent->s.angles, ent->oblivion.mission_angles);
+	if (VectorCompare(mis->mission_angles, vec3_origin))
+		VectorCopy(ent->s.angles, mis->mission_angles);
 
-	if (ent->oblivion.mission_timer_limit <= 0 && ent->wait > 0.0f)
-		ent->oblivion.mission_timer_limit = (int)floorf(ent->wait + 0.5f);
+	if (mis->mission_timer_limit <= 0 && ent->wait > 0.0f)
+		mis->mission_timer_limit = (int)floorf(ent->wait + 0.5f);
 
 	Mission_RegisterHelpTarget (ent);
 
@@ -665,6 +671,128 @@ When triggered, fires a laser.  You can either set a target
 or a direction.
 */
 
+/*
+Beam cache
+
+A laser whose last trace stopped on something that can't be hurt (the
+world or a brush that doesn't take damage) remembers where it ended.  The
+next frame only re-traces if its origin or movedir changed, or if the set
+of solid entities inside the beam's swept box (or any of their link
+counts) changed.  Movers relink whenever they move, so a door sliding
+through a beam still cuts it the same frame.
+
+Beams that pass through or end on anything damageable always trace, so
+damage ticks are unchanged.  g_laser_cache 0 turns the cache off.
+*/
+#define MAX_LASER_BOX_EDICTS	64
+
+typedef struct
+{
+	qboolean	valid;
+	vec3_t		origin;
+	vec3_t		movedir;
+	vec3_t		endpos;
+	vec3_t		normal;
+	int			box_count;
+	unsigned	box_hash;
+} laser_cache_t;
+
+static laser_cache_t	laser_cache[MAX_EDICTS];
+
+static void Laser_BeamBox (vec3_t start, vec3_t end, vec3_t mins, vec3_t maxs)
+{
+	int		i;
+
+	for (i=0 ; i<3 ; i++)
+	{
+		mins[i] = (start[i] < end[i] ? start[i] : end[i]) - 1;
+		maxs[i] = (start[i] > end[i] ? start[i] : end[i]) + 1;
+	}
+}
+
+/*
+=================
+Laser_BoxSignature
+
+Returns false if the box holds too many entities to be worth caching.
+=================
+*/
+static qboolean Laser_BoxSignature (edict_t *self, vec3_t end, int *count, unsigned *hash)
+{
+	edict_t		*list[MAX_LASER_BOX_EDICTS];
+	vec3_t		mins, maxs;
+	unsigned	h;
+	int			i, num;
+
+	Laser_BeamBox (self->s.origin, end, mins, maxs);
+	num = gi.BoxEdicts (mins, maxs, list, MAX_LASER_BOX_EDICTS, AREA_SOLID);
+	if (num == MAX_LASER_BOX_EDICTS)
+		return false;
+
+	// the order BoxEdicts returns is stable while nothing relinks
+	h = 2166136261u;
+	for (i=0 ; i<num ; i++)
+	{
+		h = (h ^ (unsigned)(list[i] - g_edicts)) * 16777619u;
+		h = (h ^ (unsigned)list[i]->linkcount) * 16777619u;
+	}
+
+	*count = num;
+	*hash = h;
+	return true;
+}
+
+static laser_cache_t *Laser_CachedBeam (edict_t *self)
+{
+	laser_cache_t	*lc;
+	unsigned		hash;
+	int				count;
+
+	if (!g_laser_cache->value)
+		return NULL;
+
+	lc = &laser_cache[self - g_edicts];
+	if (!lc->valid)
+		return NULL;
+	if (!VectorCompare (lc->origin, self->s.origin) || !VectorCompare (lc->movedir, self->movedir))
+		return NULL;
+	if (!Laser_BoxSignature (self, lc->endpos, &count, &hash))
+		return NULL;
+	if (count != lc->box_count || hash != lc->box_hash)
+		return NULL;
+
+	return lc;
+}
+
+static void Laser_StoreBeam (edict_t *self, trace_t *tr, qboolean cacheable)
+{
+	laser_cache_t	*lc;
+
+	lc = &laser_cache[self - g_edicts];
+	lc->valid = false;
+	if (!cacheable || !g_laser_cache->value)
+		return;
+	if (!Laser_BoxSignature (self, tr->endpos, &lc->box_count, &lc->box_hash))
+		return;
+
+	VectorCopy (self->s.origin, lc->origin);
+	VectorCopy (self->movedir, lc->movedir);
+	VectorCopy (tr->endpos, lc->endpos);
+	VectorCopy (tr->plane.normal, lc->normal);
+	lc->valid = true;
+}
+
+/*
+=================
+G_ResetLaserCache
+=================
+*/
+void G_ResetLaserCache (void)
+{
+	memset (laser_cache, 0, sizeof(laser_cache));
+}
+
+
 void target_laser_think (edict_t *self)
 {
 	edict_t	*ignore;
@@ -674,6 +802,8 @@ void target_laser_think (edict_t *self)
 	vec3_t	point;
 	vec3_t	last_movedir;
 	int		count;
+	laser_cache_t	*lc;
+	qboolean	cacheable;
 
 	if (self->spawnflags & 0x80000000)
 		count = 8;
@@ -690,6 +820,22 @@ void target_laser_think (edict_t *self)
 			self->spawnflags |= 0x80000000;
 	}
 
+	lc = Laser_CachedBeam (self);
+	if (lc)
+	{
+		// nothing in the beam has moved since it was last traced
+		if (self->spawnflags & 0x80000000)
+		{
+			self->spawnflags &= ~0x80000000;
+			G_TempEntitySplash (TE_LASER_SPARKS, count, lc->endpos, lc->normal, self->s.skinnum, MULTICAST_PVS);
+		}
+		VectorCopy (lc->endpos, self->s.old_origin);
+		self->nextthink = level.time + FRAMETIME;
+		return;
+	}
+
+	// only a beam that goes straight to something harmless can be cached
+	cacheable = true;
 	ignore = self;
 	VectorCopy (self->s.origin, start);
 	VectorMA (start, 2048, self->movedir, end);
@@ -698,7 +844,13 @@ void target_laser_think (edict_t *self)
 		tr = gi.trace (start, NULL, NULL, end, ignore, CONTENTS_SOLID|CONTENTS_MONSTER|CONTENTS_DEADMONSTER);
 
 		if (!tr.ent)
+		{
+			cacheable = false;
 			break;
+		}
+
+		if (tr.ent->takedamage)
+			cacheable = false;
 
 		// hurt it if we can
 		if ((tr.ent->takedamage) && !(tr.ent->flags & FL_IMMUNE_LASER))
@@ -710,21 +862,17 @@ void target_laser_think (edict_t *self)
 			if (self->spawnflags & 0x80000000)
 			{
 				self->spawnflags &= ~0x80000000;
-				gi.WriteByte (svc_temp_entity);
-				gi.WriteByte (TE_LASER_SPARKS);
-				gi.WriteByte (count);
-				gi.WritePosition (tr.endpos);
-				gi.WriteDir (tr.plane.normal);
-				gi.WriteByte (self->s.skinnum);
-				gi.multicast (tr.endpos, MULTICAST_PVS);
+				G_TempEntitySplash (TE_LASER_SPARKS, count, tr.endpos, tr.plane.normal, self->s.skinnum, MULTICAST_PVS);
 			}
 			break;
 		}
 
 		ignore = tr.ent;
+		cacheable = false;
 		VectorCopy (tr.endpos, start);
 	}
 
+	Laser_StoreBeam (self, &tr, cacheable);
 	VectorCopy (tr.endpos, self->s.old_origin);
 
 	self->nextthink = level.time + FRAMETIME;
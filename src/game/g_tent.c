@@ -0,0 +1,433 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_tent.c -- temp entity batching
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+TEMP ENTITY BATCHING
+
+Impact effects (gunshot puffs, blood, sparks, water splashes, laser
+sparks) used to be written and multicast the moment they happened.  A
+shotgun volley into a crowd or a room of target_lasers could overflow the
+clients' datagrams, which drops the whole packet.
+
+With g_te_batch set, those effects are queued for the frame instead.  An
+effect that repeats one already queued with the same type, multicast and
+position cell is merged into it (splash and laser spark particle counts
+are added together).  G_FlushTempEntities then writes the survivors after
+checking two optional budgets, which only ever drop cosmetic effects:
+
+g_te_pvs_budget		max effects sent into one potentially visible set
+g_te_client_budget	max effects any single client is sent
+
+Both default to 0, unlimited.  Which clients an effect reaches is worked
+out once for each TENT_REACH_SIZE cell and multicast, not for every
+effect.  The queue is flushed at the end of the frame and at the end of
+every ClientThink, so a client's shots go out with the messages they are
+sent alongside.
+
+g_te_stats 1 prints how many effects and bytes were saved each frame.
+
+==============================================================================
+*/
+
+#define MAX_QUEUED_TENTS	256
+#define TENT_HASH_SIZE		512		// must be a power of two
+#define TENT_CELL_SIZE		16
+#define MAX_TENT_ANCHORS	32
+#define TENT_REACH_SIZE		64
+#define MAX_TENT_REACH		32
+
+typedef enum
+{
+	TENT_POINT,			// type, position
+	TENT_POINT_DIR,		// type, position, dir
+	TENT_SPLASH			// type, count, position, dir, color
+} tent_format_t;
+
+typedef struct
+{
+	int				type;
+	tent_format_t	format;
+	multicast_t		to;
+	vec3_t			pos;
+	vec3_t			dir;
+	int				count;
+	int				color;
+	int				cell[3];
+	int				next;		// hash chain
+} queued_tent_t;
+
+typedef struct
+{
+	int		queued;
+	int		merged;
+	int		dropped;
+	int		sent;
+	int		bytes_saved;
+} tent_stats_t;
+
+// the clients that effects around one spot reach
+typedef struct
+{
+	int				cell[3];
+	multicast_t		to;
+	int				num_reached;
+	int				reached[MAX_CLIENTS];
+} tent_reach_t;
+
+static queued_tent_t	tent_queue[MAX_QUEUED_TENTS];
+static int				num_tents;
+static int				tent_hash[TENT_HASH_SIZE];	// index + 1, 0 = empty
+static tent_stats_t		tent_stats;
+static tent_reach_t		tent_reach[MAX_TENT_REACH + 1];	// the last is scratch
+static int				num_reach;
+
+static int Tent_Size (queued_tent_t *te)
+{
+	// svc_temp_entity + type + position (3 shorts)
+	switch (te->format)
+	{
+	case TENT_POINT:
+		return 8;
+	case TENT_POINT_DIR:
+		return 9;
+	default:
+		return 11;
+	}
+}
+
+static void Tent_Write (queued_tent_t *te)
+{
+	gi.WriteByte (svc_temp_entity);
+	gi.WriteByte (te->type);
+	if (te->format == TENT_SPLASH)
+		gi.WriteByte (te->count);
+	gi.WritePosition (te->pos);
+	if (te->format != TENT_POINT)
+		gi.WriteDir (te->dir);
+	if (te->format == TENT_SPLASH)
+		gi.WriteByte (te->color);
+	gi.multicast (te->pos, te->to);
+}
+
+/*
+=================
+Tent_Droppable
+
+Only effects that mark where something was hit may be dropped to stay
+within a budget; explosions and trails always go out.
+=================
+*/
+static qboolean Tent_Droppable (int type)
+{
+	switch (type)
+	{
+	case TE_GUNSHOT:
+	case TE_SHOTGUN:
+	case TE_BLOOD:
+	case TE_SPARKS:
+	case TE_BULLET_SPARKS:
+	case TE_SCREEN_SPARKS:
+	case TE_SHIELD_SPARKS:
+	case TE_SPLASH:
+	case TE_LASER_SPARKS:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static void Tent_Queue (queued_tent_t *in)
+{
+	queued_tent_t	*te;
+	unsigned		hash;
+	int				i;
+
+	if (!g_te_batch->value || num_tents == MAX_QUEUED_TENTS)
+	{
+		Tent_Write (in);
+		return;
+	}
+
+	tent_stats.queued++;
+
+	for (i=0 ; i<3 ; i++)
+		in->cell[i] = (int)floor (in->pos[i] / TENT_CELL_SIZE);
+	hash = ((unsigned)in->cell[0] * 73856093u ^ (unsigned)in->cell[1] * 19349663u
+		^ (unsigned)in->cell[2] * 83492791u ^ (unsigned)in->type) & (TENT_HASH_SIZE - 1);
+
+	for (i=tent_hash[hash] ; i ; i=te->next)
+	{
+		te = &tent_queue[i-1];
+		if (te->type != in->type || te->to != in->to)
+			continue;
+		if (te->cell[0] != in->cell[0] || te->cell[1] != in->cell[1] || te->cell[2] != in->cell[2])
+			continue;
+		if (te->format == TENT_SPLASH)
+		{
+			if (te->color != in->color)
+				continue;
+			te->count += in->count;
+			if (te->count > 255)
+				te->count = 255;
+		}
+
+		tent_stats.merged++;
+		tent_stats.bytes_saved += Tent_Size (in);
+		return;
+	}
+
+	te = &tent_queue[num_tents++];
+	*te = *in;
+	te->next = tent_hash[hash];
+	tent_hash[hash] = num_tents;
+}
+
+/*
+=================
+G_TempEntityPoint / G_TempEntityDir / G_TempEntitySplash
+
+Queue a temp entity that is multicast from its own position.
+=================
+*/
+void G_TempEntityPoint (int type, vec3_t pos, multicast_t to)
+{
+	queued_tent_t	te;
+
+	memset (&te, 0, sizeof(te));
+	te.type = type;
+	te.format = TENT_POINT;
+	te.to = to;
+	VectorCopy (pos, te.pos);
+	Tent_Queue (&te);
+}
+
+void G_TempEntityDir (int type, vec3_t pos, vec3_t dir, multicast_t to)
+{
+	queued_tent_t	te;
+
+	memset (&te, 0, sizeof(te));
+	te.type = type;
+	te.format = TENT_POINT_DIR;
+	te.to = to;
+	VectorCopy (pos, te.pos);
+	VectorCopy (dir, te.dir);
+	Tent_Queue (&te);
+}
+
+void G_TempEntitySplash (int type, int count, vec3_t pos, vec3_t dir, int color, multicast_t to)
+{
+	queued_tent_t	te;
+
+	memset (&te, 0, sizeof(te));
+	te.type = type;
+	te.format = TENT_SPLASH;
+	te.to = to;
+	te.count = count;
+	te.color = color;
+	VectorCopy (pos, te.pos);
+	VectorCopy (dir, te.dir);
+	Tent_Queue (&te);
+}
+
+static multicast_t Tent_ReachClass (multicast_t to)
+{
+	if (to == MULTICAST_ALL || to == MULTICAST_ALL_R)
+		return MULTICAST_ALL;
+	if (to == MULTICAST_PHS || to == MULTICAST_PHS_R)
+		return MULTICAST_PHS;
+	return MULTICAST_PVS;
+}
+
+/*
+=================
+Tent_Reach
+
+Returns the clients te reaches.  The views are tested from the first
+effect queued in te's cell, and every later effect there shares the
+answers.
+=================
+*/
+static tent_reach_t *Tent_Reach (queued_tent_t *te, vec3_t *views, int *viewers, int num_viewers)
+{
+	tent_reach_t	*r;
+	multicast_t		to;
+	int				cell[3];
+	int				i;
+	qboolean		reaches;
+
+	to = Tent_ReachClass (te->to);
+	for (i=0 ; i<3 ; i++)
+		cell[i] = (int)floor (te->pos[i] / TENT_REACH_SIZE);
+
+	for (i=0, r=tent_reach ; i<num_reach ; i++, r++)
+	{
+		if (r->to == to && r->cell[0] == cell[0] && r->cell[1] == cell[1] && r->cell[2] == cell[2])
+			return r;
+	}
+
+	if (num_reach < MAX_TENT_REACH)
+		r = &tent_reach[num_reach++];
+	else
+		r = &tent_reach[MAX_TENT_REACH];
+	VectorCopy (cell, r->cell);
+	r->to = to;
+	r->num_reached = 0;
+
+	for (i=0 ; i<num_viewers ; i++)
+	{
+		if (to == MULTICAST_ALL)
+			reaches = true;
+		else if (to == MULTICAST_PHS)
+			reaches = gi.inPHS (views[i], te->pos);
+		else
+			reaches = gi.inPVS (views[i], te->pos);
+		if (reaches)
+			r->reached[r->num_reached++] = viewers[i];
+	}
+	return r;
+}
+
+/*
+=================
+G_FlushTempEntities
+
+Writes the queued temp entities in the order they were queued.
+=================
+*/
+void G_FlushTempEntities (void)
+{
+	queued_tent_t	*te;
+	vec3_t			anchors[MAX_TENT_ANCHORS];
+	int				anchor_counts[MAX_TENT_ANCHORS];
+	int				client_counts[MAX_CLIENTS];
+	vec3_t			views[MAX_CLIENTS];
+	int				viewers[MAX_CLIENTS];
+	tent_reach_t	*reach;
+	int				num_anchors, num_viewers;
+	int				pvs_budget, client_budget;
+	edict_t			*cl;
+	int				i, j;
+	qboolean		drop;
+
+	if (!num_tents)
+		return;
+
+	pvs_budget = (int)g_te_pvs_budget->value;
+	client_budget = (int)g_te_client_budget->value;
+	num_anchors = 0;
+	num_reach = 0;
+	memset (client_counts, 0, sizeof(client_counts));
+
+	num_viewers = 0;
+	if (client_budget > 0)
+	{
+		for (j=0 ; j<game.maxclients && j<MAX_CLIENTS ; j++)
+		{
+			cl = g_edicts + 1 + j;
+			if (!cl->inuse)
+				continue;
+			VectorCopy (cl->s.origin, views[num_viewers]);
+			views[num_viewers][2] += cl->viewheight;
+			viewers[num_viewers++] = j;
+		}
+	}
+
+	for (i=0, te=tent_queue ; i<num_tents ; i++, te++)
+	{
+		drop = false;
+
+		if (pvs_budget > 0)
+		{
+			for (j=0 ; j<num_anchors ; j++)
+			{
+				if (gi.inPVS (anchors[j], te->pos))
+					break;
+			}
+			if (j == num_anchors && num_anchors < MAX_TENT_ANCHORS)
+			{
+				VectorCopy (te->pos, anchors[j]);
+				anchor_counts[j] = 0;
+				num_anchors++;
+			}
+			if (j < num_anchors)
+			{
+				if (anchor_counts[j] >= pvs_budget && Tent_Droppable (te->type))
+					drop = true;
+				else
+					anchor_counts[j]++;
+			}
+		}
+
+		if (!drop && client_budget > 0)
+		{
+			reach = Tent_Reach (te, views, viewers, num_viewers);
+			if (Tent_Droppable (te->type))
+			{
+				for (j=0 ; j<reach->num_reached ; j++)
+				{
+					if (client_counts[reach->reached[j]] >= client_budget)
+					{
+						drop = true;
+						break;
+					}
+				}
+			}
+			if (!drop)
+			{
+				for (j=0 ; j<reach->num_reached ; j++)
+					client_counts[reach->reached[j]]++;
+			}
+		}
+
+		if (drop)
+		{
+			tent_stats.dropped++;
+			tent_stats.bytes_saved += Tent_Size (te);
+			continue;
+		}
+
+		Tent_Write (te);
+		tent_stats.sent++;
+	}
+
+	if (g_te_stats->value && tent_stats.queued)
+		gi.dprintf ("tent: frame %i, %i queued, %i merged, %i dropped, %i sent, %i bytes saved\n",
+			level.framenum, tent_stats.queued, tent_stats.merged, tent_stats.dropped,
+			tent_stats.sent, tent_stats.bytes_saved);
+
+	G_ResetTempEntities ();
+}
+
+/*
+=================
+G_ResetTempEntities
+=================
+*/
+void G_ResetTempEntities (void)
+{
+	num_tents = 0;
+	memset (tent_hash, 0, sizeof(tent_hash));
+	memset (&tent_stats, 0, sizeof(tent_stats));
+}
@@ -21,6 +21,36 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include "g_local.h"
 
+/*
+=================
+G_Rand / G_SeedRand / G_RandState
+
+The game's own generator, used instead of the C library's rand so
+SpawnEntities can seed it for a repeatable spawn without disturbing
+anything else that shares the C runtime.  Each thread has its own state;
+the client workers seed theirs when they start.  Returns 0 to 0x7fffffff.
+=================
+*/
+static THREADLOCAL unsigned	rand_state = 2463534242u;
+
+int G_Rand (void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+	return (int)(rand_state & 0x7fffffff);
+}
+
+void G_SeedRand (unsigned seed)
+{
+	rand_state = seed ? seed : 2463534242u;
+}
+
+unsigned G_RandState (void)
+{
+	return rand_state;
+}
+
 
 void G_ProjectSource (vec3_t point, vec3_t distance, vec3_t forward, vec3_t right, vec3_t result)
 {
@@ -143,7 +173,7 @@ edict_t *G_PickTarget (char *targetname)
 		return NULL;
 	}
 
-	return choice[rand() % num_choices];
+	return choice[G_Rand() % num_choices];
 }
 
 
@@ -392,7 +422,7 @@ char *G_CopyString (char *in)
 {
 	char	*out;
 	
-	out = gi.TagMalloc (strlen(in)+1, TAG_LEVEL);
+	out = G_TagMalloc (strlen(in)+1, TAG_LEVEL, "strings");
 	strcpy (out, in);
 	return out;
 }
@@ -404,6 +434,7 @@ void G_InitEdict (edict_t *e)
 	e->classname = "noclass";
 	e->gravity = 1.0;
 	e->s.number = e - g_edicts;
+	G_SyncHotEdict (e);
 }
 
 /*
@@ -425,9 +456,11 @@ edict_t *G_Spawn (void)
 	e = &g_edicts[(int)maxclients->value+1];
 	for ( i=maxclients->value+1 ; i<globals.num_edicts ; i++, e++)
 	{
+		if (g_hot[i].inuse)
+			continue;
 		// the first couple seconds of server time can involve a lot of
 		// freeing and allocating, so relax the replacement policy
-		if (!e->inuse && ( e->freetime < 2 || level.time - e->freetime > 0.5 ) )
+		if ( e->freetime < 2 || level.time - e->freetime > 0.5 )
 		{
 			G_InitEdict (e);
 			return e;
@@ -459,10 +492,12 @@ void G_FreeEdict (edict_t *ed)
 		return;
 	}
 
+	G_FreeEdictExt (ed);
 	memset (ed, 0, sizeof(*ed));
 	ed->classname = "freed";
 	ed->freetime = level.time;
 	ed->inuse = false;
+	G_SyncHotEdict (ed);
 }
 
 
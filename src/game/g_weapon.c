@@ -190,13 +190,7 @@ static void fire_lead (edict_t *self, vec3_t start, vec3_t aimdir, int damage, i
 
 				if (color != SPLASH_UNKNOWN)
 				{
-					gi.WriteByte (svc_temp_entity);
-					gi.WriteByte (TE_SPLASH);
-					gi.WriteByte (8);
-					gi.WritePosition (tr.endpos);
-					gi.WriteDir (tr.plane.normal);
-					gi.WriteByte (color);
-					gi.multicast (tr.endpos, MULTICAST_PVS);
+					G_TempEntitySplash (TE_SPLASH, 8, tr.endpos, tr.plane.normal, color, MULTICAST_PVS);
 				}
 
 				// change bullet's course when it enters water
@@ -228,11 +222,7 @@ static void fire_lead (edict_t *self, vec3_t start, vec3_t aimdir, int damage, i
 			{
 				if (strncmp (tr.surface->name, "sky", 3) != 0)
 				{
-					gi.WriteByte (svc_temp_entity);
-					gi.WriteByte (te_impact);
-					gi.WritePosition (tr.endpos);
-					gi.WriteDir (tr.plane.normal);
-					gi.multicast (tr.endpos, MULTICAST_PVS);
+					G_TempEntityDir (te_impact, tr.endpos, tr.plane.normal, MULTICAST_PVS);
 
 					if (self->client)
 						PlayerNoise(self, tr.endpos, PNOISE_IMPACT);
@@ -368,8 +358,8 @@ void fire_blaster_with_mod (edict_t *self, vec3_t start, vec3_t dir, int damage,
 	bolt->s.effects |= effect;
 	VectorClear (bolt->mins);
 	VectorClear (bolt->maxs);
-	bolt->s.modelindex = gi.modelindex ("models/objects/laser/tris.md2");
-	bolt->s.sound = gi.soundindex ("misc/lasfly.wav");
+	bolt->s.modelindex = G_Asset (MDL_LASER);
+	bolt->s.sound = G_Asset (SND_LASER_FLY);
 	bolt->owner = self;
 	bolt->touch = blaster_touch;
 	bolt->nextthink = level.time + 2;
@@ -437,7 +427,7 @@ static void Grenade_Explode (edict_t *ent)
 		mod = MOD_HG_SPLASH;
 	else
 		mod = MOD_G_SPLASH;
-	T_RadiusDamage(ent, ent->owner, ent->dmg, ent->enemy, ent->dmg_radius, mod);
+	T_QueueRadiusDamage (ent, ent->owner, ent->dmg, ent->enemy, ent->dmg_radius, mod);
 
 	VectorMA (ent->s.origin, -0.02, ent->velocity, origin);
 	gi.WriteByte (svc_temp_entity);
@@ -480,8 +470,8 @@ void fire_plasma_bolt (edict_t *self, vec3_t start, vec3_t dir, int damage, int
 	bolt->s.effects |= effect;
 	VectorClear (bolt->mins);
 	VectorClear (bolt->maxs);
-	bolt->s.modelindex = gi.modelindex ("models/objects/laser/tris.md2");
-	bolt->s.sound = gi.soundindex ("misc/lasfly.wav");
+	bolt->s.modelindex = G_Asset (MDL_LASER);
+	bolt->s.sound = G_Asset (SND_LASER_FLY);
 	bolt->owner = self;
 	bolt->touch = blaster_touch;
 	bolt->nextthink = level.time + 2;
@@ -518,13 +508,13 @@ static void Grenade_Touch (edict_t *ent, edict_t *other, cplane_t *plane, csurfa
 		if (ent->spawnflags & 1)
 		{
 			if (random() > 0.5)
-				gi.sound (ent, CHAN_VOICE, gi.soundindex ("weapons/hgrenb1a.wav"), 1, ATTN_NORM, 0);
+				gi.sound (ent, CHAN_VOICE, G_Asset (SND_GRENADE_BOUNCE1), 1, ATTN_NORM, 0);
 			else
-				gi.sound (ent, CHAN_VOICE, gi.soundindex ("weapons/hgrenb2a.wav"), 1, ATTN_NORM, 0);
+				gi.sound (ent, CHAN_VOICE, G_Asset (SND_GRENADE_BOUNCE2), 1, ATTN_NORM, 0);
 		}
 		else
 		{
-			gi.sound (ent, CHAN_VOICE, gi.soundindex ("weapons/grenlb1b.wav"), 1, ATTN_NORM, 0);
+			gi.sound (ent, CHAN_VOICE, G_Asset (SND_GRENADE_LAUNCHER_BOUNCE), 1, ATTN_NORM, 0);
 		}
 		return;
 	}
@@ -554,7 +544,7 @@ void fire_grenade (edict_t *self, vec3_t start, vec3_t aimdir, int damage, int s
 	grenade->s.effects |= EF_GRENADE;
 	VectorClear (grenade->mins);
 	VectorClear (grenade->maxs);
-	grenade->s.modelindex = gi.modelindex ("models/objects/grenade/tris.md2");
+	grenade->s.modelindex = G_Asset (MDL_GRENADE);
 	grenade->owner = self;
 	grenade->touch = Grenade_Touch;
 	grenade->nextthink = level.time + timer;
@@ -587,7 +577,7 @@ void fire_grenade2 (edict_t *self, vec3_t start, vec3_t aimdir, int damage, int
 	grenade->s.effects |= EF_GRENADE;
 	VectorClear (grenade->mins);
 	VectorClear (grenade->maxs);
-	grenade->s.modelindex = gi.modelindex ("models/objects/grenade2/tris.md2");
+	grenade->s.modelindex = G_Asset (MDL_GRENADE2);
 	grenade->owner = self;
 	grenade->touch = Grenade_Touch;
 	grenade->nextthink = level.time + timer;
@@ -599,13 +589,13 @@ void fire_grenade2 (edict_t *self, vec3_t start, vec3_t aimdir, int damage, int
 		grenade->spawnflags = 3;
 	else
 		grenade->spawnflags = 1;
-	grenade->s.sound = gi.soundindex("weapons/hgrenc1b.wav");
+	grenade->s.sound = G_Asset (SND_GRENADE_FUSE);
 
 	if (timer <= 0.0)
 		Grenade_Explode (grenade);
 	else
 	{
-		gi.sound (self, CHAN_WEAPON, gi.soundindex ("weapons/hgrent1a.wav"), 1, ATTN_NORM, 0);
+		gi.sound (self, CHAN_WEAPON, G_Asset (SND_GRENADE_TOSS), 1, ATTN_NORM, 0);
 		gi.linkentity (grenade);
 	}
 }
@@ -648,7 +638,7 @@ void rocket_touch (edict_t *ent, edict_t *other, cplane_t *plane, csurface_t *su
 		{
 			if ((surf) && !(surf->flags & (SURF_WARP|SURF_TRANS33|SURF_TRANS66|SURF_FLOWING)))
 			{
-				n = rand() % 5;
+				n = G_Rand() % 5;
 				while(n--)
 					ThrowDebris (ent, "models/objects/debris2/tris.md2", 2, ent->s.origin);
 			}
@@ -686,7 +676,7 @@ void fire_rocket (edict_t *self, vec3_t start, vec3_t dir, int damage, int speed
 	rocket->s.effects |= EF_ROCKET;
 	VectorClear (rocket->mins);
 	VectorClear (rocket->maxs);
-	rocket->s.modelindex = gi.modelindex ("models/objects/rocket/tris.md2");
+	rocket->s.modelindex = G_Asset (MDL_ROCKET);
 	rocket->owner = self;
 	rocket->touch = rocket_touch;
 	rocket->nextthink = level.time + 8000/speed;
@@ -694,7 +684,7 @@ void fire_rocket (edict_t *self, vec3_t start, vec3_t dir, int damage, int speed
 	rocket->dmg = damage;
 	rocket->radius_dmg = radius_damage;
 	rocket->dmg_radius = damage_radius;
-	rocket->s.sound = gi.soundindex ("weapons/rockfly.wav");
+	rocket->s.sound = G_Asset (SND_ROCKET_FLY);
 	rocket->classname = "rocket";
 
 	if (self->client)
@@ -718,7 +708,7 @@ void fire_oblivion_rocket (edict_t *self, vec3_t start, vec3_t dir, int damage,
 	rocket->s.effects |= EF_ROCKET;
 	VectorClear (rocket->mins);
 	VectorClear (rocket->maxs);
-	rocket->s.modelindex = gi.modelindex ("models/objects/rocket/tris.md2");
+	rocket->s.modelindex = G_Asset (MDL_ROCKET);
 	rocket->owner = self;
 	rocket->touch = rocket_touch;
 	rocket->nextthink = level.time + 8000/speed;
@@ -726,7 +716,7 @@ void fire_oblivion_rocket (edict_t *self, vec3_t start, vec3_t dir, int damage,
 	rocket->dmg = damage;
 	rocket->radius_dmg = radius_damage;
 	rocket->dmg_radius = damage_radius;
-	rocket->s.sound = gi.soundindex ("weapons/rockfly.wav");
+	rocket->s.sound = G_Asset (SND_ROCKET_FLY);
 	rocket->classname = "rocket";
 	rocket->count = direct_mod;
 	rocket->mass = splash_mod;
@@ -823,9 +813,9 @@ void bfg_explode (edict_t *self)
 				continue;
 			if (ent == self->owner)
 				continue;
-			if (!CanDamage (ent, self))
+			if (!CanRadiusDamage (ent, self))
 				continue;
-			if (!CanDamage (ent, self->owner))
+			if (!CanRadiusDamage (ent, self->owner))
 				continue;
 
 			VectorAdd (ent->mins, ent->maxs, v);
@@ -869,12 +859,12 @@ void bfg_touch (edict_t *self, edict_t *other, cplane_t *plane, csurface_t *surf
 		T_Damage (other, self, self->owner, self->velocity, self->s.origin, plane->normal, 200, 0, 0, MOD_BFG_BLAST);
 	T_RadiusDamage(self, self->owner, 200, other, 100, MOD_BFG_BLAST);
 
-	gi.sound (self, CHAN_VOICE, gi.soundindex ("weapons/bfg__x1b.wav"), 1, ATTN_NORM, 0);
+	gi.sound (self, CHAN_VOICE, G_Asset (SND_BFG_EXPLODE), 1, ATTN_NORM, 0);
 	self->solid = SOLID_NOT;
 	self->touch = NULL;
 	VectorMA (self->s.origin, -1 * FRAMETIME, self->velocity, self->s.origin);
 	VectorClear (self->velocity);
-	self->s.modelindex = gi.modelindex ("sprites/s_bfg3.sp2");
+	self->s.modelindex = G_Asset (MDL_BFG_EXPLODE);
 	self->s.frame = 0;
 	self->s.sound = 0;
 	self->s.effects &= ~EF_ANIM_ALLFAST;
@@ -942,13 +932,7 @@ void bfg_think (edict_t *self)
 			// if we hit something that's not a monster or player we're done
 			if (!(tr.ent->svflags & SVF_MONSTER) && (!tr.ent->client))
 			{
-				gi.WriteByte (svc_temp_entity);
-				gi.WriteByte (TE_LASER_SPARKS);
-				gi.WriteByte (4);
-				gi.WritePosition (tr.endpos);
-				gi.WriteDir (tr.plane.normal);
-				gi.WriteByte (self->s.skinnum);
-				gi.multicast (tr.endpos, MULTICAST_PVS);
+				G_TempEntitySplash (TE_LASER_SPARKS, 4, tr.endpos, tr.plane.normal, self->s.skinnum, MULTICAST_PVS);
 				break;
 			}
 
@@ -982,7 +966,7 @@ void fire_bfg (edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, f
 	bfg->s.effects |= EF_BFG | EF_ANIM_ALLFAST;
 	VectorClear (bfg->mins);
 	VectorClear (bfg->maxs);
-	bfg->s.modelindex = gi.modelindex ("sprites/s_bfg1.sp2");
+	bfg->s.modelindex = G_Asset (MDL_BFG_BALL);
 	bfg->owner = self;
 	bfg->touch = bfg_touch;
 	bfg->nextthink = level.time + 8000/speed;
@@ -990,7 +974,7 @@ void fire_bfg (edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, f
 	bfg->radius_dmg = damage;
 	bfg->dmg_radius = damage_radius;
 	bfg->classname = "bfg blast";
-	bfg->s.sound = gi.soundindex ("weapons/bfg__l1a.wav");
+	bfg->s.sound = G_Asset (SND_BFG_FLY);
 
 	bfg->think = bfg_think;
 	bfg->nextthink = level.time + FRAMETIME;
@@ -1061,8 +1045,8 @@ void fire_deatomizer (edict_t *self, vec3_t start, vec3_t dir, int damage, int s
     VectorClear (bolt->mins);
     VectorClear (bolt->maxs);
     bolt->s.effects = EF_BLASTER | EF_HYPERBLASTER;
-    bolt->s.sound = gi.soundindex ("misc/lasfly.wav");
-    bolt->s.modelindex = gi.modelindex ("models/objects/laser/tris.md2");
+    bolt->s.sound = G_Asset (SND_LASER_FLY);
+    bolt->s.modelindex = G_Asset (MDL_LASER);
     bolt->owner = self;
     bolt->touch = deatomizer_touch;
     bolt->nextthink = level.time + 8000 / speed;
@@ -1126,8 +1110,8 @@ void fire_plasma_pistol (edict_t *self, vec3_t start, vec3_t dir, int damage, in
     VectorClear (bolt->mins);
     VectorClear (bolt->maxs);
     bolt->s.effects = EF_PLASMA;
-    bolt->s.sound = gi.soundindex ("misc/lasfly.wav");
-    bolt->s.modelindex = gi.modelindex ("models/objects/laser/tris.md2");
+    bolt->s.sound = G_Asset (SND_LASER_FLY);
+    bolt->s.modelindex = G_Asset (MDL_LASER);
     bolt->owner = self;
     bolt->touch = plasma_pistol_touch;
     bolt->nextthink = level.time + 8000 / speed;
@@ -1189,8 +1173,8 @@ void fire_plasma_rifle (edict_t *self, vec3_t start, vec3_t dir, int damage, int
     VectorClear (bolt->mins);
     VectorClear (bolt->maxs);
     bolt->s.effects = EF_PLASMA | EF_ANIM_ALLFAST;
-    bolt->s.sound = gi.soundindex ("misc/lasfly.wav");
-    bolt->s.modelindex = gi.modelindex ("models/objects/laser/tris.md2");
+    bolt->s.sound = G_Asset (SND_LASER_FLY);
+    bolt->s.modelindex = G_Asset (MDL_LASER);
     bolt->owner = self;
     bolt->touch = plasma_rifle_touch;
     bolt->nextthink = level.time + 8000 / speed;
@@ -1209,7 +1193,7 @@ void fire_donut (edict_t *self, vec3_t origin, float damage_radius, int splash_d
     edict_t *attacker;
 
     attacker = self->owner ? self->owner : self;
-    T_RadiusDamage (self, attacker, splash_damage, ignore, damage_radius, MOD_DONUT);
+    T_QueueRadiusDamage (self, attacker, splash_damage, ignore, damage_radius, MOD_DONUT);
 }
 
 static void dod_explode (edict_t *self)
@@ -1222,7 +1206,7 @@ static void dod_explode (edict_t *self)
     ignore = self->enemy;
 
     self->s.sound = 0;
-    gi.sound (self, CHAN_AUTO, gi.soundindex("sound/dod/DoD.wav"), 1, ATTN_NORM, 0);
+    gi.sound (self, CHAN_AUTO, G_Asset (SND_DOD), 1, ATTN_NORM, 0);
 
     gi.WriteByte (svc_temp_entity);
     gi.WriteByte (TE_EXPLOSION2);
@@ -1281,8 +1265,8 @@ void fire_dod (edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, f
     VectorClear (bolt->maxs);
     bolt->s.effects = EF_PLASMA | EF_ANIM_ALLFAST;
     bolt->s.renderfx = RF_FULLBRIGHT;
-    bolt->s.modelindex = gi.modelindex ("models/objects/dod/tris.md2");
-    bolt->s.sound = gi.soundindex ("sound/dod/DoD_hum.wav");
+    bolt->s.modelindex = G_Asset (MDL_DOD);
+    bolt->s.sound = G_Asset (SND_DOD_HUM);
     bolt->owner = self;
     bolt->enemy = NULL;
     bolt->touch = dod_touch;
@@ -1344,7 +1328,7 @@ void fire_hellfury (edict_t *self, vec3_t start, vec3_t dir, int damage, int spe
     VectorClear (bolt->mins);
     VectorClear (bolt->maxs);
     bolt->s.effects = EF_ROCKET;
-    bolt->s.modelindex = gi.modelindex ("models/objects/rocket/tris.md2");
+    bolt->s.modelindex = G_Asset (MDL_ROCKET);
     bolt->owner = self;
     bolt->touch = hellfury_touch;
     bolt->nextthink = level.time + 8000 / speed;
@@ -1422,7 +1406,7 @@ static void detpack_detonate (edict_t *self)
 	gi.WritePosition (self->s.origin);
 	gi.multicast (self->s.origin, MULTICAST_PHS);
 
-	T_RadiusDamage (self, self->owner ? self->owner : self, self->radius_dmg, NULL, self->dmg_radius, MOD_DETPACK);
+	T_QueueRadiusDamage (self, self->owner ? self->owner : self, self->radius_dmg, NULL, self->dmg_radius, MOD_DETPACK);
 
 	G_FreeEdict (self);
 }
@@ -1522,7 +1506,7 @@ edict_t *fire_detpack (edict_t *self, vec3_t start, vec3_t aimdir, int damage, i
 	charge->solid = SOLID_BBOX;
 	VectorSet (charge->mins, -8, -8, 0);
 	VectorSet (charge->maxs, 8, 8, 16);
-	charge->s.modelindex = gi.modelindex ("models/objects/detpack/tris.md2");
+	charge->s.modelindex = G_Asset (MDL_DETPACK);
 	charge->s.effects = EF_GRENADE;
 	charge->owner = self;
 	charge->touch = detpack_touch;
@@ -1580,13 +1564,10 @@ static void proximity_mine_explode (edict_t *self, edict_t *target)
         T_Damage (target, self, self->owner ? self->owner : self, dir, self->s.origin, vec3_origin, self->dmg, 0, DAMAGE_ENERGY, MOD_MINE);
     }
 
-    gi.WriteByte (svc_temp_entity);
-    gi.WriteByte (TE_PLASMA_EXPLOSION);
-    gi.WritePosition (self->s.origin);
-    gi.multicast (self->s.origin, MULTICAST_PVS);
+    G_TempEntityPoint (TE_PLASMA_EXPLOSION, self->s.origin, MULTICAST_PVS);
 
     if (self->dmg_radius > 0)
-        T_RadiusDamage (self, self->owner ? self->owner : self, self->radius_dmg, target, self->dmg_radius, MOD_MINE_SPLASH);
+        T_QueueRadiusDamage (self, self->owner ? self->owner : self, self->radius_dmg, target, self->dmg_radius, MOD_MINE_SPLASH);
 
     G_FreeEdict (self);
 }
@@ -1656,7 +1637,7 @@ edict_t *fire_proximity_mine (edict_t *self, vec3_t start, vec3_t aimdir, int da
     VectorSet (mine->mins, -8, -8, 0);
     VectorSet (mine->maxs, 8, 8, 16);
     mine->s.effects = EF_GRENADE;
-    mine->s.modelindex = gi.modelindex ("models/objects/laser/tris.md2");
+    mine->s.modelindex = G_Asset (MDL_LASER);
     mine->owner = self;
     mine->touch = proximity_mine_touch;
     mine->think = proximity_mine_arm;
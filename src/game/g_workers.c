@@ -0,0 +1,664 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_workers.c -- worker threads for the clients' end of frame
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+CLIENT FRAME WORKERS
+
+With g_client_threads set, ClientEndServerFrames runs each client's frame
+in three passes instead of one client at a time:
+
+	ClientBeginViewFrame	each client in turn, on the main thread
+	ClientCalcViewFrame		spread over the workers and the main thread
+	ClientFinishViewFrame	each client in turn, on the main thread
+
+The first pass does everything that can damage the player, alert monsters
+or spawn entities.  The last one does everything that touches another
+client or writes a message: screen fades, chase cam stats, the camera and
+the scoreboard layout.  What is left in the middle only reads the level
+and writes the client it was given.
+
+The engine isn't thread safe, so while a client is run from the pool:
+
+	gi.sound is saved in that client's buffer, and played on the main
+	thread in client order before the client is finished.  A sound that
+	doesn't fit is played at once under the lock below and counted, so
+	it is only out of order, never lost
+
+	gi.soundindex, imageindex, modelindex and pointcontents are run one at
+	a time under a lock; they only happen the first time an asset is
+	used on a level or when a client's eye has moved
+
+Outside the pool the hooks go straight to the engine.
+
+"sv clientbench" times the middle pass serially and on the pool for 1 to
+64 copies of the first client.
+
+==============================================================================
+*/
+
+#define	MAX_WORKERS			16
+
+// a client frame makes at most three sounds: a powerup running out, power
+// armor turning off and the help beep
+#define	MAX_DEFERRED_SOUNDS	8
+
+typedef struct
+{
+	edict_t		*ent;
+	int			channel;
+	int			soundindex;
+	float		volume;
+	float		attenuation;
+	float		timeofs;
+} deferredsound_t;
+
+typedef struct
+{
+	int				numsounds;
+	deferredsound_t	sounds[MAX_DEFERRED_SOUNDS];
+} deferred_t;
+
+static deferred_t	client_deferred[MAX_CLIENTS];
+static int			deferred_overflows;	// sounds played at once for a full buffer
+
+// the buffer of the client this thread is running, NULL outside the pool
+static THREADLOCAL deferred_t	*worker_deferred;
+
+static void	(*real_sound) (edict_t *ent, int channel, int soundindex, float volume, float attenuation, float timeofs);
+static int	(*real_soundindex) (char *name);
+static int	(*real_imageindex) (char *name);
+static int	(*real_modelindex) (char *name);
+static int	(*real_pointcontents) (vec3_t point);
+
+static edict_t	*job_clients[MAX_CLIENTS];
+static int		job_count;
+static int		job_next;			// next client to take
+static int		job_running;		// workers that haven't finished the batch
+static int		job_generation;		// bumped for every batch
+
+static int		num_workers;
+static int		worker_start_generation;
+static unsigned	worker_seed[MAX_WORKERS];
+static qboolean	workers_quit;
+
+#ifdef _WIN32
+static qboolean			workers_initialized;
+static CRITICAL_SECTION	work_lock;
+static CRITICAL_SECTION	engine_lock;
+static HANDLE			work_event[MAX_WORKERS];
+static HANDLE			done_event;
+static HANDLE			worker_thread[MAX_WORKERS];
+#else
+static pthread_mutex_t	work_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t	engine_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t	work_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t	done_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t		worker_thread[MAX_WORKERS];
+#endif
+
+static void Worker_Lock (void)
+{
+#ifdef _WIN32
+	EnterCriticalSection (&work_lock);
+#else
+	pthread_mutex_lock (&work_lock);
+#endif
+}
+
+static void Worker_Unlock (void)
+{
+#ifdef _WIN32
+	LeaveCriticalSection (&work_lock);
+#else
+	pthread_mutex_unlock (&work_lock);
+#endif
+}
+
+static void Engine_Lock (void)
+{
+#ifdef _WIN32
+	EnterCriticalSection (&engine_lock);
+#else
+	pthread_mutex_lock (&engine_lock);
+#endif
+}
+
+static void Engine_Unlock (void)
+{
+#ifdef _WIN32
+	LeaveCriticalSection (&engine_lock);
+#else
+	pthread_mutex_unlock (&engine_lock);
+#endif
+}
+
+// called and returns with the lock held
+static void Worker_WaitForWork (int worker)
+{
+#ifdef _WIN32
+	Worker_Unlock ();
+	WaitForSingleObject (work_event[worker], INFINITE);
+	Worker_Lock ();
+#else
+	pthread_cond_wait (&work_cond, &work_lock);
+#endif
+}
+
+// called and returns with the lock held
+static void Worker_WaitForDone (void)
+{
+#ifdef _WIN32
+	Worker_Unlock ();
+	WaitForSingleObject (done_event, INFINITE);
+	Worker_Lock ();
+#else
+	pthread_cond_wait (&done_cond, &work_lock);
+#endif
+}
+
+static void Worker_SignalWork (void)
+{
+#ifdef _WIN32
+	int		i;
+
+	for (i=0 ; i<num_workers ; i++)
+		SetEvent (work_event[i]);
+#else
+	pthread_cond_broadcast (&work_cond);
+#endif
+}
+
+static void Worker_SignalDone (void)
+{
+#ifdef _WIN32
+	SetEvent (done_event);
+#else
+	pthread_cond_signal (&done_cond);
+#endif
+}
+
+/*
+=================
+Worker_RunClient
+=================
+*/
+static void Worker_RunClient (edict_t *ent)
+{
+	worker_deferred = &client_deferred[ent - g_edicts - 1];
+	ClientCalcViewFrame (ent);
+	worker_deferred = NULL;
+}
+
+// called and returns with the lock held
+static void Worker_RunJobs (void)
+{
+	edict_t	*ent;
+
+	while (job_next < job_count)
+	{
+		ent = job_clients[job_next++];
+		Worker_Unlock ();
+		Worker_RunClient (ent);
+		Worker_Lock ();
+	}
+}
+
+#ifdef _WIN32
+static DWORD WINAPI Worker_Thread (LPVOID arg)
+#else
+static void *Worker_Thread (void *arg)
+#endif
+{
+	int		worker, seen;
+
+	worker = (int)(size_t)arg;
+
+	// every thread's generator starts from the same constant
+	G_SeedRand (worker_seed[worker]);
+
+	Worker_Lock ();
+	seen = worker_start_generation;
+	while (1)
+	{
+		while (job_generation == seen && !workers_quit)
+			Worker_WaitForWork (worker);
+		if (workers_quit)
+			break;
+
+		seen = job_generation;
+		Worker_RunJobs ();
+		if (--job_running == 0)
+			Worker_SignalDone ();
+	}
+	Worker_Unlock ();
+
+	return 0;
+}
+
+/*
+=================
+Worker_RunBatch
+
+Runs ClientCalcViewFrame for every client in the list, on the workers and
+this thread, and returns once they are all done.
+=================
+*/
+static void Worker_RunBatch (edict_t **clients, int count)
+{
+	Worker_Lock ();
+	memcpy (job_clients, clients, count * sizeof(clients[0]));
+	job_count = count;
+	job_next = 0;
+	job_running = num_workers;
+	job_generation++;
+	Worker_SignalWork ();
+
+	Worker_RunJobs ();
+	while (job_running)
+		Worker_WaitForDone ();
+	Worker_Unlock ();
+}
+
+static void Workers_Stop (void)
+{
+	int		i;
+
+	if (!num_workers)
+		return;
+
+	Worker_Lock ();
+	workers_quit = true;
+	Worker_SignalWork ();
+	Worker_Unlock ();
+
+	for (i=0 ; i<num_workers ; i++)
+	{
+#ifdef _WIN32
+		WaitForSingleObject (worker_thread[i], INFINITE);
+		CloseHandle (worker_thread[i]);
+#else
+		pthread_join (worker_thread[i], NULL);
+#endif
+	}
+
+	num_workers = 0;
+	workers_quit = false;
+}
+
+static qboolean Workers_Start (int count)
+{
+	int		i;
+
+	if (count > MAX_WORKERS)
+		count = MAX_WORKERS;
+	if (count == num_workers)
+		return true;
+	Workers_Stop ();
+
+#ifdef _WIN32
+	if (!workers_initialized)
+	{
+		InitializeCriticalSection (&work_lock);
+		InitializeCriticalSection (&engine_lock);
+		for (i=0 ; i<MAX_WORKERS ; i++)
+			work_event[i] = CreateEvent (NULL, FALSE, FALSE, NULL);
+		done_event = CreateEvent (NULL, FALSE, FALSE, NULL);
+		workers_initialized = true;
+	}
+#endif
+
+	worker_start_generation = job_generation;
+	for (i=0 ; i<count ; i++)
+	{
+		worker_seed[i] = G_RandState () + (i + 1) * 2654435761u;
+#ifdef _WIN32
+		worker_thread[i] = CreateThread (NULL, 0, Worker_Thread, (LPVOID)(size_t)i, 0, NULL);
+		if (!worker_thread[i])
+			break;
+#else
+		if (pthread_create (&worker_thread[i], NULL, Worker_Thread, (void *)(size_t)i))
+			break;
+#endif
+		num_workers++;
+	}
+
+	if (num_workers < count)
+	{
+		Workers_Stop ();
+		return false;
+	}
+	return true;
+}
+
+/*
+=================
+G_ShutdownWorkers
+=================
+*/
+void G_ShutdownWorkers (void)
+{
+	Workers_Stop ();
+}
+
+/*
+=================
+Worker_FlushDeferred
+
+Plays what a client's frame did on the pool, in the order it did it.
+=================
+*/
+static void Worker_FlushDeferred (edict_t *ent)
+{
+	deferred_t		*d;
+	deferredsound_t	*s;
+	int				i;
+
+	d = &client_deferred[ent - g_edicts - 1];
+	for (i=0, s=d->sounds ; i<d->numsounds ; i++, s++)
+		real_sound (s->ent, s->channel, s->soundindex, s->volume, s->attenuation, s->timeofs);
+	d->numsounds = 0;
+}
+
+/*
+=================
+G_ParallelClientFrames
+
+Called from ClientEndServerFrames.  Returns false if the clients should be
+run one at a time as usual.
+=================
+*/
+qboolean G_ParallelClientFrames (void)
+{
+	edict_t	*clients[MAX_CLIENTS];
+	edict_t	*ent;
+	int		i, count;
+
+	if (g_client_threads->value <= 0)
+	{
+		Workers_Stop ();
+		return false;
+	}
+
+	if (!Workers_Start ((int)g_client_threads->value))
+	{
+		gi.dprintf ("Couldn't start client frame workers\n");
+		gi.cvar_set ("g_client_threads", "0");
+		return false;
+	}
+
+	count = 0;
+	for (i=0 ; i<game.maxclients ; i++)
+	{
+		ent = g_edicts + 1 + i;
+		if (!ent->inuse || !ent->client)
+			continue;
+		if (ClientBeginViewFrame (ent))
+			clients[count++] = ent;
+	}
+
+	if (count > 1)
+		Worker_RunBatch (clients, count);
+	else if (count)
+		ClientCalcViewFrame (clients[0]);
+
+	for (i=0 ; i<count ; i++)
+	{
+		Worker_FlushDeferred (clients[i]);
+		ClientFinishViewFrame (clients[i]);
+	}
+
+	return true;
+}
+
+/*
+==============================================================================
+
+ENGINE CALL HOOKS
+
+==============================================================================
+*/
+
+static void Worker_Sound (edict_t *ent, int channel, int soundindex, float volume, float attenuation, float timeofs)
+{
+	deferredsound_t	*s;
+
+	if (!worker_deferred)
+	{
+		real_sound (ent, channel, soundindex, volume, attenuation, timeofs);
+		return;
+	}
+
+	if (worker_deferred->numsounds == MAX_DEFERRED_SOUNDS)
+	{
+		Engine_Lock ();
+		deferred_overflows++;
+		real_sound (ent, channel, soundindex, volume, attenuation, timeofs);
+		Engine_Unlock ();
+		return;
+	}
+	s = &worker_deferred->sounds[worker_deferred->numsounds++];
+	s->ent = ent;
+	s->channel = channel;
+	s->soundindex = soundindex;
+	s->volume = volume;
+	s->attenuation = attenuation;
+	s->timeofs = timeofs;
+}
+
+static int Worker_SoundIndex (char *name)
+{
+	int		index;
+
+	if (!worker_deferred)
+		return real_soundindex (name);
+	Engine_Lock ();
+	index = real_soundindex (name);
+	Engine_Unlock ();
+	return index;
+}
+
+static int Worker_ImageIndex (char *name)
+{
+	int		index;
+
+	if (!worker_deferred)
+		return real_imageindex (name);
+	Engine_Lock ();
+	index = real_imageindex (name);
+	Engine_Unlock ();
+	return index;
+}
+
+static int Worker_ModelIndex (char *name)
+{
+	int		index;
+
+	if (!worker_deferred)
+		return real_modelindex (name);
+	Engine_Lock ();
+	index = real_modelindex (name);
+	Engine_Unlock ();
+	return index;
+}
+
+static int Worker_PointContents (vec3_t point)
+{
+	int		contents;
+
+	if (!worker_deferred)
+		return real_pointcontents (point);
+	Engine_Lock ();
+	contents = real_pointcontents (point);
+	Engine_Unlock ();
+	return contents;
+}
+
+/*
+=================
+G_HookWorkerCalls
+
+Called from GetGameAPI.
+=================
+*/
+void G_HookWorkerCalls (void)
+{
+	real_sound = gi.sound;
+	real_soundindex = gi.soundindex;
+	real_imageindex = gi.imageindex;
+	real_modelindex = gi.modelindex;
+	real_pointcontents = gi.pointcontents;
+	gi.sound = Worker_Sound;
+	gi.soundindex = Worker_SoundIndex;
+	gi.imageindex = Worker_ImageIndex;
+	gi.modelindex = Worker_ModelIndex;
+	gi.pointcontents = Worker_PointContents;
+}
+
+/*
+==============================================================================
+
+BENCHMARK
+
+==============================================================================
+*/
+
+static double Worker_Seconds (void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER	freq, now;
+
+	QueryPerformanceFrequency (&freq);
+	QueryPerformanceCounter (&now);
+	return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+	struct timespec	ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static void Worker_DiscardDeferred (int count)
+{
+	int		i;
+
+	for (i=0 ; i<count ; i++)
+		client_deferred[i].numsounds = 0;
+}
+
+/*
+=================
+Svcmd_ClientBench_f
+
+sv clientbench [passes] [threads]
+
+Fills the client slots with copies of the first client and times their
+ClientCalcViewFrame, then puts the slots back as they were.  Sounds the
+copies make are thrown away.
+=================
+*/
+void Svcmd_ClientBench_f (void)
+{
+	edict_t		*saved_edicts;
+	gclient_t	*saved_clients;
+	edict_t		*clients[MAX_CLIENTS];
+	int			passes, threads, maxbench, n, i, pass;
+	double		start, serial, parallel;
+
+	if (!g_edicts[1].inuse || !g_edicts[1].client)
+	{
+		gi.cprintf (NULL, PRINT_HIGH, "clientbench needs a player in the first client slot\n");
+		return;
+	}
+
+	passes = atoi (gi.argv(2));
+	if (passes <= 0)
+		passes = 200;
+	threads = atoi (gi.argv(3));
+	if (threads <= 0)
+		threads = g_client_threads->value > 0 ? (int)g_client_threads->value : 3;
+
+	if (!Workers_Start (threads))
+	{
+		gi.cprintf (NULL, PRINT_HIGH, "couldn't start %i workers\n", threads);
+		return;
+	}
+
+	maxbench = game.maxclients < 64 ? game.maxclients : 64;
+	saved_edicts = malloc (maxbench * sizeof(edict_t));
+	saved_clients = malloc (maxbench * sizeof(gclient_t));
+	memcpy (saved_edicts, g_edicts + 1, maxbench * sizeof(edict_t));
+	memcpy (saved_clients, game.clients, maxbench * sizeof(gclient_t));
+
+	for (i=0 ; i<maxbench ; i++)
+	{
+		g_edicts[1+i] = saved_edicts[0];
+		g_edicts[1+i].client = &game.clients[i];
+		game.clients[i] = saved_clients[0];
+		clients[i] = g_edicts + 1 + i;
+	}
+
+	gi.cprintf (NULL, PRINT_HIGH, "%i passes, %i workers and the main thread\n", passes, num_workers);
+	for (n=1 ; n<=maxbench ; n*=2)
+	{
+		start = Worker_Seconds ();
+		for (pass=0 ; pass<passes ; pass++)
+		{
+			for (i=0 ; i<n ; i++)
+				Worker_RunClient (clients[i]);
+			Worker_DiscardDeferred (n);
+		}
+		serial = (Worker_Seconds () - start) * 1e6 / passes;
+
+		start = Worker_Seconds ();
+		for (pass=0 ; pass<passes ; pass++)
+		{
+			Worker_RunBatch (clients, n);
+			Worker_DiscardDeferred (n);
+		}
+		parallel = (Worker_Seconds () - start) * 1e6 / passes;
+
+		gi.cprintf (NULL, PRINT_HIGH, "%3i clients: serial %8.1f us, workers %8.1f us, %.2fx\n",
+			n, serial, parallel, parallel > 0 ? serial / parallel : 0);
+	}
+
+	if (deferred_overflows)
+		gi.cprintf (NULL, PRINT_HIGH, "%i sounds played straight away for a full buffer\n", deferred_overflows);
+
+	memcpy (g_edicts + 1, saved_edicts, maxbench * sizeof(edict_t));
+	memcpy (game.clients, saved_clients, maxbench * sizeof(gclient_t));
+	free (saved_edicts);
+	free (saved_clients);
+
+	if (g_client_threads->value <= 0)
+		Workers_Stop ();
+}
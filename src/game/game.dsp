@@ -268,6 +268,60 @@ DEP_CPP_G_COM=\
 	"..\common\q_shared.h"\
 	
 
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
+SOURCE=.\g_entcache.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_ENTC=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_ENTC=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
+SOURCE=.\g_ext.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_EXT=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_EXT=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
 !ENDIF 
 
 # End Source File
@@ -300,6 +354,33 @@ DEP_CPP_G_FUN=\
 # End Source File
 # Begin Source File
 
+SOURCE=.\g_assets.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_ASS=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_ASS=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
 SOURCE=.\g_camera.c
 
 !IF  "$(CFG)" == "game - Win32 Release"
@@ -327,6 +408,33 @@ DEP_CPP_G_CAM=\
 # End Source File
 # Begin Source File
 
+SOURCE=.\g_hot.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_HOT_=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_HOT_=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
 SOURCE=.\g_items.c
 
 !IF  "$(CFG)" == "game - Win32 Release"
@@ -349,6 +457,33 @@ DEP_CPP_G_ITE=\
 	"..\common\q_shared.h"\
 	
 
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
+SOURCE=.\g_levelcache.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_LEV=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_LEV=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
 !ENDIF 
 
 # End Source File
@@ -408,6 +543,33 @@ DEP_CPP_G_MIS=\
 # End Source File
 # Begin Source File
 
+SOURCE=.\g_ratelimit.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_RAT=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_RAT=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
 SOURCE=.\g_rtdu.c
 
 !IF  "$(CFG)" == "game - Win32 Release"
@@ -436,6 +598,33 @@ DEP_CPP_G_RTD=\
 
 # Begin Source File
 
+SOURCE=.\g_mem.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_MEM_=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_MEM_=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
 SOURCE=.\g_misc.c
 
 !IF  "$(CFG)" == "game - Win32 Release"
@@ -566,6 +755,60 @@ DEP_CPP_G_SAV=\
 	"..\common\q_shared.h"\
 	
 
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
+SOURCE=.\g_savestream.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_SAVE=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_SAVE=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
+SOURCE=.\g_snapshot.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_SNA=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_SNA=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
 !ENDIF 
 
 # End Source File
@@ -647,6 +890,33 @@ DEP_CPP_G_TAR=\
 	"..\common\q_shared.h"\
 	
 
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
+SOURCE=.\g_tent.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_TEN=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_TEN=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
 !ENDIF 
 
 # End Source File
@@ -728,6 +998,33 @@ DEP_CPP_G_UTI=\
 	"..\common\q_shared.h"\
 	
 
+!ENDIF 
+
+# End Source File
+# Begin Source File
+
+SOURCE=.\g_workers.c
+
+!IF  "$(CFG)" == "game - Win32 Release"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug"
+
+!ELSEIF  "$(CFG)" == "game - Win32 Debug Alpha"
+
+DEP_CPP_G_WOR=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
+!ELSEIF  "$(CFG)" == "game - Win32 Release Alpha"
+
+DEP_CPP_G_WOR=\
+	".\g_local.h"\
+	".\game.h"\
+	"..\common\q_shared.h"\
+	
+
 !ENDIF 
 
 # End Source File
@@ -71,8 +71,11 @@ static const char *Actor_FallbackName(edict_t *self)
 
 static const char *Actor_DisplayName(edict_t *self)
 {
-        if (self && self->oblivion.custom_name && self->oblivion.custom_name[0])
-                return self->oblivion.custom_name;
+        actor_ext_t *ext;
+
+        ext = self ? G_FindEdictExt(self, EXT_ACTOR) : NULL;
+        if (ext && ext->custom_name && ext->custom_name[0])
+                return ext->custom_name;
 
         return Actor_FallbackName(self);
 }
@@ -90,7 +93,7 @@ static void Actor_ResetChatCooldown(edict_t *self)
 	if (!self)
 		return;
 
-	self->oblivion.custom_name_time = level.time;
+	G_ActorExt(self)->custom_name_time = level.time;
 }
 
 /*
@@ -98,22 +101,25 @@ static void Actor_ResetChatCooldown(edict_t *self)
 Actor_BroadcastMessage
 
 Broadcast a chat line to every active client while honouring the cooldown
-timer stored in the oblivion extension.
+timer stored in the actor extension.
 =============
 */
 static void Actor_BroadcastMessage(edict_t *self, const char *message)
 {
 	const char *name;
 	int i;
+	actor_ext_t *ext;
 
 	if (!self || !message || !message[0])
 		return;
 
-	if (level.time < self->oblivion.custom_name_time)
+	ext = G_ActorExt(self);
+
+	if (level.time < ext->custom_name_time)
 		return;
 
 	name = Actor_DisplayName(self);
-	self->oblivion.custom_name_time = level.time + ACTOR_CHAT_COOLDOWN;
+	ext->custom_name_time = level.time + ACTOR_CHAT_COOLDOWN;
 
 	for (i = 1; i <= game.maxclients; i++)
 	{
@@ -192,16 +198,23 @@ fresh spawns and savegame restores alike.
 */
 static void Actor_InitMissionTimer(edict_t *self)
 {
+	mission_ext_t *mis;
+
 	if (!self)
 		return;
 
-	if (self->oblivion.mission_timer_limit < 0)
-		self->oblivion.mission_timer_limit = 0;
+	// an actor without mission keys has nothing to clamp
+	mis = G_FindEdictExt(self, EXT_MISSION);
+	if (!mis)
+		return;
 
-	if (self->oblivion.mission_timer_remaining <= 0
-			&& self->oblivion.mission_timer_limit > 0)
+	if (mis->mission_timer_limit < 0)
+		mis->mission_timer_limit = 0;
+
+	if (mis->mission_timer_remaining <= 0
+			&& mis->mission_timer_limit > 0)
 	{
-		self->oblivion.mission_timer_remaining = self->oblivion.mission_timer_limit;
+		mis->mission_timer_remaining = mis->mission_timer_limit;
 	}
 }
 
@@ -215,26 +228,30 @@ consistent idle state.
 */
 static void Actor_PathResetState(edict_t *self)
 {
+	actor_ext_t *ext;
+
 	if (!self)
 		return;
 
-	self->oblivion.controller = NULL;
-	self->oblivion.last_controller = NULL;
-	self->oblivion.prev_path = NULL;
-	self->oblivion.path_target = NULL;
-	self->oblivion.script_target = NULL;
-	self->oblivion.controller_serial = 0;
-	self->oblivion.controller_distance = 0.0f;
-	self->oblivion.controller_resume = 0.0f;
-	self->oblivion.path_wait_time = -1.0f;
-	self->oblivion.path_time = 0.0f;
-	self->oblivion.path_speed = (self->speed > 0.0f) ? self->speed : 0.0f;
-	self->oblivion.path_step_speed = 0.0f;
-	self->oblivion.path_remaining = 0.0f;
-	self->oblivion.path_state = ACTOR_PATH_STATE_IDLE;
-	VectorClear(self->oblivion.path_dir);
-	VectorClear(self->oblivion.path_velocity);
-	self->oblivion.path_toggle = 0;
+	ext = G_ActorExt(self);
+
+	ext->controller = NULL;
+	ext->last_controller = NULL;
+	ext->prev_path = NULL;
+	ext->path_target = NULL;
+	ext->script_target = NULL;
+	ext->controller_serial = 0;
+	ext->controller_distance = 0.0f;
+	ext->controller_resume = 0.0f;
+	ext->path_wait_time = -1.0f;
+	ext->path_time = 0.0f;
+	ext->path_speed = (self->speed > 0.0f) ? self->speed : 0.0f;
+	ext->path_step_speed = 0.0f;
+	ext->path_remaining = 0.0f;
+	ext->path_state = ACTOR_PATH_STATE_IDLE;
+	VectorClear(ext->path_dir);
+	VectorClear(ext->path_velocity);
+	ext->path_toggle = 0;
 }
 
 /*
@@ -280,25 +297,28 @@ static void Actor_PathSelectIdleAnimation(edict_t *self, edict_t *controller)
 	vec3_t dir;
 	float delay;
 	int choice;
+	actor_ext_t *ext;
 
 	if (!self)
 		return;
 
-	if (level.time < self->oblivion.controller_resume)
+	ext = G_ActorExt(self);
+
+	if (level.time < ext->controller_resume)
 		return;
 
-	self->oblivion.controller_resume = level.time + 3.0f;
+	ext->controller_resume = level.time + 3.0f;
 
 	if (controller)
 	{
 		VectorSubtract(controller->s.origin, self->s.origin, dir);
 		self->ideal_yaw = self->s.angles[YAW] = vectoyaw(dir);
 		VectorNormalize(dir);
-		VectorCopy(dir, self->oblivion.path_dir);
-		VectorScale(dir, self->oblivion.path_speed, self->oblivion.path_velocity);
+		VectorCopy(dir, ext->path_dir);
+		VectorScale(dir, ext->path_speed, ext->path_velocity);
 	}
 
-	choice = rand() % 3;
+	choice = G_Rand() % 3;
 	if (choice == 0)
 	{
 		if (self->monsterinfo.stand)
@@ -351,39 +371,42 @@ and scripted movement survive save/load cycles.
 static void Actor_PathReconcileTargets(edict_t *self)
 {
 	edict_t *controller;
+	actor_ext_t *ext;
 
 	if (!self)
 		return;
 
-	controller = self->oblivion.controller;
+	ext = G_ActorExt(self);
+
+	controller = ext->controller;
 
 	if (controller && !controller->inuse)
 		controller = NULL;
 
-	if (self->oblivion.path_target && !self->oblivion.path_target->inuse)
-		self->oblivion.path_target = NULL;
+	if (ext->path_target && !ext->path_target->inuse)
+		ext->path_target = NULL;
 
-	if (!controller && self->oblivion.path_target)
-		controller = self->oblivion.path_target;
+	if (!controller && ext->path_target)
+		controller = ext->path_target;
 
-	if (controller != self->oblivion.controller)
+	if (controller != ext->controller)
 		Actor_PathAssignController(self, controller);
 
-	if (self->oblivion.script_target && !self->oblivion.script_target->inuse)
-		self->oblivion.script_target = NULL;
+	if (ext->script_target && !ext->script_target->inuse)
+		ext->script_target = NULL;
 
-	controller = self->oblivion.controller;
+	controller = ext->controller;
 
 	if (controller && !self->goalentity)
 		self->goalentity = controller;
 
-	if (self->oblivion.controller && !self->goalentity)
-		self->goalentity = self->oblivion.controller;
+	if (ext->controller && !self->goalentity)
+		self->goalentity = ext->controller;
 
-	self->oblivion.controller_serial = controller ? controller->count : 0;
+	ext->controller_serial = controller ? controller->count : 0;
 
-	if (self->oblivion.controller)
-		self->oblivion.controller_serial = self->oblivion.controller->count;
+	if (ext->controller)
+		ext->controller_serial = ext->controller->count;
 }
 
 /*
@@ -396,25 +419,29 @@ monster think behaviour.
 */
 static void Actor_PathThink(edict_t *self)
 {
+	actor_ext_t *ext;
+
 	if (!self)
 		return;
 
+	ext = G_ActorExt(self);
+
 	Actor_PathReconcileTargets(self);
 
-	if ((self->oblivion.path_state == ACTOR_PATH_STATE_WAITING
-		|| self->oblivion.path_state == ACTOR_PATH_STATE_IDLE)
-		&& self->oblivion.prev_path)
+	if ((ext->path_state == ACTOR_PATH_STATE_WAITING
+		|| ext->path_state == ACTOR_PATH_STATE_IDLE)
+		&& ext->prev_path)
 	{
-		Actor_PathSelectIdleAnimation(self, self->oblivion.prev_path);
+		Actor_PathSelectIdleAnimation(self, ext->prev_path);
 	}
 
-	if (self->oblivion.path_state == ACTOR_PATH_STATE_WAITING)
+	if (ext->path_state == ACTOR_PATH_STATE_WAITING)
 	{
-		if (level.time >= self->oblivion.path_time)
+		if (level.time >= ext->path_time)
 		{
-			if (self->oblivion.controller)
+			if (ext->controller)
 			{
-				self->oblivion.path_state = ACTOR_PATH_STATE_SEEKING;
+				ext->path_state = ACTOR_PATH_STATE_SEEKING;
 				self->monsterinfo.aiflags &= ~AI_ACTOR_PATH_IDLE;
 				self->monsterinfo.aiflags &= ~AI_HOLD_FRAME;
 				if (!self->enemy && self->monsterinfo.walk)
@@ -422,7 +449,7 @@ static void Actor_PathThink(edict_t *self)
 			}
 			else
 			{
-				self->oblivion.path_state = ACTOR_PATH_STATE_IDLE;
+				ext->path_state = ACTOR_PATH_STATE_IDLE;
 				Actor_PathScheduleIdle(self);
 			}
 		}
@@ -431,8 +458,8 @@ static void Actor_PathThink(edict_t *self)
 			self->monsterinfo.aiflags |= AI_HOLD_FRAME;
 		}
 	}
-	else if (!self->oblivion.controller
-		&& self->oblivion.path_state == ACTOR_PATH_STATE_IDLE)
+	else if (!ext->controller
+		&& ext->path_state == ACTOR_PATH_STATE_IDLE)
 	{
 		if (!(self->monsterinfo.aiflags & AI_ACTOR_PATH_IDLE))
 			Actor_PathScheduleIdle(self);
@@ -442,10 +469,10 @@ static void Actor_PathThink(edict_t *self)
 		self->monsterinfo.aiflags &= ~AI_HOLD_FRAME;
 	}
 
-	if (self->oblivion.controller
-		&& self->oblivion.controller_serial != self->oblivion.controller->count)
+	if (ext->controller
+		&& ext->controller_serial != ext->controller->count)
 	{
-		self->oblivion.controller_serial = self->oblivion.controller->count;
+		ext->controller_serial = ext->controller->count;
 	}
 
 	self->think = Actor_PathThink;
@@ -466,38 +493,41 @@ static void Actor_PathAssignController(edict_t *self, edict_t *controller)
 {
 	vec3_t delta;
 	float distance;
+	actor_ext_t *ext;
 
 	if (!self)
 		return;
 
-	self->oblivion.controller = controller;
-	self->oblivion.path_target = controller;
-	self->oblivion.controller_serial = controller ? controller->count : 0;
-	self->oblivion.controller_resume = level.time;
-	self->oblivion.path_time = level.time;
-	self->oblivion.path_speed = (self->speed > 0.0f) ? self->speed : self->oblivion.path_speed;
+	ext = G_ActorExt(self);
+
+	ext->controller = controller;
+	ext->path_target = controller;
+	ext->controller_serial = controller ? controller->count : 0;
+	ext->controller_resume = level.time;
+	ext->path_time = level.time;
+	ext->path_speed = (self->speed > 0.0f) ? self->speed : ext->path_speed;
 
 	if (!controller)
 	{
-		self->oblivion.controller_distance = 0.0f;
-		self->oblivion.path_remaining = 0.0f;
-		self->oblivion.path_step_speed = 0.0f;
-		self->oblivion.path_state = ACTOR_PATH_STATE_IDLE;
-		VectorClear(self->oblivion.path_dir);
-		VectorClear(self->oblivion.path_velocity);
-		self->oblivion.path_toggle = 0;
+		ext->controller_distance = 0.0f;
+		ext->path_remaining = 0.0f;
+		ext->path_step_speed = 0.0f;
+		ext->path_state = ACTOR_PATH_STATE_IDLE;
+		VectorClear(ext->path_dir);
+		VectorClear(ext->path_velocity);
+		ext->path_toggle = 0;
 		Actor_PathScheduleIdle(self);
 		return;
 	}
 
 	VectorSubtract(controller->s.origin, self->s.origin, delta);
 	distance = VectorNormalize(delta);
-	self->oblivion.controller_distance = distance;
-	self->oblivion.path_remaining = distance;
-	self->oblivion.path_step_speed = 0.0f;
-	self->oblivion.path_state = ACTOR_PATH_STATE_SEEKING;
-	VectorCopy(delta, self->oblivion.path_dir);
-	VectorScale(delta, self->oblivion.path_speed, self->oblivion.path_velocity);
+	ext->controller_distance = distance;
+	ext->path_remaining = distance;
+	ext->path_step_speed = 0.0f;
+	ext->path_state = ACTOR_PATH_STATE_SEEKING;
+	VectorCopy(delta, ext->path_dir);
+	VectorScale(delta, ext->path_speed, ext->path_velocity);
 }
 
 
@@ -511,15 +541,19 @@ scripted sequence.
 */
 static void Actor_PathAdvance(edict_t *self, edict_t *current, edict_t *next_target)
 {
+	actor_ext_t *ext;
+
 	if (!self)
 		return;
 
-	self->oblivion.prev_path = current;
-	self->oblivion.last_controller = current;
-	self->oblivion.path_wait_time = -1.0f;
-	self->oblivion.script_target = NULL;
-	self->oblivion.path_toggle ^= 1;
-	self->oblivion.controller_serial = next_target ? next_target->count : 0;
+	ext = G_ActorExt(self);
+
+	ext->prev_path = current;
+	ext->last_controller = current;
+	ext->path_wait_time = -1.0f;
+	ext->script_target = NULL;
+	ext->path_toggle ^= 1;
+	ext->controller_serial = next_target ? next_target->count : 0;
 
 	Actor_PathAssignController(self, next_target);
 }
@@ -540,7 +574,7 @@ static float Actor_PathResolveWait(edict_t *self, edict_t *node)
 	if (!self)
 		return 0.0f;
 
-	wait = self->oblivion.path_wait_time;
+	wait = G_ActorExt(self)->path_wait_time;
 	if (wait < 0.0f)
 	{
 		if (node)
@@ -565,29 +599,33 @@ pause before resuming motion toward the next controller.
 */
 static void Actor_PathApplyWait(edict_t *self, float wait)
 {
+	actor_ext_t *ext;
+
 	if (!self)
 		return;
 
-	self->oblivion.path_wait_time = -1.0f;
+	ext = G_ActorExt(self);
+
+	ext->path_wait_time = -1.0f;
 
 	if (wait > 0.0f)
 	{
-		self->oblivion.path_state = ACTOR_PATH_STATE_WAITING;
-		self->oblivion.path_time = level.time + wait;
+		ext->path_state = ACTOR_PATH_STATE_WAITING;
+		ext->path_time = level.time + wait;
 		self->monsterinfo.aiflags |= AI_HOLD_FRAME;
 		return;
 	}
 
-	self->oblivion.path_time = level.time;
+	ext->path_time = level.time;
 	self->monsterinfo.aiflags &= ~AI_HOLD_FRAME;
 
-	if (self->oblivion.controller)
+	if (ext->controller)
 	{
-		self->oblivion.path_state = ACTOR_PATH_STATE_SEEKING;
+		ext->path_state = ACTOR_PATH_STATE_SEEKING;
 		return;
 	}
 
-	self->oblivion.path_state = ACTOR_PATH_STATE_IDLE;
+	ext->path_state = ACTOR_PATH_STATE_IDLE;
 	Actor_PathScheduleIdle(self);
 }
 
@@ -603,40 +641,43 @@ static void Actor_PathTrackController(edict_t *self)
 {
 	vec3_t delta;
 	float distance;
+	actor_ext_t *ext;
 
 	if (!self)
 		return;
 
-	if (!self->oblivion.controller || !self->oblivion.controller->inuse)
+	ext = G_ActorExt(self);
+
+	if (!ext->controller || !ext->controller->inuse)
 	{
-		if (self->oblivion.controller && !self->oblivion.controller->inuse)
+		if (ext->controller && !ext->controller->inuse)
 		{
-			self->oblivion.controller = NULL;
-			self->oblivion.path_target = NULL;
+			ext->controller = NULL;
+			ext->path_target = NULL;
 		}
 
-		self->oblivion.controller_distance = 0.0f;
-		self->oblivion.path_remaining = 0.0f;
-		self->oblivion.path_step_speed = VectorLength(self->velocity);
-		VectorClear(self->oblivion.path_dir);
-		VectorCopy(self->velocity, self->oblivion.path_velocity);
+		ext->controller_distance = 0.0f;
+		ext->path_remaining = 0.0f;
+		ext->path_step_speed = VectorLength(self->velocity);
+		VectorClear(ext->path_dir);
+		VectorCopy(self->velocity, ext->path_velocity);
 
-		if (!self->oblivion.controller && self->oblivion.path_state != ACTOR_PATH_STATE_WAITING)
-			self->oblivion.path_state = ACTOR_PATH_STATE_IDLE;
+		if (!ext->controller && ext->path_state != ACTOR_PATH_STATE_WAITING)
+			ext->path_state = ACTOR_PATH_STATE_IDLE;
 
 		return;
 	}
 
-	VectorSubtract(self->oblivion.controller->s.origin, self->s.origin, delta);
+	VectorSubtract(ext->controller->s.origin, self->s.origin, delta);
 	distance = VectorNormalize(delta);
-	self->oblivion.controller_distance = distance;
-	self->oblivion.path_remaining = distance;
-	VectorCopy(delta, self->oblivion.path_dir);
-	self->oblivion.path_step_speed = VectorLength(self->velocity);
-	VectorCopy(self->velocity, self->oblivion.path_velocity);
-
-	if (self->oblivion.path_step_speed <= 0.0f)
-		VectorScale(delta, self->oblivion.path_speed, self->oblivion.path_velocity);
+	ext->controller_distance = distance;
+	ext->path_remaining = distance;
+	VectorCopy(delta, ext->path_dir);
+	ext->path_step_speed = VectorLength(self->velocity);
+	VectorCopy(self->velocity, ext->path_velocity);
+
+	if (ext->path_step_speed <= 0.0f)
+		VectorScale(delta, ext->path_speed, ext->path_velocity);
 }
 
 /*
@@ -648,19 +689,22 @@ Publish pending mission events to the HUD via Mission_TargetHelpFired.
 */
 static void Actor_UpdateMissionObjective(edict_t *self)
 {
+	mission_ext_t *mis;
+
 	if (!self)
 		return;
 
-	if (self->oblivion.mission_state)
+	mis = G_FindEdictExt(self, EXT_MISSION);
+	if (mis && mis->mission_state)
 	{
-		if (self->oblivion.mission_timer_limit > 0
-			&& self->oblivion.mission_timer_remaining <= 0)
+		if (mis->mission_timer_limit > 0
+			&& mis->mission_timer_remaining <= 0)
 		{
-			self->oblivion.mission_timer_remaining = self->oblivion.mission_timer_limit;
+			mis->mission_timer_remaining = mis->mission_timer_limit;
 		}
 
 		if (Mission_TargetHelpFired(self, self))
-			self->oblivion.mission_state = 0;
+			mis->mission_state = 0;
 	}
 }
 
@@ -673,23 +717,27 @@ Update the actor's mission and path bookkeeping before physics runs.
 */
 static void Actor_PreThink(edict_t *self)
 {
+	actor_ext_t *ext;
+
 	if (!self)
 		return;
 
+	ext = G_ActorExt(self);
+
 	Actor_PathTrackController(self);
 
-	if (self->oblivion.path_state == ACTOR_PATH_STATE_WAITING
-		&& level.time >= self->oblivion.path_time)
+	if (ext->path_state == ACTOR_PATH_STATE_WAITING
+		&& level.time >= ext->path_time)
 	{
-		if (self->oblivion.controller)
+		if (ext->controller)
 		{
-			self->oblivion.path_state = ACTOR_PATH_STATE_SEEKING;
+			ext->path_state = ACTOR_PATH_STATE_SEEKING;
 			if (!self->enemy && self->monsterinfo.walk)
 				self->monsterinfo.walk(self);
 		}
 		else
 		{
-			self->oblivion.path_state = ACTOR_PATH_STATE_IDLE;
+			ext->path_state = ACTOR_PATH_STATE_IDLE;
 		}
 	}
 
@@ -700,10 +748,13 @@ static void Actor_PreThink(edict_t *self)
 static qboolean Actor_AttachController(edict_t *self, edict_t *controller)
 {
 	vec3_t dir;
+	actor_ext_t *ext;
 
 	if (!self)
 		return false;
 
+	ext = G_ActorExt(self);
+
 	self->goalentity = controller;
 	self->movetarget = controller;
 	self->monsterinfo.aiflags &= ~AI_ACTOR_PATH_IDLE;
@@ -721,9 +772,9 @@ static qboolean Actor_AttachController(edict_t *self, edict_t *controller)
 	self->monsterinfo.walk(self);
 
 	Actor_PathAssignController(self, controller);
-	self->oblivion.last_controller = controller;
-	self->oblivion.controller_distance = VectorLength(dir);
-	self->oblivion.controller_resume = level.time;
+	ext->last_controller = controller;
+	ext->controller_distance = VectorLength(dir);
+	ext->controller_resume = level.time;
 	Actor_ResetChatCooldown(self);
 
 	return true;
@@ -783,7 +834,7 @@ void actor_stand (edict_t *self)
 
 	// randomize on startup
 	if (level.time < 1.0)
-		self->s.frame = self->monsterinfo.currentmove->firstframe + (rand() % (self->monsterinfo.currentmove->lastframe - self->monsterinfo.currentmove->firstframe + 1));
+		self->s.frame = self->monsterinfo.currentmove->firstframe + (G_Rand() % (self->monsterinfo.currentmove->lastframe - self->monsterinfo.currentmove->firstframe + 1));
 }
 
 
@@ -812,21 +863,25 @@ Synchronise the actor walk cycle with the Oblivion path state machine.
 */
 void actor_walk (edict_t *self)
 {
+	actor_ext_t *ext;
+
 	if (!self)
 		return;
 
+	ext = G_ActorExt(self);
+
 	self->monsterinfo.aiflags &= ~AI_ACTOR_PATH_IDLE;
 
-	if (self->oblivion.path_state != ACTOR_PATH_STATE_WAITING)
+	if (ext->path_state != ACTOR_PATH_STATE_WAITING)
 	{
-		self->oblivion.path_state = ACTOR_PATH_STATE_SEEKING;
-		self->oblivion.path_time = level.time;
+		ext->path_state = ACTOR_PATH_STATE_SEEKING;
+		ext->path_time = level.time;
 	}
 
-	if (self->oblivion.controller && !self->enemy)
+	if (ext->controller && !self->enemy)
 	{
-		self->goalentity = self->oblivion.controller;
-		self->movetarget = self->oblivion.controller;
+		self->goalentity = ext->controller;
+		self->movetarget = ext->controller;
 	}
 
 	self->monsterinfo.currentmove = &actor_move_walk;
@@ -861,9 +916,13 @@ resuming scripted movement after scripted attacks.
 */
 void actor_run (edict_t *self)
 {
+	actor_ext_t *ext;
+
 	if (!self)
 		return;
 
+	ext = G_ActorExt(self);
+
 	if (self->monsterinfo.aiflags & AI_ACTOR_SHOOT_ONCE)
 	{
 		self->monsterinfo.aiflags &= ~(AI_ACTOR_SHOOT_ONCE | AI_STAND_GROUND);
@@ -893,17 +952,17 @@ void actor_run (edict_t *self)
 
 	self->monsterinfo.aiflags &= ~AI_ACTOR_PATH_IDLE;
 
-	if (self->oblivion.path_state != ACTOR_PATH_STATE_WAITING)
+	if (ext->path_state != ACTOR_PATH_STATE_WAITING)
 	{
-		self->oblivion.path_state = ACTOR_PATH_STATE_SEEKING;
-		self->oblivion.path_time = level.time;
+		ext->path_state = ACTOR_PATH_STATE_SEEKING;
+		ext->path_time = level.time;
 	}
 
-	if (self->oblivion.controller && !self->enemy)
+	if (ext->controller && !self->enemy)
 	{
-		self->goalentity = self->oblivion.controller;
+		self->goalentity = ext->controller;
 		if (!self->movetarget)
-			self->movetarget = self->oblivion.controller;
+			self->movetarget = ext->controller;
 	}
 
 	self->monsterinfo.currentmove = &actor_move_run;
@@ -1010,11 +1069,11 @@ void actor_pain (edict_t *self, edict_t *other, float kick, int damage)
 		else
 			self->monsterinfo.currentmove = &actor_move_taunt;
 		name = Actor_DisplayName(self);
-		gi.cprintf (other, PRINT_CHAT, "%s: %s!\n", name, messages[rand()%3]);
+		gi.cprintf (other, PRINT_CHAT, "%s: %s!\n", name, messages[G_Rand()%3]);
 		return;
 	}
 
-	n = rand() % 3;
+	n = G_Rand() % 3;
 	if (n == 0)
 		self->monsterinfo.currentmove = &actor_move_pain1;
 	else if (n == 1)
@@ -1119,7 +1178,7 @@ void actor_die (edict_t *self, edict_t *inflictor, edict_t *attacker, int damage
 	self->deadflag = DEAD_DEAD;
 	self->takedamage = DAMAGE_YES;
 
-	n = rand() % 2;
+	n = G_Rand() % 2;
 	if (n == 0)
 		self->monsterinfo.currentmove = &actor_move_death1;
 	else
@@ -1151,7 +1210,7 @@ void actor_attack(edict_t *self)
 	int		n;
 
 	self->monsterinfo.currentmove = &actor_move_attack;
-	n = (rand() & 15) + 3 + 7;
+	n = (G_Rand() & 15) + 3 + 7;
 	self->monsterinfo.pausetime = level.time + n * FRAMETIME;
 }
 
@@ -1166,10 +1225,13 @@ Activate the actor's scripted path and schedule the Oblivion think loop.
 void actor_use (edict_t *self, edict_t *other, edict_t *activator)
 {
 	edict_t *controller;
+	actor_ext_t *ext;
 
 	if (!self)
 		return;
 
+	ext = G_ActorExt(self);
+
 	(void)other;
 	(void)activator;
 
@@ -1190,10 +1252,10 @@ void actor_use (edict_t *self, edict_t *other, edict_t *activator)
 	}
 
 	self->target = NULL;
-	self->oblivion.prev_path = NULL;
-	self->oblivion.path_wait_time = -1.0f;
-	self->oblivion.script_target = NULL;
-	self->oblivion.path_toggle = 0;
+	ext->prev_path = NULL;
+	ext->path_wait_time = -1.0f;
+	ext->script_target = NULL;
+	ext->path_toggle = 0;
 	self->monsterinfo.aiflags &= ~AI_ACTOR_PATH_IDLE;
 	self->think = Actor_PathThink;
 	self->nextthink = level.time + FRAMETIME;
@@ -1212,10 +1274,13 @@ actor resumes scripted motion when activated.
 static void Actor_UseOblivion(edict_t *self, edict_t *other, edict_t *activator)
 {
 	edict_t *target;
+	actor_ext_t *ext;
 
 	if (!self)
 		return;
 
+	ext = G_ActorExt(self);
+
 	Actor_ResetChatCooldown(self);
 	Actor_InitMissionTimer(self);
 
@@ -1224,10 +1289,10 @@ static void Actor_UseOblivion(edict_t *self, edict_t *other, edict_t *activator)
 	if (Actor_AttachController(self, target))
 	{
 		self->target = NULL;
-		self->oblivion.prev_path = NULL;
-		self->oblivion.path_wait_time = -1.0f;
-		self->oblivion.script_target = NULL;
-		self->oblivion.path_toggle = 0;
+		ext->prev_path = NULL;
+		ext->path_wait_time = -1.0f;
+		ext->script_target = NULL;
+		ext->path_toggle = 0;
 		self->monsterinfo.aiflags &= ~AI_ACTOR_PATH_IDLE;
 		self->think = Actor_PathThink;
 		self->nextthink = level.time + FRAMETIME;
@@ -1307,7 +1372,7 @@ static qboolean Actor_SpawnOblivion(edict_t *self)
 	{
 		static const int corpse_frames[] = { FRAME_stand216, FRAME_stand222, FRAME_swim07 };
 
-		self->s.frame = corpse_frames[rand() % 3];
+		self->s.frame = corpse_frames[G_Rand() % 3];
 		self->svflags |= SVF_DEADMONSTER;
 		self->health = -1;
 		self->deadflag = DEAD_DEAD;
@@ -1461,7 +1526,7 @@ void target_actor_touch (edict_t *self, edict_t *other, cplane_t *plane, csurfac
 	if (self->pathtarget)
 		pathtarget_ent = G_PickTarget(self->pathtarget);
 
-	other->oblivion.script_target = pathtarget_ent;
+	G_ActorExt(other)->script_target = pathtarget_ent;
 
 	if (self->message)
 	{
@@ -1536,7 +1601,7 @@ void target_actor_touch (edict_t *self, edict_t *other, cplane_t *plane, csurfac
 
 	wait = Actor_PathResolveWait(other, self);
 	Actor_PathAdvance(other, self, next_target);
-	other->oblivion.script_target = pathtarget_ent;
+	G_ActorExt(other)->script_target = pathtarget_ent;
 	Actor_PathApplyWait(other, wait);
 
 	if (!other->goalentity)
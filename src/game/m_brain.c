@@ -410,7 +410,7 @@ void brain_hit_right (edict_t *self)
 	vec3_t	aim;
 
 	VectorSet (aim, MELEE_DISTANCE, self->maxs[0], 8);
-	if (fire_hit (self, aim, (15 + (rand() %5)), 40))
+	if (fire_hit (self, aim, (15 + (G_Rand() %5)), 40))
 		gi.sound (self, CHAN_WEAPON, sound_melee3, 1, ATTN_NORM, 0);
 }
 
@@ -424,7 +424,7 @@ void brain_hit_left (edict_t *self)
 	vec3_t	aim;
 
 	VectorSet (aim, MELEE_DISTANCE, self->mins[0], 8);
-	if (fire_hit (self, aim, (15 + (rand() %5)), 40))
+	if (fire_hit (self, aim, (15 + (G_Rand() %5)), 40))
 		gi.sound (self, CHAN_WEAPON, sound_melee3, 1, ATTN_NORM, 0);
 }
 
@@ -463,7 +463,7 @@ void brain_tentacle_attack (edict_t *self)
 	vec3_t	aim;
 
 	VectorSet (aim, MELEE_DISTANCE, 0, 8);
-	if (fire_hit (self, aim, (10 + (rand() %5)), -600) && skill->value > 0)
+	if (fire_hit (self, aim, (10 + (G_Rand() %5)), -600) && skill->value > 0)
 		self->spawnflags |= 65536;
 	gi.sound (self, CHAN_WEAPON, sound_tentacles_retract, 1, ATTN_NORM, 0);
 }
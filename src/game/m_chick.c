@@ -374,7 +374,7 @@ void chick_die (edict_t *self, edict_t *inflictor, edict_t *attacker, int damage
 	self->deadflag = DEAD_DEAD;
 	self->takedamage = DAMAGE_YES;
 
-	n = rand() % 2;
+	n = G_Rand() % 2;
 	if (n == 0)
 	{
 		self->monsterinfo.currentmove = &chick_move_death1;
@@ -444,7 +444,7 @@ void ChickSlash (edict_t *self)
 
 	VectorSet (aim, MELEE_DISTANCE, self->mins[0], 10);
 	gi.sound (self, CHAN_WEAPON, sound_melee_swing, 1, ATTN_NORM, 0);
-	fire_hit (self, aim, (10 + (rand() %6)), 100);
+	fire_hit (self, aim, (10 + (G_Rand() %6)), 100);
 }
 
 
@@ -51,7 +51,7 @@ Play one of the retail footstep samples while advancing.
 */
 static void cyborg_step (edict_t *self)
 {
-	gi.sound (self, CHAN_BODY, sound_step[rand () % 3], 1, ATTN_NORM, 0);
+	gi.sound (self, CHAN_BODY, sound_step[G_Rand () % 3], 1, ATTN_NORM, 0);
 }
 
 /*
@@ -97,7 +97,7 @@ static void cyborg_fire_deatom (edict_t *self, const vec3_t muzzle_offset, int s
 		return;
 
 if (sample_index < 0 || sample_index >= (int) (sizeof (sound_attack) / sizeof (sound_attack[0])))
-sample_index = rand () % (int) (sizeof (sound_attack) / sizeof (sound_attack[0]));
+sample_index = G_Rand () % (int) (sizeof (sound_attack) / sizeof (sound_attack[0]));
 
 	AngleVectors (self->s.angles, forward, right, NULL);
 	VectorCopy (muzzle_offset, offset);
@@ -322,10 +322,14 @@ Emit the heavy landing impact when the pending flag is set.
 */
 static void cyborg_land (edict_t *self)
 {
-	if (!self->oblivion.cyborg_landing_thud)
+	cyborg_ext_t	*ext;
+
+	ext = G_CyborgExt(self);
+
+	if (!ext->cyborg_landing_thud)
 		return;
 
-	self->oblivion.cyborg_landing_thud = false;
+	ext->cyborg_landing_thud = false;
 	gi.sound (self, CHAN_BODY, sound_thud, 1.0f, ATTN_NORM, 0.0f);
 }
 
@@ -338,17 +342,21 @@ Check whether the wounded stand-ground timer has elapsed and clear the flag.
 */
 static qboolean cyborg_update_stand_ground (edict_t *self)
 {
+	cyborg_ext_t	*ext;
+
+	ext = G_CyborgExt(self);
+
 if (!(self->monsterinfo.aiflags & AI_STAND_GROUND))
 return false;
 
-	if (self->oblivion.cyborg_anchor_time <= 0.0f)
+	if (ext->cyborg_anchor_time <= 0.0f)
 		return false;
 
-	if (level.time < self->oblivion.cyborg_anchor_time)
+	if (level.time < ext->cyborg_anchor_time)
 		return false;
 
 	self->monsterinfo.aiflags &= ~(AI_STAND_GROUND | AI_TEMP_STAND_GROUND);
-	self->oblivion.cyborg_anchor_time = 0.0f;
+	ext->cyborg_anchor_time = 0.0f;
 	cyborg_land (self);
 	return true;
 }
@@ -363,16 +371,19 @@ Apply the wounded stand-ground anchor and extend the release timer.
 static void cyborg_schedule_stand_ground (edict_t *self, float duration)
 {
 	float		anchor_expire;
+	cyborg_ext_t	*ext;
+
+	ext = G_CyborgExt(self);
 
 if (duration <= 0.0f)
 return;
 
 self->monsterinfo.aiflags |= (AI_STAND_GROUND | AI_TEMP_STAND_GROUND);
-	self->oblivion.cyborg_landing_thud = true;
+	ext->cyborg_landing_thud = true;
 	anchor_expire = level.time + duration;
 
-	if (self->oblivion.cyborg_anchor_time <= level.time || self->oblivion.cyborg_anchor_time < anchor_expire)
-		self->oblivion.cyborg_anchor_time = anchor_expire;
+	if (ext->cyborg_anchor_time <= level.time || ext->cyborg_anchor_time < anchor_expire)
+		ext->cyborg_anchor_time = anchor_expire;
 }
 
 /*
@@ -398,6 +409,9 @@ Trigger the wounded stand-ground timer when health thresholds are crossed.
 static void cyborg_wound_stand_ground (edict_t *self)
 {
 	int		max_health;
+	cyborg_ext_t	*ext;
+
+	ext = G_CyborgExt(self);
 
 	max_health = self->max_health;
 	if (!max_health)
@@ -406,16 +420,16 @@ static void cyborg_wound_stand_ground (edict_t *self)
 	if (!max_health)
 		return;
 
-	if (self->health <= max_health / 4 && self->oblivion.cyborg_anchor_stage < 2)
+	if (self->health <= max_health / 4 && ext->cyborg_anchor_stage < 2)
 	{
-		self->oblivion.cyborg_anchor_stage = 2;
+		ext->cyborg_anchor_stage = 2;
 		cyborg_schedule_stand_ground (self, CYBORG_STAND_GROUND_DURATION);
 		return;
 	}
 
-	if (self->health <= max_health / 2 && self->oblivion.cyborg_anchor_stage < 1)
+	if (self->health <= max_health / 2 && ext->cyborg_anchor_stage < 1)
 	{
-		self->oblivion.cyborg_anchor_stage = 1;
+		ext->cyborg_anchor_stage = 1;
 		cyborg_schedule_stand_ground (self, CYBORG_STAND_GROUND_DURATION);
 	}
 }
@@ -551,7 +565,7 @@ the retail selection probabilities intact.
 */
 static float cyborg_attack_roll (void)
 {
-	return (rand () & 0x7fff) * (1.0f / 32768.0f);
+	return (G_Rand () & 0x7fff) * (1.0f / 32768.0f);
 }
 
 /*
@@ -581,6 +595,9 @@ static void cyborg_attack (edict_t *self)
 static void cyborg_attack_dispatch (edict_t *self)
 {
 	float	choice;
+	cyborg_ext_t	*ext;
+
+	ext = G_CyborgExt(self);
 
 	cyborg_update_stand_ground (self);
 
@@ -594,21 +611,21 @@ static void cyborg_attack_dispatch (edict_t *self)
 
 	if (self->s.frame >= CYBORG_FRAME_ATTACK1_START && self->s.frame <= CYBORG_FRAME_ATTACK1_END)
 	{
-		self->oblivion.cyborg_landing_thud = true;
+		ext->cyborg_landing_thud = true;
 		cyborg_attack_seed (self, &cyborg_move_attack_primary);
 		return;
 	}
 
 	if (self->s.frame >= CYBORG_FRAME_ATTACK2_START && self->s.frame <= CYBORG_FRAME_ATTACK2_END)
 	{
-		self->oblivion.cyborg_landing_thud = true;
+		ext->cyborg_landing_thud = true;
 		cyborg_attack_seed (self, &cyborg_move_attack_secondary);
 		return;
 	}
 
 	if (self->s.frame >= CYBORG_FRAME_ATTACK3_START && self->s.frame <= CYBORG_FRAME_ATTACK3_END)
 	{
-		self->oblivion.cyborg_landing_thud = true;
+		ext->cyborg_landing_thud = true;
 		cyborg_attack_seed (self, &cyborg_move_attack_barrage);
 		return;
 	}
@@ -617,17 +634,17 @@ static void cyborg_attack_dispatch (edict_t *self)
 
 	if (choice < 0.5f)
 	{
-		self->oblivion.cyborg_landing_thud = true;
+		ext->cyborg_landing_thud = true;
 		self->monsterinfo.currentmove = &cyborg_move_attack_primary;
 	}
 	else if (choice < 0.7f)
 	{
-		self->oblivion.cyborg_landing_thud = true;
+		ext->cyborg_landing_thud = true;
 		self->monsterinfo.currentmove = &cyborg_move_attack_barrage;
 	}
 	else
 	{
-		self->oblivion.cyborg_landing_thud = true;
+		ext->cyborg_landing_thud = true;
 		self->monsterinfo.currentmove = &cyborg_move_attack_secondary;
 	}
 }
@@ -644,12 +661,15 @@ tables recovered from the HLIL dump.
 static void cyborg_pain (edict_t *self, edict_t *other, float kick, int damage)
 {
 	int	slot;
+	cyborg_ext_t	*ext;
+
+	ext = G_CyborgExt(self);
 
 if (level.time < self->pain_debounce_time)
 return;
 
 self->pain_debounce_time = level.time + 3.0f;
-	self->oblivion.cyborg_pain_time = self->pain_debounce_time;
+	ext->cyborg_pain_time = self->pain_debounce_time;
 
 	/* Update the wounded anchor thresholds on every damage event so the
 	 * locomotion helpers can later release the cyborg through
@@ -657,9 +677,9 @@ self->pain_debounce_time = level.time + 3.0f;
 	 */
 	cyborg_wound_stand_ground (self);
 
-	slot = self->oblivion.cyborg_pain_slot & 1;
+	slot = ext->cyborg_pain_slot & 1;
 	gi.sound (self, CHAN_VOICE, sound_pain_samples[slot], 1, ATTN_NORM, 0);
-	self->oblivion.cyborg_pain_slot ^= 1;
+	ext->cyborg_pain_slot ^= 1;
 
 	if (damage > 40 || random () > 0.5f)
 		self->monsterinfo.currentmove = &cyborg_move_pain_stagger;
@@ -675,6 +695,10 @@ static void cyborg_dead (edict_t *self)
 
 static void cyborg_die (edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, vec3_t point)
 {
+	cyborg_ext_t	*ext;
+
+	ext = G_CyborgExt(self);
+
 static mframe_t death_frames[] = {
 {ai_move, 0, NULL},
 {ai_move, 0, NULL},
@@ -682,9 +706,9 @@ static mframe_t death_frames[] = {
 };
 static mmove_t death_move = {CYBORG_FRAME_DEATH_START, CYBORG_FRAME_DEATH_END, death_frames, cyborg_dead};
 
-	self->oblivion.cyborg_anchor_time = 0.0f;
-	self->oblivion.cyborg_anchor_stage = 0;
-	self->oblivion.cyborg_landing_thud = false;
+	ext->cyborg_anchor_time = 0.0f;
+	ext->cyborg_anchor_stage = 0;
+	ext->cyborg_landing_thud = false;
 	self->monsterinfo.aiflags &= ~AI_STAND_GROUND;
 
 	gi.sound (self, CHAN_VOICE, sound_death, 1, ATTN_NORM, 0);
@@ -703,6 +727,10 @@ static mmove_t death_move = {CYBORG_FRAME_DEATH_START, CYBORG_FRAME_DEATH_END, d
 
 void SP_monster_cyborg (edict_t *self)
 {
+	cyborg_ext_t	*ext;
+
+	ext = G_CyborgExt(self);
+
     if (deathmatch->value)
     {
         G_FreeEdict (self);
@@ -736,12 +764,12 @@ sound_thud = sound_step[2];
 	self->health = 300;
 	self->gib_health = -120;
 	self->max_health = self->health;
-	self->oblivion.cyborg_anchor_time = 0.0f;
-	self->oblivion.cyborg_anchor_stage = 0;
-	self->oblivion.cyborg_landing_thud = false;
+	ext->cyborg_anchor_time = 0.0f;
+	ext->cyborg_anchor_stage = 0;
+	ext->cyborg_landing_thud = false;
 
-	self->oblivion.cyborg_pain_time = 0.0f;
-	self->oblivion.cyborg_pain_slot = 0;
+	ext->cyborg_pain_time = 0.0f;
+	ext->cyborg_pain_slot = 0;
 	self->pain = cyborg_pain;
     self->die = cyborg_die;
 
@@ -516,7 +516,7 @@ void floater_wham (edict_t *self)
 {
 	static	vec3_t	aim = {MELEE_DISTANCE, 0, 0};
 	gi.sound (self, CHAN_WEAPON, sound_attack3, 1, ATTN_NORM, 0);
-	fire_hit (self, aim, 5 + rand() % 6, -50);
+	fire_hit (self, aim, 5 + G_Rand() % 6, -50);
 }
 
 void floater_zap (edict_t *self)
@@ -545,7 +545,7 @@ void floater_zap (edict_t *self)
 	gi.WriteByte (1);	//sparks
 	gi.multicast (origin, MULTICAST_PVS);
 
-	T_Damage (self->enemy, self, self, dir, self->enemy->s.origin, vec3_origin, 5 + rand() % 6, -10, DAMAGE_ENERGY, MOD_UNKNOWN);
+	T_Damage (self->enemy, self, self, dir, self->enemy->s.origin, vec3_origin, 5 + G_Rand() % 6, -10, DAMAGE_ENERGY, MOD_UNKNOWN);
 }
 
 void floater_attack(edict_t *self)
@@ -577,7 +577,7 @@ void floater_pain (edict_t *self, edict_t *other, float kick, int damage)
 	if (skill->value == 3)
 		return;		// no pain anims in nightmare
 
-	n = (rand() + 1) % 3;
+	n = (G_Rand() + 1) % 3;
 	if (n == 0)
 	{
 		gi.sound (self, CHAN_VOICE, sound_pain1, 1, ATTN_NORM, 0);
@@ -415,7 +415,7 @@ static void spider_claw(edict_t *self)
 	return;
 	}
 
-	gi.sound(self, CHAN_WEAPON, sound_melee[rand() % 3], 1.0f, ATTN_NORM, 0.0f);
+	gi.sound(self, CHAN_WEAPON, sound_melee[G_Rand() % 3], 1.0f, ATTN_NORM, 0.0f);
 	T_Damage(self->enemy, self, self, forward, self->enemy->s.origin, vec3_origin, (int)damage, (int)damage, 0, MOD_HIT);
 }
 
@@ -428,7 +428,7 @@ Select the appropriate idle sequence based on spawn configuration.
 */
 static void spider_idle_loop(edict_t *self)
 {
-	if (self->oblivion.spider_alt_idle)
+	if (G_SpiderExt(self)->spider_alt_idle)
 	{
 	self->monsterinfo.currentmove = &spider_move_boss_idle;
 	}
@@ -496,8 +496,12 @@ Reset the combo bookkeeping fields after attack interruption.
 */
 static void spider_clear_combo_state(edict_t *self)
 {
-	self->oblivion.spider_combo_stage = SPIDER_STAGE_NONE;
-	self->oblivion.spider_combo_last = SPIDER_CHAIN_PRIMARY;
+	spider_ext_t *ext;
+
+	ext = G_SpiderExt(self);
+
+	ext->spider_combo_stage = SPIDER_STAGE_NONE;
+	ext->spider_combo_last = SPIDER_CHAIN_PRIMARY;
 	self->state_flags &= ~(SPIDER_STATE_COMBO_READY | SPIDER_STATE_COMBO_DISPATCHED);
 	self->state_time = 0.0f;
 }
@@ -511,8 +515,12 @@ Record that the spider is currently staggered by a pain reaction.
 */
 static void spider_mark_stagger(edict_t *self)
 {
-	self->oblivion.spider_staggered = true;
-	self->oblivion.spider_stagger_time = self->pain_debounce_time;
+	spider_ext_t *ext;
+
+	ext = G_SpiderExt(self);
+
+	ext->spider_staggered = true;
+	ext->spider_stagger_time = self->pain_debounce_time;
 	spider_clear_combo_state(self);
 }
 
@@ -525,8 +533,12 @@ Clear the stagger flag so locomotion may resume.
 */
 static void spider_clear_stagger(edict_t *self)
 {
-	self->oblivion.spider_staggered = false;
-	self->oblivion.spider_stagger_time = 0.0f;
+	spider_ext_t *ext;
+
+	ext = G_SpiderExt(self);
+
+	ext->spider_staggered = false;
+	ext->spider_stagger_time = 0.0f;
 }
 
 /*
@@ -538,7 +550,7 @@ Pin the final pain frame until the stagger timer expires.
 */
 static void spider_hold_stagger(edict_t *self)
 {
-	if (level.time < self->oblivion.spider_stagger_time)
+	if (level.time < G_SpiderExt(self)->spider_stagger_time)
 	{
 		self->monsterinfo.nextframe = self->s.frame;
 		return;
@@ -562,7 +574,7 @@ static void spider_select_locomotion(edict_t *self)
 	return;
 	}
 
-	if (self->oblivion.spider_staggered)
+	if (G_SpiderExt(self)->spider_staggered)
 	{
 	spider_stand(self);
 	return;
@@ -618,7 +630,7 @@ Request that the spider begin or continue a melee combo.
 */
 static void spider_attack(edict_t *self)
 {
-	if (self->oblivion.spider_staggered)
+	if (G_SpiderExt(self)->spider_staggered)
 	{
 		return;
 	}
@@ -671,6 +683,7 @@ Start a melee combo using the alternating chain logic.
 static void spider_combo_entry(edict_t *self)
 {
 	int next_chain;
+	spider_ext_t *ext;
 
 	if (!self->enemy)
 	{
@@ -678,15 +691,17 @@ static void spider_combo_entry(edict_t *self)
 		return;
 	}
 
-	if (self->oblivion.spider_combo_stage != SPIDER_STAGE_NONE && spider_combo_window_active(self))
+	ext = G_SpiderExt(self);
+
+	if (ext->spider_combo_stage != SPIDER_STAGE_NONE && spider_combo_window_active(self))
 	{
 		return;
 	}
 
-	next_chain = self->oblivion.spider_combo_next;
-	self->oblivion.spider_combo_next ^= 1;
-	self->oblivion.spider_combo_last = next_chain;
-	self->oblivion.spider_combo_stage = SPIDER_STAGE_FIRST;
+	next_chain = ext->spider_combo_next;
+	ext->spider_combo_next ^= 1;
+	ext->spider_combo_last = next_chain;
+	ext->spider_combo_stage = SPIDER_STAGE_FIRST;
 	spider_set_combo_window(self, SPIDER_COMBO_FIRST_WINDOW);
 
 	if (next_chain == SPIDER_CHAIN_PRIMARY)
@@ -708,24 +723,28 @@ Advance through the chained melee sequences while the window is open.
 */
 static void spider_continue_combo(edict_t *self)
 {
+	spider_ext_t *ext;
+
 	if (!self->enemy || range(self, self->enemy) > RANGE_MELEE)
 	{
 		spider_begin_recover(self);
 		return;
 	}
 
+	ext = G_SpiderExt(self);
+
 	if (!spider_combo_window_active(self))
 	{
 		spider_begin_recover(self);
 		return;
 	}
 
-	if (self->oblivion.spider_combo_stage == SPIDER_STAGE_FIRST)
+	if (ext->spider_combo_stage == SPIDER_STAGE_FIRST)
 	{
-		int follow_up = (self->oblivion.spider_combo_last == SPIDER_CHAIN_PRIMARY) ? SPIDER_CHAIN_SECONDARY : SPIDER_CHAIN_PRIMARY;
+		int follow_up = (ext->spider_combo_last == SPIDER_CHAIN_PRIMARY) ? SPIDER_CHAIN_SECONDARY : SPIDER_CHAIN_PRIMARY;
 
-		self->oblivion.spider_combo_last = follow_up;
-		self->oblivion.spider_combo_stage = SPIDER_STAGE_SECOND;
+		ext->spider_combo_last = follow_up;
+		ext->spider_combo_stage = SPIDER_STAGE_SECOND;
 		spider_set_combo_window(self, SPIDER_COMBO_CHAIN_WINDOW);
 
 		if (follow_up == SPIDER_CHAIN_PRIMARY)
@@ -739,7 +758,7 @@ static void spider_continue_combo(edict_t *self)
 		return;
 	}
 
-	self->oblivion.spider_combo_stage = SPIDER_STAGE_FINISH;
+	ext->spider_combo_stage = SPIDER_STAGE_FINISH;
 	spider_set_combo_window(self, SPIDER_COMBO_FINISH_WINDOW);
 	self->monsterinfo.currentmove = &spider_move_attack_finisher;
 }
@@ -792,7 +811,7 @@ Handle stagger tracking, cooldown management, and pain animation entry.
 */
 static void spider_pain(edict_t *self, edict_t *other, float kick, int damage)
 {
-	qboolean play_secondary = (rand() & 1);
+	qboolean play_secondary = (G_Rand() & 1);
 
 	if (level.time < self->pain_debounce_time)
 	{
@@ -821,7 +840,7 @@ static void spider_pain_recover(edict_t *self)
 {
 	spider_hold_stagger(self);
 
-	if (self->oblivion.spider_staggered)
+	if (G_SpiderExt(self)->spider_staggered)
 	{
 		return;
 	}
@@ -881,6 +900,10 @@ Spawn function for the Oblivion spider tank.
 */
 void SP_monster_spider(edict_t *self)
 {
+	spider_ext_t *ext;
+
+	ext = G_SpiderExt(self);
+
 	if (deathmatch->value)
 	{
 		G_FreeEdict(self);
@@ -923,12 +946,12 @@ void SP_monster_spider(edict_t *self)
 	self->monsterinfo.sight = spider_sight;
 	self->monsterinfo.search = spider_search;
 
-	self->oblivion.spider_combo_next = SPIDER_CHAIN_PRIMARY;
+	ext->spider_combo_next = SPIDER_CHAIN_PRIMARY;
 	spider_clear_combo_state(self);
 	spider_clear_stagger(self);
-	self->oblivion.spider_alt_idle = (self->spawnflags & 0x100) != 0;
+	ext->spider_alt_idle = (self->spawnflags & 0x100) != 0;
 
-	if (self->oblivion.spider_alt_idle)
+	if (ext->spider_alt_idle)
 	{
 		VectorSet(self->mins, -48.0f, -48.0f, -40.0f);
 		VectorSet(self->maxs, 48.0f, 48.0f, 48.0f);
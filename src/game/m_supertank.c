@@ -598,7 +598,7 @@ void BossExplode (edict_t *self)
 
 	self->think = BossExplode;
 	VectorCopy (self->s.origin, org);
-	org[2] += 24 + (rand()&15);
+	org[2] += 24 + (G_Rand()&15);
 	switch (self->count++)
 	{
 	case 0:
@@ -549,7 +549,7 @@ void TossClientWeapon (edict_t *self)
 	if (quad)
 	{
 		self->client->v_angle[YAW] += spread;
-		drop = Drop_Item (self, FindItemByClassname ("item_quad"));
+		drop = Drop_Item (self, G_Item (ITEM_QUAD));
 		self->client->v_angle[YAW] -= spread;
 		drop->spawnflags |= DROPPED_PLAYER_ITEM;
 
@@ -691,7 +691,7 @@ void player_die (edict_t *self, edict_t *inflictor, edict_t *attacker, int damag
 				self->client->anim_end = FRAME_death308;
 				break;
 			}
-			gi.sound (self, CHAN_VOICE, gi.soundindex(va("*death%i.wav", (rand()%4)+1)), 1, ATTN_NORM, 0);
+			gi.sound (self, CHAN_VOICE, gi.soundindex(va("*death%i.wav", (G_Rand()%4)+1)), 1, ATTN_NORM, 0);
 		}
 	}
 
@@ -716,7 +716,7 @@ void InitClientPersistant (gclient_t *client)
 
 	memset (&client->pers, 0, sizeof(client->pers));
 
-	item = FindItem("Blaster");
+	item = G_Item (ITEM_BLASTER);
 	client->pers.selected_item = ITEM_INDEX(item);
 	client->pers.inventory[client->pers.selected_item] = 1;
 
@@ -833,6 +833,110 @@ float	PlayersRangeFromSpot (edict_t *spot)
 	return bestplayerdistance;
 }
 
+/*
+================
+DEATHMATCH SPOTS
+
+The info_player_deathmatch spots are gathered into dm_spots the first
+time one is needed on a level, in the order G_Find would return them.
+dm_spotrange holds each one's PlayersRangeFromSpot, worked out for every
+spot at once the first time a spot is chosen in a frame.  Players moving
+later in the same frame don't change it, but a player put on a spot does,
+so two clients respawning together still spread out.
+================
+*/
+static edict_t	*dm_spots[MAX_EDICTS];
+static float	dm_spotrange[MAX_EDICTS];
+static int		dm_numspots = -1;
+static int		dm_rangeframe = -1;
+
+void G_ResetSpawnSpots (void)
+{
+	dm_numspots = -1;
+	dm_rangeframe = -1;
+}
+
+static void DM_GatherSpots (void)
+{
+	edict_t	*spot;
+
+	dm_numspots = 0;
+	spot = NULL;
+	while ((spot = G_Find (spot, FOFS(classname), "info_player_deathmatch")) != NULL)
+		dm_spots[dm_numspots++] = spot;
+	dm_rangeframe = -1;
+}
+
+static void DM_UpdateSpots (void)
+{
+	edict_t	*player;
+	vec3_t	origins[MAX_CLIENTS];
+	vec3_t	v;
+	int		i, n, numplayers;
+	float	playerdistance;
+
+	if (dm_numspots < 0)
+		DM_GatherSpots ();
+	else
+	{
+		for (i=0 ; i<dm_numspots ; i++)
+			if (!dm_spots[i]->inuse || !dm_spots[i]->classname
+				|| strcmp (dm_spots[i]->classname, "info_player_deathmatch"))
+				break;
+		if (i < dm_numspots)
+			DM_GatherSpots ();
+	}
+
+	if (dm_rangeframe == level.framenum)
+		return;
+	dm_rangeframe = level.framenum;
+
+	numplayers = 0;
+	for (n = 1; n <= maxclients->value; n++)
+	{
+		player = &g_edicts[n];
+		if (!player->inuse || player->health <= 0)
+			continue;
+		VectorCopy (player->s.origin, origins[numplayers]);
+		numplayers++;
+	}
+
+	for (i=0 ; i<dm_numspots ; i++)
+	{
+		dm_spotrange[i] = 9999999;
+		for (n=0 ; n<numplayers ; n++)
+		{
+			VectorSubtract (dm_spots[i]->s.origin, origins[n], v);
+			playerdistance = VectorLength (v);
+			if (playerdistance < dm_spotrange[i])
+				dm_spotrange[i] = playerdistance;
+		}
+	}
+}
+
+// the client about to be put on spot will stand where SelectSpawnPoint
+// puts it
+static edict_t *DM_TakeSpot (edict_t *spot)
+{
+	vec3_t	origin, v;
+	int		i;
+	float	playerdistance;
+
+	if (!spot)
+		return NULL;
+
+	VectorCopy (spot->s.origin, origin);
+	origin[2] += 9;
+	for (i=0 ; i<dm_numspots ; i++)
+	{
+		VectorSubtract (dm_spots[i]->s.origin, origin, v);
+		playerdistance = VectorLength (v);
+		if (playerdistance < dm_spotrange[i])
+			dm_spotrange[i] = playerdistance;
+	}
+	return spot;
+}
+
 /*
 ================
 SelectRandomDeathmatchSpawnPoint
@@ -844,18 +948,19 @@ to other players
 edict_t *SelectRandomDeathmatchSpawnPoint (void)
 {
 	edict_t	*spot, *spot1, *spot2;
-	int		count = 0;
-	int		selection;
+	int		count;
+	int		selection, i;
 	float	range, range1, range2;
 
-	spot = NULL;
+	DM_UpdateSpots ();
+
 	range1 = range2 = 99999;
 	spot1 = spot2 = NULL;
 
-	while ((spot = G_Find (spot, FOFS(classname), "info_player_deathmatch")) != NULL)
+	for (i=0 ; i<dm_numspots ; i++)
 	{
-		count++;
-		range = PlayersRangeFromSpot(spot);
+		spot = dm_spots[i];
+		range = dm_spotrange[i];
 		if (range < range1)
 		{
 			range1 = range;
@@ -868,6 +973,7 @@ edict_t *SelectRandomDeathmatchSpawnPoint (void)
 		}
 	}
 
+	count = dm_numspots;
 	if (!count)
 		return NULL;
 
@@ -878,17 +984,17 @@ edict_t *SelectRandomDeathmatchSpawnPoint (void)
 	else
 		count -= 2;
 
-	selection = rand() % count;
+	selection = G_Rand() % count;
 
-	spot = NULL;
+	i = -1;
 	do
 	{
-		spot = G_Find (spot, FOFS(classname), "info_player_deathmatch");
+		spot = ++i < dm_numspots ? dm_spots[i] : NULL;
 		if (spot == spot1 || spot == spot2)
 			selection++;
 	} while(selection--);
 
-	return spot;
+	return DM_TakeSpot (spot);
 }
 
 /*
@@ -901,33 +1007,31 @@ edict_t *SelectFarthestDeathmatchSpawnPoint (void)
 {
 	edict_t	*bestspot;
 	float	bestdistance, bestplayerdistance;
-	edict_t	*spot;
+	int		i;
 
+	DM_UpdateSpots ();
 
-	spot = NULL;
 	bestspot = NULL;
 	bestdistance = 0;
-	while ((spot = G_Find (spot, FOFS(classname), "info_player_deathmatch")) != NULL)
+	for (i=0 ; i<dm_numspots ; i++)
 	{
-		bestplayerdistance = PlayersRangeFromSpot (spot);
+		bestplayerdistance = dm_spotrange[i];
 
 		if (bestplayerdistance > bestdistance)
 		{
-			bestspot = spot;
+			bestspot = dm_spots[i];
 			bestdistance = bestplayerdistance;
 		}
 	}
 
 	if (bestspot)
 	{
-		return bestspot;
+		return DM_TakeSpot (bestspot);
 	}
 
 	// if there is a player just spawned on each and every start spot
 	// we have no choice to turn one into a telefrag meltdown
-	spot = G_Find (NULL, FOFS(classname), "info_player_deathmatch");
-
-	return spot;
+	return DM_TakeSpot (dm_numspots ? dm_spots[0] : NULL);
 }
 
 edict_t *SelectDeathmatchSpawnPoint (void)
@@ -1559,6 +1663,13 @@ qboolean ClientConnect (edict_t *ent, char *userinfo)
 		return false;
 	}
 
+	// don't let a connect flood take the server's frames
+	if (!ent->inuse && !G_RateLimitConnect(value)) {
+		Info_SetValueForKey(userinfo, "rejmsg", "Server is busy, try again.");
+		return false;
+	}
+	G_SnapshotClientConnect (ent, value);
+
 	// check for a spectator
 	value = Info_ValueForKey (userinfo, "spectator");
 	if (deathmatch->value && *value && strcmp(value, "0")) {
@@ -1604,7 +1715,9 @@ qboolean ClientConnect (edict_t *ent, char *userinfo)
 			InitClientPersistant (ent->client);
 	}
 
+	G_RateLimitClientConnect (ent);
 	ClientUserinfoChanged (ent, userinfo);
+	G_ScreenFade_ClientConnect (ent);
 
 	if (game.maxclients > 1)
 		gi.dprintf ("%s connected\n", ent->client->pers.netname);
@@ -1642,6 +1755,7 @@ void ClientDisconnect (edict_t *ent)
 	ent->s.modelindex = 0;
 	ent->solid = SOLID_NOT;
 	ent->inuse = false;
+	G_SyncHotEdict (ent);
 	ent->classname = "disconnected";
 	ent->client->pers.connected = false;
 
@@ -1865,6 +1979,11 @@ void ClientThink (edict_t *ent, usercmd_t *ucmd)
 		if (other->inuse && other->client->chase_target == ent)
 			UpdateChaseCam(other);
 	}
+
+	// weapons fired this think may have queued blasts, damage and effects
+	G_RunExplosions ();
+	G_FlushDamage ();
+	G_FlushTempEntities ();
 }
 
 
@@ -1881,6 +2000,8 @@ void ClientBeginServerFrame (edict_t *ent)
 	gclient_t	*client;
 	int			buttonMask;
 
+	G_RunPendingUserinfo (ent);
+
 	if (level.intermissiontime)
 		return;
 
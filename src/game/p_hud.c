@@ -122,6 +122,10 @@ void BeginIntermission (edict_t *targ)
 
 	level.exitintermission = 0;
 
+	// compile the next map's entities while the scoreboard is up
+	if (deathmatch->value)
+		EntCache_Prepare (level.changemap);
+
 	// find an intermission spot
 	ent = G_Find (NULL, FOFS(classname), "info_player_intermission");
 	if (!ent)
@@ -132,7 +136,7 @@ void BeginIntermission (edict_t *targ)
 	}
 	else
 	{	// chose one of four spots
-		i = rand() & 3;
+		i = G_Rand() & 3;
 		while (i--)
 		{
 			ent = G_Find (ent, FOFS(classname), "info_player_intermission");
@@ -155,68 +159,174 @@ void BeginIntermission (edict_t *targ)
 }
 
 
+/*
+==============================================================================
+
+DEATHMATCH SCOREBOARD
+
+The scoreboard layout is the same for every viewer except for the dogtags
+drawn next to the viewer and the killer.  It is kept here along with the
+sort order and the numbers each row was built from.  Each request compares
+the clients against them, re-sorts only when someone's score or presence
+changed, and reformats only when a row's score, ping or time changed.  A
+viewer's message is then the shared rows copied out with its own dogtags
+patched in, so a frame with every spectator watching the scores builds the
+layout at most once.
+
+==============================================================================
+*/
+
+#define	SCOREBOARD_ROWS		12
+#define	SCOREBOARD_MAXLEN	1024
+
+typedef struct
+{
+	qboolean	listed[MAX_CLIENTS];	// in use and not a spectator
+	int			score[MAX_CLIENTS];		// as last sorted
+
+	int			total;
+	int			sorted[MAX_CLIENTS];
+
+	// the rows as last formatted
+	int			rows;
+	int			rowclient[SCOREBOARD_ROWS];
+	int			rowscore[SCOREBOARD_ROWS];
+	int			rowping[SCOREBOARD_ROWS];
+	int			rowtime[SCOREBOARD_ROWS];
+	char		rowtext[SCOREBOARD_ROWS][64];
+} scoreboard_t;
+
+static scoreboard_t	scoreboard;
+
 /*
 ==================
-DeathmatchScoreboardMessage
+Scoreboard_Sort
 
+Same order as ever: by score, ties in client order.
 ==================
 */
-void DeathmatchScoreboardMessage (edict_t *ent, edict_t *killer)
+static void Scoreboard_Sort (void)
 {
-	char	entry[1024];
-	char	string[1400];
-	int		stringlength;
-	int		i, j, k;
-	int		sorted[MAX_CLIENTS];
-	int		sortedscores[MAX_CLIENTS];
-	int		score, total;
-	int		picnum;
-	int		x, y;
-	gclient_t	*cl;
-	edict_t		*cl_ent;
-	char	*tag;
+	int		i, j, k, score;
 
-	// sort the clients by score
-	total = 0;
+	scoreboard.total = 0;
 	for (i=0 ; i<game.maxclients ; i++)
 	{
-		cl_ent = g_edicts + 1 + i;
-		if (!cl_ent->inuse || game.clients[i].resp.spectator)
+		if (!scoreboard.listed[i])
 			continue;
-		score = game.clients[i].resp.score;
-		for (j=0 ; j<total ; j++)
+		score = scoreboard.score[i];
+		for (j=0 ; j<scoreboard.total ; j++)
 		{
-			if (score > sortedscores[j])
+			if (score > scoreboard.score[scoreboard.sorted[j]])
 				break;
 		}
-		for (k=total ; k>j ; k--)
-		{
-			sorted[k] = sorted[k-1];
-			sortedscores[k] = sortedscores[k-1];
-		}
-		sorted[j] = i;
-		sortedscores[j] = score;
-		total++;
+		for (k=scoreboard.total ; k>j ; k--)
+			scoreboard.sorted[k] = scoreboard.sorted[k-1];
+		scoreboard.sorted[j] = i;
+		scoreboard.total++;
 	}
+}
 
-	// print level name and exit rules
-	string[0] = 0;
+/*
+==================
+Scoreboard_Update
+
+Brings the shared layout up to date with the clients.
+==================
+*/
+static void Scoreboard_Update (void)
+{
+	qboolean	resort, reformat, listed;
+	gclient_t	*cl;
+	int			i, x, y, rows, time;
 
-	stringlength = strlen(string);
+	resort = false;
+	for (i=0 ; i<game.maxclients ; i++)
+	{
+		listed = g_edicts[1+i].inuse && !game.clients[i].resp.spectator;
+		if (listed != scoreboard.listed[i] || (listed && game.clients[i].resp.score != scoreboard.score[i]))
+		{
+			scoreboard.listed[i] = listed;
+			scoreboard.score[i] = game.clients[i].resp.score;
+			resort = true;
+		}
+	}
+	if (resort)
+		Scoreboard_Sort ();
 
-	// add the clients in sorted order
-	if (total > 12)
-		total = 12;
+	rows = scoreboard.total;
+	if (rows > SCOREBOARD_ROWS)
+		rows = SCOREBOARD_ROWS;
 
-	for (i=0 ; i<total ; i++)
+	reformat = (rows != scoreboard.rows);
+	for (i=0 ; i<rows && !reformat ; i++)
 	{
-		cl = &game.clients[sorted[i]];
-		cl_ent = g_edicts + 1 + sorted[i];
+		cl = &game.clients[scoreboard.sorted[i]];
+		if (scoreboard.rowclient[i] != scoreboard.sorted[i]
+			|| scoreboard.rowscore[i] != cl->resp.score
+			|| scoreboard.rowping[i] != cl->ping
+			|| scoreboard.rowtime[i] != (level.framenum - cl->resp.enterframe)/600)
+			reformat = true;
+	}
+	if (!reformat)
+		return;
 
-		picnum = gi.imageindex ("i_fixme");
+	for (i=0 ; i<rows ; i++)
+	{
+		cl = &game.clients[scoreboard.sorted[i]];
+		time = (level.framenum - cl->resp.enterframe)/600;
 		x = (i>=6) ? 160 : 0;
 		y = 32 + 32 * (i%6);
 
+		scoreboard.rowclient[i] = scoreboard.sorted[i];
+		scoreboard.rowscore[i] = cl->resp.score;
+		scoreboard.rowping[i] = cl->ping;
+		scoreboard.rowtime[i] = time;
+		Com_sprintf (scoreboard.rowtext[i], sizeof(scoreboard.rowtext[i]),
+			"client %i %i %i %i %i %i ",
+			x, y, scoreboard.sorted[i], cl->resp.score, cl->ping, time);
+	}
+	scoreboard.rows = rows;
+}
+
+/*
+==================
+G_ResetScoreboard
+
+The layout is only ever a function of the numbers compared above, but
+game.maxclients can change between games, so it is dropped whenever a
+level is spawned or loaded.
+==================
+*/
+void G_ResetScoreboard (void)
+{
+	memset (&scoreboard, 0, sizeof(scoreboard));
+}
+
+/*
+==================
+DeathmatchScoreboardMessage
+
+==================
+*/
+void DeathmatchScoreboardMessage (edict_t *ent, edict_t *killer)
+{
+	char		string[SCOREBOARD_MAXLEN+1];
+	textbuf_t	buf;
+	int			i, x, y;
+	edict_t		*cl_ent;
+	char		*tag;
+
+	Scoreboard_Update ();
+
+	// print level name and exit rules
+	TB_Init (&buf, string, sizeof(string));
+
+	// add the clients in sorted order
+	for (i=0 ; i<scoreboard.rows ; i++)
+	{
+		cl_ent = g_edicts + 1 + scoreboard.rowclient[i];
+
 		// add a dogtag
 		if (cl_ent == ent)
 			tag = "tag1";
@@ -226,24 +336,15 @@ void DeathmatchScoreboardMessage (edict_t *ent, edict_t *killer)
 			tag = NULL;
 		if (tag)
 		{
-			Com_sprintf (entry, sizeof(entry),
-				"xv %i yv %i picn %s ",x+32, y, tag);
-			j = strlen(entry);
-			if (stringlength + j > 1024)
+			x = (i>=6) ? 160 : 0;
+			y = 32 + 32 * (i%6);
+			if (!TB_Printf (&buf, "xv %i yv %i picn %s ", x+32, y, tag))
 				break;
-			strcpy (string + stringlength, entry);
-			stringlength += j;
 		}
 
-		// send the layout
-		Com_sprintf (entry, sizeof(entry),
-			"client %i %i %i %i %i %i ",
-			x, y, sorted[i], cl->resp.score, cl->ping, (level.framenum - cl->resp.enterframe)/600);
-		j = strlen(entry);
-		if (stringlength + j > 1024)
+		// the row itself is shared
+		if (!TB_Append (&buf, scoreboard.rowtext[i]))
 			break;
-		strcpy (string + stringlength, entry);
-		stringlength += j;
 	}
 
 	gi.WriteByte (svc_layout);
@@ -303,7 +404,7 @@ void HelpComputer (edict_t *ent)
 {
 	char	string[1024];
 	char	*sk;
-	char	objectives[768];
+	textbuf_t	buf;
 
 	if (skill->value == 0)
 		sk = "easy";
@@ -314,22 +415,21 @@ void HelpComputer (edict_t *ent)
 	else
 		sk = "hard+";
 
-	MissionMenu_BuildObjectiveLayout (objectives, sizeof(objectives));
-
-	// send the layout
-	Com_sprintf (string, sizeof(string),
+	// send the layout, with the objectives last so they can only
+	// crowd out each other
+	TB_Init (&buf, string, sizeof(string));
+	TB_Printf (&buf,
 		"xv 32 yv 8 picn help "			// background
 		"xv 202 yv 12 string2 \"%s\" "		// skill
 		"xv 0 yv 24 cstring2 \"%s\" "		// level name
-		"%s"
 		"xv 50 yv 164 string2 \" kills     goals    secrets\" "
 		"xv 50 yv 172 string2 \"%3i/%3i     %i/%i       %i/%i\" ", 
 		sk,
 		level.level_name,
-		objectives,
 		level.killed_monsters, level.total_monsters, 
 		level.found_goals, level.total_goals,
 		level.found_secrets, level.total_secrets);
+	MissionMenu_BuildObjectiveLayout (&buf);
 
 	gi.WriteByte (svc_layout);
 	gi.WriteString (string);
@@ -373,156 +473,117 @@ void Cmd_Help_f (edict_t *ent)
 //=======================================================================
 
 /*
-===============
-G_SetStats
-===============
+==============================================================================
+
+CLIENT STATS
+
+G_SetStats runs for every client every frame, but what most of the stats
+are worked out from rarely changes.  The ammo, armor and selected item
+stats are only worked out again when the inventory values they read
+differ from last frame (VIEW_INVENTORY), and the timer stats only while
+a powerup or a recharging weapon is counting down (VIEW_POWERUPS).  The
+results are kept for each client, and only the ps.stats entries that
+differ from them are written.
+
+==============================================================================
 */
-void G_SetStats (edict_t *ent)
+
+typedef struct
+{
+	short		stats[MAX_STATS];	// what G_SetStats last worked out
+	qboolean	valid;
+
+	// VIEW_INVENTORY
+	int			ammo_index, ammo;
+	int			armor_index, armor;
+	qboolean	power_armor;		// power armor icon showing
+	int			cells;
+	int			selected_item;
+
+	// VIEW_POWERUPS
+	gitem_t		*weapon;
+	qboolean	weapon_timer;		// the weapon has a timer of its own
+	qboolean	timer;				// a timer was counting last frame
+} clientstats_t;
+
+static clientstats_t	client_stats[MAX_CLIENTS];
+
+// the stats G_SetStats sets every frame
+static int	owned_stats[] =
 {
-	gitem_t		*item;
-	int			index, cells;
-	int			power_armor_type;
+	STAT_HEALTH_ICON, STAT_HEALTH, STAT_AMMO_ICON, STAT_AMMO,
+	STAT_ARMOR_ICON, STAT_ARMOR, STAT_TIMER_ICON, STAT_TIMER,
+	STAT_SELECTED_ICON, STAT_SELECTED_ITEM, STAT_LAYOUTS, STAT_FRAGS,
+	STAT_HELPICON, STAT_SPECTATOR
+};
 
-	//
-	// health
-	//
-	ent->client->ps.stats[STAT_HEALTH_ICON] = level.pic_health;
-	ent->client->ps.stats[STAT_HEALTH] = ent->health;
+/*
+===============
+G_ResetClientStats
 
-	//
-	// ammo
-	//
-	if (!ent->client->ammo_index /* || !ent->client->pers.inventory[ent->client->ammo_index] */)
-	{
-		ent->client->ps.stats[STAT_AMMO_ICON] = 0;
-		ent->client->ps.stats[STAT_AMMO] = 0;
-	}
-	else
-	{
-		item = &itemlist[ent->client->ammo_index];
-		ent->client->ps.stats[STAT_AMMO_ICON] = gi.imageindex (item->icon);
-		ent->client->ps.stats[STAT_AMMO] = ent->client->pers.inventory[ent->client->ammo_index];
-	}
-	
-	//
-	// armor
-	//
-	power_armor_type = PowerArmorType (ent);
-	if (power_armor_type)
-	{
-		cells = ent->client->pers.inventory[ITEM_INDEX(FindItem ("cells"))];
-		if (cells == 0)
-		{	// ran out of cells for power armor
-			ent->flags &= ~FL_POWER_ARMOR;
-			gi.sound(ent, CHAN_ITEM, gi.soundindex("misc/power2.wav"), 1, ATTN_NORM, 0);
-			power_armor_type = 0;;
-		}
-	}
+The icons are asset indexes, which every level hands out afresh.
+===============
+*/
+void G_ResetClientStats (void)
+{
+	memset (client_stats, 0, sizeof(client_stats));
+}
 
-	index = ArmorIndex (ent);
-	if (power_armor_type && (!index || (level.framenum & 8) ) )
-	{	// flash between power armor and other armor icon
-		ent->client->ps.stats[STAT_ARMOR_ICON] = gi.imageindex ("i_powershield");
-		ent->client->ps.stats[STAT_ARMOR] = cells;
-	}
-	else if (index)
-	{
-		item = GetItemByIndex (index);
-		ent->client->ps.stats[STAT_ARMOR_ICON] = gi.imageindex (item->icon);
-		ent->client->ps.stats[STAT_ARMOR] = ent->client->pers.inventory[index];
-	}
-	else
-	{
-		ent->client->ps.stats[STAT_ARMOR_ICON] = 0;
-		ent->client->ps.stats[STAT_ARMOR] = 0;
-	}
+/*
+===============
+G_SetTimerStats
 
-	//
-	// pickup message
-	//
-	if (level.time > ent->client->pickup_msg_time)
-	{
-		ent->client->ps.stats[STAT_PICKUP_ICON] = 0;
-		ent->client->ps.stats[STAT_PICKUP_STRING] = 0;
-	}
+The powerup timers, or failing those the recharge of the weapon in hand.
+===============
+*/
+static void G_SetTimerStats (edict_t *ent, short *stats)
+{
+	gclient_t	*client = ent->client;
+	gitem_t		*weapon;
 
-	//
-	// timers
-	//
-	if (ent->client->quad_framenum > level.framenum)
+	if (client->quad_framenum > level.framenum)
 	{
-		ent->client->ps.stats[STAT_TIMER_ICON] = gi.imageindex ("p_quad");
-		ent->client->ps.stats[STAT_TIMER] = (ent->client->quad_framenum - level.framenum)/10;
+		stats[STAT_TIMER_ICON] = G_Asset (IMG_QUAD);
+		stats[STAT_TIMER] = (client->quad_framenum - level.framenum)/10;
 	}
-	else if (ent->client->invincible_framenum > level.framenum)
+	else if (client->invincible_framenum > level.framenum)
 	{
-		ent->client->ps.stats[STAT_TIMER_ICON] = gi.imageindex ("p_invulnerability");
-		ent->client->ps.stats[STAT_TIMER] = (ent->client->invincible_framenum - level.framenum)/10;
+		stats[STAT_TIMER_ICON] = G_Asset (IMG_INVULNERABILITY);
+		stats[STAT_TIMER] = (client->invincible_framenum - level.framenum)/10;
 	}
-	else if (ent->client->enviro_framenum > level.framenum)
+	else if (client->enviro_framenum > level.framenum)
 	{
-		ent->client->ps.stats[STAT_TIMER_ICON] = gi.imageindex ("p_envirosuit");
-		ent->client->ps.stats[STAT_TIMER] = (ent->client->enviro_framenum - level.framenum)/10;
+		stats[STAT_TIMER_ICON] = G_Asset (IMG_ENVIROSUIT);
+		stats[STAT_TIMER] = (client->enviro_framenum - level.framenum)/10;
 	}
-	else if (ent->client->breather_framenum > level.framenum)
+	else if (client->breather_framenum > level.framenum)
 	{
-		ent->client->ps.stats[STAT_TIMER_ICON] = gi.imageindex ("p_rebreather");
-		ent->client->ps.stats[STAT_TIMER] = (ent->client->breather_framenum - level.framenum)/10;
+		stats[STAT_TIMER_ICON] = G_Asset (IMG_REBREATHER);
+		stats[STAT_TIMER] = (client->breather_framenum - level.framenum)/10;
 	}
 	else
 	{
-		ent->client->ps.stats[STAT_TIMER_ICON] = 0;
-		ent->client->ps.stats[STAT_TIMER] = 0;
+		stats[STAT_TIMER_ICON] = 0;
+		stats[STAT_TIMER] = 0;
 	}
 
-	if (!ent->client->ps.stats[STAT_TIMER_ICON])
+	if (!stats[STAT_TIMER_ICON])
 	{
-		gitem_t *weapon = ent->client->pers.weapon;
+		weapon = client->pers.weapon;
 
 		if (weapon)
 		{
-			static gitem_t *plasma_pistol_weapon = NULL;
-			static gitem_t *plasma_rifle_weapon = NULL;
-			static gitem_t *pistol_plasma_ammo = NULL;
-			static gitem_t *rifle_plasma_ammo = NULL;
-			static gitem_t *dod_weapon = NULL;
-			static gitem_t *dod_ammo = NULL;
-			static int	pistol_plasma_ammo_index = 0;
-			static int	rifle_plasma_ammo_index = 0;
-			static int	dod_ammo_index = 0;
-
-			if (!plasma_pistol_weapon)
-				plasma_pistol_weapon = FindItem("Plasma Pistol");
-			if (!plasma_rifle_weapon)
-				plasma_rifle_weapon = FindItem("Plasma Rifle");
-			if (!pistol_plasma_ammo)
-			{
-				pistol_plasma_ammo = FindItem("PistolPlasma");
-				if (pistol_plasma_ammo)
-					pistol_plasma_ammo_index = ITEM_INDEX(pistol_plasma_ammo);
-			}
-			if (!rifle_plasma_ammo)
-			{
-				rifle_plasma_ammo = FindItem("Rifle Plasma");
-				if (rifle_plasma_ammo)
-					rifle_plasma_ammo_index = ITEM_INDEX(rifle_plasma_ammo);
-			}
-			if (!dod_weapon)
-				dod_weapon = FindItem("DoD Launcher");
-			if (!dod_ammo)
-			{
-				dod_ammo = FindItem("DOD");
-				if (dod_ammo)
-					dod_ammo_index = ITEM_INDEX(dod_ammo);
-			}
+			gitem_t	*pistol_plasma_ammo = G_Item (ITEM_PISTOL_PLASMA);
+			gitem_t	*rifle_plasma_ammo = G_Item (ITEM_RIFLE_PLASMA);
+			gitem_t	*dod_ammo = G_Item (ITEM_DOD);
 
-			if (weapon == plasma_pistol_weapon && pistol_plasma_ammo_index)
+			if (weapon == G_Item (ITEM_PLASMA_PISTOL))
 			{
-				int ammo = ent->client->pers.inventory[pistol_plasma_ammo_index];
+				int ammo = client->pers.inventory[G_ItemIndex (ITEM_PISTOL_PLASMA)];
 
-				if (ammo < ent->client->pers.max_pistolplasma)
+				if (ammo < client->pers.max_pistolplasma)
 				{
-					float remaining = ent->client->plasma_pistol_next_regen - level.time;
+					float remaining = client->plasma_pistol_next_regen - level.time;
 
 					if (remaining > 0.0f)
 					{
@@ -533,18 +594,18 @@ void G_SetStats (edict_t *ent)
 						if (seconds < 1)
 							seconds = 1;
 
-						ent->client->ps.stats[STAT_TIMER_ICON] = gi.imageindex(pistol_plasma_ammo->icon);
-						ent->client->ps.stats[STAT_TIMER] = seconds;
+						stats[STAT_TIMER_ICON] = G_ItemIcon (pistol_plasma_ammo);
+						stats[STAT_TIMER] = seconds;
 					}
 				}
 			}
-			else if (weapon == plasma_rifle_weapon && rifle_plasma_ammo_index)
+			else if (weapon == G_Item (ITEM_PLASMA_RIFLE))
 			{
-				int ammo = ent->client->pers.inventory[rifle_plasma_ammo_index];
+				int ammo = client->pers.inventory[G_ItemIndex (ITEM_RIFLE_PLASMA)];
 
-				if (ammo < ent->client->pers.max_rifleplasma)
+				if (ammo < client->pers.max_rifleplasma)
 				{
-					float remaining = ent->client->plasma_rifle_next_regen - level.time;
+					float remaining = client->plasma_rifle_next_regen - level.time;
 
 					if (remaining > 0.0f)
 					{
@@ -555,68 +616,251 @@ void G_SetStats (edict_t *ent)
 						if (seconds < 1)
 							seconds = 1;
 
-						ent->client->ps.stats[STAT_TIMER_ICON] = gi.imageindex(rifle_plasma_ammo->icon);
-						ent->client->ps.stats[STAT_TIMER] = seconds;
+						stats[STAT_TIMER_ICON] = G_ItemIcon (rifle_plasma_ammo);
+						stats[STAT_TIMER] = seconds;
 					}
 				}
 			}
-			else if (weapon == dod_weapon && dod_ammo_index)
+			else if (weapon == G_Item (ITEM_DOD_LAUNCHER))
 			{
-				ent->client->ps.stats[STAT_TIMER_ICON] = gi.imageindex(dod_ammo->icon);
-				ent->client->ps.stats[STAT_TIMER] = ent->client->pers.max_dods;
+				stats[STAT_TIMER_ICON] = G_ItemIcon (dod_ammo);
+				stats[STAT_TIMER] = client->pers.max_dods;
 			}
 		}
 	}
+}
 
+/*
+===============
+G_SetStats
+===============
+*/
+void G_SetStats (edict_t *ent)
+{
+	gclient_t		*client = ent->client;
+	clientstats_t	*cs;
+	short			*stats;
+	gitem_t			*item;
+	int				index, cells, ammo, armor;
+	int				power_armor_type;
+	int				dirty, stat, i;
+	qboolean		power_armor, timer;
+
+	cs = &client_stats[ent - g_edicts - 1];
+	stats = cs->stats;
+	dirty = cs->valid ? 0 : VIEW_INVENTORY|VIEW_POWERUPS;
 
 	//
-	// selected item
+	// health
 	//
-	if (ent->client->pers.selected_item == -1)
-		ent->client->ps.stats[STAT_SELECTED_ICON] = 0;
-	else
-		ent->client->ps.stats[STAT_SELECTED_ICON] = gi.imageindex (itemlist[ent->client->pers.selected_item].icon);
+	stats[STAT_HEALTH_ICON] = level.pic_health;
+	stats[STAT_HEALTH] = ent->health;
+
+	//
+	// what ammo, armor and the selected item are shown from
+	//
+	ammo = client->ammo_index ? client->pers.inventory[client->ammo_index] : 0;
+
+	cells = 0;
+	power_armor_type = PowerArmorType (ent);
+	if (power_armor_type)
+	{
+		cells = client->pers.inventory[G_ItemIndex (ITEM_CELLS)];
+		if (cells == 0)
+		{	// ran out of cells for power armor
+			ent->flags &= ~FL_POWER_ARMOR;
+			gi.sound(ent, CHAN_ITEM, G_Asset (SND_POWER_OFF), 1, ATTN_NORM, 0);
+			power_armor_type = 0;;
+		}
+	}
+
+	index = ArmorIndex (ent);
+	armor = index ? client->pers.inventory[index] : 0;
 
-	ent->client->ps.stats[STAT_SELECTED_ITEM] = ent->client->pers.selected_item;
+	// flash between power armor and other armor icon
+	power_armor = power_armor_type && (!index || (level.framenum & 8));
+
+	if (client->ammo_index != cs->ammo_index || ammo != cs->ammo
+		|| index != cs->armor_index || armor != cs->armor
+		|| power_armor != cs->power_armor || cells != cs->cells
+		|| client->pers.selected_item != cs->selected_item)
+		dirty |= VIEW_INVENTORY;
+
+	if (dirty & VIEW_INVENTORY)
+	{
+		cs->ammo_index = client->ammo_index;
+		cs->ammo = ammo;
+		cs->armor_index = index;
+		cs->armor = armor;
+		cs->power_armor = power_armor;
+		cs->cells = cells;
+		cs->selected_item = client->pers.selected_item;
+
+		//
+		// ammo
+		//
+		if (!client->ammo_index /* || !client->pers.inventory[client->ammo_index] */)
+		{
+			stats[STAT_AMMO_ICON] = 0;
+			stats[STAT_AMMO] = 0;
+		}
+		else
+		{
+			item = &itemlist[client->ammo_index];
+			stats[STAT_AMMO_ICON] = G_ItemIcon (item);
+			stats[STAT_AMMO] = ammo;
+		}
+
+		//
+		// armor
+		//
+		if (power_armor)
+		{
+			stats[STAT_ARMOR_ICON] = G_Asset (IMG_POWERSHIELD);
+			stats[STAT_ARMOR] = cells;
+		}
+		else if (index)
+		{
+			item = GetItemByIndex (index);
+			stats[STAT_ARMOR_ICON] = G_ItemIcon (item);
+			stats[STAT_ARMOR] = armor;
+		}
+		else
+		{
+			stats[STAT_ARMOR_ICON] = 0;
+			stats[STAT_ARMOR] = 0;
+		}
+
+		//
+		// selected item
+		//
+		if (client->pers.selected_item == -1)
+			stats[STAT_SELECTED_ICON] = 0;
+		else
+			stats[STAT_SELECTED_ICON] = G_ItemIcon (&itemlist[client->pers.selected_item]);
+
+		stats[STAT_SELECTED_ITEM] = client->pers.selected_item;
+	}
+
+	//
+	// pickup message
+	//
+	if (level.time > client->pickup_msg_time)
+	{
+		if (client->ps.stats[STAT_PICKUP_ICON])
+			client->ps.stats[STAT_PICKUP_ICON] = 0;
+		if (client->ps.stats[STAT_PICKUP_STRING])
+			client->ps.stats[STAT_PICKUP_STRING] = 0;
+	}
+
+	//
+	// timers, which count down for as long as a powerup lasts or the
+	// weapon in hand recharges
+	//
+	if (!cs->valid || client->pers.weapon != cs->weapon)
+	{
+		cs->weapon = client->pers.weapon;
+		cs->weapon_timer = cs->weapon && (cs->weapon == G_Item (ITEM_PLASMA_PISTOL)
+			|| cs->weapon == G_Item (ITEM_PLASMA_RIFLE) || cs->weapon == G_Item (ITEM_DOD_LAUNCHER));
+		dirty |= VIEW_POWERUPS;
+	}
+
+	timer = cs->weapon_timer
+		|| client->quad_framenum > level.framenum
+		|| client->invincible_framenum > level.framenum
+		|| client->enviro_framenum > level.framenum
+		|| client->breather_framenum > level.framenum;
+	if (timer || cs->timer)
+		dirty |= VIEW_POWERUPS;		// counting, or just stopped
+	cs->timer = timer;
+
+	if (dirty & VIEW_POWERUPS)
+		G_SetTimerStats (ent, stats);
 
 	//
 	// layouts
 	//
-	ent->client->ps.stats[STAT_LAYOUTS] = 0;
+	stats[STAT_LAYOUTS] = 0;
 
 	if (deathmatch->value)
 	{
-		if (ent->client->pers.health <= 0 || level.intermissiontime
-			|| ent->client->showscores)
-			ent->client->ps.stats[STAT_LAYOUTS] |= 1;
-		if (ent->client->showinventory && ent->client->pers.health > 0)
-			ent->client->ps.stats[STAT_LAYOUTS] |= 2;
+		if (client->pers.health <= 0 || level.intermissiontime
+			|| client->showscores)
+			stats[STAT_LAYOUTS] |= 1;
+		if (client->showinventory && client->pers.health > 0)
+			stats[STAT_LAYOUTS] |= 2;
 	}
 	else
 	{
-		if (ent->client->showscores || ent->client->showhelp)
-			ent->client->ps.stats[STAT_LAYOUTS] |= 1;
-		if (ent->client->showinventory && ent->client->pers.health > 0)
-			ent->client->ps.stats[STAT_LAYOUTS] |= 2;
+		if (client->showscores || client->showhelp)
+			stats[STAT_LAYOUTS] |= 1;
+		if (client->showinventory && client->pers.health > 0)
+			stats[STAT_LAYOUTS] |= 2;
 	}
 
 	//
 	// frags
 	//
-	ent->client->ps.stats[STAT_FRAGS] = ent->client->resp.score;
+	stats[STAT_FRAGS] = client->resp.score;
 
 	//
 	// help icon / current weapon if not shown
 	//
-	if ((ent->client->pers.helpchanged || Mission_HasUnread()) && (level.framenum&8) )
-		ent->client->ps.stats[STAT_HELPICON] = gi.imageindex ("i_help");
-	else if ( (ent->client->pers.hand == CENTER_HANDED || ent->client->ps.fov > 91)
-		&& ent->client->pers.weapon)
-		ent->client->ps.stats[STAT_HELPICON] = gi.imageindex (ent->client->pers.weapon->icon);
+	if ((client->pers.helpchanged || Mission_HasUnread()) && (level.framenum&8) )
+		stats[STAT_HELPICON] = G_Asset (IMG_HELP);
+	else if ( (client->pers.hand == CENTER_HANDED || client->ps.fov > 91)
+		&& client->pers.weapon)
+		stats[STAT_HELPICON] = G_ItemIcon (client->pers.weapon);
 	else
-		ent->client->ps.stats[STAT_HELPICON] = 0;
+		stats[STAT_HELPICON] = 0;
 
-	ent->client->ps.stats[STAT_SPECTATOR] = 0;
+	stats[STAT_SPECTATOR] = 0;
+
+	cs->valid = true;
+
+	// other code sets some of these as well (chase cams, pickups), so
+	// they are checked against what the client has rather than what was
+	// worked out last frame
+	for (i=0 ; i<sizeof(owned_stats)/sizeof(owned_stats[0]) ; i++)
+	{
+		stat = owned_stats[i];
+		if (client->ps.stats[stat] != stats[stat])
+			client->ps.stats[stat] = stats[stat];
+	}
+}
+
+// the clients chasing each client, in client order
+static int	chase_first[MAX_CLIENTS];
+static int	chase_next[MAX_CLIENTS];
+static int	chase_framenum = -1;
+
+/*
+=================
+G_BuildChaseList
+
+Called once a frame before the clients' views are set, so a client's
+chasers can be found without looking at every other client.
+=================
+*/
+void G_BuildChaseList (void)
+{
+	int			i, target;
+	gclient_t	*cl;
+
+	chase_framenum = level.framenum;
+	for (i = 0; i < game.maxclients; i++)
+		chase_first[i] = -1;
+
+	for (i = game.maxclients - 1; i >= 0; i--) {
+		cl = &game.clients[i];
+		if (!g_edicts[i+1].inuse || !cl->chase_target)
+			continue;
+		target = cl->chase_target - g_edicts - 1;
+		if (target < 0 || target >= game.maxclients)
+			continue;
+		chase_next[i] = chase_first[target];
+		chase_first[target] = i;
+	}
 }
 
 /*
@@ -629,12 +873,16 @@ void G_CheckChaseStats (edict_t *ent)
 	int i;
 	gclient_t *cl;
 
-	for (i = 1; i <= maxclients->value; i++) {
-		cl = g_edicts[i].client;
-		if (!g_edicts[i].inuse || cl->chase_target != ent)
+	// ClientBegin ends a frame on its own
+	if (chase_framenum != level.framenum)
+		G_BuildChaseList ();
+
+	for (i = chase_first[ent - g_edicts - 1]; i != -1; i = chase_next[i]) {
+		cl = g_edicts[i+1].client;
+		if (!g_edicts[i+1].inuse || cl->chase_target != ent)
 			continue;
 		memcpy(cl->ps.stats, ent->client->ps.stats, sizeof(cl->ps.stats));
-		G_SetSpectatorStats(g_edicts + i);
+		G_SetSpectatorStats(g_edicts + i + 1);
 	}
 }
 
@@ -23,30 +23,25 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #define MISSION_TIMER_TICKS_PER_SECOND ((int)(1.0f / FRAMETIME))
 
-void MissionMenu_BuildObjectiveLayout (char *buffer, size_t size)
+/*
+Appends the objective list to a layout.  Lines that don't fit are left
+out whole.
+*/
+void MissionMenu_BuildObjectiveLayout (textbuf_t *buf)
 {
         int count;
         int y;
-        size_t length;
         int i;
 
-        if (!buffer || size == 0)
-                return;
-
-        buffer[0] = '\0';
-        length = 0;
         y = 54;
 
-        Com_sprintf (buffer + length, size - length, "xv 0 yv %d string2 \"Objectives\" ", y);
-        length += strlen (buffer + length);
+        TB_Printf (buf, "xv 0 yv %d string2 \"Objectives\" ", y);
         y += 10;
 
         count = Mission_GetObjectiveCount ();
         if (count <= 0)
         {
-                if (length < size)
-                Com_sprintf (buffer + length, size - length, "xv 0 yv %d string \"No active objectives\" ", y);
-                length += strlen (buffer + length);
+                TB_Printf (buf, "xv 0 yv %d string \"No active objectives\" ", y);
                 return;
         }
 
@@ -74,16 +69,12 @@ void MissionMenu_BuildObjectiveLayout (char *buffer, size_t size)
                         break;
                 }
 
-                if (length < size)
-                        Com_sprintf (buffer + length, size - length, "xv 8 yv %d string2 \"%s %s\" ", y, marker, obj->title);
-                        length += strlen (buffer + length);
+                TB_Printf (buf, "xv 8 yv %d string2 \"%s %s\" ", y, marker, obj->title);
                 y += 10;
 
                 if (obj->text[0])
                 {
-                        if (length < size)
-                                Com_sprintf (buffer + length, size - length, "xv 16 yv %d string \"%s\" ", y, obj->text);
-                                length += strlen (buffer + length);
+                        TB_Printf (buf, "xv 16 yv %d string \"%s\" ", y, obj->text);
                         y += 8;
                 }
 
@@ -92,9 +83,7 @@ void MissionMenu_BuildObjectiveLayout (char *buffer, size_t size)
                         int seconds = obj->timer_remaining / MISSION_TIMER_TICKS_PER_SECOND;
                         if (seconds < 0)
                                 seconds = 0;
-                        if (length < size)
-                                Com_sprintf (buffer + length, size - length, "xv 16 yv %d string \"Time Remaining: %ds\" ", y, seconds);
-                                length += strlen (buffer + length);
+                        TB_Printf (buf, "xv 16 yv %d string \"Time Remaining: %ds\" ", y, seconds);
                         y += 8;
                 }
 
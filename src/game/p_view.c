@@ -23,15 +23,51 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 
 
-static	edict_t		*current_player;
-static	gclient_t	*current_client;
+// the view phase of a client's frame can run on a worker thread
+// (g_workers.c), so each thread has its own copy of these
+static	THREADLOCAL	edict_t		*current_player;
+static	THREADLOCAL	gclient_t	*current_client;
 
-static	vec3_t	forward, right, up;
-float	xyspeed;
+static	THREADLOCAL	vec3_t	forward, right, up;
+static	THREADLOCAL	float	xyspeed;
 
-float	bobmove;
-int		bobcycle;		// odd cycles are right foot going forward
-float	bobfracsin;		// sin(bobfrac*M_PI)
+static	THREADLOCAL	float	bobmove;
+static	THREADLOCAL	int		bobcycle;		// odd cycles are right foot going forward
+static	THREADLOCAL	float	bobfracsin;		// sin(bobfrac*M_PI)
+
+// the above as ClientBeginViewFrame left them for each client
+typedef struct
+{
+	vec3_t		forward, right, up;
+	float		xyspeed;
+	float		bobmove;
+	int			bobcycle;
+	float		bobfracsin;
+} clientframe_t;
+
+static	clientframe_t	client_frame[MAX_CLIENTS];
+
+// what was at each client's eye the last time it was looked up.  Only
+// the world and brush models give the contents SV_CalcBlend cares about,
+// so the lookup holds until the eye moves or a brush model is linked or
+// unlinked over it.
+//
+// The blend SV_CalcBlend worked out is kept as well.  With no powerup or
+// damage flash in it, it is the same until the eye contents change.
+typedef struct
+{
+	vec3_t		vieworg;
+	int			brushmoves;
+	int			contents;
+	qboolean	valid;
+
+	float		blend[4];			// before any screen fade is added
+	int			blend_contents;
+	int			blend_flags;		// VIEW_POWERUPS / VIEW_DAMAGE in it
+	qboolean	blend_valid;
+} clientview_t;
+
+static	clientview_t	client_view[MAX_CLIENTS];
 
 /*
 ===============
@@ -132,7 +168,7 @@ void P_DamageFeedback (edict_t *player)
 	// play an apropriate pain sound
 	if ((level.time > player->pain_debounce_time) && !(player->flags & FL_GODMODE) && (client->invincible_framenum <= level.framenum))
 	{
-		r = 1 + (rand()&1);
+		r = 1 + (G_Rand()&1);
 		player->pain_debounce_time = level.time + 0.7;
 		if (player->health < 25)
 			l = 25;
@@ -142,7 +178,7 @@ void P_DamageFeedback (edict_t *player)
 			l = 75;
 		else
 			l = 100;
-		gi.sound (player, CHAN_VOICE, gi.soundindex(va("*pain%i_%i.wav", l, r)), 1, ATTN_NORM, 0);
+		gi.sound (player, CHAN_VOICE, G_Asset (SND_PAIN25_1 + (l/25 - 1)*2 + r - 1), 1, ATTN_NORM, 0);
 	}
 
 	// the total alpha of the blend is always proportional to count
@@ -420,18 +456,47 @@ void SV_CalcBlend (edict_t *ent)
 	int		contents;
 	vec3_t	vieworg;
 	int		remaining;
-
-	ent->client->ps.blend[0] = ent->client->ps.blend[1] = 
-		ent->client->ps.blend[2] = ent->client->ps.blend[3] = 0;
+	clientview_t	*view;
+	int		dirty;
 
 	// add for contents
 	VectorAdd (ent->s.origin, ent->client->ps.viewoffset, vieworg);
-	contents = gi.pointcontents (vieworg);
+	view = &client_view[ent - g_edicts - 1];
+	if (!view->valid || !VectorCompare (view->vieworg, vieworg)
+		|| (view->brushmoves != g_brushmoves && G_BrushMovedSince (view->brushmoves, vieworg)))
+	{
+		VectorCopy (vieworg, view->vieworg);
+		view->contents = gi.pointcontents (vieworg);
+		view->valid = true;
+	}
+	view->brushmoves = g_brushmoves;
+	contents = view->contents;
 	if (contents & (CONTENTS_LAVA|CONTENTS_SLIME|CONTENTS_WATER) )
 		ent->client->ps.rdflags |= RDF_UNDERWATER;
 	else
 		ent->client->ps.rdflags &= ~RDF_UNDERWATER;
 
+	dirty = 0;
+	if (!view->blend_valid || contents != view->blend_contents)
+		dirty |= VIEW_MOVEMENT;
+	if (ent->client->quad_framenum > level.framenum
+		|| ent->client->invincible_framenum > level.framenum
+		|| ent->client->enviro_framenum > level.framenum
+		|| ent->client->breather_framenum > level.framenum)
+		dirty |= VIEW_POWERUPS;
+	if (ent->client->damage_alpha > 0 || ent->client->bonus_alpha > 0)
+		dirty |= VIEW_DAMAGE;
+
+	// only the contents are in the blend, and they haven't changed
+	if (!dirty && !view->blend_flags)
+	{
+		memcpy (ent->client->ps.blend, view->blend, sizeof(view->blend));
+		return;
+	}
+
+	ent->client->ps.blend[0] = ent->client->ps.blend[1] = 
+		ent->client->ps.blend[2] = ent->client->ps.blend[3] = 0;
+
 	if (contents & (CONTENTS_SOLID|CONTENTS_LAVA))
 		SV_AddBlend (1.0, 0.3, 0.0, 0.6, ent->client->ps.blend);
 	else if (contents & CONTENTS_SLIME)
@@ -444,7 +509,7 @@ void SV_CalcBlend (edict_t *ent)
 	{
 		remaining = ent->client->quad_framenum - level.framenum;
 		if (remaining == 30)	// beginning to fade
-			gi.sound(ent, CHAN_ITEM, gi.soundindex("items/damage2.wav"), 1, ATTN_NORM, 0);
+			gi.sound(ent, CHAN_ITEM, G_Asset (SND_QUAD_END), 1, ATTN_NORM, 0);
 		if (remaining > 30 || (remaining & 4) )
 			SV_AddBlend (0, 0, 1, 0.08, ent->client->ps.blend);
 	}
@@ -452,7 +517,7 @@ void SV_CalcBlend (edict_t *ent)
 	{
 		remaining = ent->client->invincible_framenum - level.framenum;
 		if (remaining == 30)	// beginning to fade
-			gi.sound(ent, CHAN_ITEM, gi.soundindex("items/protect2.wav"), 1, ATTN_NORM, 0);
+			gi.sound(ent, CHAN_ITEM, G_Asset (SND_INVUL_END), 1, ATTN_NORM, 0);
 		if (remaining > 30 || (remaining & 4) )
 			SV_AddBlend (1, 1, 0, 0.08, ent->client->ps.blend);
 	}
@@ -460,7 +525,7 @@ void SV_CalcBlend (edict_t *ent)
 	{
 		remaining = ent->client->enviro_framenum - level.framenum;
 		if (remaining == 30)	// beginning to fade
-			gi.sound(ent, CHAN_ITEM, gi.soundindex("items/airout.wav"), 1, ATTN_NORM, 0);
+			gi.sound(ent, CHAN_ITEM, G_Asset (SND_AIR_OUT), 1, ATTN_NORM, 0);
 		if (remaining > 30 || (remaining & 4) )
 			SV_AddBlend (0, 1, 0, 0.08, ent->client->ps.blend);
 	}
@@ -468,7 +533,7 @@ void SV_CalcBlend (edict_t *ent)
 	{
 		remaining = ent->client->breather_framenum - level.framenum;
 		if (remaining == 30)	// beginning to fade
-			gi.sound(ent, CHAN_ITEM, gi.soundindex("items/airout.wav"), 1, ATTN_NORM, 0);
+			gi.sound(ent, CHAN_ITEM, G_Asset (SND_AIR_OUT), 1, ATTN_NORM, 0);
 		if (remaining > 30 || (remaining & 4) )
 			SV_AddBlend (0.4, 1, 0.4, 0.04, ent->client->ps.blend);
 	}
@@ -481,6 +546,11 @@ void SV_CalcBlend (edict_t *ent)
 	if (ent->client->bonus_alpha > 0)
 		SV_AddBlend (0.85, 0.7, 0.3, ent->client->bonus_alpha, ent->client->ps.blend);
 
+	memcpy (view->blend, ent->client->ps.blend, sizeof(view->blend));
+	view->blend_contents = contents;
+	view->blend_flags = dirty & (VIEW_POWERUPS|VIEW_DAMAGE);
+	view->blend_valid = true;
+
 	// drop the damage value
 	ent->client->damage_alpha -= 0.06;
 	if (ent->client->damage_alpha < 0)
@@ -602,11 +672,11 @@ void P_WorldEffects (void)
 	{
 		PlayerNoise(current_player, current_player->s.origin, PNOISE_SELF);
 		if (current_player->watertype & CONTENTS_LAVA)
-			gi.sound (current_player, CHAN_BODY, gi.soundindex("player/lava_in.wav"), 1, ATTN_NORM, 0);
+			gi.sound (current_player, CHAN_BODY, G_Asset (SND_LAVA_IN), 1, ATTN_NORM, 0);
 		else if (current_player->watertype & CONTENTS_SLIME)
-			gi.sound (current_player, CHAN_BODY, gi.soundindex("player/watr_in.wav"), 1, ATTN_NORM, 0);
+			gi.sound (current_player, CHAN_BODY, G_Asset (SND_WATER_IN), 1, ATTN_NORM, 0);
 		else if (current_player->watertype & CONTENTS_WATER)
-			gi.sound (current_player, CHAN_BODY, gi.soundindex("player/watr_in.wav"), 1, ATTN_NORM, 0);
+			gi.sound (current_player, CHAN_BODY, G_Asset (SND_WATER_IN), 1, ATTN_NORM, 0);
 		current_player->flags |= FL_INWATER;
 
 		// clear damage_debounce, so the pain sound will play immediately
@@ -619,7 +689,7 @@ void P_WorldEffects (void)
 	if (old_waterlevel && ! waterlevel)
 	{
 		PlayerNoise(current_player, current_player->s.origin, PNOISE_SELF);
-		gi.sound (current_player, CHAN_BODY, gi.soundindex("player/watr_out.wav"), 1, ATTN_NORM, 0);
+		gi.sound (current_player, CHAN_BODY, G_Asset (SND_WATER_OUT), 1, ATTN_NORM, 0);
 		current_player->flags &= ~FL_INWATER;
 	}
 
@@ -628,7 +698,7 @@ void P_WorldEffects (void)
 	//
 	if (old_waterlevel != 3 && waterlevel == 3)
 	{
-		gi.sound (current_player, CHAN_BODY, gi.soundindex("player/watr_un.wav"), 1, ATTN_NORM, 0);
+		gi.sound (current_player, CHAN_BODY, G_Asset (SND_WATER_UNDER), 1, ATTN_NORM, 0);
 	}
 
 	//
@@ -638,12 +708,12 @@ void P_WorldEffects (void)
 	{
 		if (current_player->air_finished < level.time)
 		{	// gasp for air
-			gi.sound (current_player, CHAN_VOICE, gi.soundindex("player/gasp1.wav"), 1, ATTN_NORM, 0);
+			gi.sound (current_player, CHAN_VOICE, G_Asset (SND_GASP1), 1, ATTN_NORM, 0);
 			PlayerNoise(current_player, current_player->s.origin, PNOISE_SELF);
 		}
 		else  if (current_player->air_finished < level.time + 11)
 		{	// just break surface
-			gi.sound (current_player, CHAN_VOICE, gi.soundindex("player/gasp2.wav"), 1, ATTN_NORM, 0);
+			gi.sound (current_player, CHAN_VOICE, G_Asset (SND_GASP2), 1, ATTN_NORM, 0);
 		}
 	}
 
@@ -660,9 +730,9 @@ void P_WorldEffects (void)
 			if (((int)(current_client->breather_framenum - level.framenum) % 25) == 0)
 			{
 				if (!current_client->breather_sound)
-					gi.sound (current_player, CHAN_AUTO, gi.soundindex("player/u_breath1.wav"), 1, ATTN_NORM, 0);
+					gi.sound (current_player, CHAN_AUTO, G_Asset (SND_BREATH1), 1, ATTN_NORM, 0);
 				else
-					gi.sound (current_player, CHAN_AUTO, gi.soundindex("player/u_breath2.wav"), 1, ATTN_NORM, 0);
+					gi.sound (current_player, CHAN_AUTO, G_Asset (SND_BREATH2), 1, ATTN_NORM, 0);
 				current_client->breather_sound ^= 1;
 				PlayerNoise(current_player, current_player->s.origin, PNOISE_SELF);
 				//FIXME: release a bubble?
@@ -684,11 +754,11 @@ void P_WorldEffects (void)
 
 				// play a gurp sound instead of a normal pain sound
 				if (current_player->health <= current_player->dmg)
-					gi.sound (current_player, CHAN_VOICE, gi.soundindex("player/drown1.wav"), 1, ATTN_NORM, 0);
-				else if (rand()&1)
-					gi.sound (current_player, CHAN_VOICE, gi.soundindex("*gurp1.wav"), 1, ATTN_NORM, 0);
+					gi.sound (current_player, CHAN_VOICE, G_Asset (SND_DROWN), 1, ATTN_NORM, 0);
+				else if (G_Rand()&1)
+					gi.sound (current_player, CHAN_VOICE, G_Asset (SND_GURP1), 1, ATTN_NORM, 0);
 				else
-					gi.sound (current_player, CHAN_VOICE, gi.soundindex("*gurp2.wav"), 1, ATTN_NORM, 0);
+					gi.sound (current_player, CHAN_VOICE, G_Asset (SND_GURP2), 1, ATTN_NORM, 0);
 
 				current_player->pain_debounce_time = level.time;
 
@@ -713,10 +783,10 @@ void P_WorldEffects (void)
 				&& current_player->pain_debounce_time <= level.time
 				&& current_client->invincible_framenum < level.framenum)
 			{
-				if (rand()&1)
-					gi.sound (current_player, CHAN_VOICE, gi.soundindex("player/burn1.wav"), 1, ATTN_NORM, 0);
+				if (G_Rand()&1)
+					gi.sound (current_player, CHAN_VOICE, G_Asset (SND_BURN1), 1, ATTN_NORM, 0);
 				else
-					gi.sound (current_player, CHAN_VOICE, gi.soundindex("player/burn2.wav"), 1, ATTN_NORM, 0);
+					gi.sound (current_player, CHAN_VOICE, G_Asset (SND_BURN2), 1, ATTN_NORM, 0);
 				current_player->pain_debounce_time = level.time + 1;
 			}
 
@@ -814,7 +884,7 @@ G_SetClientSound
 */
 void G_SetClientSound (edict_t *ent)
 {
-	char	*weap;
+	gitem_t	*weap;
 
 	if (ent->client->pers.game_helpchanged != game.helpchanged)
 	{
@@ -826,21 +896,18 @@ void G_SetClientSound (edict_t *ent)
 	if (ent->client->pers.helpchanged && ent->client->pers.helpchanged <= 3 && !(level.framenum&63) )
 	{
 		ent->client->pers.helpchanged++;
-		gi.sound (ent, CHAN_VOICE, gi.soundindex ("misc/pc_up.wav"), 1, ATTN_STATIC, 0);
+		gi.sound (ent, CHAN_VOICE, G_Asset (SND_HELP_BEEP), 1, ATTN_STATIC, 0);
 	}
 
 
-	if (ent->client->pers.weapon)
-		weap = ent->client->pers.weapon->classname;
-	else
-		weap = "";
+	weap = ent->client->pers.weapon;
 
 	if (ent->waterlevel && (ent->watertype&(CONTENTS_LAVA|CONTENTS_SLIME)) )
 		ent->s.sound = snd_fry;
-	else if (strcmp(weap, "weapon_railgun") == 0)
-		ent->s.sound = gi.soundindex("weapons/rg_hum.wav");
-	else if (strcmp(weap, "weapon_bfg") == 0)
-		ent->s.sound = gi.soundindex("weapons/bfg_hum.wav");
+	else if (weap && weap == G_Item (ITEM_RAILGUN))
+		ent->s.sound = G_Asset (SND_RAIL_HUM);
+	else if (weap && weap == G_Item (ITEM_BFG))
+		ent->s.sound = G_Asset (SND_BFG_HUM);
 	else if (ent->client->weapon_sound)
 		ent->s.sound = ent->client->weapon_sound;
 	else
@@ -949,16 +1016,18 @@ newanim:
 
 /*
 =================
-ClientEndServerFrame
+ClientBeginViewFrame
 
-Called for each player at the end of the server frame
-and right after spawning
+The part of a client's end of frame that can hurt it, make noises heard
+by other entities or spawn things.  Returns false if the frame is already
+finished.
 =================
 */
-void ClientEndServerFrame (edict_t *ent)
+qboolean ClientBeginViewFrame (edict_t *ent)
 {
 	float	bobtime;
 	int		i;
+	clientframe_t	*frame;
 
 	current_player = ent;
 	current_client = ent->client;
@@ -989,7 +1058,7 @@ void ClientEndServerFrame (edict_t *ent)
 		current_client->ps.blend[3] = 0;
 		current_client->ps.fov = 90;
 		G_SetStats (ent);
-		return;
+		return false;
 	}
 
 	AngleVectors (ent->client->v_angle, forward, right, up);
@@ -1044,6 +1113,43 @@ void ClientEndServerFrame (edict_t *ent)
 	// apply all the damage taken this frame
 	P_DamageFeedback (ent);
 
+	frame = &client_frame[ent - g_edicts - 1];
+	VectorCopy (forward, frame->forward);
+	VectorCopy (right, frame->right);
+	VectorCopy (up, frame->up);
+	frame->xyspeed = xyspeed;
+	frame->bobmove = bobmove;
+	frame->bobcycle = bobcycle;
+	frame->bobfracsin = bobfracsin;
+
+	return true;
+}
+
+/*
+=================
+ClientCalcViewFrame
+
+Only touches ent and its client, so clients can be run in parallel once
+every ClientBeginViewFrame is done.  gi.sound and the index lookups are
+the only engine calls made, and g_workers.c makes those safe.
+=================
+*/
+void ClientCalcViewFrame (edict_t *ent)
+{
+	clientframe_t	*frame;
+
+	current_player = ent;
+	current_client = ent->client;
+
+	frame = &client_frame[ent - g_edicts - 1];
+	VectorCopy (frame->forward, forward);
+	VectorCopy (frame->right, right);
+	VectorCopy (frame->up, up);
+	xyspeed = frame->xyspeed;
+	bobmove = frame->bobmove;
+	bobcycle = frame->bobcycle;
+	bobfracsin = frame->bobfracsin;
+
 	// determine the view offsets
 	SV_CalcViewOffset (ent);
 
@@ -1056,14 +1162,12 @@ void ClientEndServerFrame (edict_t *ent)
 	// FIXME: with client prediction, the contents
 	// should be determined by the client
 	SV_CalcBlend (ent);
-	G_ScreenFade_AddBlend (ent);
 
 	// chase cam stuff
 	if (ent->client->resp.spectator)
 		G_SetSpectatorStats(ent);
 	else
 		G_SetStats (ent);
-	G_CheckChaseStats(ent);
 
 	G_SetClientEvent (ent);
 
@@ -1072,6 +1176,20 @@ void ClientEndServerFrame (edict_t *ent)
 	G_SetClientSound (ent);
 
 	G_SetClientFrame (ent);
+}
+
+/*
+=================
+ClientFinishViewFrame
+
+The rest, which reaches other clients or writes messages.
+=================
+*/
+void ClientFinishViewFrame (edict_t *ent)
+{
+	G_ScreenFade_AddBlend (ent);
+
+	G_CheckChaseStats(ent);
 
 	Camera_ClientPostFrame(ent);
 
@@ -1090,3 +1208,18 @@ void ClientEndServerFrame (edict_t *ent)
 	}
 }
 
+/*
+=================
+ClientEndServerFrame
+
+Called for each player at the end of the server frame
+and right after spawning
+=================
+*/
+void ClientEndServerFrame (edict_t *ent)
+{
+	if (!ClientBeginViewFrame (ent))
+		return;
+	ClientCalcViewFrame (ent);
+	ClientFinishViewFrame (ent);
+}
@@ -156,7 +156,7 @@ qboolean Pickup_Weapon (edict_t *ent, edict_t *other)
 
 	if (other->client->pers.weapon != ent->item && 
 		(other->client->pers.inventory[index] == 1) &&
-		( !deathmatch->value || other->client->pers.weapon == FindItem("blaster") ) )
+		( !deathmatch->value || other->client->pers.weapon == G_Item (ITEM_BLASTER) ) )
 		other->client->newweapon = ent->item;
 
 	return true;
@@ -210,7 +210,7 @@ void ChangeWeapon (edict_t *ent)
 
 	ent->client->weaponstate = WEAPON_ACTIVATING;
 	ent->client->ps.gunframe = 0;
-	ent->client->ps.gunindex = gi.modelindex(ent->client->pers.weapon->view_model);
+	ent->client->ps.gunindex = G_ItemViewModel (ent->client->pers.weapon);
 
 	ent->client->anim_priority = ANIM_PAIN;
 	if(ent->client->ps.pmove.pm_flags & PMF_DUCKED)
@@ -233,117 +233,93 @@ NoAmmoWeaponChange
 */
 void NoAmmoWeaponChange (edict_t *ent)
 {
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("Rifle Plasma"))]
-		&& ent->client->pers.inventory[ITEM_INDEX(FindItem("Plasma Rifle"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_RIFLE_PLASMA)]
+		&& ent->client->pers.inventory[G_ItemIndex (ITEM_PLASMA_RIFLE)] )
 	{
-		ent->client->newweapon = FindItem ("Plasma Rifle");
+		ent->client->newweapon = G_Item (ITEM_PLASMA_RIFLE);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("Cells"))]
-		&& ent->client->pers.inventory[ITEM_INDEX(FindItem("Obliterator"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_CELLS)]
+		&& ent->client->pers.inventory[G_ItemIndex (ITEM_OBLITERATOR)] )
 	{
-		ent->client->newweapon = FindItem ("Obliterator");
+		ent->client->newweapon = G_Item (ITEM_OBLITERATOR);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("Cells"))]
-		&& ent->client->pers.inventory[ITEM_INDEX(FindItem("Deatomizer"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_CELLS)]
+		&& ent->client->pers.inventory[G_ItemIndex (ITEM_DEATOMIZER)] )
 	{
-		ent->client->newweapon = FindItem ("Deatomizer");
+		ent->client->newweapon = G_Item (ITEM_DEATOMIZER);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("Rockets"))]
-		&& ent->client->pers.inventory[ITEM_INDEX(FindItem("HellFury"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_ROCKETS)]
+		&& ent->client->pers.inventory[G_ItemIndex (ITEM_HELLFURY)] )
 	{
-		ent->client->newweapon = FindItem ("HellFury");
+		ent->client->newweapon = G_Item (ITEM_HELLFURY);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("Detonation Pack"))]
-		&& ent->client->pers.inventory[ITEM_INDEX(FindItem("Remote Detonator"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_DETPACK)]
+		&& ent->client->pers.inventory[G_ItemIndex (ITEM_REMOTE_DETONATOR)] )
 	{
-		ent->client->newweapon = FindItem ("Remote Detonator");
+		ent->client->newweapon = G_Item (ITEM_REMOTE_DETONATOR);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("PistolPlasma"))]
-		&& ent->client->pers.inventory[ITEM_INDEX(FindItem("Plasma Pistol"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_PISTOL_PLASMA)]
+		&& ent->client->pers.inventory[G_ItemIndex (ITEM_PLASMA_PISTOL)] )
 	{
-		ent->client->newweapon = FindItem ("Plasma Pistol");
+		ent->client->newweapon = G_Item (ITEM_PLASMA_PISTOL);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("slugs"))]
-		&&  ent->client->pers.inventory[ITEM_INDEX(FindItem("railgun"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_SLUGS)]
+		&&  ent->client->pers.inventory[G_ItemIndex (ITEM_RAILGUN)] )
 	{
-		ent->client->newweapon = FindItem ("railgun");
+		ent->client->newweapon = G_Item (ITEM_RAILGUN);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("cells"))]
-		&&  ent->client->pers.inventory[ITEM_INDEX(FindItem("hyperblaster"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_CELLS)]
+		&&  ent->client->pers.inventory[G_ItemIndex (ITEM_HYPERBLASTER)] )
 	{
-		ent->client->newweapon = FindItem ("hyperblaster");
+		ent->client->newweapon = G_Item (ITEM_HYPERBLASTER);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("bullets"))]
-		&&  ent->client->pers.inventory[ITEM_INDEX(FindItem("chaingun"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_BULLETS)]
+		&&  ent->client->pers.inventory[G_ItemIndex (ITEM_CHAINGUN)] )
 	{
-		ent->client->newweapon = FindItem ("chaingun");
+		ent->client->newweapon = G_Item (ITEM_CHAINGUN);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("bullets"))]
-		&&  ent->client->pers.inventory[ITEM_INDEX(FindItem("machinegun"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_BULLETS)]
+		&&  ent->client->pers.inventory[G_ItemIndex (ITEM_MACHINEGUN)] )
 	{
-		ent->client->newweapon = FindItem ("machinegun");
+		ent->client->newweapon = G_Item (ITEM_MACHINEGUN);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("shells"))] > 1
-		&&  ent->client->pers.inventory[ITEM_INDEX(FindItem("super shotgun"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_SHELLS)] > 1
+		&&  ent->client->pers.inventory[G_ItemIndex (ITEM_SUPER_SHOTGUN)] )
 	{
-		ent->client->newweapon = FindItem ("super shotgun");
+		ent->client->newweapon = G_Item (ITEM_SUPER_SHOTGUN);
 		return;
 	}
-	if ( ent->client->pers.inventory[ITEM_INDEX(FindItem("shells"))]
-		&&  ent->client->pers.inventory[ITEM_INDEX(FindItem("shotgun"))] )
+	if ( ent->client->pers.inventory[G_ItemIndex (ITEM_SHELLS)]
+		&&  ent->client->pers.inventory[G_ItemIndex (ITEM_SHOTGUN)] )
 	{
-		ent->client->newweapon = FindItem ("shotgun");
+		ent->client->newweapon = G_Item (ITEM_SHOTGUN);
 		return;
 	}
-	ent->client->newweapon = FindItem ("blaster");
+	ent->client->newweapon = G_Item (ITEM_BLASTER);
 }
 
 static void Oblivion_UpdateWeaponRegen (edict_t *ent)
 {
         gclient_t       *cl;
-        static qboolean regen_indexes_cached = false;
-        static int      plasma_pistol_index;
-        static int      plasma_rifle_index;
-        static int      pistol_plasma_ammo_index;
-        static int      rifle_plasma_ammo_index;
+        int             plasma_pistol_index = G_ItemIndex (ITEM_PLASMA_PISTOL);
+        int             plasma_rifle_index = G_ItemIndex (ITEM_PLASMA_RIFLE);
+        int             pistol_plasma_ammo_index = G_ItemIndex (ITEM_PISTOL_PLASMA);
+        int             rifle_plasma_ammo_index = G_ItemIndex (ITEM_RIFLE_PLASMA);
 
         cl = ent->client;
         if (!cl)
                 return;
 
-        if (!regen_indexes_cached)
-        {
-                gitem_t *lookup;
-
-                lookup = FindItem("Plasma Pistol");
-                if (lookup)
-                        plasma_pistol_index = ITEM_INDEX(lookup);
-
-                lookup = FindItem("Plasma Rifle");
-                if (lookup)
-                        plasma_rifle_index = ITEM_INDEX(lookup);
-
-                lookup = FindItem("PistolPlasma");
-                if (lookup)
-                        pistol_plasma_ammo_index = ITEM_INDEX(lookup);
-
-                lookup = FindItem("Rifle Plasma");
-                if (lookup)
-                        rifle_plasma_ammo_index = ITEM_INDEX(lookup);
-
-                regen_indexes_cached = true;
-        }
-
         if (plasma_pistol_index && cl->plasma_pistol_next_regen <= level.time)
         {
                 if (cl->pers.inventory[plasma_pistol_index] && pistol_plasma_ammo_index)
@@ -592,7 +568,7 @@ void Weapon_Generic (edict_t *ent, int FRAME_ACTIVATE_LAST, int FRAME_FIRE_LAST,
 			{
 				if (level.time >= ent->pain_debounce_time)
 				{
-					gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+					gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
 					ent->pain_debounce_time = level.time + 1;
 				}
 				NoAmmoWeaponChange (ent);
@@ -612,7 +588,7 @@ void Weapon_Generic (edict_t *ent, int FRAME_ACTIVATE_LAST, int FRAME_FIRE_LAST,
 				{
 					if (ent->client->ps.gunframe == pause_frames[n])
 					{
-						if (rand()&15)
+						if (G_Rand()&15)
 							return;
 					}
 				}
@@ -630,7 +606,7 @@ void Weapon_Generic (edict_t *ent, int FRAME_ACTIVATE_LAST, int FRAME_FIRE_LAST,
 			if (ent->client->ps.gunframe == fire_frames[n])
 			{
 				if (ent->client->quad_framenum > level.framenum)
-					gi.sound(ent, CHAN_ITEM, gi.soundindex("items/damage3.wav"), 1, ATTN_NORM, 0);
+					gi.sound(ent, CHAN_ITEM, G_Asset (SND_QUAD_FIRE), 1, ATTN_NORM, 0);
 
 				fire (ent);
 				break;
@@ -737,7 +713,7 @@ void Weapon_Grenade (edict_t *ent)
 			{
 				if (level.time >= ent->pain_debounce_time)
 				{
-					gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+					gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
 					ent->pain_debounce_time = level.time + 1;
 				}
 				NoAmmoWeaponChange (ent);
@@ -747,7 +723,7 @@ void Weapon_Grenade (edict_t *ent)
 
 		if ((ent->client->ps.gunframe == 29) || (ent->client->ps.gunframe == 34) || (ent->client->ps.gunframe == 39) || (ent->client->ps.gunframe == 48))
 		{
-			if (rand()&15)
+			if (G_Rand()&15)
 				return;
 		}
 
@@ -759,14 +735,14 @@ void Weapon_Grenade (edict_t *ent)
 	if (ent->client->weaponstate == WEAPON_FIRING)
 	{
 		if (ent->client->ps.gunframe == 5)
-			gi.sound(ent, CHAN_WEAPON, gi.soundindex("weapons/hgrena1b.wav"), 1, ATTN_NORM, 0);
+			gi.sound(ent, CHAN_WEAPON, G_Asset (SND_GRENADE_PIN), 1, ATTN_NORM, 0);
 
 		if (ent->client->ps.gunframe == 11)
 		{
 			if (!ent->client->grenade_time)
 			{
 				ent->client->grenade_time = level.time + GRENADE_TIMER + 0.2;
-				ent->client->weapon_sound = gi.soundindex("weapons/hgrenc1b.wav");
+				ent->client->weapon_sound = G_Asset (SND_GRENADE_FUSE);
 			}
 
 			// they waited too long, detonate it in their hand
@@ -987,7 +963,7 @@ void Weapon_HyperBlaster_Fire (edict_t *ent)
 	int		effect;
 	int		damage;
 
-	ent->client->weapon_sound = gi.soundindex("weapons/hyprbl1a.wav");
+	ent->client->weapon_sound = G_Asset (SND_HYPER_LOOP);
 
 	if (!(ent->client->buttons & BUTTON_ATTACK))
 	{
@@ -999,7 +975,7 @@ void Weapon_HyperBlaster_Fire (edict_t *ent)
 		{
 			if (level.time >= ent->pain_debounce_time)
 			{
-				gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+				gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
 				ent->pain_debounce_time = level.time + 1;
 			}
 			NoAmmoWeaponChange (ent);
@@ -1043,7 +1019,7 @@ void Weapon_HyperBlaster_Fire (edict_t *ent)
 
 	if (ent->client->ps.gunframe == 12)
 	{
-		gi.sound(ent, CHAN_AUTO, gi.soundindex("weapons/hyprbd1a.wav"), 1, ATTN_NORM, 0);
+		gi.sound(ent, CHAN_AUTO, G_Asset (SND_HYPER_DOWN), 1, ATTN_NORM, 0);
 		ent->client->weapon_sound = 0;
 	}
 
@@ -1092,7 +1068,7 @@ void Machinegun_Fire (edict_t *ent)
 		ent->client->ps.gunframe = 6;
 		if (level.time >= ent->pain_debounce_time)
 		{
-			gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+			gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
 			ent->pain_debounce_time = level.time + 1;
 		}
 		NoAmmoWeaponChange (ent);
@@ -1176,7 +1152,7 @@ void Chaingun_Fire (edict_t *ent)
 		damage = 8;
 
 	if (ent->client->ps.gunframe == 5)
-		gi.sound(ent, CHAN_AUTO, gi.soundindex("weapons/chngnu1a.wav"), 1, ATTN_IDLE, 0);
+		gi.sound(ent, CHAN_AUTO, G_Asset (SND_CHAINGUN_UP), 1, ATTN_IDLE, 0);
 
 	if ((ent->client->ps.gunframe == 14) && !(ent->client->buttons & BUTTON_ATTACK))
 	{
@@ -1197,11 +1173,11 @@ void Chaingun_Fire (edict_t *ent)
 	if (ent->client->ps.gunframe == 22)
 	{
 		ent->client->weapon_sound = 0;
-		gi.sound(ent, CHAN_AUTO, gi.soundindex("weapons/chngnd1a.wav"), 1, ATTN_IDLE, 0);
+		gi.sound(ent, CHAN_AUTO, G_Asset (SND_CHAINGUN_DOWN), 1, ATTN_IDLE, 0);
 	}
 	else
 	{
-		ent->client->weapon_sound = gi.soundindex("weapons/chngnl1a.wav");
+		ent->client->weapon_sound = G_Asset (SND_CHAINGUN_LOOP);
 	}
 
 	ent->client->anim_priority = ANIM_ATTACK;
@@ -1235,7 +1211,7 @@ void Chaingun_Fire (edict_t *ent)
 	{
 		if (level.time >= ent->pain_debounce_time)
 		{
-			gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+			gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
 			ent->pain_debounce_time = level.time + 1;
 		}
 		NoAmmoWeaponChange (ent);
@@ -1571,7 +1547,7 @@ static void Weapon_Deatomizer_Fire (edict_t *ent)
                         ent->client->ps.gunframe++;
                         if (level.time >= ent->pain_debounce_time)
                         {
-                                gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+                                gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
                                 ent->pain_debounce_time = level.time + 1;
                         }
                         return;
@@ -1622,7 +1598,7 @@ static void Weapon_PlasmaPistol_Fire (edict_t *ent)
                         ent->client->ps.gunframe++;
                         if (level.time >= ent->pain_debounce_time)
                         {
-                                gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+                                gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
                                 ent->pain_debounce_time = level.time + 1;
                         }
                         return;
@@ -1672,7 +1648,7 @@ static void Weapon_PlasmaRifle_Fire (edict_t *ent)
                         ent->client->ps.gunframe++;
                         if (level.time >= ent->pain_debounce_time)
                         {
-                                gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+                                gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
                                 ent->pain_debounce_time = level.time + 1;
                         }
                         return;
@@ -1724,7 +1700,7 @@ static void Weapon_Hellfury_Fire (edict_t *ent)
                         ent->client->ps.gunframe++;
                         if (level.time >= ent->pain_debounce_time)
                         {
-                                gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+                                gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
                                 ent->pain_debounce_time = level.time + 1;
                         }
                         return;
@@ -1781,7 +1757,7 @@ static void Weapon_DOD_Fire (edict_t *ent)
                         ent->client->ps.gunframe++;
                         if (level.time >= ent->pain_debounce_time)
                         {
-                                gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+                                gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
                                 ent->pain_debounce_time = level.time + 1;
                         }
                         return;
@@ -1804,7 +1780,7 @@ static void Weapon_DOD_Fire (edict_t *ent)
         gi.WriteByte (MZ_BFG | is_silenced);
         gi.multicast (ent->s.origin, MULTICAST_PVS);
 
-        gi.sound (ent, CHAN_WEAPON, gi.soundindex("sound/dod/DoD.wav"), 1, ATTN_NORM, 0);
+        gi.sound (ent, CHAN_WEAPON, G_Asset (SND_DOD), 1, ATTN_NORM, 0);
 
         ent->client->ps.gunframe++;
         PlayerNoise(ent, start, PNOISE_WEAPON);
@@ -1835,7 +1811,7 @@ static void Weapon_LaserCannon_Fire (edict_t *ent)
                         ent->client->ps.gunframe++;
                         if (level.time >= ent->pain_debounce_time)
                         {
-                                gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+                                gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
                                 ent->pain_debounce_time = level.time + 1;
                         }
                         return;
@@ -1858,7 +1834,7 @@ static void Weapon_LaserCannon_Fire (edict_t *ent)
         gi.WriteByte (MZ_RAILGUN | is_silenced);
         gi.multicast (ent->s.origin, MULTICAST_PVS);
 
-        gi.sound(ent, CHAN_WEAPON, gi.soundindex("weapons/hyprbu1a.wav"), 1, ATTN_NORM, 0);
+        gi.sound(ent, CHAN_WEAPON, G_Asset (SND_HYPER_UP), 1, ATTN_NORM, 0);
 
         ent->client->ps.gunframe++;
         PlayerNoise(ent, start, PNOISE_WEAPON);
@@ -1915,7 +1891,7 @@ static void Weapon_RemoteDetonator_Fire (edict_t *ent)
                                 ent->client->ps.gunframe++;
                                 if (level.time >= ent->pain_debounce_time)
                                 {
-                                        gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+                                        gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
                                         ent->pain_debounce_time = level.time + 1;
                                 }
                                 return;
@@ -1975,7 +1951,7 @@ static void Weapon_ProximityMines_Fire (edict_t *ent)
 			ent->client->ps.gunframe++;
 			if (level.time >= ent->pain_debounce_time)
 			{
-				gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/noammo.wav"), 1, ATTN_NORM, 0);
+				gi.sound(ent, CHAN_VOICE, G_Asset (SND_NOAMMO), 1, ATTN_NORM, 0);
 				ent->pain_debounce_time = level.time + 1;
 			}
 			return;
@@ -1994,7 +1970,7 @@ static void Weapon_ProximityMines_Fire (edict_t *ent)
 	mine = fire_proximity_mine (ent, start, forward, damage, 600, radius, splash);
 
 	if (mine)
-		gi.sound(ent, CHAN_ITEM, gi.soundindex("weapons/hgrent1a.wav"), 1, ATTN_NORM, 0);
+		gi.sound(ent, CHAN_ITEM, G_Asset (SND_GRENADE_TOSS), 1, ATTN_NORM, 0);
 
 	gi.WriteByte (svc_muzzleflash);
 	gi.WriteShort (ent-g_edicts);
@@ -0,0 +1,74 @@
+// client_stats.c -- stats and blends that are only worked out when their inputs change
+
+#include "harness.h"
+
+void SV_CalcBlend (edict_t *ent);
+
+int main (int argc, char **argv)
+{
+	game_export_t	*ge;
+	edict_t			*ent;
+	gclient_t		*client;
+	int				shells, frames;
+
+	ge = Harness_Init (1);
+	ge->SpawnEntities ("harness", "{\n\"classname\" \"worldspawn\"\n}\n", "");
+
+	ent = &g_edicts[1];
+	client = ent->client;
+	ent->health = 100;
+	client->pers.selected_item = -1;
+	shells = G_ItemIndex (ITEM_SHELLS);
+	client->ammo_index = shells;
+	client->pers.inventory[shells] = 10;
+
+	G_SetStats (ent);
+	CHECK (client->ps.stats[STAT_HEALTH] == 100);
+	CHECK (client->ps.stats[STAT_AMMO] == 10);
+	CHECK (client->ps.stats[STAT_TIMER] == 0);
+
+	// the inventory changing is picked up on the next frame
+	client->pers.inventory[shells] = 9;
+	level.framenum++;
+	G_SetStats (ent);
+	CHECK (client->ps.stats[STAT_AMMO] == 9);
+
+	// a chase cam or pickup writing over the stats is put right, even
+	// though nothing G_SetStats reads has changed
+	client->ps.stats[STAT_AMMO] = 50;
+	client->ps.stats[STAT_HEALTH] = 1;
+	level.framenum++;
+	G_SetStats (ent);
+	CHECK (client->ps.stats[STAT_AMMO] == 9);
+	CHECK (client->ps.stats[STAT_HEALTH] == 100);
+
+	// a powerup's timer counts down, and clears when it runs out
+	client->quad_framenum = level.framenum + 25;
+	level.framenum++;
+	G_SetStats (ent);
+	CHECK (client->ps.stats[STAT_TIMER] == 2);
+	CHECK (client->ps.stats[STAT_TIMER_ICON] != 0);
+	level.framenum += 24;
+	G_SetStats (ent);
+	CHECK (client->ps.stats[STAT_TIMER] == 0);
+	CHECK (client->ps.stats[STAT_TIMER_ICON] == 0);
+
+	// a damage flash fades out of the blend, and the blend goes back to
+	// what the contents give once it has
+	SV_CalcBlend (ent);
+	CHECK (client->ps.blend[3] == 0);
+	VectorSet (client->damage_blend, 1, 0, 0);
+	client->damage_alpha = 0.5;
+	SV_CalcBlend (ent);
+	CHECK (client->ps.blend[3] > 0);
+	for (frames=0 ; frames<20 && client->damage_alpha > 0 ; frames++)
+		SV_CalcBlend (ent);
+	CHECK (client->damage_alpha == 0);
+	SV_CalcBlend (ent);
+	CHECK (client->ps.blend[3] == 0);
+	SV_CalcBlend (ent);
+	CHECK (client->ps.blend[3] == 0);
+
+	printf ("ok\n");
+	return 0;
+}
@@ -0,0 +1,95 @@
+// delta_save.c -- hub levels cached as a delta, written to disk whole
+//
+// usage: delta_save <dir> cache|changed|stale
+//
+// cache:   the file is deleted after WriteLevel, so the level can only
+//          come back from the hub cache's delta image
+// changed: the map is spawned differently before ReadLevel, so the
+//          delta image can't be rebuilt and the file has to be used
+// stale:   the level is read back without a SpawnEntities first, over
+//          an edict left past num_edicts
+
+#include "harness.h"
+
+static char	*spawned =
+	"{\n\"classname\" \"worldspawn\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"a\"\n\"origin\" \"0 0 0\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"b\"\n\"origin\" \"64 0 0\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"c\"\n\"origin\" \"128 0 0\"\n}\n";
+
+// the same map after an update put another entity in front
+static char	*updated =
+	"{\n\"classname\" \"worldspawn\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"new\"\n\"origin\" \"0 64 0\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"a\"\n\"origin\" \"0 0 0\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"b\"\n\"origin\" \"64 0 0\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"c\"\n\"origin\" \"128 0 0\"\n}\n";
+
+static int CountNotNull (void)
+{
+	edict_t	*ent;
+	int		count;
+
+	count = 0;
+	for (ent=g_edicts ; ent<&g_edicts[globals.num_edicts] ; ent++)
+		if (ent->inuse && ent->classname && !strcmp (ent->classname, "info_notnull"))
+			count++;
+	return count;
+}
+
+int main (int argc, char **argv)
+{
+	game_export_t	*ge;
+	edict_t			*ent, *high;
+	char			path[MAX_OSPATH];
+	qboolean		changed, stale;
+	int				i;
+
+	if (argc < 3)
+		return 1;
+	changed = !strcmp (argv[2], "changed");
+	stale = !strcmp (argv[2], "stale");
+	Com_sprintf (path, sizeof(path), "%s/hub1.sav", argv[1]);
+
+	ge = Harness_Init (1);
+	ge->SpawnEntities ("hub1", spawned, "");
+
+	// one entity moves and one is removed, the third is left alone
+	ent = G_Find (NULL, FOFS(targetname), "b");
+	CHECK (ent);
+	ent->s.origin[2] = 32;
+	G_FreeEdict (G_Find (NULL, FOFS(targetname), "c"));
+
+	ge->WriteLevel (path);
+	if (!changed)
+		remove (path);
+
+	if (stale)
+	{
+		high = &g_edicts[game.maxentities - 1];
+		high->inuse = true;
+		high->classname = "info_notnull";
+		high->health = 100;
+	}
+	else
+		ge->SpawnEntities ("hub1", changed ? updated : spawned, "");
+	ge->ReadLevel (path);
+	CHECK (harness.errors == 0);
+
+	if (stale)
+	{
+		high = &g_edicts[game.maxentities - 1];
+		for (i=0 ; i<(int)sizeof(*high) ; i++)
+			CHECK (((byte *)high)[i] == 0);
+	}
+
+	CHECK (CountNotNull () == 2);
+	CHECK (G_Find (NULL, FOFS(targetname), "a") != NULL);
+	CHECK (G_Find (NULL, FOFS(targetname), "c") == NULL);
+	CHECK (G_Find (NULL, FOFS(targetname), "new") == NULL);
+	ent = G_Find (NULL, FOFS(targetname), "b");
+	CHECK (ent && ent->s.origin[2] == 32);
+
+	printf ("ok\n");
+	return 0;
+}
@@ -0,0 +1,387 @@
+// engine.c -- a stand-in engine for running game code from the tests
+//
+// Nothing here collides or sends anything: traces hit nothing, every
+// point is empty and in every PVS, and messages are only counted.
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include "harness.h"
+
+game_export_t *GetGameAPI (game_import_t *import);
+
+harness_counts_t	harness;
+jmp_buf				*harness_error_jump;
+char				harness_error[1024];
+
+static int		harness_argc;
+static char		**harness_argv;
+
+// m_actor.c and m_kigrax.c don't build in this tree, so the harness
+// leaves them out and stands in for what the rest of the game calls
+void Actor_PostLoad (edict_t *self) {}
+void SP_misc_actor (edict_t *self) { G_FreeEdict (self); }
+void SP_monster_kigrax (edict_t *self) { G_FreeEdict (self); }
+void SP_target_actor (edict_t *self) { G_FreeEdict (self); }
+
+static void H_Print (char *fmt, va_list argptr)
+{
+	if (getenv ("HARNESS_VERBOSE"))
+		vprintf (fmt, argptr);
+}
+
+static void H_bprintf (int printlevel, char *fmt, ...)
+{
+	va_list	argptr;
+
+	va_start (argptr, fmt);
+	H_Print (fmt, argptr);
+	va_end (argptr);
+}
+
+static void H_dprintf (char *fmt, ...)
+{
+	va_list	argptr;
+
+	va_start (argptr, fmt);
+	H_Print (fmt, argptr);
+	va_end (argptr);
+}
+
+static void H_cprintf (edict_t *ent, int printlevel, char *fmt, ...)
+{
+	va_list	argptr;
+
+	va_start (argptr, fmt);
+	H_Print (fmt, argptr);
+	va_end (argptr);
+}
+
+static void H_centerprintf (edict_t *ent, char *fmt, ...)
+{
+	va_list	argptr;
+
+	va_start (argptr, fmt);
+	H_Print (fmt, argptr);
+	va_end (argptr);
+}
+
+static void H_error (char *fmt, ...)
+{
+	va_list	argptr;
+
+	va_start (argptr, fmt);
+	vsnprintf (harness_error, sizeof(harness_error), fmt, argptr);
+	va_end (argptr);
+
+	harness.errors++;
+	if (harness_error_jump)
+		longjmp (*harness_error_jump, 1);
+	printf ("ERROR %s\n", harness_error);
+	exit (2);
+}
+
+static void H_sound (edict_t *ent, int channel, int soundindex, float volume, float attenuation, float timeofs)
+{
+	harness.sounds++;
+}
+
+static void H_positioned_sound (vec3_t origin, edict_t *ent, int channel, int soundindex, float volume, float attenuation, float timeofs)
+{
+	harness.sounds++;
+}
+
+static void H_configstring (int num, char *string)
+{
+}
+
+static int H_index (char *name)
+{
+	return 1;
+}
+
+static void H_linkentity (edict_t *ent);
+
+// like the engine, an inline brush model is linked straight away
+static void H_setmodel (edict_t *ent, char *name)
+{
+	if (name && name[0] == '*')
+		H_linkentity (ent);
+}
+
+static trace_t H_trace (vec3_t start, vec3_t mins, vec3_t maxs, vec3_t end, edict_t *passent, int contentmask)
+{
+	trace_t	tr;
+
+	memset (&tr, 0, sizeof(tr));
+	tr.fraction = 1;
+	VectorCopy (end, tr.endpos);
+	tr.ent = g_edicts;
+	return tr;
+}
+
+static int H_pointcontents (vec3_t point)
+{
+	return 0;
+}
+
+static qboolean H_inPVS (vec3_t p1, vec3_t p2)
+{
+	harness.pvs_tests++;
+	return true;
+}
+
+static void H_SetAreaPortalState (int portalnum, qboolean open)
+{
+}
+
+static qboolean H_AreasConnected (int area1, int area2)
+{
+	return true;
+}
+
+static link_t	harness_area;
+
+static void H_linkentity (edict_t *ent)
+{
+	VectorAdd (ent->s.origin, ent->mins, ent->absmin);
+	VectorAdd (ent->s.origin, ent->maxs, ent->absmax);
+	VectorSubtract (ent->maxs, ent->mins, ent->size);
+	ent->area.prev = &harness_area;
+	ent->linkcount++;
+}
+
+static void H_unlinkentity (edict_t *ent)
+{
+	ent->area.prev = NULL;
+}
+
+static int H_BoxEdicts (vec3_t mins, vec3_t maxs, edict_t **list, int maxcount, int areatype)
+{
+	return 0;
+}
+
+static void H_Pmove (pmove_t *pmove)
+{
+}
+
+static void H_multicast (vec3_t origin, multicast_t to)
+{
+	harness.multicasts++;
+}
+
+static void H_unicast (edict_t *ent, qboolean reliable)
+{
+	harness.unicasts++;
+}
+
+static void H_WriteInt (int c)
+{
+}
+
+static void H_WriteFloat (float f)
+{
+}
+
+static void H_WriteString (char *s)
+{
+}
+
+static void H_WriteVec (vec3_t v)
+{
+}
+
+// TagMalloc blocks are chained so FreeTags can give them back
+typedef struct hblock_s
+{
+	struct hblock_s	*prev, *next;
+	int				tag;
+	int				pad[3];
+} hblock_t;
+
+static hblock_t	harness_blocks = {&harness_blocks, &harness_blocks};
+
+static void *H_TagMalloc (int size, int tag)
+{
+	hblock_t	*b;
+
+	b = calloc (1, sizeof(*b) + size);
+	b->tag = tag;
+	b->next = harness_blocks.next;
+	b->prev = &harness_blocks;
+	b->next->prev = b;
+	harness_blocks.next = b;
+	return b + 1;
+}
+
+static void H_TagFree (void *block)
+{
+	hblock_t	*b;
+
+	b = (hblock_t *)block - 1;
+	b->prev->next = b->next;
+	b->next->prev = b->prev;
+	free (b);
+}
+
+static void H_FreeTags (int tag)
+{
+	hblock_t	*b, *next;
+
+	for (b=harness_blocks.next ; b != &harness_blocks ; b=next)
+	{
+		next = b->next;
+		if (b->tag == tag)
+			H_TagFree (b + 1);
+	}
+}
+
+typedef struct hcvar_s
+{
+	cvar_t			cvar;
+	struct hcvar_s	*next;
+} hcvar_t;
+
+static hcvar_t	*harness_cvars;
+
+static cvar_t *H_cvar_set (char *name, char *value)
+{
+	hcvar_t	*v;
+
+	for (v=harness_cvars ; v ; v=v->next)
+		if (!strcmp (v->cvar.name, name))
+			break;
+	if (!v)
+	{
+		v = calloc (1, sizeof(*v));
+		v->cvar.name = strdup (name);
+		v->next = harness_cvars;
+		harness_cvars = v;
+	}
+	v->cvar.string = strdup (value);
+	v->cvar.value = (float)atof (value);
+	v->cvar.modified = true;
+	return &v->cvar;
+}
+
+static cvar_t *H_cvar (char *name, char *value, int flags)
+{
+	hcvar_t	*v;
+	char	*env, envname[128];
+
+	for (v=harness_cvars ; v ; v=v->next)
+		if (!strcmp (v->cvar.name, name))
+			return &v->cvar;
+
+	// HARNESS_CVAR_<name> overrides a default
+	snprintf (envname, sizeof(envname), "HARNESS_CVAR_%s", name);
+	env = getenv (envname);
+	return H_cvar_set (name, env ? env : value);
+}
+
+static int H_argc (void)
+{
+	return harness_argc;
+}
+
+static char *H_argv (int n)
+{
+	return n < harness_argc ? harness_argv[n] : "";
+}
+
+static char *H_args (void)
+{
+	return harness_argc > 1 ? harness_argv[1] : "";
+}
+
+static void H_AddCommandString (char *text)
+{
+}
+
+static void H_DebugGraph (float value, int color)
+{
+}
+
+void Harness_Args (int argc, char **argv)
+{
+	harness_argc = argc;
+	harness_argv = argv;
+}
+
+void Harness_Reset (void)
+{
+	memset (&harness, 0, sizeof(harness));
+}
+
+game_export_t *Harness_Init (int maxclients)
+{
+	game_import_t	import;
+	game_export_t	*ge;
+	char			value[16];
+
+	memset (&import, 0, sizeof(import));
+	import.bprintf = H_bprintf;
+	import.dprintf = H_dprintf;
+	import.cprintf = H_cprintf;
+	import.centerprintf = H_centerprintf;
+	import.sound = H_sound;
+	import.positioned_sound = H_positioned_sound;
+	import.configstring = H_configstring;
+	import.error = H_error;
+	import.modelindex = H_index;
+	import.soundindex = H_index;
+	import.imageindex = H_index;
+	import.setmodel = H_setmodel;
+	import.trace = H_trace;
+	import.pointcontents = H_pointcontents;
+	import.inPVS = H_inPVS;
+	import.inPHS = H_inPVS;
+	import.SetAreaPortalState = H_SetAreaPortalState;
+	import.AreasConnected = H_AreasConnected;
+	import.linkentity = H_linkentity;
+	import.unlinkentity = H_unlinkentity;
+	import.BoxEdicts = H_BoxEdicts;
+	import.Pmove = H_Pmove;
+	import.multicast = H_multicast;
+	import.unicast = H_unicast;
+	import.WriteChar = H_WriteInt;
+	import.WriteByte = H_WriteInt;
+	import.WriteShort = H_WriteInt;
+	import.WriteLong = H_WriteInt;
+	import.WriteFloat = H_WriteFloat;
+	import.WriteString = H_WriteString;
+	import.WritePosition = H_WriteVec;
+	import.WriteDir = H_WriteVec;
+	import.WriteAngle = H_WriteFloat;
+	import.TagMalloc = H_TagMalloc;
+	import.TagFree = H_TagFree;
+	import.FreeTags = H_FreeTags;
+	import.cvar = H_cvar;
+	import.cvar_set = H_cvar_set;
+	import.cvar_forceset = H_cvar_set;
+	import.argc = H_argc;
+	import.argv = H_argv;
+	import.args = H_args;
+	import.AddCommandString = H_AddCommandString;
+	import.DebugGraph = H_DebugGraph;
+
+	snprintf (value, sizeof(value), "%i", maxclients);
+	H_cvar_set ("maxclients", value);
+
+	ge = GetGameAPI (&import);
+	ge->Init ();
+	return ge;
+}
+
+edict_t *Harness_Spawn (char *classname, float x, float y, float z)
+{
+	edict_t	*ent;
+
+	ent = G_Spawn ();
+	ent->classname = classname;
+	VectorSet (ent->s.origin, x, y, z);
+	VectorSet (ent->mins, -16, -16, -16);
+	VectorSet (ent->maxs, 16, 16, 16);
+	ent->solid = SOLID_BBOX;
+	gi.linkentity (ent);
+	return ent;
+}
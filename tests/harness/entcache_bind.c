@@ -0,0 +1,118 @@
+// entcache_bind.c -- a damaged entity cache file is compiled again, not used
+//
+// usage: entcache_bind field|string|spawn
+//
+// Run from an empty directory: the cache file goes in oblivion/maps.
+
+#include <sys/stat.h>
+#include "harness.h"
+
+// the layout g_entcache.c writes
+typedef struct
+{
+	int			ident;
+	int			version;
+	unsigned	build;
+	unsigned	crc;
+	int			length;
+	int			numents;
+	int			numvalues;
+	int			poolsize;
+} header_t;
+
+typedef struct
+{
+	int			firstvalue;
+	short		numvalues;
+	short		flags;
+	int			spawn;
+} ent_t;
+
+typedef struct
+{
+	int			field;
+	union
+	{
+		vec3_t	vec;
+		int		i;
+		float	f;
+		int		str;
+	} u;
+} value_t;
+
+static char	*entities =
+	"{\n\"classname\" \"worldspawn\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"a\"\n\"origin\" \"0 0 0\"\n}\n";
+
+static char	*filename = GAMEVERSION "/maps/damaged.entc";
+
+static int ReadFile (byte *data, int max)
+{
+	FILE	*f;
+	int		size;
+
+	f = fopen (filename, "rb");
+	if (!f)
+		return -1;
+	size = fread (data, 1, max, f);
+	fclose (f);
+	return size;
+}
+
+int main (int argc, char **argv)
+{
+	game_export_t	*ge;
+	static byte		good[65536], data[65536];
+	int				size, i;
+	header_t		*h;
+	ent_t			*ents;
+	value_t			*values;
+	FILE			*f;
+
+	if (argc < 2)
+		return 1;
+	mkdir (GAMEVERSION, 0777);
+	mkdir (GAMEVERSION "/maps", 0777);
+
+	ge = Harness_Init (1);
+	ge->SpawnEntities ("damaged", entities, "");
+	size = ReadFile (good, sizeof(good));
+	CHECK (size > (int)sizeof(header_t));
+	memcpy (data, good, size);
+
+	h = (header_t *)data;
+	ents = (ent_t *)(h + 1);
+	values = (value_t *)(ents + h->numents);
+	CHECK (h->numents == 2 && h->numvalues > 0);
+
+	if (!strcmp (argv[1], "field"))
+		values[0].field = 100000;
+	else if (!strcmp (argv[1], "string"))
+	{
+		for (i=0 ; i<h->numvalues ; i++)
+			if (fields[values[i].field].type == F_LSTRING)
+				values[i].u.str = h->poolsize + 64;
+	}
+	else if (!strcmp (argv[1], "spawn"))
+		ents[1].spawn = -100000;
+	else
+		return 1;
+
+	f = fopen (filename, "wb");
+	CHECK (f);
+	fwrite (data, 1, size, f);
+	fclose (f);
+
+	// only the file is left to load from
+	EntCache_Clear ();
+	ge->SpawnEntities ("damaged", entities, "");
+	CHECK (harness.errors == 0);
+	CHECK (G_Find (NULL, FOFS(targetname), "a") != NULL);
+
+	// and it was compiled again and written back whole
+	CHECK (ReadFile (data, sizeof(data)) == size);
+	CHECK (!memcmp (data, good, size));
+
+	printf ("ok\n");
+	return 0;
+}
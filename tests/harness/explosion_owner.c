@@ -0,0 +1,58 @@
+// explosion_owner.c -- a queued blast whose self-attacking explosive is freed
+
+#include "harness.h"
+
+static edict_t	*died_attacker;
+
+static void target_die (edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, vec3_t point)
+{
+	died_attacker = attacker;
+	self->activator = attacker;		// what barrel_delay does
+	self->die = NULL;				// not one the save tables know
+}
+
+static qboolean IsEdict (edict_t *ent)
+{
+	return ent >= g_edicts && ent < g_edicts + game.maxentities;
+}
+
+int main (int argc, char **argv)
+{
+	game_export_t	*ge;
+	edict_t			*owner, *barrel, *target;
+	char			path[MAX_OSPATH];
+	qboolean		owned;
+
+	ge = Harness_Init (1);
+	ge->SpawnEntities ("harness", "{\n\"classname\" \"worldspawn\"\n}\n", "");
+
+	owner = Harness_Spawn ("player_stand_in", 400, 0, 0);
+	barrel = Harness_Spawn ("misc_explobox", 0, 0, 0);
+	owned = argc > 2 && !strcmp (argv[2], "owner");
+	barrel->owner = owned ? owner : NULL;
+	target = Harness_Spawn ("func_explosive", 40, 0, 0);
+	target->takedamage = DAMAGE_YES;
+	target->health = 1;
+	target->movetype = MOVETYPE_PUSH;
+	target->die = target_die;
+
+	// the barrel sets itself off and is gone before the queue drains
+	T_QueueRadiusDamage (barrel, barrel, 150, NULL, 200, MOD_BARREL);
+	G_FreeEdict (barrel);
+	G_RunExplosions ();
+
+	CHECK (died_attacker != NULL);
+	CHECK (IsEdict (died_attacker));
+	CHECK (IsEdict (target->enemy));
+	CHECK (IsEdict (target->activator));
+	CHECK (died_attacker == (owned ? owner : g_edicts));
+
+	// what Killed kept has to survive a save
+	Com_sprintf (path, sizeof(path), "%s/level.sav", argv[1]);
+	ge->WriteLevel (path);
+	ge->ReadLevel (path);
+	CHECK (harness.errors == 0);
+
+	printf ("ok\n");
+	return 0;
+}
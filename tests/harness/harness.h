@@ -0,0 +1,32 @@
+// harness.h -- a stand-in engine for running game code from the tests
+
+#include <setjmp.h>
+#include "g_local.h"
+
+// what the game has asked the engine to do since the last Harness_Reset
+typedef struct
+{
+	int		multicasts;
+	int		unicasts;
+	int		sounds;
+	int		pvs_tests;	// inPVS and inPHS calls
+	int		errors;
+} harness_counts_t;
+
+extern harness_counts_t	harness;
+
+// fills in every gi import, calls GetGameAPI and Init with maxclients
+game_export_t *Harness_Init (int maxclients);
+void Harness_Reset (void);
+
+// sets the arguments gi.argc/gi.argv/gi.args return
+void Harness_Args (int argc, char **argv);
+
+// a new solid 32 unit box, linked at x y z
+edict_t *Harness_Spawn (char *classname, float x, float y, float z);
+
+// gi.error longjmps here when set, otherwise it exits with status 2
+extern jmp_buf	*harness_error_jump;
+extern char		harness_error[1024];
+
+#define CHECK(cond)	do { if (!(cond)) { printf ("FAIL %s:%i: %s\n", __FILE__, __LINE__, #cond); return 1; } } while (0)
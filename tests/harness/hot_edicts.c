@@ -0,0 +1,38 @@
+// hot_edicts.c -- g_hot follows links the engine makes on its own, and
+// findradius sees what was changed without a link
+
+#include "harness.h"
+
+int main (int argc, char **argv)
+{
+	game_export_t	*ge;
+	edict_t			*brush, *ent;
+	vec3_t			org;
+	int				moves;
+
+	ge = Harness_Init (1);
+	ge->SpawnEntities ("harness", "{\n\"classname\" \"worldspawn\"\n}\n", "");
+
+	// gi.setmodel links an inline model without gi.linkentity
+	brush = Harness_Spawn ("func_wall", 0, 0, 0);
+	brush->solid = SOLID_BSP;
+	gi.linkentity (brush);
+	moves = g_brushmoves;
+	brush->s.origin[0] = 64;
+	gi.setmodel (brush, "*1");
+	CHECK (G_HOT(brush)->linkcount == brush->linkcount);
+	CHECK (G_HOT(brush)->solid == SOLID_BSP);
+	CHECK (g_brushmoves > moves);
+
+	// solid and origin set without a link
+	ent = Harness_Spawn ("thing", 0, 0, 0);
+	ent->solid = SOLID_NOT;
+	gi.linkentity (ent);
+	ent->solid = SOLID_TRIGGER;
+	VectorSet (ent->s.origin, 1000, 0, 0);
+	VectorSet (org, 1000, 0, 0);
+	CHECK (findradius (NULL, org, 8) == ent);
+
+	printf ("ok\n");
+	return 0;
+}
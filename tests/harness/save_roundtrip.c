@@ -0,0 +1,80 @@
+// save_roundtrip.c -- a level written out and read back is the level it was
+//
+// usage: save_roundtrip <dir> level|badedict
+//
+// level:    strings, edict pointers, items and plain fields come back as
+//           they were written, and NULL and "" stay apart
+// badedict: an edict pointer outside g_edicts is refused when it is written
+
+#include "harness.h"
+
+static char	*entities =
+	"{\n\"classname\" \"worldspawn\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"a\"\n\"origin\" \"0 0 0\"\n}\n"
+	"{\n\"classname\" \"info_notnull\"\n\"targetname\" \"b\"\n\"origin\" \"64 0 0\"\n}\n";
+
+int main (int argc, char **argv)
+{
+	game_export_t	*ge;
+	edict_t			*a, *b;
+	gitem_t			*item;
+	char			path[MAX_OSPATH];
+	jmp_buf			jump;
+
+	if (argc < 3)
+		return 1;
+	Com_sprintf (path, sizeof(path), "%s/roundtrip.sav", argv[1]);
+
+	ge = Harness_Init (1);
+	ge->SpawnEntities ("roundtrip", entities, "");
+	a = G_Find (NULL, FOFS(targetname), "a");
+	b = G_Find (NULL, FOFS(targetname), "b");
+	CHECK (a && b);
+
+	if (!strcmp (argv[2], "badedict"))
+	{
+		a->enemy = (edict_t *)&level;
+		harness_error_jump = &jump;
+		if (!setjmp (jump))
+		{
+			ge->WriteLevel (path);
+			CHECK (!"WriteLevel took a pointer outside g_edicts");
+		}
+		harness_error_jump = NULL;
+		CHECK (strstr (harness_error, "enemy") != NULL);
+		printf ("ok\n");
+		return 0;
+	}
+	if (strcmp (argv[2], "level"))
+		return 1;
+
+	item = FindItem ("Shells");
+	CHECK (item);
+	a->message = G_CopyString ("");
+	a->team = NULL;
+	a->pathtarget = G_CopyString ("corner");
+	a->enemy = b;
+	a->item = item;
+	a->health = 42;
+	a->s.origin[2] = 24;
+
+	ge->WriteLevel (path);
+	ge->SpawnEntities ("roundtrip", entities, "");
+	ge->ReadLevel (path);
+	CHECK (harness.errors == 0);
+
+	a = G_Find (NULL, FOFS(targetname), "a");
+	b = G_Find (NULL, FOFS(targetname), "b");
+	CHECK (a && b);
+	CHECK (a->message && !a->message[0]);
+	CHECK (a->team == NULL);
+	CHECK (a->pathtarget && !strcmp (a->pathtarget, "corner"));
+	CHECK (a->enemy == b);
+	CHECK (a->item == item);
+	CHECK (a->health == 42);
+	CHECK (a->s.origin[2] == 24);
+	CHECK (b->enemy == NULL);
+
+	printf ("ok\n");
+	return 0;
+}
@@ -0,0 +1,41 @@
+// snapshot_restore.c -- a quickload drops what the frame had queued
+//
+// A blast and a temp entity are queued after the quicksave.  Once the
+// world is put back, neither may go out when the frame finishes.
+
+#include "harness.h"
+
+int main (int argc, char **argv)
+{
+	game_export_t	*ge;
+	edict_t			*target, *barrel;
+	vec3_t			pos;
+
+	ge = Harness_Init (1);
+	ge->SpawnEntities ("harness", "{\n\"classname\" \"worldspawn\"\n}\n", "");
+
+	target = Harness_Spawn ("func_explosive", 40, 0, 0);
+	target->takedamage = DAMAGE_YES;
+	target->health = 100;
+	CHECK (G_QuickSave ());
+
+	barrel = Harness_Spawn ("misc_explobox", 0, 0, 0);
+	T_QueueRadiusDamage (barrel, barrel, 150, NULL, 200, MOD_BARREL);
+	VectorClear (pos);
+	G_TempEntityPoint (TE_EXPLOSION1, pos, MULTICAST_PVS);
+
+	CHECK (G_QuickLoad ());
+	CHECK (!barrel->inuse);
+
+	// what G_RunFrame does at the end of a frame
+	Harness_Reset ();
+	G_RunExplosions ();
+	G_FlushDamage ();
+	G_FlushTempEntities ();
+
+	CHECK (target->health == 100);
+	CHECK (harness.multicasts == 0);
+
+	printf ("ok\n");
+	return 0;
+}
@@ -0,0 +1,63 @@
+// tent_flush.c -- queued temp entities, their budgets and when they go out
+
+#include "harness.h"
+
+int main (int argc, char **argv)
+{
+	game_export_t	*ge;
+	edict_t			*ent;
+	usercmd_t		ucmd;
+	vec3_t			pos;
+	int				i;
+
+	ge = Harness_Init (4);
+	ge->SpawnEntities ("harness",
+		"{\n\"classname\" \"worldspawn\"\n}\n"
+		"{\n\"classname\" \"info_player_start\"\n\"origin\" \"0 0 0\"\n}\n", "");
+
+	// the client budget is opt-in
+	CHECK (g_te_client_budget->value == 0);
+	gi.cvar_set ("g_te_client_budget", "2");
+
+	for (i=1 ; i<=4 ; i++)
+	{
+		ent = &g_edicts[i];
+		CHECK (ge->ClientConnect (ent, "\\name\\player\\skin\\male/grunt"));
+		ge->ClientBegin (ent);
+	}
+
+	// ten puffs 20 units apart fall in three reach cells, and each client
+	// is tested once for every cell, not once for every puff
+	Harness_Reset ();
+	for (i=0 ; i<10 ; i++)
+	{
+		VectorSet (pos, i * 20, 0, 0);
+		G_TempEntityPoint (TE_GUNSHOT, pos, MULTICAST_PVS);
+	}
+	G_FlushTempEntities ();
+	CHECK (harness.pvs_tests == 3 * 4);
+	CHECK (harness.multicasts == 2);
+
+	// effects that can't be dropped still go out
+	Harness_Reset ();
+	VectorSet (pos, 0, 0, 0);
+	for (i=0 ; i<4 ; i++)
+	{
+		pos[0] = i * 20;
+		G_TempEntityPoint (TE_EXPLOSION1, pos, MULTICAST_PHS);
+	}
+	G_FlushTempEntities ();
+	CHECK (harness.multicasts == 4);
+
+	// an effect queued during a client's think goes out before it returns
+	Harness_Reset ();
+	G_TempEntityPoint (TE_GUNSHOT, pos, MULTICAST_PVS);
+	CHECK (harness.multicasts == 0);
+	memset (&ucmd, 0, sizeof(ucmd));
+	ucmd.msec = 100;
+	ge->ClientThink (&g_edicts[1], &ucmd);
+	CHECK (harness.multicasts == 1);
+
+	printf ("ok\n");
+	return 0;
+}
@@ -33,12 +33,12 @@ class ActorChatCooldownTests(unittest.TestCase):
     def test_broadcast_message_cooldown_sequence(self) -> None:
         block = extract_function_block(self.source_text, "Actor_BroadcastMessage")
         guard = re.search(
-            r"if\s*\(\s*level\.time\s*<\s*self->oblivion\.custom_name_time\s*\)\s*return\s*;",
+            r"if\s*\(\s*level\.time\s*<\s*ext->custom_name_time\s*\)\s*return\s*;",
             block,
         )
         self.assertIsNotNone(guard, "Cooldown guard missing from Actor_BroadcastMessage")
         assignment = re.search(
-            r"self->oblivion\.custom_name_time\s*=\s*level\.time\s*\+\s*ACTOR_CHAT_COOLDOWN\s*;",
+            r"ext->custom_name_time\s*=\s*level\.time\s*\+\s*ACTOR_CHAT_COOLDOWN\s*;",
             block,
         )
         self.assertIsNotNone(assignment, "Cooldown timer is not updated after broadcasting")
@@ -71,7 +71,7 @@ class ActorChatCooldownTests(unittest.TestCase):
     def test_reset_helper_rewinds_timer(self) -> None:
         reset_block = extract_function_block(self.source_text, "Actor_ResetChatCooldown")
         self.assertIn(
-            "self->oblivion.custom_name_time = level.time;",
+            "G_ActorExt(self)->custom_name_time = level.time;",
             reset_block,
             "Reset helper should rewind the cooldown to allow future messages",
         )
@@ -68,7 +68,7 @@ class ActorPathRuntimeTests(unittest.TestCase):
 
     def test_use_resets_controller_state(self) -> None:
         block = extract_function_block(self.source_text, "Actor_UseOblivion")
-        self.assertIn("self->oblivion.prev_path = NULL;", block)
+        self.assertIn("ext->prev_path = NULL;", block)
         self.assertIn("Actor_PathAssignController(self, NULL);", block)
         self.assertIn("Actor_UpdateMissionObjective(self);", block)
 
@@ -94,13 +94,13 @@ class ActorPathRuntimeTests(unittest.TestCase):
         self.assertIn("Actor_PathTrackController(self);", block)
         self.assertRegex(
             block,
-            r"self->oblivion.path_state\s*==\s*ACTOR_PATH_STATE_WAITING",
+            r"ext->path_state\s*==\s*ACTOR_PATH_STATE_WAITING",
         )
         self.assertIn("Actor_UpdateMissionObjective(self);", block)
 
     def test_path_select_idle_randomises(self) -> None:
         block = extract_function_block(self.source_text, "Actor_PathSelectIdleAnimation")
-        self.assertIn("rand() % 3", block)
+        self.assertIn("G_Rand() % 3", block)
         self.assertIn("self->monsterinfo.pausetime = level.time + delay;", block)
 
     def test_path_schedule_idle_sets_flag(self) -> None:
@@ -110,8 +110,8 @@ class ActorPathRuntimeTests(unittest.TestCase):
 
     def test_path_reconcile_updates_goal(self) -> None:
         block = extract_function_block(self.source_text, "Actor_PathReconcileTargets")
-        self.assertIn("self->goalentity = self->oblivion.controller;", block)
-        self.assertIn("self->oblivion.controller_serial = self->oblivion.controller->count;", block)
+        self.assertIn("self->goalentity = ext->controller;", block)
+        self.assertIn("ext->controller_serial = ext->controller->count;", block)
 
     def test_path_think_calls_monster_think(self) -> None:
         block = extract_function_block(self.source_text, "Actor_PathThink")
@@ -124,23 +124,23 @@ class ActorPathRuntimeTests(unittest.TestCase):
 
     def test_path_advance_updates_toggle_and_serial(self) -> None:
         block = extract_function_block(self.source_text, "Actor_PathAdvance")
-        self.assertIn("self->oblivion.path_toggle ^= 1;", block)
-        self.assertIn("self->oblivion.controller_serial = next_target ? next_target->count : 0;", block)
+        self.assertIn("ext->path_toggle ^= 1;", block)
+        self.assertIn("ext->controller_serial = next_target ? next_target->count : 0;", block)
 
     def test_path_assign_controller_sets_serial(self) -> None:
         block = extract_function_block(self.source_text, "Actor_PathAssignController")
-        self.assertIn("self->oblivion.controller_serial = controller ? controller->count : 0;", block)
+        self.assertIn("ext->controller_serial = controller ? controller->count : 0;", block)
         self.assertIn("Actor_PathScheduleIdle(self);", block)
 
     def test_actor_walk_updates_state(self) -> None:
         block = extract_function_block(self.source_text, "actor_walk")
         self.assertIn("self->monsterinfo.aiflags &= ~AI_ACTOR_PATH_IDLE;", block)
-        self.assertIn("self->oblivion.path_state = ACTOR_PATH_STATE_SEEKING;", block)
+        self.assertIn("ext->path_state = ACTOR_PATH_STATE_SEEKING;", block)
 
     def test_actor_run_updates_state(self) -> None:
         block = extract_function_block(self.source_text, "actor_run")
         self.assertIn("self->monsterinfo.aiflags &= ~AI_ACTOR_PATH_IDLE;", block)
-        self.assertIn("self->oblivion.path_state = ACTOR_PATH_STATE_SEEKING;", block)
+        self.assertIn("ext->path_state = ACTOR_PATH_STATE_SEEKING;", block)
 
     def test_path_fields_persisted_in_save(self) -> None:
         save_text = (REPO_ROOT / "src" / "game" / "g_save.c").read_text(encoding="utf-8")
@@ -167,7 +167,7 @@ class ActorPathRuntimeTests(unittest.TestCase):
         self.assertIn("Actor_BroadcastMessage(other, self->message);", block)
         broadcast_block = extract_function_block(self.source_text, "Actor_BroadcastMessage")
         self.assertIn(
-            "self->oblivion.custom_name_time = level.time + ACTOR_CHAT_COOLDOWN;",
+            "ext->custom_name_time = level.time + ACTOR_CHAT_COOLDOWN;",
             broadcast_block,
         )
         self.assertRegex(
@@ -179,7 +179,7 @@ class ActorPathRuntimeTests(unittest.TestCase):
     def test_path_wait_application_updates_timers(self) -> None:
         block = extract_function_block(self.source_text, "Actor_PathApplyWait")
         self.assertIn(
-            "self->oblivion.path_time = level.time + wait;",
+            "ext->path_time = level.time + wait;",
             block,
         )
         self.assertRegex(
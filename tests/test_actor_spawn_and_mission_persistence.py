@@ -94,17 +94,17 @@ class ActorSpawnAndMissionPersistenceTests(unittest.TestCase):
     def test_mission_fields_persisted_through_save_slots(self) -> None:
         self.assertRegex(
             self.save_text,
-            r"\{\"mission_timer_limit\",\s*FOFS\(oblivion\.mission_timer_limit\),\s*F_INT\}",
+            r"\{\"mission_timer_limit\",\s*MISOFS\(mission_timer_limit\),\s*F_INT,\s*FFL_MISSIONEXT\}",
             "Mission timer limit should be serialized",
         )
         self.assertRegex(
             self.save_text,
-            r"\{\"mission_timer_start\",\s*FOFS\(oblivion\.mission_timer_remaining\),\s*F_INT\}",
+            r"\{\"mission_timer_start\",\s*MISOFS\(mission_timer_remaining\),\s*F_INT,\s*FFL_MISSIONEXT\}",
             "Mission timer start/remaining should be serialized",
         )
         self.assertRegex(
             self.save_text,
-            r"\{\"mission_flags\",\s*FOFS\(oblivion\.mission_timer_cooldown\),\s*F_INT\}",
+            r"\{\"mission_flags\",\s*MISOFS\(mission_timer_cooldown\),\s*F_INT,\s*FFL_MISSIONEXT\}",
             "Mission flag bitmask should be serialized",
         )
 
@@ -112,12 +112,12 @@ class ActorSpawnAndMissionPersistenceTests(unittest.TestCase):
         actor_block = extract_function_block(self.actor_text, "Actor_InitMissionTimer")
         self.assertRegex(
             actor_block,
-            r"mission_timer_limit\s*<\s*0\)[^\n]*\n\s*self->oblivion\.mission_timer_limit\s*=\s*0;",
+            r"mission_timer_limit\s*<\s*0\)[^\n]*\n\s*mis->mission_timer_limit\s*=\s*0;",
             "Actor timers should clamp negative limits to zero",
         )
         self.assertRegex(
             actor_block,
-            r"mission_timer_remaining\s*<=\s*0[\s\S]*mission_timer_limit\s*>\s*0[\s\S]*mission_timer_remaining\s*=\s*self->oblivion\.mission_timer_limit",
+            r"mission_timer_remaining\s*<=\s*0[\s\S]*mission_timer_limit\s*>\s*0[\s\S]*mission_timer_remaining\s*=\s*mis->mission_timer_limit",
             "Actor timers should seed remaining time from the limit",
         )
 
@@ -129,7 +129,7 @@ class ActorSpawnAndMissionPersistenceTests(unittest.TestCase):
         )
         self.assertRegex(
             mission_block,
-            r"mission_timer_remaining\s*=\s*ent->oblivion\.mission_timer_limit;",
+            r"mission_timer_remaining\s*=\s*mis->mission_timer_limit;",
             "Mission registration should seed countdowns from the limit when missing",
         )
 
@@ -0,0 +1,14 @@
+import unittest
+
+import game_harness
+
+
+class ClientViewRunTests(unittest.TestCase):
+    def test_stats_and_blend_follow_their_inputs(self) -> None:
+        result = game_harness.run("client_stats")
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("ok", result.stdout)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -24,7 +24,7 @@ SOUND_SETUP_RE = re.compile(
     r"sound_([a-z0-9_\[\]]+)\s*=\s*gi.soundindex\s*\(\"([^\"]+)\"\);"
 )
 LAND_HELPER_CALL_RE = re.compile(r"cyborg_land\s*\(\s*self\s*\)\s*;")
-LANDING_FLAG_SET_RE = re.compile(r"self->oblivion\.cyborg_landing_thud\s*=\s*true\s*;")
+LANDING_FLAG_SET_RE = re.compile(r"ext->cyborg_landing_thud\s*=\s*true\s*;")
 
 
 def load_fixture() -> dict:
@@ -144,7 +144,7 @@ class CyborgRegressionTests(unittest.TestCase):
             "Pain handler must update the wounded stand-ground anchoring",
         )
 
-        debounce_assign = "self->oblivion.cyborg_pain_time = self->pain_debounce_time;"
+        debounce_assign = "ext->cyborg_pain_time = self->pain_debounce_time;"
         self.assertIn(
             debounce_assign,
             block,
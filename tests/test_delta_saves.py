@@ -0,0 +1,45 @@
+from pathlib import Path
+import tempfile
+import unittest
+
+import game_harness
+
+
+REPO_ROOT = Path(__file__).resolve().parents[1]
+GAME_DIR = REPO_ROOT / "src" / "game"
+
+
+class SpawnSeedTests(unittest.TestCase):
+    def test_spawn_is_seeded_from_the_map(self) -> None:
+        spawn = (GAME_DIR / "g_spawn.c").read_text(encoding="utf-8")
+        body = spawn[spawn.index("void SpawnEntities"):]
+        body = body[:body.index("\n}\n")]
+        self.assertNotIn("srand", body)
+        self.assertRegex(body, r"PlayerTrail_Init \(\);\s*\n\s*G_SeedRand \(seed\);")
+        self.assertRegex(body, r"if \(deathmatch->value\)\s*\n\s*G_FreeSpawnBaseline \(\);\s*\n\s*else\s*\n\s*G_CaptureSpawnBaseline \(\);\s*$")
+
+    def test_game_code_calls_its_own_generator(self) -> None:
+        header = (GAME_DIR / "g_local.h").read_text(encoding="utf-8")
+        self.assertNotRegex(header, r"#define\s+rand\s*\(")
+
+
+class DeltaSaveRunTests(unittest.TestCase):
+    def run_driver(self, mode: str) -> None:
+        env = {"HARNESS_CVAR_g_async_save": "0", "HARNESS_CVAR_g_hub_cache": "4"}
+        with tempfile.TemporaryDirectory() as tmp:
+            result = game_harness.run("delta_save", tmp, mode, env=env)
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("ok", result.stdout)
+
+    def test_hub_cache_rebuilds_from_the_spawn_baseline(self) -> None:
+        self.run_driver("cache")
+
+    def test_changed_map_loads_from_the_whole_file(self) -> None:
+        self.run_driver("changed")
+
+    def test_cached_level_clears_every_edict(self) -> None:
+        self.run_driver("stale")
+
+
+if __name__ == "__main__":
+    unittest.main()
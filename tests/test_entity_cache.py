@@ -0,0 +1,25 @@
+import tempfile
+import unittest
+
+import game_harness
+
+
+class EntityCacheRunTests(unittest.TestCase):
+    def run_driver(self, damage: str) -> None:
+        with tempfile.TemporaryDirectory() as tmp:
+            result = game_harness.run("entcache_bind", damage, cwd=tmp)
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("ok", result.stdout)
+
+    def test_out_of_range_field_is_rejected(self) -> None:
+        self.run_driver("field")
+
+    def test_out_of_range_string_is_rejected(self) -> None:
+        self.run_driver("string")
+
+    def test_out_of_range_spawn_is_rejected(self) -> None:
+        self.run_driver("spawn")
+
+
+if __name__ == "__main__":
+    unittest.main()
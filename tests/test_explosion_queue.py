@@ -0,0 +1,87 @@
+import re
+from pathlib import Path
+import tempfile
+import unittest
+
+import game_harness
+
+
+REPO_ROOT = Path(__file__).resolve().parents[1]
+GAME_DIR = REPO_ROOT / "src" / "game"
+
+
+def extract_function_block(source: str, function_name: str) -> str:
+    pattern = re.compile(rf"{function_name}\s*\([^)]*\)\s*\{{", re.MULTILINE)
+    match = pattern.search(source)
+    if not match:
+        raise AssertionError(f"Could not locate function {function_name}")
+    start = match.end()
+    depth = 1
+    idx = start
+    while idx < len(source) and depth > 0:
+        char = source[idx]
+        if char == "{":
+            depth += 1
+        elif char == "}":
+            depth -= 1
+        idx += 1
+    return source[match.start():idx]
+
+
+class ExplosionQueueTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.weapon_source = (GAME_DIR / "g_weapon.c").read_text(encoding="utf-8")
+        cls.misc_source = (GAME_DIR / "g_misc.c").read_text(encoding="utf-8")
+        cls.main_source = (GAME_DIR / "g_main.c").read_text(encoding="utf-8")
+        cls.combat_source = (GAME_DIR / "g_combat.c").read_text(encoding="utf-8")
+
+    def test_chained_explosives_queue_their_blasts(self) -> None:
+        sites = {
+            "barrel_explode": self.misc_source,
+            "func_explosive_explode": self.misc_source,
+            "Grenade_Explode": self.weapon_source,
+            "fire_donut": self.weapon_source,
+            "detpack_detonate": self.weapon_source,
+            "proximity_mine_explode": self.weapon_source,
+        }
+        for name, source in sites.items():
+            with self.subTest(function=name):
+                block = extract_function_block(source, name)
+                self.assertIn("T_QueueRadiusDamage", block)
+                self.assertNotRegex(block, r"\bT_RadiusDamage\s*\(")
+
+    def test_queue_drains_after_entity_loop(self) -> None:
+        block = extract_function_block(self.main_source, "G_RunFrame_Internal")
+        run_entity = block.find("G_RunEntity (ent);")
+        drain = block.find("G_RunExplosions ();")
+        dm_rules = block.find("CheckDMRules ();")
+        self.assertGreater(run_entity, -1)
+        self.assertGreater(drain, run_entity, "Blasts must resolve after every entity has thought")
+        self.assertLess(drain, dm_rules, "Blast kills must count before the frag/time limit check")
+
+    def test_resolution_matches_radius_damage_falloff(self) -> None:
+        radius = extract_function_block(self.combat_source, "T_RadiusDamage")
+        cluster = extract_function_block(self.combat_source, "Blast_ResolveCluster")
+        self.assertIn("points = damage - 0.5 * VectorLength (v);", radius)
+        self.assertIn("points = cluster[i].damage - 0.5 * VectorLength (v);", cluster)
+        self.assertIn("points = points * 0.5;", cluster)
+        self.assertIn("DAMAGE_RADIUS", cluster)
+
+
+class ExplosionQueueRunTests(unittest.TestCase):
+    def run_driver(self, *args: str) -> None:
+        with tempfile.TemporaryDirectory() as tmp:
+            result = game_harness.run("explosion_owner", tmp, *args)
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("ok", result.stdout)
+
+    def test_freed_self_attacker_falls_back_to_world(self) -> None:
+        self.run_driver()
+
+    def test_freed_self_attacker_falls_back_to_owner(self) -> None:
+        self.run_driver("owner")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -32,6 +32,25 @@ def _collect_itemlist_classnames(source: str) -> Set[str]:
     return classnames
 
 
+def _collect_itemlist_pickup_names(source: str) -> Set[str]:
+    block = _extract_itemlist_block(source)
+    return set(re.findall(r"/\* pickup \*/\s*\"([^\"]+)\"", block))
+
+
+def _collect_itemid_names(source: str) -> list:
+    match = re.search(r"itemid_names\[NUM_ITEM_IDS\]\s*=\s*\{(.*?)\};", source, re.S)
+    if not match:
+        raise AssertionError("Could not locate itemid_names[] in g_items.c")
+    return re.findall(r"\"([^\"]+)\"", match.group(1))
+
+
+def _collect_itemid_constants(header: str) -> list:
+    match = re.search(r"\bITEM_NONE,(.*?)NUM_ITEM_IDS", header, re.S)
+    if not match:
+        raise AssertionError("Could not locate the itemid_t enum in g_local.h")
+    return re.findall(r"\b(ITEM_[A-Z0-9_]+)\b", match.group(1))
+
+
 class HLILItemlistSyncTest(unittest.TestCase):
     def test_hlil_items_exist_in_itemlist(self) -> None:
         repo_root = Path(__file__).resolve().parents[1]
@@ -63,6 +82,26 @@ class HLILItemlistSyncTest(unittest.TestCase):
             f"HLIL weapon/key classnames missing from g_items itemlist: {missing}",
         )
 
+    def test_item_ids_name_existing_items(self) -> None:
+        repo_root = Path(__file__).resolve().parents[1]
+        g_items_source = (repo_root / "src" / "game" / "g_items.c").read_text(encoding="utf-8")
+        header = (repo_root / "src" / "game" / "g_local.h").read_text(encoding="utf-8")
+        constants = _collect_itemid_constants(header)
+        names = _collect_itemid_names(g_items_source)
+        self.assertEqual(
+            len(constants),
+            len(names),
+            "itemid_t constants and itemid_names[] entries are out of step",
+        )
+        known = {
+            name.lower()
+            for name in _collect_itemlist_pickup_names(g_items_source)
+            | _collect_itemlist_classnames(g_items_source)
+        }
+        missing = [name for name in names if name.lower() not in known]
+        self.assertEqual(missing, [], f"itemid_names[] entries with no itemlist item: {missing}")
+
+
 
 if __name__ == "__main__":
     unittest.main()
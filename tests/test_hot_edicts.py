@@ -0,0 +1,14 @@
+import unittest
+
+import game_harness
+
+
+class HotEdictRunTests(unittest.TestCase):
+    def test_hot_entries_follow_engine_links_and_findradius_reads_the_edict(self) -> None:
+        result = game_harness.run("hot_edicts")
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("ok", result.stdout)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -7,7 +7,7 @@ REPO_ROOT = Path(__file__).resolve().parents[1]
 G_SAVE_PATH = REPO_ROOT / "src" / "game" / "g_save.c"
 
 MISSION_FIELD_RE = re.compile(
-    r"\{\s*\"(?P<name>mission_[^\"]+)\"\s*,\s*FOFS\(oblivion\.[^)]*\)\s*,\s*(?P<type>F_[A-Z_]+)",
+    r"\{\s*\"(?P<name>mission_[^\"]+)\"\s*,\s*(?:ACTOFS|MISOFS)\([^)]*\)\s*,\s*(?P<type>F_[A-Z_]+)",
 )
 
 
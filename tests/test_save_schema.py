@@ -0,0 +1,105 @@
+import re
+from pathlib import Path
+import tempfile
+import unittest
+
+import game_harness
+
+
+REPO_ROOT = Path(__file__).resolve().parents[1]
+GAME_DIR = REPO_ROOT / "src" / "game"
+
+# rebuilt by gi.linkentity on load, never saved
+SERVER_OWNED = {"area", "num_clusters", "clusternums", "headnode", "areanum", "areanum2", "absmin", "absmax", "size"}
+
+
+def extract_struct_body(source: str, header: str) -> str:
+    start = source.index(header)
+    start = source.index("{", start) + 1
+    depth = 1
+    idx = start
+    while depth > 0:
+        if source[idx] == "{":
+            depth += 1
+        elif source[idx] == "}":
+            depth -= 1
+        idx += 1
+    return source[start:idx - 1]
+
+
+def extract_table(source: str, name: str) -> str:
+    start = source.index(f"field_t\t\t{name}[] =")
+    return source[start:source.index("};", start)]
+
+
+def struct_members(body: str) -> set[str]:
+    body = re.sub(r"//[^\n]*", "", body)
+    body = re.sub(r"/\*.*?\*/", "", body, flags=re.S)
+    # nested anonymous structs are named after their member
+    body = re.sub(r"struct\s*\{[^}]*\}\s*(\w+)\s*;", r"\1;", body)
+    members = set()
+    for decl in body.split(";"):
+        decl = decl.strip()
+        if not decl:
+            continue
+        func = re.search(r"\(\s*\*\s*(\w+)\s*\)", decl)
+        if func:
+            members.add(func.group(1))
+            continue
+        for part in decl.split(","):
+            name = re.search(r"(\w+)\s*(\[[^\]]*\])?\s*$", part.strip())
+            if name:
+                members.add(name.group(1))
+    return members
+
+
+class SaveSchemaTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.header = (GAME_DIR / "g_local.h").read_text(encoding="utf-8")
+        cls.save_source = (GAME_DIR / "g_save.c").read_text(encoding="utf-8")
+
+    def assert_covered(self, struct_header: str, table: str, offset_macro: str, skip: set[str]) -> None:
+        members = struct_members(extract_struct_body(self.header, struct_header))
+        saved = extract_table(self.save_source, table)
+        for member in sorted(members - skip):
+            with self.subTest(member=member):
+                self.assertRegex(
+                    saved,
+                    rf"(?:{offset_macro}|PERSFIELDS)\({re.escape(member)}[.)]",
+                    f"{member} has no descriptor in {table}[]",
+                )
+
+    def test_every_edict_member_has_a_descriptor(self) -> None:
+        self.assert_covered("struct edict_s\n{", "savefields", "FOFS", SERVER_OWNED)
+
+    def test_every_client_member_has_a_descriptor(self) -> None:
+        self.assert_covered("struct gclient_s\n{", "clientfields", "CLOFS", set())
+
+    def test_every_level_member_has_a_descriptor(self) -> None:
+        start = self.header.index("} level_locals_t;")
+        header = self.header[self.header.rindex("typedef struct", 0, start):start + 1]
+        members = struct_members(extract_struct_body(header, "typedef struct"))
+        saved = extract_table(self.save_source, "levelfields")
+        for member in sorted(members):
+            with self.subTest(member=member):
+                self.assertIn(f"LLOFS({member})", saved)
+
+
+class SaveRoundTripRunTests(unittest.TestCase):
+    def run_driver(self, mode: str) -> None:
+        env = {"HARNESS_CVAR_g_async_save": "0", "HARNESS_CVAR_g_hub_cache": "0"}
+        with tempfile.TemporaryDirectory() as tmp:
+            result = game_harness.run("save_roundtrip", tmp, mode, env=env)
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("ok", result.stdout)
+
+    def test_level_reads_back_as_it_was_written(self) -> None:
+        self.run_driver("level")
+
+    def test_edict_pointer_outside_the_array_is_refused(self) -> None:
+        self.run_driver("badedict")
+
+
+if __name__ == "__main__":
+    unittest.main()
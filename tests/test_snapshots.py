@@ -0,0 +1,14 @@
+import unittest
+
+import game_harness
+
+
+class SnapshotRunTests(unittest.TestCase):
+    def test_restore_drops_queued_blasts_and_effects(self) -> None:
+        result = game_harness.run("snapshot_restore")
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("ok", result.stdout)
+
+
+if __name__ == "__main__":
+    unittest.main()
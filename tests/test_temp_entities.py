@@ -0,0 +1,14 @@
+import unittest
+
+import game_harness
+
+
+class TempEntityRunTests(unittest.TestCase):
+    def test_budgets_test_each_spot_once_and_client_thinks_flush(self) -> None:
+        result = game_harness.run("tent_flush")
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("ok", result.stdout)
+
+
+if __name__ == "__main__":
+    unittest.main()